@@ -0,0 +1,326 @@
+/**
+ * \file  actor_scheduler_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Events going through a chain of actors, as from the postman to the leds, with a thread for each actor or on
+ * the workers of ACTOR_POOL_SCHEDULER : resident memory, threads, context switches per second and latency from the
+ * first actor to the last one. The stacks of the threads are reserved in vm_kb, resident once touched.
+ *   ../bin/actor_scheduler_bench.elf                  8 actors, an event every 200 us, both schedulers
+ *   ../bin/actor_scheduler_bench.elf -m pool -i 0     pool only, as fast as the actors take them
+ *
+ * \see ../src/lib/actor.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "lib/actor.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def MAX_ACTORS
+ * Longest chain of actors.
+ */
+#define MAX_ACTORS 16
+/**
+ * \def MSG_COUNT
+ * Messages held by the mailbox of each actor, as for the modules.
+ */
+#define MSG_COUNT 10
+/**
+ * \def NAME_SIZE
+ * Size of the names of the actors and of their mailboxes.
+ */
+#define NAME_SIZE 16
+/* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/**
+ * \enum Bench_State
+ * \brief States of the actors.
+ */
+typedef enum {
+    S_FORGET = ACTOR_FORGET,
+    S_RUNNING,
+    S_DEATH,
+    S_NB,
+} Bench_State;
+/**
+ * \enum Bench_Event_Id
+ * \brief Events of the actors.
+ */
+typedef enum {
+    E_HOP = 0,
+    E_STOP,
+    E_NB,
+} Bench_Event_Id;
+/**
+ * \enum Bench_Action
+ * \brief Actions of the actors.
+ */
+typedef enum {
+    A_NOP = 0,
+    A_FORWARD,
+} Bench_Action;
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Bench_Msg
+ * \brief Event of the size of the messages of the modules, stamped when sent to the first actor.
+ */
+typedef struct {
+    Bench_Event_Id event;  /**< Event of the state machine. */
+    uint32_t hop;          /**< Actor handling the event. */
+    uint64_t sent_at;      /**< Time of the send to the first actor, in nanoseconds. */
+    uint8_t data[40];      /**< Rest of the event. */
+} Bench_Msg;
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static int BENCH_run(const char * mode)
+ * \brief Sends the events through the chain of actors on the given scheduler and prints the measures.
+ * \return 0 on success, -1 on error.
+ */
+static int BENCH_run(const char * mode);
+/**
+ * \fn static int BENCH_perform(int action, void * msg)
+ * \brief Actions of the actors : forwards the event to the next actor, or measures it at the end of the chain.
+ */
+static int BENCH_perform(int action, void * msg);
+/**
+ * \fn static long BENCH_status(const char * field)
+ * \brief Reads a field of /proc/self/status, in kB for the memory.
+ */
+static long BENCH_status(const char * field);
+/**
+ * \fn static int BENCH_compare(const void * a, const void * b)
+ * \brief Orders the latencies for qsort().
+ */
+static int BENCH_compare(const void * a, const void * b);
+/**
+ * \fn static uint64_t BENCH_now(void)
+ * \brief Reads the monotonic clock, in nanoseconds.
+ */
+static uint64_t BENCH_now(void);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static const Actor_Transition state_machine[S_NB - 1][E_NB]
+ * \brief State machine of the actors.
+ */
+static const Actor_Transition state_machine[S_NB - 1][E_NB] = {
+    [S_RUNNING][E_HOP] = {S_RUNNING, A_FORWARD},
+    [S_RUNNING][E_STOP] = {S_DEATH, A_NOP},
+};
+/**
+ * \var static Actor * actors[MAX_ACTORS]
+ * \brief Chain of actors.
+ */
+static Actor * actors[MAX_ACTORS];
+/**
+ * \var static uint64_t * latencies
+ * \brief Latencies of the events, written by the last actor only.
+ */
+static uint64_t * latencies;
+/**
+ * \var static long measured
+ * \brief Events which reached the last actor.
+ */
+static long measured;
+/**
+ * \var static long actors_nb
+ * \brief Actors of the chain.
+ */
+static long actors_nb = 8;
+/**
+ * \var static long events_nb
+ * \brief Events sent to the first actor.
+ */
+static long events_nb = 20000;
+/**
+ * \var static long interval
+ * \brief Time between two events in microseconds, 0 to send as fast as the first actor takes them.
+ */
+static long interval = 200;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    const char * mode = NULL;
+    while((option = getopt(argc, argv, "m:a:n:i:")) != -1) {
+        switch(option) {
+            case 'm' : mode = optarg; break;
+            case 'a' : actors_nb = atol(optarg); break;
+            case 'n' : events_nb = atol(optarg); break;
+            case 'i' : interval = atol(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-m thread|pool] [-a actors] [-n events] [-i interval_us]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(actors_nb <= 0 || actors_nb > MAX_ACTORS || events_nb <= 0 || interval < 0
+       || (mode != NULL && strcmp(mode, "thread") != 0 && strcmp(mode, "pool") != 0)) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+    if((mode == NULL || strcmp(mode, "thread") == 0) && BENCH_run("thread") == -1) {
+        return EXIT_FAILURE;
+    }
+    if((mode == NULL || strcmp(mode, "pool") == 0) && BENCH_run("pool") == -1) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static int BENCH_run(const char * mode) {
+    static char names[MAX_ACTORS][2][NAME_SIZE];
+    static Actor_Descriptor descriptors[MAX_ACTORS];
+    ACTOR_set_scheduler(strcmp(mode, "pool") == 0 ? &ACTOR_POOL_SCHEDULER : &ACTOR_THREAD_SCHEDULER);
+    latencies = malloc((size_t) events_nb * sizeof(uint64_t));
+    __atomic_store_n(&measured, 0, __ATOMIC_SEQ_CST);
+    for(long id = 0; id < actors_nb; id++) {
+        snprintf(names[id][0], NAME_SIZE, "bench_%ld", id);
+        snprintf(names[id][1], NAME_SIZE, "/bench_%ld", id);
+        descriptors[id] = (Actor_Descriptor) {
+            .name = names[id][0],
+            .mailbox_name = names[id][1],
+            .msg_size = sizeof(Bench_Msg),
+            .msg_count = MSG_COUNT,
+            .priorities_nb = 1,
+            .mailbox_kind = MAILBOX_RING,
+            .state_machine = &state_machine[0][0],
+            .states_nb = S_NB,
+            .events_nb = E_NB,
+            .event_offset = offsetof(Bench_Msg, event),
+            .initial_state = S_RUNNING,
+            .initial_action = A_NOP,
+            .perform = BENCH_perform,
+            .run = NULL,
+            .is_logged = FALSE,
+        };
+        if(latencies == NULL || (actors[id] = ACTOR_create(&descriptors[id])) == NULL || ACTOR_start(actors[id]) == -1) {
+            fprintf(stderr, "ACTOR_create or ACTOR_start failed.\n");
+            return -1;
+        }
+    }
+
+    struct rusage usage_before, usage_after;
+    getrusage(RUSAGE_SELF, &usage_before);
+    Bench_Msg msg = {.event = E_HOP, .hop = 0};
+    uint64_t start = BENCH_now();
+    uint64_t next = start;
+    for(long event_id = 0; event_id < events_nb; event_id++) {
+        if(interval > 0) {
+            next += (uint64_t) interval * 1000;
+            struct timespec deadline = {.tv_sec = (time_t) (next / 1000000000), .tv_nsec = (long) (next % 1000000000)};
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        }
+        msg.sent_at = BENCH_now();
+        if(ACTOR_send(actors[0], &msg, 0) == -1) {
+            perror("ACTOR_send");
+            return -1;
+        }
+    }
+    while(__atomic_load_n(&measured, __ATOMIC_ACQUIRE) < events_nb) {
+        usleep(1000);
+    }
+    uint64_t elapsed = BENCH_now() - start;
+    getrusage(RUSAGE_SELF, &usage_after);
+    long rss = BENCH_status("VmRSS:");
+    long vm = BENCH_status("VmSize:");
+    long threads = BENCH_status("Threads:");
+
+    Bench_Msg stop = {.event = E_STOP};
+    for(long id = 0; id < actors_nb; id++) {
+        ACTOR_send(actors[id], &stop, 0);
+    }
+    for(long id = 0; id < actors_nb; id++) {
+        ACTOR_join(actors[id]);
+        ACTOR_destroy(actors[id]);
+    }
+
+    qsort(latencies, (size_t) events_nb, sizeof(uint64_t), BENCH_compare);
+    long switches = (usage_after.ru_nvcsw - usage_before.ru_nvcsw) + (usage_after.ru_nivcsw - usage_before.ru_nivcsw);
+    printf("scheduler %s\n", mode);
+    printf("actors %ld\n", actors_nb);
+    printf("threads %ld\n", threads);
+    printf("rss_kb %ld\n", rss);
+    printf("vm_kb %ld\n", vm);
+    printf("events %ld\n", events_nb);
+    printf("events_per_s %.0f\n", events_nb / (elapsed / 1e9));
+    printf("context_switches_per_s %.0f\n", switches / (elapsed / 1e9));
+    printf("context_switches_per_event %.2f\n", (double) switches / events_nb);
+    printf("latency_p50_us %.2f\n", latencies[events_nb / 2] / 1e3);
+    printf("latency_p99_us %.2f\n", latencies[events_nb * 99 / 100] / 1e3);
+    printf("latency_max_us %.2f\n\n", latencies[events_nb - 1] / 1e3);
+    free(latencies);
+    return 0;
+}
+
+static int BENCH_perform(int action, void * msg) {
+    Bench_Msg * bench_msg = (Bench_Msg *) msg;
+    if(action != A_FORWARD) {
+        return 0;
+    }
+    if(++bench_msg->hop < actors_nb) {
+        return ACTOR_send(actors[bench_msg->hop], bench_msg, 0);
+    }
+    long id = __atomic_load_n(&measured, __ATOMIC_RELAXED);
+    latencies[id] = BENCH_now() - bench_msg->sent_at;
+    __atomic_store_n(&measured, id + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+static long BENCH_status(const char * field) {
+    char line[128];
+    long value = -1;
+    FILE * status = fopen("/proc/self/status", "r");
+    if(status == NULL) {
+        return -1;
+    }
+    while(fgets(line, sizeof(line), status) != NULL) {
+        if(strncmp(line, field, strlen(field)) == 0) {
+            value = atol(line + strlen(field));
+            break;
+        }
+    }
+    fclose(status);
+    return value;
+}
+
+static int BENCH_compare(const void * a, const void * b) {
+    uint64_t first = *(const uint64_t *) a;
+    uint64_t second = *(const uint64_t *) b;
+    return (first > second) - (first < second);
+}
+
+static uint64_t BENCH_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
@@ -0,0 +1,244 @@
+/**
+ * \file  dispatcher_batch_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Measures the cost of a command when SB_IHM sends its control updates one frame per message or as one ASK_BATCH frame.
+ *
+ * \see ../src/com/dispatcher.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "com/postman.h"
+#include "com/frame_pool.h"
+#include "com/dispatcher.h"
+#include "com/capabilities.h"
+#include "controller/pilot.h"
+#include "controller/controller_ringer.h"
+#include "alphabot2/camera.h"
+#include "lib/protocol.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def SERVER_PORT
+ * Port the postman listens on.
+ */
+#define SERVER_PORT 12345
+/**
+ * \def DEFAULT_UPDATES
+ * Amount of control updates sent by default.
+ */
+#define DEFAULT_UPDATES 100000
+/**
+ * \def UPDATE_COMMANDS
+ * Messages of a control update : SET_MODE, SET_STATE then ASK_CMD.
+ */
+#define UPDATE_COMMANDS 3
+/**
+ * \def UPDATE_MAX_SIZE
+ * Biggest control update on the wire, batch head included.
+ */
+#define UPDATE_MAX_SIZE 64
+/**
+ * \def WAIT_TIMEOUT_S
+ * Time given to SB_C to handle every update once they are all sent.
+ */
+#define WAIT_TIMEOUT_S 10
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static size_t BENCH_write_update(uint8_t * update, Command command, int is_batched)
+ * \brief Writes a control update as SB_IHM would : three frames, or one ASK_BATCH frame holding them.
+ * \return Size of the update.
+ */
+static size_t BENCH_write_update(uint8_t * update, Command command, int is_batched);
+/**
+ * \fn static uint64_t BENCH_now(int clock)
+ * \brief Reads a clock, in nanoseconds.
+ */
+static uint64_t BENCH_now(int clock);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static long handled_commands
+ * \brief ASK_CMD that reached the pilot.
+ */
+static long handled_commands;
+/**
+ * \var static pthread_mutex_t handled_mutex
+ * \brief Protects handled_commands.
+ */
+static pthread_mutex_t handled_mutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * \var static pthread_cond_t handled_condition
+ * \brief Signaled at each ASK_CMD reaching the pilot.
+ */
+static pthread_cond_t handled_condition = PTHREAD_COND_INITIALIZER;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    int is_batched = 0;
+    long updates = DEFAULT_UPDATES;
+    while((option = getopt(argc, argv, "n:b")) != -1) {
+        switch(option) {
+            case 'n' : updates = atol(optarg); break;
+            case 'b' : is_batched = 1; break;
+            default :
+                fprintf(stderr, "usage: %s [-n updates] [-b]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(updates <= 0) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+    if(FRAME_POOL_create() == -1 || DISPATCHER_create() == -1 || POSTMAN_create() == -1
+        || DISPATCHER_start() == -1 || POSTMAN_start() == -1) {
+        fprintf(stderr, "SB_C modules failed to start.\n");
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_in server = {.sin_family = AF_INET, .sin_port = htons(SERVER_PORT)};
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int operator_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if(connect(operator_socket, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        return EXIT_FAILURE;
+    }
+    /* SB_IHM flushes each message on its own. */
+    int is_set = 1;
+    setsockopt(operator_socket, IPPROTO_TCP, TCP_NODELAY, &is_set, sizeof(is_set));
+    usleep(100000); /* Lets the postman accept the operator. */
+    DISPATCHER_start_reading(); /* What controller_core does once connected. */
+    /* What an up-to-date SB_IHM announces with its first ASK_AVAILABILITY. */
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_BATCH);
+
+    uint8_t update[UPDATE_MAX_SIZE];
+    unsigned long frames = 0, wire_bytes = 0;
+    uint64_t wall_start = BENCH_now(CLOCK_MONOTONIC);
+    uint64_t cpu_start = BENCH_now(CLOCK_PROCESS_CPUTIME_ID);
+    for(long i = 0; i < updates; i++) {
+        size_t update_size = BENCH_write_update(update, (Command) (i % STOP), is_batched);
+        /* One write for each frame of the update. */
+        for(size_t offset = 0; offset < update_size; frames++) {
+            size_t frame_size = 2 + (size_t) PROTOCOL_get_U16(update + offset);
+            if(send(operator_socket, update + offset, frame_size, 0) != (ssize_t) frame_size) {
+                perror("send");
+                return EXIT_FAILURE;
+            }
+            offset += frame_size;
+        }
+        wire_bytes += update_size;
+    }
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += WAIT_TIMEOUT_S;
+    pthread_mutex_lock(&handled_mutex);
+    while(handled_commands < updates) {
+        if(pthread_cond_timedwait(&handled_condition, &handled_mutex, &deadline) != 0) {
+            break;
+        }
+    }
+    long handled = handled_commands;
+    pthread_mutex_unlock(&handled_mutex);
+    uint64_t wall_ns = BENCH_now(CLOCK_MONOTONIC) - wall_start;
+    uint64_t cpu_ns = BENCH_now(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+
+    long commands = updates * UPDATE_COMMANDS;
+    printf("framing %s\n", is_batched ? "batch" : "frames");
+    printf("commands %ld\n", commands);
+    printf("commands_lost %ld\n", (updates - handled) * UPDATE_COMMANDS);
+    printf("frames %lu\n", frames);
+    printf("wire_bytes_per_command %.2f\n", (double) wire_bytes / commands);
+    printf("wall_ns_per_command %.1f\n", (double) wall_ns / commands);
+    printf("cpu_ns_per_command %.1f\n", (double) cpu_ns / commands);
+
+    close(operator_socket);
+    POSTMAN_stop();
+    DISPATCHER_stop();
+    POSTMAN_destroy();
+    DISPATCHER_destroy();
+    FRAME_POOL_destroy();
+    return handled == updates ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int PILOT_ask_cmd(Command cmd) {
+    pthread_mutex_lock(&handled_mutex);
+    handled_commands++;
+    pthread_cond_signal(&handled_condition);
+    pthread_mutex_unlock(&handled_mutex);
+    return 0;
+}
+
+int CONTROLLER_RINGER_ask_availability(int id_robot) {
+    return 0;
+}
+
+int CAMERA_set_up_ihm_info(char * ip_address, uint16_t port) {
+    return 0;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static size_t BENCH_write_update(uint8_t * update, Command command, int is_batched) {
+    uint8_t * frame = is_batched ? update + PROTOCOL_HEAD_SIZE : update;
+    uint8_t * payload;
+
+    payload = PROTOCOL_encode_SET_MODE(frame);
+    PROTOCOL_put_SET_MODE_camera_mode(payload, ENABLED);
+    PROTOCOL_put_SET_MODE_radar_mode(payload, ENABLED);
+    PROTOCOL_put_SET_MODE_buzzer_mode(payload, DISABLED);
+    PROTOCOL_put_SET_MODE_leds_mode(payload, ENABLED);
+    frame = payload + PROTOCOL_SET_MODE_SIZE;
+    payload = PROTOCOL_encode_SET_STATE(frame);
+    PROTOCOL_put_SET_STATE_state(payload, SELECTED);
+    frame = payload + PROTOCOL_SET_STATE_SIZE;
+    payload = PROTOCOL_encode_ASK_CMD(frame);
+    PROTOCOL_put_ASK_CMD_command(payload, command);
+    frame = payload + PROTOCOL_ASK_CMD_SIZE;
+
+    size_t update_size = (size_t) (frame - update);
+    if(is_batched) {
+        PROTOCOL_put_head(update, ASK_BATCH, (uint16_t) (update_size - PROTOCOL_HEAD_SIZE));
+    }
+    return update_size;
+}
+
+static uint64_t BENCH_now(int clock) {
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
@@ -0,0 +1,440 @@
+/**
+ * \file  dispatcher_fuzz.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Fuzzing harness of the read, decode and dispatch path of SB_C : the bytes of SB_IHM go through postman, the
+ * frame reader and the dispatcher, the modules behind them are stubbed.
+ *
+ * \see ../src/com/dispatcher.c
+ * \see ../src/com/postman.c
+ *
+ * Built with clang (make fuzz), the harness is a libFuzzer target. Built with gcc, it replays inputs, writes the seed
+ * corpus, mutates it by itself or measures the frames decoded per second :
+ *   ../bin/dispatcher_fuzz.elf -s corpus/          writes a valid frame of every Message_Type
+ *   ../bin/dispatcher_fuzz.elf crash-1234 ...      replays inputs
+ *   ../bin/dispatcher_fuzz.elf -m 1000000 corpus/  mutates the files of the corpus
+ *   ../bin/dispatcher_fuzz.elf -b [-f fragment]    measures the decoding
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include "controller/controller_ringer.h"
+#include "alphabot2/camera.h"
+#include "com/frame_reader.h"
+/* The registry and the handlers are private : the harness is built with the dispatcher, as its tests are. */
+#include "com/dispatcher.c"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def MAX_INPUT_SIZE
+ * Biggest input read from a file, a few frames of the biggest size.
+ */
+#define MAX_INPUT_SIZE (4 * FRAME_READER_BUFFER_SIZE)
+/**
+ * \def MAX_SEED_SIZE
+ * Biggest frame of the seed corpus.
+ */
+#define MAX_SEED_SIZE 64
+/**
+ * \def MAX_SPLICED_SEEDS
+ * Most seeds put one after the other in a mutated input.
+ */
+#define MAX_SPLICED_SEEDS 4
+/**
+ * \def MAX_MUTATIONS
+ * Most mutations applied to an input.
+ */
+#define MAX_MUTATIONS 8
+/**
+ * \def BENCH_STREAM_SIZE
+ * Size of the stream decoded at each pass of the benchmark.
+ */
+#define BENCH_STREAM_SIZE 65536
+/**
+ * \def BENCH_DURATION_S
+ * Duration of the benchmark.
+ */
+#define BENCH_DURATION_S 2
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Seed
+ * \brief Message type of the seed corpus.
+ */
+typedef struct {
+    const char * name;      /**< Name of the type, name of its file. */
+    Message_Type type;      /**< Type of the frame. */
+    uint16_t fields_size;   /**< Size of its fields. */
+} Seed;
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size)
+ * \brief Entry point of libFuzzer. The first byte gives the most bytes a recv() returns (0 for as many as asked),
+ * the others are the stream sent by SB_IHM.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size);
+/**
+ * \fn ssize_t __wrap_recv(int socket, void * buffer, size_t length, int flags)
+ * \brief Gives the stream of the input to the frame reader, cut as the input asks (linked with -Wl,--wrap=recv).
+ */
+ssize_t __wrap_recv(int socket, void * buffer, size_t length, int flags);
+#ifndef BENCH_LIBFUZZER
+/**
+ * \fn static size_t BENCH_write_seed(uint8_t * input, const Seed * seed)
+ * \brief Writes the input holding a valid frame of a type, sent in one piece.
+ * \return Size of the input.
+ */
+static size_t BENCH_write_seed(uint8_t * input, const Seed * seed);
+/**
+ * \fn static int BENCH_write_corpus(const char * directory)
+ * \brief Writes a file for every seed in a directory.
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int BENCH_write_corpus(const char * directory);
+/**
+ * \fn static size_t BENCH_read_input(const char * path, uint8_t * input)
+ * \brief Reads an input from a file.
+ * \return Size of the input, 0 when the file can not be read.
+ */
+static size_t BENCH_read_input(const char * path, uint8_t * input);
+/**
+ * \fn static size_t BENCH_mutate(uint8_t * input, unsigned int * random_state, const char * corpus)
+ * \brief Writes an input made of a few seeds, and of a file of the corpus if any, then changes some of its bytes.
+ * \return Size of the input.
+ */
+static size_t BENCH_mutate(uint8_t * input, unsigned int * random_state, const char * corpus);
+/**
+ * \fn static int BENCH_measure(uint8_t fragment)
+ * \brief Decodes a stream of valid frames for a while and prints the frames decoded per second.
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int BENCH_measure(uint8_t fragment);
+/**
+ * \fn static uint64_t BENCH_now(void)
+ * \brief Reads the monotonic clock, in nanoseconds.
+ */
+static uint64_t BENCH_now(void);
+#endif
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static const uint8_t * stream
+ * \brief Bytes sent by SB_IHM in the current input.
+ */
+static const uint8_t * stream;
+/**
+ * \var static size_t stream_size
+ * \brief Size of the stream.
+ */
+static size_t stream_size;
+/**
+ * \var static size_t stream_offset
+ * \brief Bytes of the stream already received.
+ */
+static size_t stream_offset;
+/**
+ * \var static size_t fragment_size
+ * \brief Most bytes received by a recv(), 0 for as many as asked.
+ */
+static size_t fragment_size;
+/**
+ * \var static unsigned long decoded_frames
+ * \brief Frames read and decoded since the start.
+ */
+static unsigned long decoded_frames;
+/**
+ * \var static const Seed seeds[]
+ * \brief A seed for every type of the protocol, SB_C ones included : SB_C must skip them.
+ */
+#define M(m) {#m, m, PROTOCOL_##m##_SIZE},
+static const Seed seeds[] = {PROTOCOL_GENERATION};
+#undef M
+/**
+ * \def SEEDS_NB
+ * Amount of seeds.
+ */
+#define SEEDS_NB (sizeof(seeds) / sizeof(seeds[0]))
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size) {
+    if(size == 0) {
+        return 0;
+    }
+    fragment_size = data[0];
+    stream = data + 1;
+    stream_size = size - 1;
+    stream_offset = 0;
+    /* Whatever the inputs before, batches are accepted as from an up-to-date SB_IHM. */
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_BATCH);
+
+    /* What DISPATCHER_run() does until the end of the stream. */
+    const uint8_t * raw_message;
+    int raw_message_size;
+    while((raw_message_size = POSTMAN_read_request(&raw_message)) > 0) {
+        Dispatcher_Message msg_decoded = DISPATCHER_decode_message(raw_message, (size_t) raw_message_size);
+        DISPATCHER_dispatch_received_msg(&msg_decoded);
+        decoded_frames++;
+    }
+    return 0;
+}
+
+ssize_t __wrap_recv(int socket, void * buffer, size_t length, int flags) {
+    size_t amount = stream_size - stream_offset;
+    if(amount > length) {
+        amount = length;
+    }
+    if(fragment_size != 0 && amount > fragment_size) {
+        amount = fragment_size;
+    }
+    memcpy(buffer, stream + stream_offset, amount);
+    stream_offset += amount;
+    return (ssize_t) amount;
+}
+
+int CONTROLLER_RINGER_ask_availability(int id_robot) {
+    return 0;
+}
+
+int CAMERA_set_up_ihm_info(char * ip_address, uint16_t port) {
+    return 0;
+}
+
+#ifndef BENCH_LIBFUZZER
+int main(int argc, char * argv[]) {
+    int option;
+    const char * corpus = NULL;
+    long mutations = 0;
+    int is_measured = 0;
+    int fragment = 0;
+    while((option = getopt(argc, argv, "s:m:bf:")) != -1) {
+        switch(option) {
+            case 's' : return BENCH_write_corpus(optarg) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+            case 'm' : mutations = atol(optarg); break;
+            case 'b' : is_measured = 1; break;
+            case 'f' : fragment = atoi(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-s corpus] [-m mutations [corpus]] [-b [-f fragment]] [input ...]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(fragment < 0 || fragment > UINT8_MAX || mutations < 0) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+    if(is_measured) {
+        return BENCH_measure((uint8_t) fragment) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    static uint8_t input[MAX_INPUT_SIZE];
+    if(mutations > 0) {
+        corpus = optind < argc ? argv[optind] : NULL;
+        unsigned int random_state = 1;
+        for(long i = 0; i < mutations; i++) {
+            LLVMFuzzerTestOneInput(input, BENCH_mutate(input, &random_state, corpus));
+        }
+        printf("inputs %ld\n", mutations);
+        printf("frames_decoded %lu\n", decoded_frames);
+        return EXIT_SUCCESS;
+    }
+    for(int i = optind; i < argc; i++) {
+        size_t input_size = BENCH_read_input(argv[i], input);
+        LLVMFuzzerTestOneInput(input, input_size);
+        printf("%s : %zu bytes\n", argv[i], input_size);
+    }
+    printf("frames_decoded %lu\n", decoded_frames);
+    return EXIT_SUCCESS;
+}
+#endif
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+#ifndef BENCH_LIBFUZZER
+static size_t BENCH_write_seed(uint8_t * input, const Seed * seed) {
+    static const uint8_t logs[] = "INFO : Thu Jan  1 00:00:00 1970 - Seed\n";
+    uint8_t * frame = input + 1;
+    uint8_t * payload = frame + PROTOCOL_HEAD_SIZE;
+    uint16_t payload_size = seed->fields_size;
+
+    input[0] = 0;
+    memset(payload, 0, payload_size);
+    switch(seed->type) {
+        case ASK_AVAILABILITY :
+            PROTOCOL_put_ASK_AVAILABILITY_version(payload, PROTOCOL_VERSION);
+            PROTOCOL_put_ASK_AVAILABILITY_capabilities(payload, CONFIG_CAPABILITIES);
+            break;
+        case ASK_CMD :
+            PROTOCOL_put_ASK_CMD_command(payload, FORWARD);
+            break;
+        case SET_STATE :
+            PROTOCOL_put_SET_STATE_state(payload, SELECTED);
+            break;
+        case SET_LOGS :
+            PROTOCOL_put_SET_LOGS_page(payload, 1);
+            PROTOCOL_put_SET_LOGS_max_page(payload, 1);
+            memcpy(payload + payload_size, logs, sizeof(logs) - 1);
+            payload_size += sizeof(logs) - 1;
+            break;
+        case SET_CURRENT_TIME :
+            PROTOCOL_put_SET_CURRENT_TIME_century(payload, 20);
+            PROTOCOL_put_SET_CURRENT_TIME_year(payload, 26);
+            PROTOCOL_put_SET_CURRENT_TIME_month(payload, 10);
+            PROTOCOL_put_SET_CURRENT_TIME_day(payload, 17);
+            break;
+        case SET_IP_PORT :
+            PROTOCOL_put_SET_IP_PORT_ip(payload, 0xC0A8010A);
+            PROTOCOL_put_SET_IP_PORT_port(payload, 5000);
+            break;
+        case ASK_BATCH :
+            PROTOCOL_put_ASK_CMD_command(PROTOCOL_encode_ASK_CMD(payload), LEFT);
+            payload_size = PROTOCOL_HEAD_SIZE + PROTOCOL_ASK_CMD_SIZE;
+            break;
+        default :
+            break;
+    }
+    PROTOCOL_put_head(frame, seed->type, payload_size);
+    return 1 + PROTOCOL_HEAD_SIZE + payload_size;
+}
+
+static int BENCH_write_corpus(const char * directory) {
+    uint8_t input[1 + MAX_SEED_SIZE];
+    char path[256];
+    for(size_t i = 0; i < SEEDS_NB; i++) {
+        size_t input_size = BENCH_write_seed(input, &seeds[i]);
+        snprintf(path, sizeof(path), "%s/%s", directory, seeds[i].name);
+        FILE * file = fopen(path, "wb");
+        if(file == NULL || fwrite(input, 1, input_size, file) != input_size) {
+            perror(path);
+            if(file != NULL) {
+                fclose(file);
+            }
+            return -1;
+        }
+        fclose(file);
+    }
+    printf("seeds %zu\n", SEEDS_NB);
+    return 0;
+}
+
+static size_t BENCH_read_input(const char * path, uint8_t * input) {
+    FILE * file = fopen(path, "rb");
+    if(file == NULL) {
+        perror(path);
+        return 0;
+    }
+    size_t input_size = fread(input, 1, MAX_INPUT_SIZE, file);
+    fclose(file);
+    return input_size;
+}
+
+static size_t BENCH_mutate(uint8_t * input, unsigned int * random_state, const char * corpus) {
+    uint8_t seed_input[1 + MAX_SEED_SIZE];
+    size_t input_size = 1;
+
+    input[0] = (uint8_t) (rand_r(random_state) % 4 == 0 ? rand_r(random_state) : 0);
+    /* A file of the corpus, found by libFuzzer or written by hand, starts the input one time out of two. */
+    if(corpus != NULL && rand_r(random_state) % 2 == 0) {
+        DIR * directory = opendir(corpus);
+        if(directory != NULL) {
+            struct dirent * entry;
+            char path[512];
+            long files_nb = 0;
+            while((entry = readdir(directory)) != NULL) {
+                files_nb += entry->d_name[0] != '.';
+            }
+            long chosen = files_nb > 0 ? rand_r(random_state) % files_nb : -1;
+            rewinddir(directory);
+            while(chosen >= 0 && (entry = readdir(directory)) != NULL) {
+                if(entry->d_name[0] != '.' && chosen-- == 0) {
+                    snprintf(path, sizeof(path), "%s/%s", corpus, entry->d_name);
+                    size_t file_size = BENCH_read_input(path, input);
+                    input_size = file_size > 0 ? file_size : 1;
+                }
+            }
+            closedir(directory);
+        }
+    }
+    for(int spliced = rand_r(random_state) % MAX_SPLICED_SEEDS; spliced >= 0; spliced--) {
+        size_t seed_size = BENCH_write_seed(seed_input, &seeds[rand_r(random_state) % SEEDS_NB]) - 1;
+        if(input_size + seed_size <= MAX_INPUT_SIZE) {
+            memcpy(input + input_size, seed_input + 1, seed_size);
+            input_size += seed_size;
+        }
+    }
+    for(int mutation = rand_r(random_state) % MAX_MUTATIONS; mutation > 0 && input_size > 1; mutation--) {
+        size_t position = 1 + (size_t) rand_r(random_state) % (input_size - 1);
+        switch(rand_r(random_state) % 4) {
+            case 0 : input[position] ^= (uint8_t) (1 << (rand_r(random_state) % 8)); break;
+            case 1 : input[position] = (uint8_t) rand_r(random_state); break;
+            case 2 : input[position] = (uint8_t) (rand_r(random_state) % 2 ? 0xFF : 0x00); break;
+            default : input_size = position; break;
+        }
+    }
+    return input_size;
+}
+
+static int BENCH_measure(uint8_t fragment) {
+    static uint8_t input[1 + BENCH_STREAM_SIZE];
+    uint8_t seed_input[1 + MAX_SEED_SIZE];
+    size_t input_size = 1;
+    input[0] = fragment;
+    /* The frames SB_IHM sends, again and again. */
+    for(size_t i = 0;; i++) {
+        size_t seed_size = BENCH_write_seed(seed_input, &seeds[i % SEEDS_NB]) - 1;
+        if(input_size + seed_size > sizeof(input)) {
+            break;
+        }
+        memcpy(input + input_size, seed_input + 1, seed_size);
+        input_size += seed_size;
+    }
+
+    unsigned long passes = 0;
+    uint64_t start = BENCH_now();
+    uint64_t elapsed;
+    do {
+        LLVMFuzzerTestOneInput(input, input_size);
+        passes++;
+        elapsed = BENCH_now() - start;
+    } while(elapsed < (uint64_t) BENCH_DURATION_S * 1000000000);
+
+    printf("fragment %u\n", fragment);
+    printf("stream_bytes %zu\n", input_size - 1);
+    printf("frames_decoded %lu\n", decoded_frames);
+    printf("frames_per_s %.0f\n", (double) decoded_frames * 1e9 / elapsed);
+    printf("mb_per_s %.1f\n", (double) passes * (input_size - 1) * 1e3 / elapsed);
+    return decoded_frames > 0 ? 0 : -1;
+}
+
+static uint64_t BENCH_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+#endif
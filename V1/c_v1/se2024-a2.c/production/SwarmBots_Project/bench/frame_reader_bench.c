@@ -0,0 +1,268 @@
+/**
+ * \file  frame_reader_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Measures the frame reader on a recorded SB_IHM session cut into random fragments.
+ *
+ * \see ../src/com/frame_reader.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include "com/frame_reader.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def DEFAULT_REPEATS
+ * Amount of times the session is replayed by default.
+ */
+#define DEFAULT_REPEATS 20000
+/**
+ * \def DEFAULT_MAX_FRAGMENT
+ * Biggest fragment written at once by default.
+ */
+#define DEFAULT_MAX_FRAGMENT 64
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static void * BENCH_replay(void * arg)
+ * \brief Writes the session again and again, cut into fragments of random sizes, then closes the stream.
+ */
+static void * BENCH_replay(void * arg);
+/**
+ * \fn static size_t BENCH_read_frame(int socket, const uint8_t ** frame)
+ * \brief Reads the next frame with the frame reader.
+ */
+static size_t BENCH_read_frame(int socket, const uint8_t ** frame);
+/**
+ * \fn static size_t BENCH_read_frame_legacy(int socket, const uint8_t ** frame)
+ * \brief Reads the next frame as POSTMAN_read_msg() used to : one read() for the size, one for the rest, then
+ * a copy into the heap and a copy into the buffer of the dispatcher.
+ */
+static size_t BENCH_read_frame_legacy(int socket, const uint8_t ** frame);
+/**
+ * \fn ssize_t __wrap_recv(int socket, void * buffer, size_t length, int flags)
+ * \brief Counts the recv() calls (linked with -Wl,--wrap=recv).
+ */
+ssize_t __wrap_recv(int socket, void * buffer, size_t length, int flags);
+/**
+ * \fn ssize_t __real_recv(int socket, void * buffer, size_t length, int flags)
+ * \brief Real recv().
+ */
+ssize_t __real_recv(int socket, void * buffer, size_t length, int flags);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static const uint8_t session
+ * \brief Frames sent by SB_IHM during a short session : time and camera set up, mode, a few moves with the
+ * pings of the ringer, the logs, then the disconnection.
+ */
+static const uint8_t session[] = {
+    0x00, 0x09, 0x00, 0x13, 0x00, 0x17, 0x0A, 0x11, 0x0E, 0x1E, 0x05, /* SET_CURRENT_TIME */
+    0x00, 0x08, 0x00, 0x14, 0xC0, 0xA8, 0x01, 0x0A, 0x13, 0x88,       /* SET_IP_PORT */
+    0x00, 0x02, 0x00, 0x05,                                           /* ASK_MODE */
+    0x00, 0x06, 0x00, 0x06, 0x01, 0x01, 0x00, 0x01,                   /* SET_MODE */
+    0x00, 0x03, 0x00, 0x04, 0x01,                                     /* SET_STATE */
+    0x00, 0x02, 0x00, 0x01,                                           /* ASK_AVAILABILITY */
+    0x00, 0x03, 0x00, 0x03, 0x01,                                     /* ASK_CMD */
+    0x00, 0x03, 0x00, 0x03, 0x01,                                     /* ASK_CMD */
+    0x00, 0x03, 0x00, 0x03, 0x03,                                     /* ASK_CMD */
+    0x00, 0x02, 0x00, 0x01,                                           /* ASK_AVAILABILITY */
+    0x00, 0x03, 0x00, 0x03, 0x02,                                     /* ASK_CMD */
+    0x00, 0x03, 0x00, 0x03, 0x00,                                     /* ASK_CMD */
+    0x00, 0x02, 0x00, 0x01,                                           /* ASK_AVAILABILITY */
+    0x00, 0x02, 0x00, 0x07,                                           /* ASK_LOGS */
+    0x00, 0x02, 0x00, 0x15,                                           /* LOGS_RECEIVED */
+    0x00, 0x03, 0x00, 0x04, 0x00,                                     /* SET_STATE */
+    0x00, 0x02, 0x00, 0x10,                                           /* ASK_TO_DISCONNECT */
+};
+/**
+ * \var static size_t session_frames
+ * \brief Amount of frames of the session.
+ */
+static size_t session_frames;
+/**
+ * \var static int sockets
+ * \brief Both ends of the stream : the session is written on sockets[1] and read on sockets[0].
+ */
+static int sockets[2];
+/**
+ * \var static long repeats
+ * \brief Amount of times the session is replayed.
+ */
+static long repeats = DEFAULT_REPEATS;
+/**
+ * \var static int max_fragment
+ * \brief Biggest fragment written at once.
+ */
+static int max_fragment = DEFAULT_MAX_FRAGMENT;
+/**
+ * \var static unsigned int seed
+ * \brief Seed of the fragment sizes.
+ */
+static unsigned int seed = 1;
+/**
+ * \var static unsigned long recv_calls
+ * \brief recv() calls made by the reader.
+ */
+static unsigned long recv_calls;
+/**
+ * \var static Frame_Reader reader
+ * \brief Receive buffer of the frame reader.
+ */
+static Frame_Reader reader;
+/**
+ * \var static uint8_t dispatcher_buffer
+ * \brief Stands for the data_received buffer the dispatcher used to copy every payload into.
+ */
+static uint8_t dispatcher_buffer[0xFFFF];
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    int is_legacy = 0;
+    while((option = getopt(argc, argv, "n:f:s:l")) != -1) {
+        switch(option) {
+            case 'n' : repeats = atol(optarg); break;
+            case 'f' : max_fragment = atoi(optarg); break;
+            case 's' : seed = (unsigned int) atoi(optarg); break;
+            case 'l' : is_legacy = 1; break;
+            default :
+                fprintf(stderr, "usage: %s [-n session_repeats] [-f max_fragment_bytes] [-s seed] [-l]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(max_fragment < 1) {
+        fprintf(stderr, "Fragments carry one byte at least.\n");
+        return EXIT_FAILURE;
+    }
+    for(size_t offset = 0; offset < sizeof(session); session_frames++) {
+        offset += 2 + (size_t) (session[offset] << 8 | session[offset + 1]);
+    }
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == -1) {
+        perror("socketpair");
+        return EXIT_FAILURE;
+    }
+
+    size_t (* read_frame)(int, const uint8_t **) = is_legacy ? BENCH_read_frame_legacy : BENCH_read_frame;
+    unsigned long frames = 0, misparsed = 0;
+    size_t expected_offset = 0;
+    const uint8_t * frame;
+    size_t frame_size;
+    struct timespec start, end;
+    pthread_t writer;
+    FRAME_READER_reset(&reader);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&writer, NULL, BENCH_replay, NULL);
+    while((frame_size = read_frame(sockets[0], &frame)) != 0) {
+        /* Every frame is checked against the session, a misparsed frame also shifts the following ones. */
+        size_t expected_size = 2 + (size_t) (session[expected_offset] << 8 | session[expected_offset + 1]);
+        if(frame_size != expected_size || memcmp(frame, session + expected_offset, frame_size) != 0) {
+            misparsed++;
+        }
+        expected_offset = (expected_offset + expected_size) % sizeof(session);
+        frames++;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    pthread_join(writer, NULL);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("reader %s\n", is_legacy ? "legacy" : "frame_reader");
+    printf("max_fragment_bytes %d\n", max_fragment);
+    printf("frames_expected %lu\n", (unsigned long) (session_frames * repeats));
+    printf("frames_read %lu\n", frames);
+    printf("frames_misparsed %lu\n", misparsed);
+    printf("frames_per_s %.0f\n", frames / seconds);
+    printf("recv_per_frame %.3f\n", frames ? (double) recv_calls / frames : 0.0);
+
+    close(sockets[0]);
+    return EXIT_SUCCESS;
+}
+
+ssize_t __wrap_recv(int socket, void * buffer, size_t length, int flags) {
+    recv_calls++;
+    return __real_recv(socket, buffer, length, flags);
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static void * BENCH_replay(void * arg) {
+    unsigned int writer_seed = seed;
+    for(long i = 0; i < repeats; i++) {
+        size_t offset = 0;
+        while(offset < sizeof(session)) {
+            size_t fragment = 1 + (size_t) (rand_r(&writer_seed) % max_fragment);
+            if(fragment > sizeof(session) - offset) {
+                fragment = sizeof(session) - offset;
+            }
+            if(write(sockets[1], session + offset, fragment) == -1) {
+                perror("write");
+                exit(EXIT_FAILURE);
+            }
+            offset += fragment;
+        }
+    }
+    close(sockets[1]);
+    return NULL;
+}
+
+static size_t BENCH_read_frame(int socket, const uint8_t ** frame) {
+    size_t frame_size;
+    while((frame_size = FRAME_READER_next(&reader, frame)) == 0) {
+        if(FRAME_READER_fill(&reader, socket) <= 0) {
+            return 0;
+        }
+    }
+    return frame_size;
+}
+
+static size_t BENCH_read_frame_legacy(int socket, const uint8_t ** frame) {
+    static uint8_t * raw_message = NULL;
+    uint8_t size_check[2];
+    free(raw_message);
+    raw_message = NULL;
+    if(recv(socket, size_check, 2, 0) <= 0) {
+        return 0;
+    }
+    int data_size = size_check[0] << 8 | size_check[1];
+    uint8_t data_buff[data_size];
+    if(recv(socket, data_buff, data_size, 0) == -1) {
+        return 0;
+    }
+    raw_message = (uint8_t *) malloc(data_size + 2);
+    memcpy(raw_message, size_check, 2);
+    memcpy(raw_message + 2, data_buff, data_size);
+    if(data_size > 2) {
+        memcpy(dispatcher_buffer, raw_message + 4, data_size - 2);
+    }
+    *frame = raw_message;
+    return (size_t) data_size + 2;
+}
@@ -0,0 +1,225 @@
+/**
+ * \file  logger_level_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Measures the cost of a frame through the dispatcher at each log level, with the real logger behind it.
+ *
+ * \see ../src/logs/controller_logger.c
+ * \see ../src/com/dispatcher.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "config.h"
+#include "com/postman.h"
+#include "com/frame_pool.h"
+#include "com/dispatcher.h"
+#include "com/gui_proxy.h"
+#include "com/logs_manager_proxy.h"
+#include "controller/pilot.h"
+#include "controller/controller_ringer.h"
+#include "alphabot2/camera.h"
+#include "logs/controller_logger.h"
+#include "lib/protocol.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def SERVER_PORT
+ * Port the postman listens on.
+ */
+#define SERVER_PORT 12345
+/**
+ * \def DEFAULT_FRAMES
+ * Amount of ASK_CMD frames sent by default.
+ */
+#define DEFAULT_FRAMES 50000
+/**
+ * \def FRAMES_PER_WRITE
+ * ASK_CMD frames written at once : the cost of the socket is shared by several frames.
+ */
+#define FRAMES_PER_WRITE 64
+/**
+ * \def WAIT_TIMEOUT_S
+ * Time given to SB_C to handle every frame once they are all sent.
+ */
+#define WAIT_TIMEOUT_S 30
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static uint64_t BENCH_now(int clock)
+ * \brief Reads a clock, in nanoseconds.
+ */
+static uint64_t BENCH_now(int clock);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static long handled_commands
+ * \brief ASK_CMD that reached the pilot.
+ */
+static long handled_commands;
+/**
+ * \var static pthread_mutex_t handled_mutex
+ * \brief Protects handled_commands.
+ */
+static pthread_mutex_t handled_mutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * \var static pthread_cond_t handled_condition
+ * \brief Signaled at each ASK_CMD reaching the pilot.
+ */
+static pthread_cond_t handled_condition = PTHREAD_COND_INITIALIZER;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    long frames = DEFAULT_FRAMES;
+    int log_level = CONFIG_LOGGER_LOG_LEVEL;
+    while((option = getopt(argc, argv, "n:l:")) != -1) {
+        switch(option) {
+            case 'n' : frames = atol(optarg); break;
+            case 'l' : log_level = atoi(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-n frames] [-l log_level]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(frames <= 0 || log_level < DEBUG || log_level > NONE) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+    /* Each run starts with an empty log file, far from the memory alert. */
+    unlink(CONFIG_LOG_FILE_PATH);
+    if(CONTROLLER_LOGGER_create() == -1 || CONTROLLER_LOGGER_start() == -1) {
+        fprintf(stderr, "The logger failed to start.\n");
+        return EXIT_FAILURE;
+    }
+    CONTROLLER_LOGGER_set_level((log_level_e) log_level);
+    if(FRAME_POOL_create() == -1 || DISPATCHER_create() == -1 || POSTMAN_create() == -1
+        || DISPATCHER_start() == -1 || POSTMAN_start() == -1) {
+        fprintf(stderr, "SB_C modules failed to start.\n");
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_in server = {.sin_family = AF_INET, .sin_port = htons(SERVER_PORT)};
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int operator_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if(connect(operator_socket, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        return EXIT_FAILURE;
+    }
+    usleep(100000); /* Lets the postman accept the operator. */
+    DISPATCHER_start_reading(); /* What controller_core does once connected. */
+
+    uint8_t frames_buffer[FRAMES_PER_WRITE * (PROTOCOL_HEAD_SIZE + PROTOCOL_ASK_CMD_SIZE)];
+    uint64_t wall_start = BENCH_now(CLOCK_MONOTONIC);
+    uint64_t cpu_start = BENCH_now(CLOCK_PROCESS_CPUTIME_ID);
+    for(long sent = 0; sent < frames;) {
+        uint8_t * frame = frames_buffer;
+        for(int i = 0; i < FRAMES_PER_WRITE && sent < frames; i++, sent++) {
+            uint8_t * payload = PROTOCOL_encode_ASK_CMD(frame);
+            PROTOCOL_put_ASK_CMD_command(payload, (Command) (sent % STOP));
+            frame = payload + PROTOCOL_ASK_CMD_SIZE;
+        }
+        ssize_t size = frame - frames_buffer;
+        if(send(operator_socket, frames_buffer, (size_t) size, 0) != size) {
+            perror("send");
+            return EXIT_FAILURE;
+        }
+    }
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += WAIT_TIMEOUT_S;
+    pthread_mutex_lock(&handled_mutex);
+    while(handled_commands < frames) {
+        if(pthread_cond_timedwait(&handled_condition, &handled_mutex, &deadline) != 0) {
+            break;
+        }
+    }
+    long handled = handled_commands;
+    pthread_mutex_unlock(&handled_mutex);
+    uint64_t wall_ns = BENCH_now(CLOCK_MONOTONIC) - wall_start;
+    uint64_t cpu_ns = BENCH_now(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+
+    printf("log_level %d\n", log_level);
+    printf("log_floor %d\n", CONFIG_LOGGER_LOG_FLOOR);
+    printf("frames %ld\n", frames);
+    printf("frames_lost %ld\n", frames - handled);
+    printf("wall_ns_per_frame %.1f\n", (double) wall_ns / frames);
+    printf("cpu_ns_per_frame %.1f\n", (double) cpu_ns / frames);
+
+    close(operator_socket);
+    POSTMAN_stop();
+    DISPATCHER_stop();
+    POSTMAN_destroy();
+    DISPATCHER_destroy();
+    FRAME_POOL_destroy();
+    CONTROLLER_LOGGER_stop();
+    CONTROLLER_LOGGER_destroy();
+    return handled == frames ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int PILOT_ask_cmd(Command cmd) {
+    pthread_mutex_lock(&handled_mutex);
+    handled_commands++;
+    pthread_cond_signal(&handled_condition);
+    pthread_mutex_unlock(&handled_mutex);
+    return 0;
+}
+
+int CONTROLLER_RINGER_ask_availability(int id_robot) {
+    return 0;
+}
+
+int CAMERA_set_up_ihm_info(char * ip_address, uint16_t port) {
+    return 0;
+}
+
+int GUI_PROXY_raise_memory_alert(Id_Robot id_robot) {
+    return 0;
+}
+
+int LOGS_MANAGER_PROXY_set_logs(uint8_t page, uint8_t max_page, const uint8_t * logs, uint16_t logs_size) {
+    return 0;
+}
+
+int LOGS_MANAGER_PROXY_stream_logs(int logs_file, uint32_t logs_size) {
+    return 0;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static uint64_t BENCH_now(int clock) {
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
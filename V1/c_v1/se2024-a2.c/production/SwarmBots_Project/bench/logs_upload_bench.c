@@ -0,0 +1,269 @@
+/**
+ * \file  logs_upload_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Upload of the logs to SB_IHM : bytes on the wire and upload time, with and without CAPABILITY_COMPRESSION.
+ * The link to SB_IHM may be slowed down to the rate left by the camera stream on the Wi-Fi :
+ *   ../bin/logs_upload_bench.elf -r 8000        logs sent as they are, 8 Mbit/s
+ *   ../bin/logs_upload_bench.elf -r 8000 -c     pages compressed
+ *
+ * \see ../src/com/logs_manager_proxy.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "com/postman.h"
+#include "com/frame_pool.h"
+#include "com/capabilities.h"
+#include "com/logs_manager_proxy.h"
+#include "lib/lz4_block.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def SERVER_PORT
+ * Port of the postman.
+ */
+#define SERVER_PORT 12345
+/**
+ * \def DEFAULT_LOGS_SIZE
+ * Size of the logs uploaded by default.
+ */
+#define DEFAULT_LOGS_SIZE (2 * 1024 * 1024)
+/**
+ * \def READ_SIZE
+ * Most bytes read from the socket at once by SB_IHM, the rate being checked between two reads.
+ */
+#define READ_SIZE 1460
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static uint8_t * BENCH_write_logs(FILE * file, size_t logs_size)
+ * \brief Writes logs in a file as the logger does.
+ * \return The logs, kept to check the pages received.
+ */
+static uint8_t * BENCH_write_logs(FILE * file, size_t logs_size);
+/**
+ * \fn static void BENCH_receive(int client, uint8_t * buffer, size_t size)
+ * \brief Receives bytes as SB_IHM does, no faster than the rate of the link.
+ */
+static void BENCH_receive(int client, uint8_t * buffer, size_t size);
+/**
+ * \fn static uint64_t BENCH_now(void)
+ * \brief Reads the monotonic clock, in nanoseconds.
+ */
+static uint64_t BENCH_now(void);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static long link_rate
+ * \brief Rate of the link in kbit/s, 0 for the rate of the loopback.
+ */
+static long link_rate;
+/**
+ * \var static uint64_t upload_start
+ * \brief Time of the upload request.
+ */
+static uint64_t upload_start;
+/**
+ * \var static unsigned long long wire_bytes
+ * \brief Bytes received by SB_IHM since the upload request.
+ */
+static unsigned long long wire_bytes;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    long logs_size = DEFAULT_LOGS_SIZE;
+    bool_e is_compressed = FALSE;
+    while((option = getopt(argc, argv, "s:r:c")) != -1) {
+        switch(option) {
+            case 's' : logs_size = atol(optarg); break;
+            case 'r' : link_rate = atol(optarg); break;
+            case 'c' : is_compressed = TRUE; break;
+            default :
+                fprintf(stderr, "usage: %s [-s logs_bytes] [-r link_kbit_per_s] [-c]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(logs_size <= 0 || logs_size > 255L * LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE || link_rate < 0) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+    FILE * logs_file = tmpfile();
+    uint8_t * logs = BENCH_write_logs(logs_file, (size_t) logs_size);
+    if(logs == NULL) {
+        fprintf(stderr, "Logs could not be written.\n");
+        return EXIT_FAILURE;
+    }
+    if(FRAME_POOL_create() == -1 || POSTMAN_create() == -1 || POSTMAN_start() == -1) {
+        fprintf(stderr, "Postman failed to start.\n");
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_in server = {.sin_family = AF_INET, .sin_port = htons(SERVER_PORT)};
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    /* A small window : the postman is held back by the link, as on the Wi-Fi. */
+    int receive_buffer = 64 * 1024;
+    setsockopt(client, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+    if(connect(client, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        return EXIT_FAILURE;
+    }
+    usleep(100000); /* Lets the postman accept the operator, which resets the capabilities. */
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, is_compressed ? CAPABILITY_COMPRESSION : 0);
+
+    static uint8_t frame[0xFFFF + 2];
+    static uint8_t page_logs[LOGS_MANAGER_PROXY_MAX_PAGE_SIZE];
+    size_t received_logs = 0;
+    unsigned int pages = 0;
+    upload_start = BENCH_now();
+    if(LOGS_MANAGER_PROXY_stream_logs(dup(fileno(logs_file)), (uint32_t) logs_size) == -1) {
+        fprintf(stderr, "LOGS_MANAGER_PROXY_stream_logs() failed.\n");
+        return EXIT_FAILURE;
+    }
+    for(uint8_t page = 0, max_page = 1; page != max_page; ) {
+        BENCH_receive(client, frame, PROTOCOL_HEAD_SIZE);
+        uint16_t payload_size = PROTOCOL_get_U16(frame) - 2;
+        BENCH_receive(client, frame + PROTOCOL_HEAD_SIZE, payload_size);
+        const uint8_t * payload = PROTOCOL_decode_SET_LOGS(frame, PROTOCOL_HEAD_SIZE + payload_size);
+        if(payload == NULL) {
+            fprintf(stderr, "Unexpected frame.\n");
+            return EXIT_FAILURE;
+        }
+        page = PROTOCOL_get_SET_LOGS_page(payload);
+        max_page = PROTOCOL_get_SET_LOGS_max_page(payload);
+        const uint8_t * page_data = payload + PROTOCOL_SET_LOGS_SIZE;
+        int page_size = payload_size - PROTOCOL_SET_LOGS_SIZE;
+        /* What SB_IHM does with each page, whatever the pages before. */
+        if(is_compressed) {
+            Logs_Encoding encoding = (Logs_Encoding) *page_data++;
+            page_size--;
+            if(encoding == LOGS_ENCODING_LZ4) {
+                page_size = LZ4_BLOCK_decompress(page_data, (size_t) page_size, page_logs, sizeof(page_logs));
+                page_data = page_logs;
+            }
+        }
+        if(page_size < 0 || received_logs + (size_t) page_size > (size_t) logs_size
+           || memcmp(page_data, logs + received_logs, (size_t) page_size) != 0) {
+            fprintf(stderr, "Page %u differs from the logs.\n", page);
+            return EXIT_FAILURE;
+        }
+        received_logs += (size_t) page_size;
+        pages++;
+    }
+    uint64_t upload_time = BENCH_now() - upload_start;
+    if(received_logs != (size_t) logs_size) {
+        fprintf(stderr, "%zu bytes of logs received out of %ld.\n", received_logs, logs_size);
+        return EXIT_FAILURE;
+    }
+
+    printf("compression %s\n", is_compressed ? "lz4" : "none");
+    printf("link_kbit_per_s %ld\n", link_rate);
+    printf("logs_bytes %ld\n", logs_size);
+    printf("pages %u\n", pages);
+    printf("wire_bytes %llu\n", wire_bytes);
+    printf("ratio %.2f\n", (double) logs_size / wire_bytes);
+    printf("upload_ms %.1f\n", upload_time / 1e6);
+
+    close(client);
+    POSTMAN_stop();
+    POSTMAN_destroy();
+    FRAME_POOL_destroy();
+    fclose(logs_file);
+    free(logs);
+    return EXIT_SUCCESS;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static uint8_t * BENCH_write_logs(FILE * file, size_t logs_size) {
+    static const char * const events[] = {
+        "Postman has established a connection",
+        "Pilot has received the command FORWARD",
+        "Pilot has received the command STOP",
+        "Radar has detected an obstacle at 12 cm",
+        "Camera stream has been started on 192.168.1.42:5000",
+        "Logger memory check : 35 % of the partition used",
+        "State indicator switches to RUNNING",
+    };
+    uint8_t * logs = malloc(logs_size);
+    if(file == NULL || logs == NULL) {
+        free(logs);
+        return NULL;
+    }
+    unsigned int random_state = 1;
+    size_t written = 0;
+    for(unsigned int line = 0; written < logs_size; line++) {
+        char text[160];
+        unsigned int seconds = line * 3 + (unsigned int) rand_r(&random_state) % 3;
+        int text_size = snprintf(text, sizeof(text), "%s : Mon Jan  8 %02u:%02u:%02u 2024 - %s\n",
+                                 line % 5 == 0 ? "DEBUG" : "INFO", 10 + seconds / 3600 % 14, seconds / 60 % 60, seconds % 60,
+                                 events[(unsigned int) rand_r(&random_state) % (sizeof(events) / sizeof(events[0]))]);
+        size_t copied = (size_t) text_size < logs_size - written ? (size_t) text_size : logs_size - written;
+        memcpy(logs + written, text, copied);
+        written += copied;
+    }
+    if(fwrite(logs, 1, logs_size, file) != logs_size || fflush(file) != 0) {
+        free(logs);
+        return NULL;
+    }
+    return logs;
+}
+
+static void BENCH_receive(int client, uint8_t * buffer, size_t size) {
+    for(size_t received = 0; received < size; ) {
+        size_t asked = size - received < READ_SIZE ? size - received : READ_SIZE;
+        ssize_t amount_read = read(client, buffer + received, asked);
+        if(amount_read <= 0) {
+            fprintf(stderr, "Connection closed after %llu bytes.\n", wire_bytes);
+            exit(EXIT_FAILURE);
+        }
+        received += (size_t) amount_read;
+        wire_bytes += (unsigned long long) amount_read;
+        if(link_rate > 0) {
+            /* Not faster than the link : waits until the bytes received so far could have gone through it. */
+            uint64_t link_time = wire_bytes * 8 * 1000000 / (uint64_t) link_rate;
+            uint64_t elapsed = BENCH_now() - upload_start;
+            if(link_time > elapsed) {
+                struct timespec pause = {.tv_sec = (time_t) ((link_time - elapsed) / 1000000000),
+                                         .tv_nsec = (long) ((link_time - elapsed) % 1000000000)};
+                nanosleep(&pause, NULL);
+            }
+        }
+    }
+}
+
+static uint64_t BENCH_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
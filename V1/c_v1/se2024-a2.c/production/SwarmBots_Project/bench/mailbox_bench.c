@@ -0,0 +1,224 @@
+/**
+ * \file  mailbox_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Events carried by a mailbox from several senders to the thread of a module : events per second, latency
+ * from MAILBOX_send() to MAILBOX_receive() and context switches, for the POSIX queue and for the ring.
+ *   ../bin/mailbox_bench.elf                    4 senders, as fast as they can
+ *   ../bin/mailbox_bench.elf -i 100 -k ring     an event every 100 us for each sender, ring only
+ *
+ * \see ../src/lib/mailbox.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include "lib/mailbox.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def MAILBOX_NAME
+ * Name of the POSIX queue measured.
+ */
+#define MAILBOX_NAME "/mb_bench"
+/**
+ * \def MSG_COUNT
+ * Messages held by the mailbox, as for the postman.
+ */
+#define MSG_COUNT 50
+/**
+ * \def MAX_SENDERS
+ * Most threads sending events.
+ */
+#define MAX_SENDERS 16
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Bench_Event
+ * \brief Event of the size of the messages of the postman, stamped when sent.
+ */
+typedef struct {
+    uint64_t sent_at;  /**< Time of MAILBOX_send(), in nanoseconds. */
+    uint32_t sender;   /**< Sender of the event. */
+    uint32_t last;     /**< 1 for the last event of the sender. */
+    uint8_t data[48];  /**< Rest of the event. */
+} Bench_Event;
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static int BENCH_run(Mailbox_Kind kind)
+ * \brief Sends the events through a mailbox of the given kind and prints the measures.
+ * \return 0 on success, -1 on error.
+ */
+static int BENCH_run(Mailbox_Kind kind);
+/**
+ * \fn static void * BENCH_send(void * arg)
+ * \brief Thread of a sender.
+ */
+static void * BENCH_send(void * arg);
+/**
+ * \fn static int BENCH_compare(const void * a, const void * b)
+ * \brief Orders the latencies for qsort().
+ */
+static int BENCH_compare(const void * a, const void * b);
+/**
+ * \fn static uint64_t BENCH_now(void)
+ * \brief Reads the monotonic clock, in nanoseconds.
+ */
+static uint64_t BENCH_now(void);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static Mailbox * mailbox
+ * \brief Mailbox measured.
+ */
+static Mailbox * mailbox;
+/**
+ * \var static long senders_nb
+ * \brief Threads sending events.
+ */
+static long senders_nb = 4;
+/**
+ * \var static long events_nb
+ * \brief Events sent by each sender.
+ */
+static long events_nb = 100000;
+/**
+ * \var static long interval
+ * \brief Time between two events of a sender in microseconds, 0 to send as fast as the mailbox takes them.
+ */
+static long interval;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    const char * kind = NULL;
+    while((option = getopt(argc, argv, "k:p:n:i:")) != -1) {
+        switch(option) {
+            case 'k' : kind = optarg; break;
+            case 'p' : senders_nb = atol(optarg); break;
+            case 'n' : events_nb = atol(optarg); break;
+            case 'i' : interval = atol(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-k queue|ring] [-p senders] [-n events_per_sender] [-i interval_us]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(senders_nb <= 0 || senders_nb > MAX_SENDERS || events_nb <= 0 || interval < 0
+       || (kind != NULL && strcmp(kind, "queue") != 0 && strcmp(kind, "ring") != 0)) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+    if((kind == NULL || strcmp(kind, "queue") == 0) && BENCH_run(MAILBOX_POSIX_QUEUE) == -1) {
+        return EXIT_FAILURE;
+    }
+    if((kind == NULL || strcmp(kind, "ring") == 0) && BENCH_run(MAILBOX_RING) == -1) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static int BENCH_run(Mailbox_Kind kind) {
+    size_t total = (size_t) (senders_nb * events_nb);
+    uint64_t * latencies = malloc(total * sizeof(uint64_t));
+    if(latencies == NULL || (mailbox = MAILBOX_open(MAILBOX_NAME, sizeof(Bench_Event), MSG_COUNT, 1, kind)) == NULL) {
+        perror("MAILBOX_open");
+        free(latencies);
+        return -1;
+    }
+    struct rusage usage_before, usage_after;
+    getrusage(RUSAGE_SELF, &usage_before);
+    pthread_t senders[MAX_SENDERS];
+    uint64_t start = BENCH_now();
+    for(long sender = 0; sender < senders_nb; sender++) {
+        pthread_create(&senders[sender], NULL, BENCH_send, (void *) (intptr_t) sender);
+    }
+    Bench_Event event;
+    size_t received = 0;
+    for(long senders_left = senders_nb; senders_left > 0; ) {
+        if(MAILBOX_receive(mailbox, &event) == -1) {
+            perror("MAILBOX_receive");
+            return -1;
+        }
+        latencies[received++] = BENCH_now() - event.sent_at;
+        senders_left -= (long) event.last;
+    }
+    uint64_t elapsed = BENCH_now() - start;
+    for(long sender = 0; sender < senders_nb; sender++) {
+        pthread_join(senders[sender], NULL);
+    }
+    getrusage(RUSAGE_SELF, &usage_after);
+    MAILBOX_close(mailbox);
+
+    qsort(latencies, received, sizeof(uint64_t), BENCH_compare);
+    long switches = (usage_after.ru_nvcsw - usage_before.ru_nvcsw) + (usage_after.ru_nivcsw - usage_before.ru_nivcsw);
+    printf("kind %s\n", kind == MAILBOX_RING ? "ring" : "queue");
+    printf("senders %ld\n", senders_nb);
+    printf("events %zu\n", received);
+    printf("events_per_s %.0f\n", received / (elapsed / 1e9));
+    printf("latency_p50_us %.2f\n", latencies[received / 2] / 1e3);
+    printf("latency_p99_us %.2f\n", latencies[received * 99 / 100] / 1e3);
+    printf("latency_max_us %.2f\n", latencies[received - 1] / 1e3);
+    printf("context_switches_per_event %.3f\n\n", (double) switches / received);
+    free(latencies);
+    return 0;
+}
+
+static void * BENCH_send(void * arg) {
+    Bench_Event event = {.sender = (uint32_t) (intptr_t) arg};
+    uint64_t next = BENCH_now();
+    for(long event_id = 0; event_id < events_nb; event_id++) {
+        if(interval > 0) {
+            /* Periodic sender : the deadline of each event does not drift with the time spent sending. */
+            next += (uint64_t) interval * 1000;
+            struct timespec deadline = {.tv_sec = (time_t) (next / 1000000000), .tv_nsec = (long) (next % 1000000000)};
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        }
+        event.last = event_id == events_nb - 1;
+        event.sent_at = BENCH_now();
+        if(MAILBOX_send(mailbox, &event, 0) == -1) {
+            perror("MAILBOX_send");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return NULL;
+}
+
+static int BENCH_compare(const void * a, const void * b) {
+    uint64_t first = *(const uint64_t *) a;
+    uint64_t second = *(const uint64_t *) b;
+    return (first > second) - (first < second);
+}
+
+static uint64_t BENCH_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
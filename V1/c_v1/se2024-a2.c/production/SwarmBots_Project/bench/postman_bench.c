@@ -0,0 +1,318 @@
+/**
+ * \file  postman_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Measures the idle cost and the connection latency of the postman of a running SB_C.
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <dirent.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def DEFAULT_ADDRESS
+ * SB_C address used when none is given.
+ */
+#define DEFAULT_ADDRESS "127.0.0.1"
+/**
+ * \def DEFAULT_PORT
+ * SB_C port used when none is given (postman SERVER_PORT).
+ */
+#define DEFAULT_PORT 12345
+/**
+ * \def DEFAULT_CONNECTIONS
+ * Amount of connect / ASK_AVAILABILITY / disconnect cycles measured by default.
+ */
+#define DEFAULT_CONNECTIONS 100
+/**
+ * \def DEFAULT_IDLE_SECONDS
+ * Length of the idle window in seconds.
+ */
+#define DEFAULT_IDLE_SECONDS 10
+/**
+ * \def DEFAULT_PAUSE_MS
+ * Pause between two connection cycles in milliseconds. The postman before epoll needs one to take a disconnection
+ * into account before the next connection is accepted.
+ */
+#define DEFAULT_PAUSE_MS 0
+/**
+ * \def RECEIVE_TIMEOUT_S
+ * Delay without any byte from SB_C after which a connection cycle fails, in seconds.
+ */
+#define RECEIVE_TIMEOUT_S 5
+/* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
+/**
+ * \struct Process_Sample postman_bench.c "bench/postman_bench.c"
+ * \brief CPU time and context switches of a process at a given time.
+ */
+typedef struct {
+    unsigned long long cpu_ticks; /**< utime + stime of the whole process, in clock ticks. */
+    unsigned long long switches; /**< Voluntary and involuntary context switches summed on every thread. */
+} Process_Sample;
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static double BENCH_now_us(void)
+ * \brief Gives the monotonic time in microseconds.
+ *
+ * \return Current monotonic time in microseconds.
+ */
+static double BENCH_now_us(void);
+/**
+ * \fn static int BENCH_sample_process(pid_t pid, Process_Sample * sample)
+ * \brief Reads the CPU time and the context switches of a process from /proc.
+ *
+ * \param pid : observed process.
+ * \param sample : filled with the values read.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int BENCH_sample_process(pid_t pid, Process_Sample * sample);
+/**
+ * \fn static int BENCH_connect(const char * address, uint16_t port)
+ * \brief Opens a TCP connection to SB_C.
+ *
+ * \param address : IPv4 address of SB_C.
+ * \param port : TCP port of SB_C.
+ *
+ * \return On success, returns the socket. On error, returns -1.
+ */
+static int BENCH_connect(const char * address, uint16_t port);
+/**
+ * \fn static int BENCH_measure_first_byte(const char * address, uint16_t port, double * latency_us)
+ * \brief Connects, sends ASK_AVAILABILITY and measures the time until the first byte of the answer,
+ * then asks the disconnection and waits for SB_C to close.
+ *
+ * \param address : IPv4 address of SB_C.
+ * \param port : TCP port of SB_C.
+ * \param latency_us : measured connection to first byte latency.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int BENCH_measure_first_byte(const char * address, uint16_t port, double * latency_us);
+/**
+ * \fn static int BENCH_compare(const void * a, const void * b)
+ * \brief qsort() comparator of doubles.
+ */
+static int BENCH_compare(const void * a, const void * b);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static const uint8_t ask_availability[]
+ * \brief ASK_AVAILABILITY frame as sent by SB_IHM.
+ */
+static const uint8_t ask_availability[] = {0x00, 0x02, 0x00, 0x01};
+/**
+ * \var static const uint8_t ask_to_disconnect[]
+ * \brief ASK_TO_DISCONNECT frame as sent by SB_IHM.
+ */
+static const uint8_t ask_to_disconnect[] = {0x00, 0x02, 0x00, 0x10};
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    const char * address = DEFAULT_ADDRESS;
+    uint16_t port = DEFAULT_PORT;
+    int connections = DEFAULT_CONNECTIONS;
+    int idle_seconds = DEFAULT_IDLE_SECONDS;
+    int pause_ms = DEFAULT_PAUSE_MS;
+    pid_t pid = 0;
+    int option;
+
+    while((option = getopt(argc, argv, "a:p:n:i:P:w:")) != -1) {
+        switch(option) {
+            case 'a' : address = optarg; break;
+            case 'p' : port = (uint16_t) atoi(optarg); break;
+            case 'n' : connections = atoi(optarg); break;
+            case 'i' : idle_seconds = atoi(optarg); break;
+            case 'P' : pid = (pid_t) atoi(optarg); break;
+            case 'w' : pause_ms = atoi(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-a address] [-p port] [-n connections] [-w pause_ms] [-P sb_c_pid [-i idle_seconds]]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if(pid > 0) {
+        Process_Sample before, after;
+        long ticks_per_second = sysconf(_SC_CLK_TCK);
+        if(BENCH_sample_process(pid, &before) == -1) {
+            fprintf(stderr, "Cannot read /proc/%d.\n", (int) pid);
+            return EXIT_FAILURE;
+        }
+        sleep(idle_seconds);
+        if(BENCH_sample_process(pid, &after) == -1) {
+            fprintf(stderr, "Cannot read /proc/%d.\n", (int) pid);
+            return EXIT_FAILURE;
+        }
+        printf("idle_window_s %d\n", idle_seconds);
+        printf("idle_cpu_ms %.1f\n", (after.cpu_ticks - before.cpu_ticks) * 1000.0 / ticks_per_second);
+        printf("idle_wakeups_per_s %.2f\n", (double)(after.switches - before.switches) / idle_seconds);
+    }
+
+    if(connections > 0) {
+        double * latencies = malloc(connections * sizeof(double));
+        int measured = 0;
+        if(latencies == NULL) {
+            return EXIT_FAILURE;
+        }
+        for(int i = 0; i < connections; i++) {
+            if(i > 0 && pause_ms > 0) {
+                usleep((useconds_t) pause_ms * 1000);
+            }
+            if(BENCH_measure_first_byte(address, port, &latencies[measured]) == 0) {
+                measured++;
+            }
+        }
+        if(measured > 0) {
+            qsort(latencies, measured, sizeof(double), BENCH_compare);
+            printf("first_byte_samples %d\n", measured);
+            printf("first_byte_p50_us %.0f\n", latencies[measured / 2]);
+            printf("first_byte_p99_us %.0f\n", latencies[(measured * 99) / 100]);
+            printf("first_byte_max_us %.0f\n", latencies[measured - 1]);
+        }
+        free(latencies);
+        if(measured != connections) {
+            fprintf(stderr, "%d connection(s) failed.\n", connections - measured);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static double BENCH_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+}
+
+static int BENCH_sample_process(pid_t pid, Process_Sample * sample) {
+    char path[64];
+    char line[256];
+    FILE * file;
+    unsigned long utime, stime;
+
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int) pid);
+    if((file = fopen(path, "r")) == NULL) {
+        return -1;
+    }
+    /* The command name may hold spaces : fields are counted after the closing parenthesis. */
+    if(fgets(line, sizeof(line), file) == NULL || strrchr(line, ')') == NULL
+       || sscanf(strrchr(line, ')') + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &utime, &stime) != 2) {
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+    sample->cpu_ticks = utime + stime;
+    sample->switches = 0;
+
+    snprintf(path, sizeof(path), "/proc/%d/task", (int) pid);
+    DIR * tasks = opendir(path);
+    struct dirent * task;
+    if(tasks == NULL) {
+        return -1;
+    }
+    while((task = readdir(tasks)) != NULL) {
+        if(task->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(path, sizeof(path), "/proc/%d/task/%.16s/status", (int) pid, task->d_name);
+        if((file = fopen(path, "r")) == NULL) {
+            continue;
+        }
+        while(fgets(line, sizeof(line), file) != NULL) {
+            unsigned long long value;
+            if(sscanf(line, "voluntary_ctxt_switches: %llu", &value) == 1
+               || sscanf(line, "nonvoluntary_ctxt_switches: %llu", &value) == 1) {
+                sample->switches += value;
+            }
+        }
+        fclose(file);
+    }
+    closedir(tasks);
+    return 0;
+}
+
+static int BENCH_connect(const char * address, uint16_t port) {
+    struct sockaddr_in server = {.sin_family = AF_INET, .sin_port = htons(port)};
+    struct timeval timeout = {.tv_sec = RECEIVE_TIMEOUT_S};
+    int one = 1;
+    int fd;
+    if(inet_pton(AF_INET, address, &server.sin_addr) != 1) {
+        fprintf(stderr, "Invalid address %s.\n", address);
+        return -1;
+    }
+    if((fd = socket(AF_INET, SOCK_STREAM, 0)) == -1) {
+        perror("socket");
+        return -1;
+    }
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if(connect(fd, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int BENCH_measure_first_byte(const char * address, uint16_t port, double * latency_us) {
+    uint8_t buffer[256];
+    double start = BENCH_now_us();
+    int fd = BENCH_connect(address, port);
+    if(fd == -1) {
+        return -1;
+    }
+    if(write(fd, ask_availability, sizeof(ask_availability)) != sizeof(ask_availability)
+       || read(fd, buffer, 1) != 1) {
+        fprintf(stderr, "No answer to ASK_AVAILABILITY.\n");
+        close(fd);
+        return -1;
+    }
+    *latency_us = BENCH_now_us() - start;
+    /* Leaves cleanly so that SB_C goes back to waiting for a connection. */
+    if(write(fd, ask_to_disconnect, sizeof(ask_to_disconnect)) == sizeof(ask_to_disconnect)) {
+        while(read(fd, buffer, sizeof(buffer)) > 0);
+    }
+    close(fd);
+    return 0;
+}
+
+static int BENCH_compare(const void * a, const void * b) {
+    double first = *(const double *) a;
+    double second = *(const double *) b;
+    return (first > second) - (first < second);
+}
@@ -0,0 +1,228 @@
+/**
+ * \file  postman_priority_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Measures how long an alert waits behind a burst of log pages sent to a slow operator.
+ *
+ * \see ../src/com/postman.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include "com/postman.h"
+#include "com/frame_pool.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def SERVER_PORT
+ * Port of the postman.
+ */
+#define SERVER_PORT 12345
+/**
+ * \def DEFAULT_PAGES
+ * Amount of log pages of the burst by default.
+ */
+#define DEFAULT_PAGES 40
+/**
+ * \def PAGE_SIZE
+ * Payload of a log page, as sent by controller_logger.
+ */
+#define PAGE_SIZE 0xFFFB
+/**
+ * \def READ_CHUNK
+ * Amount of bytes read by the operator at each turn.
+ */
+#define READ_CHUNK 16384
+/**
+ * \def READ_PERIOD_US
+ * Delay between two reads of the operator : about 16 MB/s.
+ */
+#define READ_PERIOD_US 1000
+/**
+ * \def RECEIVE_BUFFER_SIZE
+ * Receive buffer of the operator socket, as small as on a busy wireless link.
+ */
+#define RECEIVE_BUFFER_SIZE 65536
+/**
+ * \def ALERT_DELAY_US
+ * Delay between the start of the burst and the alert.
+ */
+#define ALERT_DELAY_US 5000
+/**
+ * \def READ_TIME_OUT_S
+ * Delay after which the operator stops waiting for the pages.
+ */
+#define READ_TIME_OUT_S 3
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static uint64_t BENCH_now(void)
+ * \brief Monotonic time in microseconds.
+ */
+static uint64_t BENCH_now(void);
+/**
+ * \fn static void * BENCH_send_logs(void * arg)
+ * \brief Sends the burst of log pages, as controller_logger does.
+ */
+static void * BENCH_send_logs(void * arg);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static long pages_nb
+ * \brief Amount of log pages of the burst.
+ */
+static long pages_nb = DEFAULT_PAGES;
+/**
+ * \var static long pages_refused
+ * \brief Log pages refused by the postman.
+ */
+static long pages_refused;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    while((option = getopt(argc, argv, "n:")) != -1) {
+        switch(option) {
+            case 'n' : pages_nb = atol(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-n pages]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(FRAME_POOL_create() == -1 || POSTMAN_create() == -1 || POSTMAN_start() == -1) {
+        fprintf(stderr, "Postman failed to start.\n");
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_in server = {.sin_family = AF_INET, .sin_port = htons(SERVER_PORT)};
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    int receive_buffer_size = RECEIVE_BUFFER_SIZE;
+    setsockopt(client, SOL_SOCKET, SO_RCVBUF, &receive_buffer_size, sizeof(receive_buffer_size));
+    struct timeval read_time_out = {.tv_sec = READ_TIME_OUT_S};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &read_time_out, sizeof(read_time_out));
+    if(connect(client, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        return EXIT_FAILURE;
+    }
+    usleep(100000); /* Lets the postman accept the operator. */
+
+    pthread_t logger;
+    pthread_create(&logger, NULL, BENCH_send_logs, NULL);
+    usleep(ALERT_DELAY_US);
+    uint8_t * alert = FRAME_POOL_new_frame(ALERT, 1);
+    alert[FRAME_POOL_HEAD_SIZE] = 1;
+    uint64_t alert_time = BENCH_now();
+    if(POSTMAN_send_request(alert) == -1) {
+        fprintf(stderr, "POSTMAN_send_request() failed.\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Walks through the frames received until the alert and every page have been received. */
+    static uint8_t buffer[READ_CHUNK];
+    long pages_received = 0;
+    uint64_t alert_delay = 0;
+    long pages_before_alert = -1;
+    size_t frame_left = 0;
+    uint8_t head[4];
+    size_t head_size = 0;
+    while(pages_before_alert == -1 || pages_received < pages_nb) {
+        ssize_t amount_read = read(client, buffer, sizeof(buffer));
+        if(amount_read <= 0) {
+            break;
+        }
+        for(ssize_t i = 0; i < amount_read; ) {
+            if(frame_left > 0) {
+                size_t skipped = (size_t) (amount_read - i) < frame_left ? (size_t) (amount_read - i) : frame_left;
+                frame_left -= skipped;
+                i += (ssize_t) skipped;
+                continue;
+            }
+            head[head_size++] = buffer[i++];
+            if(head_size < sizeof(head)) {
+                continue;
+            }
+            head_size = 0;
+            frame_left = (size_t) (head[0] << 8 | head[1]) - 2;
+            if((head[2] << 8) == ALERT) {
+                alert_delay = BENCH_now() - alert_time;
+                pages_before_alert = pages_received;
+            }
+            else {
+                pages_received++;
+            }
+        }
+        usleep(READ_PERIOD_US);
+    }
+    pthread_join(logger, NULL);
+    printf("alert_delay_us %llu\n", (unsigned long long) alert_delay);
+    printf("pages_before_alert %ld\n", pages_before_alert);
+    printf("pages_received %ld\n", pages_received);
+    printf("pages_refused %ld\n", pages_refused);
+    static const char * lanes_name[LANE_NB] = {"control", "state", "bulk"};
+    for(int lane = 0; lane < LANE_NB; lane++) {
+        Postman_Lane_Stats stats;
+        POSTMAN_get_lane_stats(lane, &stats);
+        printf("%s_max_depth %u\n", lanes_name[lane], stats.max_depth);
+        printf("%s_written %u\n", lanes_name[lane], stats.written);
+        printf("%s_dropped %u\n", lanes_name[lane], stats.dropped);
+        printf("%s_max_wait_us %u\n", lanes_name[lane], stats.max_wait_us);
+    }
+
+    close(client);
+    POSTMAN_stop();
+    POSTMAN_destroy();
+    FRAME_POOL_destroy();
+    return EXIT_SUCCESS;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static uint64_t BENCH_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+static void * BENCH_send_logs(void * arg) {
+    for(long i = 0; i < pages_nb; i++) {
+        uint8_t * frame = FRAME_POOL_new_frame(SET_LOGS, PAGE_SIZE);
+        memset(frame + FRAME_POOL_HEAD_SIZE, 'L', PAGE_SIZE);
+        if(POSTMAN_send_request(frame) == -1) {
+            FRAME_POOL_release(frame);
+            pages_refused++;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,184 @@
+/**
+ * \file  postman_throughput_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Loopback throughput of the postman send path : frames/s and sendmsg() calls per frame.
+ *
+ * \see ../src/com/postman.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "com/postman.h"
+#include "com/frame_pool.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def SERVER_PORT
+ * Port of the postman.
+ */
+#define SERVER_PORT 12345
+/**
+ * \def DEFAULT_FRAMES
+ * Amount of frames sent by default.
+ */
+#define DEFAULT_FRAMES 100000
+/**
+ * \def DEFAULT_PAYLOAD
+ * Payload size by default : one byte, as a SET_RADAR frame.
+ */
+#define DEFAULT_PAYLOAD 1
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn ssize_t __wrap_sendmsg(int fd, const struct msghdr * message, int flags)
+ * \brief Counts the sendmsg() calls of the postman (linked with -Wl,--wrap=sendmsg).
+ */
+ssize_t __wrap_sendmsg(int fd, const struct msghdr * message, int flags);
+/**
+ * \fn ssize_t __real_sendmsg(int fd, const struct msghdr * message, int flags)
+ * \brief Real sendmsg().
+ */
+ssize_t __real_sendmsg(int fd, const struct msghdr * message, int flags);
+/**
+ * \fn static void * BENCH_produce(void * arg)
+ * \brief Asks the postman to send every frame, as the proxies do.
+ */
+static void * BENCH_produce(void * arg);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static unsigned long sendmsg_calls
+ * \brief sendmsg() calls made by the postman thread.
+ */
+static unsigned long sendmsg_calls;
+/**
+ * \var static long frames_nb
+ * \brief Amount of frames to send.
+ */
+static long frames_nb = DEFAULT_FRAMES;
+/**
+ * \var static int payload_size
+ * \brief Payload size of each frame.
+ */
+static int payload_size = DEFAULT_PAYLOAD;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    while((option = getopt(argc, argv, "n:s:")) != -1) {
+        switch(option) {
+            case 'n' : frames_nb = atol(optarg); break;
+            case 's' : payload_size = atoi(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-n frames] [-s payload_bytes]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(payload_size < 0 || payload_size > 0xFFFD) {
+        fprintf(stderr, "Payload size must fit in a frame.\n");
+        return EXIT_FAILURE;
+    }
+    if(FRAME_POOL_create() == -1 || POSTMAN_create() == -1 || POSTMAN_start() == -1) {
+        fprintf(stderr, "Postman failed to start.\n");
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_in server = {.sin_family = AF_INET, .sin_port = htons(SERVER_PORT)};
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    if(connect(client, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        return EXIT_FAILURE;
+    }
+    usleep(100000); /* Lets the postman accept the operator. */
+
+    unsigned long long expected = (unsigned long long) frames_nb * (4 + payload_size);
+    unsigned long long received = 0;
+    static uint8_t buffer[1 << 16];
+    struct timespec start, end;
+    pthread_t producer;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&producer, NULL, BENCH_produce, NULL);
+    while(received < expected) {
+        ssize_t amount_read = read(client, buffer, sizeof(buffer));
+        if(amount_read <= 0) {
+            fprintf(stderr, "Connection closed after %llu bytes.\n", received);
+            return EXIT_FAILURE;
+        }
+        received += (unsigned long long) amount_read;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    pthread_join(producer, NULL);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("frames %ld\n", frames_nb);
+    printf("payload_bytes %d\n", payload_size);
+    printf("frames_per_s %.0f\n", frames_nb / seconds);
+    printf("mbytes_per_s %.1f\n", received / seconds / 1e6);
+    printf("sendmsg_per_frame %.3f\n", (double) sendmsg_calls / frames_nb);
+    Frame_Pool_Stats stats;
+    FRAME_POOL_get_stats(&stats);
+    printf("pool_hits %u\n", stats.hits);
+    printf("pool_misses %u\n", stats.misses);
+    printf("pool_exhaustions %u\n", stats.exhaustions);
+
+    close(client);
+    POSTMAN_stop();
+    POSTMAN_destroy();
+    FRAME_POOL_destroy();
+    return EXIT_SUCCESS;
+}
+
+ssize_t __wrap_sendmsg(int fd, const struct msghdr * message, int flags) {
+    __atomic_fetch_add(&sendmsg_calls, 1, __ATOMIC_RELAXED);
+    return __real_sendmsg(fd, message, flags);
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static void * BENCH_produce(void * arg) {
+    for(long i = 0; i < frames_nb; i++) {
+        uint8_t * frame = FRAME_POOL_new_frame(SET_RADAR, (uint16_t) payload_size);
+        if(frame == NULL) {
+            fprintf(stderr, "FRAME_POOL_new_frame() failed.\n");
+            exit(EXIT_FAILURE);
+        }
+        memset(frame + FRAME_POOL_HEAD_SIZE, 0x55, payload_size);
+        if(POSTMAN_send_request(frame) == -1) {
+            fprintf(stderr, "POSTMAN_send_request() failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return NULL;
+}
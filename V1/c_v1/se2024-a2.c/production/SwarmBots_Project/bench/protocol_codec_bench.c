@@ -0,0 +1,242 @@
+/**
+ * \file  protocol_codec_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Measures a round trip through the protocol codec : messages encoded in a frame, then decoded.
+ *
+ * \see ../src/lib/protocol.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include "lib/protocol.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def DEFAULT_ROUNDS
+ * Amount of rounds by default, each round encodes and decodes every message of BENCH_round().
+ */
+#define DEFAULT_ROUNDS 10000000
+/**
+ * \def ROUND_MESSAGES
+ * Messages encoded and decoded by a round.
+ */
+#define ROUND_MESSAGES 6
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static uint32_t BENCH_round(uint8_t * frame, uint32_t value)
+ * \brief Encodes then decodes SET_MODE, SET_SESSION, SET_CURRENT_TIME, SET_IP_PORT, ASK_RESUME and ASK_CMD
+ * with the codec.
+ * \return Sum of the decoded fields.
+ */
+static uint32_t BENCH_round(uint8_t * frame, uint32_t value);
+/**
+ * \fn static uint32_t BENCH_round_legacy(uint8_t * frame, uint32_t value)
+ * \brief Same round written by hand as the proxies and the dispatcher used to : htonl() and memcpy() to
+ * encode, byte indexes and ntohs() to decode.
+ * \return Sum of the decoded fields.
+ */
+static uint32_t BENCH_round_legacy(uint8_t * frame, uint32_t value);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static volatile uint32_t sink
+ * \brief Keeps the decoded fields alive.
+ */
+static volatile uint32_t sink;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    int is_legacy = 0;
+    long rounds = DEFAULT_ROUNDS;
+    while((option = getopt(argc, argv, "n:l")) != -1) {
+        switch(option) {
+            case 'n' : rounds = atol(optarg); break;
+            case 'l' : is_legacy = 1; break;
+            default :
+                fprintf(stderr, "usage: %s [-n rounds] [-l]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    uint32_t (* round)(uint8_t *, uint32_t) = is_legacy ? BENCH_round_legacy : BENCH_round;
+    uint8_t frame[PROTOCOL_HEAD_SIZE + PROTOCOL_SET_CURRENT_TIME_SIZE];
+    uint32_t sum = 0;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(long i = 0; i < rounds; i++) {
+        sum += round(frame, (uint32_t) i);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    sink = sum;
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("codec %s\n", is_legacy ? "legacy" : "protocol");
+    printf("round_trips %ld\n", rounds * ROUND_MESSAGES);
+    printf("ns_per_round_trip %.2f\n", seconds * 1e9 / (rounds * ROUND_MESSAGES));
+    printf("checksum %u\n", sum);
+    return EXIT_SUCCESS;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static uint32_t BENCH_round(uint8_t * frame, uint32_t value) {
+    uint32_t sum = 0;
+    uint8_t * payload;
+    const uint8_t * decoded;
+
+    payload = PROTOCOL_encode_SET_MODE(frame);
+    PROTOCOL_put_SET_MODE_camera_mode(payload, (uint8_t) value & 1);
+    PROTOCOL_put_SET_MODE_radar_mode(payload, (uint8_t) (value >> 1) & 1);
+    PROTOCOL_put_SET_MODE_buzzer_mode(payload, (uint8_t) (value >> 2) & 1);
+    PROTOCOL_put_SET_MODE_leds_mode(payload, (uint8_t) (value >> 3) & 1);
+    decoded = PROTOCOL_decode_SET_MODE(frame, PROTOCOL_HEAD_SIZE + PROTOCOL_SET_MODE_SIZE);
+    sum += PROTOCOL_get_SET_MODE_camera_mode(decoded) + PROTOCOL_get_SET_MODE_radar_mode(decoded)
+         + PROTOCOL_get_SET_MODE_buzzer_mode(decoded) + PROTOCOL_get_SET_MODE_leds_mode(decoded);
+
+    payload = PROTOCOL_encode_SET_SESSION(frame);
+    PROTOCOL_put_SET_SESSION_session_token(payload, value);
+    PROTOCOL_put_SET_SESSION_is_resumed(payload, (uint8_t) value & 1);
+    decoded = PROTOCOL_decode_SET_SESSION(frame, PROTOCOL_HEAD_SIZE + PROTOCOL_SET_SESSION_SIZE);
+    sum += PROTOCOL_get_SET_SESSION_session_token(decoded) + PROTOCOL_get_SET_SESSION_is_resumed(decoded);
+
+    payload = PROTOCOL_encode_SET_CURRENT_TIME(frame);
+    PROTOCOL_put_SET_CURRENT_TIME_century(payload, 20);
+    PROTOCOL_put_SET_CURRENT_TIME_year(payload, (uint8_t) (value % 100));
+    PROTOCOL_put_SET_CURRENT_TIME_month(payload, (uint8_t) (value % 12 + 1));
+    PROTOCOL_put_SET_CURRENT_TIME_day(payload, (uint8_t) (value % 28 + 1));
+    PROTOCOL_put_SET_CURRENT_TIME_hour(payload, (uint8_t) (value % 24));
+    PROTOCOL_put_SET_CURRENT_TIME_minute(payload, (uint8_t) (value % 60));
+    PROTOCOL_put_SET_CURRENT_TIME_second(payload, (uint8_t) (value % 60));
+    decoded = PROTOCOL_decode_SET_CURRENT_TIME(frame, PROTOCOL_HEAD_SIZE + PROTOCOL_SET_CURRENT_TIME_SIZE);
+    sum += PROTOCOL_get_SET_CURRENT_TIME_century(decoded) + PROTOCOL_get_SET_CURRENT_TIME_year(decoded)
+         + PROTOCOL_get_SET_CURRENT_TIME_month(decoded) + PROTOCOL_get_SET_CURRENT_TIME_day(decoded)
+         + PROTOCOL_get_SET_CURRENT_TIME_hour(decoded) + PROTOCOL_get_SET_CURRENT_TIME_minute(decoded)
+         + PROTOCOL_get_SET_CURRENT_TIME_second(decoded);
+
+    payload = PROTOCOL_encode_SET_IP_PORT(frame);
+    PROTOCOL_put_SET_IP_PORT_ip(payload, value);
+    PROTOCOL_put_SET_IP_PORT_port(payload, (uint16_t) value);
+    decoded = PROTOCOL_decode_SET_IP_PORT(frame, PROTOCOL_HEAD_SIZE + PROTOCOL_SET_IP_PORT_SIZE);
+    sum += PROTOCOL_get_SET_IP_PORT_ip(decoded) + PROTOCOL_get_SET_IP_PORT_port(decoded);
+
+    payload = PROTOCOL_encode_ASK_RESUME(frame);
+    PROTOCOL_put_ASK_RESUME_session_token(payload, value);
+    decoded = PROTOCOL_decode_ASK_RESUME(frame, PROTOCOL_HEAD_SIZE + PROTOCOL_ASK_RESUME_SIZE);
+    sum += PROTOCOL_get_ASK_RESUME_session_token(decoded);
+
+    payload = PROTOCOL_encode_ASK_CMD(frame);
+    PROTOCOL_put_ASK_CMD_command(payload, (uint8_t) (value % 5));
+    decoded = PROTOCOL_decode_ASK_CMD(frame, PROTOCOL_HEAD_SIZE + PROTOCOL_ASK_CMD_SIZE);
+    sum += PROTOCOL_get_ASK_CMD_command(decoded);
+    return sum;
+}
+
+static uint32_t BENCH_round_legacy(uint8_t * frame, uint32_t value) {
+    uint32_t sum = 0;
+    uint8_t * payload = frame + 4;
+    uint16_t msg_size;
+    uint16_t type;
+    uint32_t token;
+
+    msg_size = htons(6);
+    type = SET_MODE;
+    memcpy(frame, &msg_size, sizeof(msg_size));
+    memcpy(frame + 2, &type, sizeof(type));
+    payload[0] = (uint8_t) value & 1;
+    payload[1] = (uint8_t) (value >> 1) & 1;
+    payload[2] = (uint8_t) (value >> 2) & 1;
+    payload[3] = (uint8_t) (value >> 3) & 1;
+    if(((frame[0] << 8) | frame[1]) >= 6 && ntohs((frame[2] << 8) | frame[3]) == SET_MODE) {
+        sum += payload[0] + payload[1] + payload[2] + payload[3];
+    }
+
+    msg_size = htons(7);
+    type = SET_SESSION;
+    memcpy(frame, &msg_size, sizeof(msg_size));
+    memcpy(frame + 2, &type, sizeof(type));
+    token = htonl(value);
+    memcpy(payload, &token, sizeof(token));
+    payload[4] = (uint8_t) value & 1;
+    if(((frame[0] << 8) | frame[1]) >= 7 && ntohs((frame[2] << 8) | frame[3]) == SET_SESSION) {
+        memcpy(&token, payload, sizeof(token));
+        sum += ntohl(token) + payload[4];
+    }
+
+    msg_size = htons(9);
+    type = SET_CURRENT_TIME;
+    memcpy(frame, &msg_size, sizeof(msg_size));
+    memcpy(frame + 2, &type, sizeof(type));
+    payload[0] = 20;
+    payload[1] = (uint8_t) (value % 100);
+    payload[2] = (uint8_t) (value % 12 + 1);
+    payload[3] = (uint8_t) (value % 28 + 1);
+    payload[4] = (uint8_t) (value % 24);
+    payload[5] = (uint8_t) (value % 60);
+    payload[6] = (uint8_t) (value % 60);
+    if(((frame[0] << 8) | frame[1]) >= 9 && ntohs((frame[2] << 8) | frame[3]) == SET_CURRENT_TIME) {
+        sum += payload[0] + payload[1] + payload[2] + payload[3] + payload[4] + payload[5] + payload[6];
+    }
+
+    msg_size = htons(8);
+    type = SET_IP_PORT;
+    memcpy(frame, &msg_size, sizeof(msg_size));
+    memcpy(frame + 2, &type, sizeof(type));
+    token = htonl(value);
+    memcpy(payload, &token, sizeof(token));
+    payload[4] = (uint8_t) (value >> 8);
+    payload[5] = (uint8_t) value;
+    if(((frame[0] << 8) | frame[1]) >= 8 && ntohs((frame[2] << 8) | frame[3]) == SET_IP_PORT) {
+        memcpy(&token, payload, sizeof(token));
+        sum += ntohl(token) + (uint16_t) ((payload[4] << 8) | payload[5]);
+    }
+
+    msg_size = htons(6);
+    type = ASK_RESUME;
+    memcpy(frame, &msg_size, sizeof(msg_size));
+    memcpy(frame + 2, &type, sizeof(type));
+    token = htonl(value);
+    memcpy(payload, &token, sizeof(token));
+    if(((frame[0] << 8) | frame[1]) >= 6 && ntohs((frame[2] << 8) | frame[3]) == ASK_RESUME) {
+        sum += (uint32_t) payload[0] << 24 | (uint32_t) payload[1] << 16 | (uint32_t) payload[2] << 8 | payload[3];
+    }
+
+    msg_size = htons(3);
+    type = ASK_CMD;
+    memcpy(frame, &msg_size, sizeof(msg_size));
+    memcpy(frame + 2, &type, sizeof(type));
+    payload[0] = (uint8_t) (value % 5);
+    if(((frame[0] << 8) | frame[1]) >= 3 && ntohs((frame[2] << 8) | frame[3]) == ASK_CMD) {
+        sum += payload[0];
+    }
+    return sum;
+}
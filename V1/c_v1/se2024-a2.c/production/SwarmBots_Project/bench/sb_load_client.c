@@ -0,0 +1,411 @@
+/**
+ * \file  sb_load_client.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Load client of SB_C : measures the protocol round trips, the logs upload and the command rate on a running SB_C.
+ *
+ * \see ../src/lib/defs.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "lib/defs.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def DEFAULT_ADDRESS
+ * SB_C address used when none is given.
+ */
+#define DEFAULT_ADDRESS "127.0.0.1"
+/**
+ * \def DEFAULT_PORT
+ * SB_C port used when none is given (postman SERVER_PORT).
+ */
+#define DEFAULT_PORT 12345
+/**
+ * \def DEFAULT_SAMPLES
+ * Amount of ASK_AVAILABILITY and ASK_MODE round trips measured by default.
+ */
+#define DEFAULT_SAMPLES 1000
+/**
+ * \def DEFAULT_CMD_SECONDS
+ * Length of the ASK_CMD window in seconds.
+ */
+#define DEFAULT_CMD_SECONDS 5
+/**
+ * \def DEFAULT_CMD_BURST
+ * Amount of ASK_CMD sent between two ASK_AVAILABILITY checking that SB_C keeps up.
+ */
+#define DEFAULT_CMD_BURST 1
+/**
+ * \def RECEIVE_TIMEOUT_S
+ * Delay without any byte from SB_C after which the bench fails, in seconds.
+ */
+#define RECEIVE_TIMEOUT_S 5
+/**
+ * \def LOGS_ATTEMPTS
+ * Amount of ASK_LOGS sent before giving up : the controller logger drops the requests coming while it is busy
+ * with a log entry.
+ */
+#define LOGS_ATTEMPTS 3
+/**
+ * \def FRAME_MAX_SIZE
+ * Biggest frame SB_C can send : the size field, then up to 0xFFFF bytes.
+ */
+#define FRAME_MAX_SIZE (2 + 0xFFFF)
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static double BENCH_now_us(void)
+ * \brief Gives the monotonic time in microseconds.
+ *
+ * \return Current monotonic time in microseconds.
+ */
+static double BENCH_now_us(void);
+/**
+ * \fn static int BENCH_connect(const char * address, uint16_t port)
+ * \brief Opens a TCP connection to SB_C.
+ *
+ * \param address : IPv4 address of SB_C.
+ * \param port : TCP port of SB_C.
+ *
+ * \return On success, returns the socket. On error, returns -1.
+ */
+static int BENCH_connect(const char * address, uint16_t port);
+/**
+ * \fn static int BENCH_send(int fd, Message_Type type, const uint8_t * payload, uint16_t payload_size)
+ * \brief Sends a frame the way SB_IHM does : [size][0x00][type][payload].
+ *
+ * \param fd : socket connected to SB_C.
+ * \param type : type of the message.
+ * \param payload : payload of the message, may be NULL when payload_size is 0.
+ * \param payload_size : size of the payload in bytes.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int BENCH_send(int fd, Message_Type type, const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int BENCH_wait_for(int fd, Message_Type type, uint8_t * payload)
+ * \brief Reads the frames of SB_C until one of the given type, the others (radar, alert, session...) are skipped.
+ *
+ * \param fd : socket connected to SB_C.
+ * \param type : awaited type.
+ * \param payload : filled with the payload of the awaited frame, FRAME_MAX_SIZE bytes.
+ *
+ * \return On success, returns the payload size. On error or disconnection, returns -1.
+ */
+static int BENCH_wait_for(int fd, Message_Type type, uint8_t * payload);
+/**
+ * \fn static int BENCH_round_trips(int fd, Message_Type ask, Message_Type answer, int samples, const char * name)
+ * \brief Measures the round trips of a request and prints their percentiles.
+ *
+ * \param fd : socket connected to SB_C.
+ * \param ask : type of the request.
+ * \param answer : type of the answer of SB_C.
+ * \param samples : amount of round trips.
+ * \param name : prefix of the printed results.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int BENCH_round_trips(int fd, Message_Type ask, Message_Type answer, int samples, const char * name);
+/**
+ * \fn static int BENCH_command_rate(int fd, int seconds, int burst)
+ * \brief Sends ASK_CMD during the given window and prints the rate SB_C sustained. After each burst, an
+ * ASK_AVAILABILITY is answered only once the dispatcher has read the whole burst.
+ *
+ * \param fd : socket connected to SB_C.
+ * \param seconds : length of the window.
+ * \param burst : amount of ASK_CMD between two checks.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int BENCH_command_rate(int fd, int seconds, int burst);
+/**
+ * \fn static int BENCH_logs_upload(int fd)
+ * \brief Asks the logs, receives every page, acknowledges them and prints the throughput of the upload.
+ *
+ * \param fd : socket connected to SB_C.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int BENCH_logs_upload(int fd);
+/**
+ * \fn static int BENCH_compare(const void * a, const void * b)
+ * \brief qsort() comparator of doubles.
+ */
+static int BENCH_compare(const void * a, const void * b);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static uint8_t frame[]
+ * \brief Reception buffer, big enough for a full log page.
+ */
+static uint8_t frame[FRAME_MAX_SIZE];
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    const char * address = DEFAULT_ADDRESS;
+    uint16_t port = DEFAULT_PORT;
+    int samples = DEFAULT_SAMPLES;
+    int cmd_seconds = DEFAULT_CMD_SECONDS;
+    int cmd_burst = DEFAULT_CMD_BURST;
+    bool_e with_logs = TRUE;
+    int option;
+
+    while((option = getopt(argc, argv, "a:p:n:d:b:L")) != -1) {
+        switch(option) {
+            case 'a' : address = optarg; break;
+            case 'p' : port = (uint16_t) atoi(optarg); break;
+            case 'n' : samples = atoi(optarg); break;
+            case 'd' : cmd_seconds = atoi(optarg); break;
+            case 'b' : cmd_burst = atoi(optarg); break;
+            case 'L' : with_logs = FALSE; break;
+            default :
+                fprintf(stderr, "usage: %s [-a address] [-p port] [-n samples] [-d cmd_seconds] [-b cmd_burst] [-L]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(samples < 1 || cmd_burst < 1) {
+        fprintf(stderr, "The samples and the burst must be positive.\n");
+        return EXIT_FAILURE;
+    }
+
+    int fd = BENCH_connect(address, port);
+    if(fd == -1) {
+        return EXIT_FAILURE;
+    }
+    /* The first answer tells that SB_C has accepted the connection. */
+    if(BENCH_send(fd, ASK_AVAILABILITY, NULL, 0) == -1 || BENCH_wait_for(fd, SET_AVAILABILITY, frame) == -1) {
+        fprintf(stderr, "No answer to ASK_AVAILABILITY.\n");
+        close(fd);
+        return EXIT_FAILURE;
+    }
+    /* The logs can only be asked once the clock of SB_C is set : [unused][year - 2000][month][day][h][min][s]. */
+    time_t now = time(NULL);
+    struct tm * date = localtime(&now);
+    uint8_t current_time[] = {0, date->tm_year - 100, date->tm_mon + 1, date->tm_mday, date->tm_hour, date->tm_min, date->tm_sec};
+
+    int result = EXIT_FAILURE;
+    if(BENCH_send(fd, SET_CURRENT_TIME, current_time, sizeof(current_time)) == -1
+       || BENCH_round_trips(fd, ASK_AVAILABILITY, SET_AVAILABILITY, samples, "availability") == -1
+       || BENCH_round_trips(fd, ASK_MODE, SET_MODE, samples, "mode") == -1
+       || (with_logs && BENCH_logs_upload(fd) == -1)
+       || (cmd_seconds > 0 && BENCH_command_rate(fd, cmd_seconds, cmd_burst) == -1)) {
+        fprintf(stderr, "Bench aborted.\n");
+    }
+    else {
+        result = EXIT_SUCCESS;
+    }
+    /* Leaves cleanly so that SB_C goes back to waiting for a connection. */
+    if(BENCH_send(fd, ASK_TO_DISCONNECT, NULL, 0) == 0) {
+        while(read(fd, frame, sizeof(frame)) > 0);
+    }
+    close(fd);
+    return result;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static double BENCH_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+}
+
+static int BENCH_connect(const char * address, uint16_t port) {
+    struct sockaddr_in server = {.sin_family = AF_INET, .sin_port = htons(port)};
+    struct timeval timeout = {.tv_sec = RECEIVE_TIMEOUT_S};
+    int one = 1;
+    int fd;
+    if(inet_pton(AF_INET, address, &server.sin_addr) != 1) {
+        fprintf(stderr, "Invalid address %s.\n", address);
+        return -1;
+    }
+    if((fd = socket(AF_INET, SOCK_STREAM, 0)) == -1) {
+        perror("socket");
+        return -1;
+    }
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if(connect(fd, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int BENCH_send(int fd, Message_Type type, const uint8_t * payload, uint16_t payload_size) {
+    uint8_t message[4 + 16];
+    uint16_t size = 2 + payload_size;
+    if(payload_size > sizeof(message) - 4) {
+        return -1;
+    }
+    message[0] = size >> 8;
+    message[1] = size & 0xFF;
+    message[2] = 0x00;
+    message[3] = type >> 8;
+    if(payload_size > 0) {
+        memcpy(message + 4, payload, payload_size);
+    }
+    if(send(fd, message, 2 + size, MSG_NOSIGNAL) != 2 + size) {
+        perror("send");
+        return -1;
+    }
+    return 0;
+}
+
+static int BENCH_wait_for(int fd, Message_Type type, uint8_t * payload) {
+    for(;;) {
+        uint8_t head[4];
+        if(recv(fd, head, sizeof(head), MSG_WAITALL) != sizeof(head)) {
+            return -1;
+        }
+        /* The size field counts the type and the payload. */
+        int payload_size = ((head[0] << 8) | head[1]) - 2;
+        if(payload_size < 0) {
+            return -1;
+        }
+        if(payload_size > 0 && recv(fd, payload, payload_size, MSG_WAITALL) != payload_size) {
+            return -1;
+        }
+        if(head[2] == type >> 8) {
+            return payload_size;
+        }
+    }
+}
+
+static int BENCH_round_trips(int fd, Message_Type ask, Message_Type answer, int samples, const char * name) {
+    double * latencies = malloc(samples * sizeof(double));
+    if(latencies == NULL) {
+        return -1;
+    }
+    for(int i = 0; i < samples; i++) {
+        double start = BENCH_now_us();
+        if(BENCH_send(fd, ask, NULL, 0) == -1 || BENCH_wait_for(fd, answer, frame) == -1) {
+            fprintf(stderr, "No answer to the request %d of %s.\n", i, name);
+            free(latencies);
+            return -1;
+        }
+        latencies[i] = BENCH_now_us() - start;
+    }
+    qsort(latencies, samples, sizeof(double), BENCH_compare);
+    printf("%s_samples %d\n", name, samples);
+    printf("%s_p50_us %.0f\n", name, latencies[samples / 2]);
+    printf("%s_p90_us %.0f\n", name, latencies[(samples * 90) / 100]);
+    printf("%s_p99_us %.0f\n", name, latencies[(samples * 99) / 100]);
+    printf("%s_max_us %.0f\n", name, latencies[samples - 1]);
+    free(latencies);
+    return 0;
+}
+
+static int BENCH_command_rate(int fd, int seconds, int burst) {
+    /* Every direction is sent so that the pilot goes through all its states. */
+    static const Command commands[] = {FORWARD, RIGHT, LEFT, BACKWARD, STOP};
+    long sent = 0;
+    double start = BENCH_now_us();
+    double end = start + seconds * 1e6;
+    double now = start;
+
+    while(now < end) {
+        for(int i = 0; i < burst; i++) {
+            uint8_t command = commands[sent % (sizeof(commands) / sizeof(commands[0]))];
+            if(BENCH_send(fd, ASK_CMD, &command, 1) == -1) {
+                return -1;
+            }
+            sent++;
+        }
+        if(BENCH_send(fd, ASK_AVAILABILITY, NULL, 0) == -1 || BENCH_wait_for(fd, SET_AVAILABILITY, frame) == -1) {
+            fprintf(stderr, "SB_C stopped answering after %ld commands.\n", sent);
+            return -1;
+        }
+        now = BENCH_now_us();
+    }
+    /* The robot is left stopped. */
+    uint8_t command = STOP;
+    if(BENCH_send(fd, ASK_CMD, &command, 1) == -1) {
+        return -1;
+    }
+    printf("cmd_sent %ld\n", sent);
+    printf("cmd_window_s %.2f\n", (now - start) / 1e6);
+    printf("cmd_per_s %.0f\n", sent * 1e6 / (now - start));
+    return 0;
+}
+
+static int BENCH_logs_upload(int fd) {
+    unsigned long bytes = 0;
+    int pages = 0;
+    int page_size = -1;
+    double start = 0;
+
+    for(int attempt = 0; attempt < LOGS_ATTEMPTS && page_size == -1; attempt++) {
+        start = BENCH_now_us();
+        if(BENCH_send(fd, ASK_LOGS, NULL, 0) == -1) {
+            return -1;
+        }
+        if((page_size = BENCH_wait_for(fd, SET_LOGS, frame)) == -1 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+    }
+    /* Each page is [page][max_page][logs], the pages are numbered from 1. */
+    while(page_size >= 2) {
+        bytes += page_size - 2;
+        pages++;
+        if(frame[0] >= frame[1]) {
+            break;
+        }
+        page_size = BENCH_wait_for(fd, SET_LOGS, frame);
+    }
+    if(page_size < 2) {
+        fprintf(stderr, "Logs upload interrupted after %d pages.\n", pages);
+        return -1;
+    }
+    double duration = BENCH_now_us() - start;
+
+    if(BENCH_send(fd, LOGS_RECEIVED, NULL, 0) == -1) {
+        return -1;
+    }
+    printf("logs_bytes %lu\n", bytes);
+    printf("logs_pages %d\n", pages);
+    printf("logs_upload_us %.0f\n", duration);
+    printf("logs_mb_per_s %.2f\n", bytes / duration);
+    return 0;
+}
+
+static int BENCH_compare(const void * a, const void * b) {
+    double first = *(const double *) a;
+    double second = *(const double *) b;
+    return (first > second) - (first < second);
+}
@@ -0,0 +1,163 @@
+/**
+ * \file  alphabot2_stub.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Alphabot2 drivers standing in for the real ones in the host build of SB_C : no hardware is driven, every call succeeds.
+ *
+ * \see ../../src/alphabot2/
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include "alphabot2/buzzer.h"
+#include "alphabot2/camera.h"
+#include "alphabot2/leds.h"
+#include "alphabot2/motor.h"
+#include "alphabot2/radar.h"
+#include "alphabot2/servo_motor.h"
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+/* BUZZER */
+int BUZZER_create() {
+    return 0;
+}
+
+void BUZZER_destroy() {
+}
+
+void BUZZER_enable_buzzer() {
+}
+
+void BUZZER_disable_buzzer() {
+}
+
+/* CAMERA */
+int CAMERA_create(void) {
+    return 0;
+}
+
+int CAMERA_destroy(void) {
+    return 0;
+}
+
+int CAMERA_start(void) {
+    return 0;
+}
+
+int CAMERA_stop(void) {
+    return 0;
+}
+
+int CAMERA_enable_camera(void) {
+    return 0;
+}
+
+int CAMERA_disable_camera(void) {
+    return 0;
+}
+
+int CAMERA_set_up_ihm_info(char * ip_address, uint16_t port) {
+    return 0;
+}
+
+int CAMERA_disconnect_camera(void) {
+    return 0;
+}
+
+/* LEDS */
+int LEDS_create(void) {
+    return 0;
+}
+
+int LEDS_destroy(void) {
+    return 0;
+}
+
+int LEDS_start(void) {
+    return 0;
+}
+
+int LEDS_stop(void) {
+    return 0;
+}
+
+int LEDS_set_color(id_led_t p_id_led, color_e p_color) {
+    return 0;
+}
+
+int LEDS_start_blinking() {
+    return 0;
+}
+
+/* MOTOR */
+int MOTOR_create(void) {
+    return 0;
+}
+
+int MOTOR_destroy(void) {
+    return 0;
+}
+
+void MOTOR_set_velocity(Command cmd) {
+}
+
+/* RADAR */
+int RADAR_create() {
+    return 0;
+}
+
+int RADAR_destroy() {
+    return 0;
+}
+
+int RADAR_get_radar(bool_e * obstacle_state) {
+    *obstacle_state = FALSE;
+    return 0;
+}
+
+/* SERVO MOTOR */
+int SERVO_MOTOR_create(void) {
+    return 0;
+}
+
+int SERVO_MOTOR_destroy(void) {
+    return 0;
+}
+
+void SERVO_MOTOR_init(void) {
+}
+
+void SERVO_MOTOR_enable_servo_motor(void) {
+}
+
+void SERVO_MOTOR_disable_servo_motor(void) {
+}
+
+int SERVO_MOTOR_set_position(int servo_addr, float angle) {
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * \file  controller_core_stub.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Controller_core standing in for the real one in the benchmarks : every request is accepted.
+ *
+ * \see ../../src/controller/controller_core.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include "config.h"
+#include "controller/controller_core.h"
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int CONTROLLER_CORE_ask_to_connect(Id_Robot id_robot) {
+    return 0;
+}
+
+int CONTROLLER_CORE_connection_lost(void) {
+    return 0;
+}
+
+int CONTROLLER_CORE_ask_to_disconnect(Id_Robot id_robot) {
+    return 0;
+}
+
+int CONTROLLER_CORE_ask_set_state(Id_Robot id_robot, State state) {
+    return 0;
+}
+
+int CONTROLLER_CORE_ask_resume(Id_Robot id_robot, uint32_t session_token) {
+    return 0;
+}
+
+int CONTROLLER_CORE_ask_mode(Id_Robot id_robot) {
+    return 0;
+}
+
+int CONTROLLER_CORE_ask_set_mode(Id_Robot id_robot, Operating_Mode operating_mode) {
+    return 0;
+}
+
+Id_Robot CONTROLLER_CORE_get_id_robot(void) {
+    return ID_ROBOT;
+}
+
+Operating_Mode CONTROLLER_CORE_get_mode(void) {
+    Operating_Mode operating_mode = {DISABLED, DISABLED, DISABLED, DISABLED};
+    return operating_mode;
+}
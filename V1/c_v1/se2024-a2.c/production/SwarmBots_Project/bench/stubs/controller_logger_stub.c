@@ -0,0 +1,68 @@
+/**
+ * \file  controller_logger_stub.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Silent controller_logger for the benchmarks : logs cost nothing and print nothing.
+ *
+ * \see ../../src/logs/controller_logger.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include "logs/controller_logger.h"
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static log_level_e level
+ * \brief Lowest level logged, as in the real logger.
+ */
+static log_level_e level = CONFIG_LOGGER_LOG_LEVEL;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int CONTROLLER_LOGGER_log(log_level_e log_level, const char* msg) {
+    return 0;
+}
+
+bool_e CONTROLLER_LOGGER_is_enabled(log_level_e log_level) {
+    return log_level >= __atomic_load_n(&level, __ATOMIC_RELAXED) ? TRUE : FALSE;
+}
+
+void CONTROLLER_LOGGER_set_level(log_level_e log_level) {
+    __atomic_store_n(&level, log_level, __ATOMIC_RELAXED);
+}
+
+int CONTROLLER_LOGGER_ask_logs(Id_Robot id_robot) {
+    return 0;
+}
+
+int CONTROLLER_LOGGER_ask_set_rtc(Id_Robot id_robot, time_t rtc) {
+    return 0;
+}
+
+int CONTROLLER_LOGGER_logs_saved(Id_Robot id_robot) {
+    return 0;
+}
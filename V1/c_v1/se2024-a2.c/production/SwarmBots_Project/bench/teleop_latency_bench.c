@@ -0,0 +1,409 @@
+/**
+ * \file  teleop_latency_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Measures the delay between a drive command of the operator and the motor order, over TCP and over the teleoperation channel, while logs are flowing to SB_IHM.
+ *
+ * \see ../src/com/postman.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "config.h"
+#include "com/postman.h"
+#include "com/frame_pool.h"
+#include "com/dispatcher.h"
+#include "com/capabilities.h"
+#include "com/gui_secretary_proxy.h"
+#include "controller/pilot.h"
+#include "controller/controller_ringer.h"
+#include "controller/state_indicator.h"
+#include "alphabot2/motor.h"
+#include "alphabot2/radar.h"
+#include "alphabot2/camera.h"
+#include "lib/protocol.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def SERVER_PORT
+ * Port of the postman.
+ */
+#define SERVER_PORT 12345
+/**
+ * \def DEFAULT_COMMANDS
+ * Amount of commands sent by default on each channel.
+ */
+#define DEFAULT_COMMANDS 2000
+/**
+ * \def DEFAULT_PERIOD_US
+ * Delay between two commands by default, in microseconds.
+ */
+#define DEFAULT_PERIOD_US 2000
+/**
+ * \def DEFAULT_LOGS_PAGE_SIZE
+ * Size of the log pages flowing to SB_IHM by default, 0 for no background traffic.
+ */
+#define DEFAULT_LOGS_PAGE_SIZE 4096
+/**
+ * \def READ_CHUNK
+ * Amount of bytes read by the operator at each turn, as a slow SB_IHM would.
+ */
+#define READ_CHUNK 4096
+/**
+ * \def COMMAND_TIME_OUT_S
+ * Delay after which a command which did not reach the motors is counted as lost.
+ */
+#define COMMAND_TIME_OUT_S 1
+/**
+ * \def STALE_COMMANDS
+ * Amount of outdated teleoperation commands, then of late ones, sent at the end of the run.
+ */
+#define STALE_COMMANDS 100
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static uint64_t BENCH_now(void)
+ * \brief Monotonic time in nanoseconds.
+ */
+static uint64_t BENCH_now(void);
+/**
+ * \fn static void * BENCH_flood_logs(void * arg)
+ * \brief Pushes log pages to the operator through the postman, as controller_logger does.
+ */
+static void * BENCH_flood_logs(void * arg);
+/**
+ * \fn static void * BENCH_read_slowly(void * arg)
+ * \brief Reads what the robot sends to the operator, a chunk per millisecond.
+ */
+static void * BENCH_read_slowly(void * arg);
+/**
+ * \fn static void BENCH_send_teleop(int teleop_client, uint32_t sequence, Command command, uint32_t delay_ms)
+ * \brief Sends a drive command on the teleoperation channel, stamped delay_ms in the past.
+ */
+static void BENCH_send_teleop(int teleop_client, uint32_t sequence, Command command, uint32_t delay_ms);
+/**
+ * \fn static void BENCH_measure(const char * channel, int tcp_client, int teleop_client)
+ * \brief Sends the commands on one channel and prints the delays until the motors are driven.
+ */
+static void BENCH_measure(const char * channel, int tcp_client, int teleop_client);
+/**
+ * \fn static int BENCH_compare(const void * a, const void * b)
+ * \brief Orders two delays for qsort().
+ */
+static int BENCH_compare(const void * a, const void * b);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static pthread_mutex_t motor_mutex
+ * \brief Protects the motor probe.
+ */
+static pthread_mutex_t motor_mutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * \var static pthread_cond_t motor_driven
+ * \brief Signaled each time the motors receive an order.
+ */
+static pthread_cond_t motor_driven = PTHREAD_COND_INITIALIZER;
+/**
+ * \var static unsigned long motor_orders
+ * \brief Amount of orders given to the motors.
+ */
+static unsigned long motor_orders;
+/**
+ * \var static uint64_t motor_order_time
+ * \brief Time of the last order given to the motors.
+ */
+static uint64_t motor_order_time;
+/**
+ * \var static volatile int is_running
+ * \brief Tells the background threads to go on.
+ */
+static volatile int is_running = 1;
+/**
+ * \var static int operator_socket
+ * \brief Connection of the operator.
+ */
+static int operator_socket = -1;
+/**
+ * \var static long commands_nb
+ * \brief Amount of commands sent on each channel.
+ */
+static long commands_nb = DEFAULT_COMMANDS;
+/**
+ * \var static long period_us
+ * \brief Delay between two commands.
+ */
+static long period_us = DEFAULT_PERIOD_US;
+/**
+ * \var static int logs_page_size
+ * \brief Size of the log pages flowing in the background.
+ */
+static int logs_page_size = DEFAULT_LOGS_PAGE_SIZE;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    while((option = getopt(argc, argv, "n:p:l:")) != -1) {
+        switch(option) {
+            case 'n' : commands_nb = atol(optarg); break;
+            case 'p' : period_us = atol(optarg); break;
+            case 'l' : logs_page_size = atoi(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-n commands] [-p period_us] [-l logs_page_bytes]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(commands_nb <= 0 || logs_page_size < 0 || logs_page_size > 0xFFFD) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+    if(FRAME_POOL_create() == -1 || PILOT_create() == -1 || DISPATCHER_create() == -1 || POSTMAN_create() == -1
+        || PILOT_start() == -1 || DISPATCHER_start() == -1 || POSTMAN_start() == -1) {
+        fprintf(stderr, "SB_C modules failed to start.\n");
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_in server = {.sin_family = AF_INET, .sin_port = htons(SERVER_PORT)};
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    operator_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if(connect(operator_socket, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        return EXIT_FAILURE;
+    }
+    int teleop_client = socket(AF_INET, SOCK_DGRAM, 0);
+    server.sin_port = htons(CONFIG_POSTMAN_TELEOP_PORT);
+    if(connect(teleop_client, (struct sockaddr *) &server, sizeof(server)) == -1) {
+        perror("connect");
+        return EXIT_FAILURE;
+    }
+    usleep(100000); /* Lets the postman accept the operator. */
+    DISPATCHER_start_reading(); /* What controller_core does once connected. */
+    /* What an up-to-date SB_IHM announces with its first ASK_AVAILABILITY. */
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_TELEOP_UDP);
+
+    pthread_t flooder, reader;
+    pthread_create(&reader, NULL, BENCH_read_slowly, NULL);
+    if(logs_page_size > 0) {
+        pthread_create(&flooder, NULL, BENCH_flood_logs, NULL);
+    }
+    usleep(200000); /* Lets the log traffic fill the queues. */
+
+    printf("commands %ld\n", commands_nb);
+    printf("logs_page_bytes %d\n", logs_page_size);
+    BENCH_measure("tcp", operator_socket, -1);
+    BENCH_measure("udp", -1, teleop_client);
+
+    /* Outdated commands must never reach the motors. */
+    pthread_mutex_lock(&motor_mutex);
+    unsigned long orders_before = motor_orders;
+    pthread_mutex_unlock(&motor_mutex);
+    for(uint32_t i = 0; i < STALE_COMMANDS; i++) {
+        BENCH_send_teleop(teleop_client, i, (Command) (i % STOP), 0);
+    }
+    usleep(100000);
+    pthread_mutex_lock(&motor_mutex);
+    printf("udp_stale_applied %lu\n", motor_orders - orders_before);
+    orders_before = motor_orders;
+    pthread_mutex_unlock(&motor_mutex);
+
+    /* Neither must commands held back in the network, even with a newer sequence. */
+    for(uint32_t i = 0; i < STALE_COMMANDS; i++) {
+        BENCH_send_teleop(teleop_client, (1u << 30) + i, (Command) (i % STOP), 2 * CONFIG_POSTMAN_TELEOP_MAX_AGE_MS);
+    }
+    usleep(100000);
+    pthread_mutex_lock(&motor_mutex);
+    printf("udp_late_applied %lu\n", motor_orders - orders_before);
+    pthread_mutex_unlock(&motor_mutex);
+
+    is_running = 0;
+    if(logs_page_size > 0) {
+        pthread_join(flooder, NULL);
+    }
+    shutdown(operator_socket, SHUT_RDWR);
+    pthread_join(reader, NULL);
+    close(teleop_client);
+    close(operator_socket);
+    POSTMAN_stop();
+    DISPATCHER_stop();
+    PILOT_stop();
+    POSTMAN_destroy();
+    DISPATCHER_destroy();
+    PILOT_destroy();
+    FRAME_POOL_destroy();
+    return EXIT_SUCCESS;
+}
+
+int MOTOR_create(void) {
+    return 0;
+}
+
+int MOTOR_destroy(void) {
+    return 0;
+}
+
+void MOTOR_set_velocity(Command cmd) {
+    pthread_mutex_lock(&motor_mutex);
+    motor_order_time = BENCH_now();
+    motor_orders++;
+    pthread_cond_signal(&motor_driven);
+    pthread_mutex_unlock(&motor_mutex);
+}
+
+int RADAR_create() {
+    return 0;
+}
+
+int RADAR_destroy() {
+    return 0;
+}
+
+int RADAR_get_radar(bool_e * obstacle_state) {
+    *obstacle_state = FALSE;
+    return 0;
+}
+
+int STATE_INDICATOR_set_state(State state) {
+    return 0;
+}
+
+int GUI_SECRETARY_PROXY_set_radar(Id_Robot id_robot, bool_e radar) {
+    return 0;
+}
+
+int CONTROLLER_RINGER_ask_availability(int id_robot) {
+    return 0;
+}
+
+int CAMERA_set_up_ihm_info(char * ip_address, uint16_t port) {
+    return 0;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static uint64_t BENCH_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+static void * BENCH_flood_logs(void * arg) {
+    while(is_running) {
+        uint8_t * frame = FRAME_POOL_new_frame(SET_LOGS, (uint16_t) logs_page_size);
+        if(frame == NULL) {
+            fprintf(stderr, "FRAME_POOL_new_frame() failed.\n");
+            exit(EXIT_FAILURE);
+        }
+        memset(frame + FRAME_POOL_HEAD_SIZE, 'L', logs_page_size);
+        if(POSTMAN_send_request(frame) == -1) {
+            FRAME_POOL_release(frame);
+        }
+        usleep(100);
+    }
+    return NULL;
+}
+
+static void * BENCH_read_slowly(void * arg) {
+    static uint8_t buffer[READ_CHUNK];
+    while(read(operator_socket, buffer, sizeof(buffer)) > 0) {
+        usleep(1000);
+    }
+    return NULL;
+}
+
+static void BENCH_send_teleop(int teleop_client, uint32_t sequence, Command command, uint32_t delay_ms) {
+    uint32_t timestamp = (uint32_t) (BENCH_now() / 1000000) - delay_ms;
+    uint8_t datagram[13] = {
+        0x00, 11, 0x00, ASK_CMD >> 8,
+        sequence >> 24, sequence >> 16, sequence >> 8, sequence,
+        timestamp >> 24, timestamp >> 16, timestamp >> 8, timestamp,
+        command
+    };
+    if(send(teleop_client, datagram, sizeof(datagram), 0) == -1) {
+        perror("send");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void BENCH_measure(const char * channel, int tcp_client, int teleop_client) {
+    static uint32_t sequence = 1u << 16; /* Above the outdated commands sent at the end. */
+    uint64_t * delays = malloc(commands_nb * sizeof(uint64_t));
+    long measured = 0;
+    long lost = 0;
+    for(long i = 0; i < commands_nb; i++) {
+        Command command = (i % 2) ? RIGHT : LEFT; /* Turns only : forward would start the radar checks. */
+        pthread_mutex_lock(&motor_mutex);
+        unsigned long orders = motor_orders;
+        pthread_mutex_unlock(&motor_mutex);
+        uint64_t sent_time = BENCH_now();
+        if(teleop_client != -1) {
+            BENCH_send_teleop(teleop_client, sequence++, command, 0);
+        }
+        else {
+            uint8_t frame[5] = {0x00, 3, 0x00, ASK_CMD >> 8, command};
+            if(write(tcp_client, frame, sizeof(frame)) != sizeof(frame)) {
+                perror("write");
+                exit(EXIT_FAILURE);
+            }
+        }
+        struct timespec time_out;
+        clock_gettime(CLOCK_REALTIME, &time_out);
+        time_out.tv_sec += COMMAND_TIME_OUT_S;
+        pthread_mutex_lock(&motor_mutex);
+        int error = 0;
+        while(motor_orders == orders && error != ETIMEDOUT) {
+            error = pthread_cond_timedwait(&motor_driven, &motor_mutex, &time_out);
+        }
+        if(motor_orders != orders) {
+            delays[measured++] = motor_order_time - sent_time;
+        }
+        else {
+            lost++;
+        }
+        pthread_mutex_unlock(&motor_mutex);
+        usleep(period_us);
+    }
+    qsort(delays, measured, sizeof(uint64_t), BENCH_compare);
+    if(measured > 0) {
+        printf("%s_p50_us %.1f\n", channel, delays[measured / 2] / 1e3);
+        printf("%s_p99_us %.1f\n", channel, delays[measured * 99 / 100] / 1e3);
+        printf("%s_max_us %.1f\n", channel, delays[measured - 1] / 1e3);
+    }
+    printf("%s_lost %ld\n", channel, lost);
+    free(delays);
+}
+
+static int BENCH_compare(const void * a, const void * b) {
+    uint64_t first = *(const uint64_t *) a;
+    uint64_t second = *(const uint64_t *) b;
+    return (first > second) - (first < second);
+}
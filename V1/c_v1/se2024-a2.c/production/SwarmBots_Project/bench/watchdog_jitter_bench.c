@@ -0,0 +1,315 @@
+/**
+ * \file  watchdog_jitter_bench.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Periods of a watchdog sending its event to an actor, as the radar check of the pilot, every core busy with a
+ * spinning thread : jitter of the periods and drift of the last expiry, both from the first expiry. The watchdog is started again
+ * by the action handling each event, as the pilot and the leds used to do, or started once with
+ * watchdog_start_periodic().
+ *   ../bin/watchdog_jitter_bench.elf                      a period of 10 ms, 1000 periods, both modes
+ *   ../bin/watchdog_jitter_bench.elf -m periodic -l 0     periodic only, without load
+ *
+ * \see ../src/lib/watchdog.c
+ * \copyright Prose A2 2023
+ */
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include "lib/actor.h"
+#include "lib/watchdog.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def MSG_COUNT
+ * Messages held by the mailbox of the actor, as for the pilot.
+ */
+#define MSG_COUNT 10
+/**
+ * \def MAX_LOADS
+ * Most threads spinning.
+ */
+#define MAX_LOADS 64
+/* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/**
+ * \enum Bench_State
+ * \brief States of the actor.
+ */
+typedef enum {
+    S_FORGET = ACTOR_FORGET,
+    S_RUNNING,
+    S_DEATH,
+    S_NB,
+} Bench_State;
+/**
+ * \enum Bench_Event_Id
+ * \brief Events of the actor.
+ */
+typedef enum {
+    E_TIME_OUT = 0,
+    E_STOP,
+    E_NB,
+} Bench_Event_Id;
+/**
+ * \enum Bench_Action
+ * \brief Actions of the actor.
+ */
+typedef enum {
+    A_NOP = 0,
+    A_CHECK,
+} Bench_Action;
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Bench_Msg
+ * \brief Event of the size of the messages of the pilot.
+ */
+typedef struct {
+    Bench_Event_Id event;  /**< Event of the state machine. */
+    uint8_t data[12];      /**< Rest of the event. */
+} Bench_Msg;
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static int BENCH_run(const char * mode)
+ * \brief Runs the periods of the watchdog in the given mode and prints the measures.
+ * \return 0 on success, -1 on error.
+ */
+static int BENCH_run(const char * mode);
+/**
+ * \fn static int BENCH_perform(int action, void * msg)
+ * \brief Action of the actor : stamps the expiry, works as long as a radar read, then starts the watchdog again in
+ * the rearm mode.
+ */
+static int BENCH_perform(int action, void * msg);
+/**
+ * \fn static void * BENCH_load(void * arg)
+ * \brief Thread spinning while is_loaded.
+ */
+static void * BENCH_load(void * arg);
+/**
+ * \fn static int BENCH_compare(const void * a, const void * b)
+ * \brief Orders the jitters for qsort().
+ */
+static int BENCH_compare(const void * a, const void * b);
+/**
+ * \fn static uint64_t BENCH_now(void)
+ * \brief Reads the monotonic clock, in nanoseconds.
+ */
+static uint64_t BENCH_now(void);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static const Actor_Transition state_machine[S_NB - 1][E_NB]
+ * \brief State machine of the actor.
+ */
+static const Actor_Transition state_machine[S_NB - 1][E_NB] = {
+    [S_RUNNING][E_TIME_OUT] = {S_RUNNING, A_CHECK},
+    [S_RUNNING][E_STOP] = {S_DEATH, A_NOP},
+};
+/**
+ * \var static const Actor_Descriptor descriptor
+ * \brief Descriptor of the actor.
+ */
+static const Actor_Descriptor descriptor = {
+    .name = "bench_radar",
+    .mailbox_name = "/bench_radar",
+    .msg_size = sizeof(Bench_Msg),
+    .msg_count = MSG_COUNT,
+    .priorities_nb = 1,
+    .mailbox_kind = MAILBOX_RING,
+    .state_machine = &state_machine[0][0],
+    .states_nb = S_NB,
+    .events_nb = E_NB,
+    .event_offset = offsetof(Bench_Msg, event),
+    .initial_state = S_RUNNING,
+    .initial_action = A_NOP,
+    .perform = BENCH_perform,
+    .run = NULL,
+    .is_logged = FALSE,
+};
+/**
+ * \var static watchdog_t * watchdog
+ * \brief Watchdog measured.
+ */
+static watchdog_t * watchdog;
+/**
+ * \var static bool_e is_rearmed
+ * \brief TRUE when the action starts the watchdog again.
+ */
+static bool_e is_rearmed;
+/**
+ * \var static uint64_t * expiries
+ * \brief Times the events were handled, written by the actor only.
+ */
+static uint64_t * expiries;
+/**
+ * \var static long measured
+ * \brief Events handled.
+ */
+static long measured;
+/**
+ * \var static bool_e is_loaded
+ * \brief TRUE while the load threads spin.
+ */
+static bool_e is_loaded;
+/**
+ * \var static long period
+ * \brief Delay of the watchdog, in milliseconds.
+ */
+static long period = 10;
+/**
+ * \var static long periods_nb
+ * \brief Periods measured.
+ */
+static long periods_nb = 1000;
+/**
+ * \var static long work
+ * \brief Time spent by the action on each event, in microseconds.
+ */
+static long work = 200;
+/**
+ * \var static long loads_nb
+ * \brief Threads spinning during the measure, one per core by default.
+ */
+static long loads_nb = -1;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int main(int argc, char * argv[]) {
+    int option;
+    const char * mode = NULL;
+    while((option = getopt(argc, argv, "m:p:n:w:l:")) != -1) {
+        switch(option) {
+            case 'm' : mode = optarg; break;
+            case 'p' : period = atol(optarg); break;
+            case 'n' : periods_nb = atol(optarg); break;
+            case 'w' : work = atol(optarg); break;
+            case 'l' : loads_nb = atol(optarg); break;
+            default :
+                fprintf(stderr, "usage: %s [-m rearm|periodic] [-p period_ms] [-n periods] [-w work_us] [-l loads]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if(loads_nb == -1) {
+        loads_nb = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if(period <= 0 || periods_nb < 2 || work < 0 || loads_nb < 0 || loads_nb > MAX_LOADS
+       || (mode != NULL && strcmp(mode, "rearm") != 0 && strcmp(mode, "periodic") != 0)) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+    if((mode == NULL || strcmp(mode, "rearm") == 0) && BENCH_run("rearm") == -1) {
+        return EXIT_FAILURE;
+    }
+    if((mode == NULL || strcmp(mode, "periodic") == 0) && BENCH_run("periodic") == -1) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static int BENCH_run(const char * mode) {
+    is_rearmed = strcmp(mode, "rearm") == 0 ? TRUE : FALSE;
+    expiries = malloc((size_t) periods_nb * sizeof(uint64_t));
+    __atomic_store_n(&measured, 0, __ATOMIC_SEQ_CST);
+    Actor * actor = ACTOR_create(&descriptor);
+    Bench_Msg msg = {.event = E_TIME_OUT};
+    if(expiries == NULL || actor == NULL || (watchdog = watchdog_create_event((unsigned int) period, actor, &msg)) == NULL
+       || ACTOR_start(actor) == -1) {
+        fprintf(stderr, "ACTOR_create, watchdog_create_event or ACTOR_start failed.\n");
+        return -1;
+    }
+    pthread_t loads[MAX_LOADS];
+    __atomic_store_n(&is_loaded, TRUE, __ATOMIC_RELAXED);
+    for(long load = 0; load < loads_nb; load++) {
+        pthread_create(&loads[load], NULL, BENCH_load, NULL);
+    }
+
+    uint64_t start = BENCH_now();
+    if(is_rearmed) {
+        watchdog_start(watchdog);
+    }
+    else {
+        watchdog_start_periodic(watchdog);
+    }
+    while(__atomic_load_n(&measured, __ATOMIC_ACQUIRE) < periods_nb) {
+        usleep(1000);
+    }
+    watchdog_cancel(watchdog);
+    __atomic_store_n(&is_loaded, FALSE, __ATOMIC_RELAXED);
+    for(long load = 0; load < loads_nb; load++) {
+        pthread_join(loads[load], NULL);
+    }
+    Bench_Msg stop = {.event = E_STOP};
+    ACTOR_send(actor, &stop, 0);
+    ACTOR_join(actor);
+    watchdog_destroy(watchdog);
+    ACTOR_destroy(actor);
+
+    /* From the first expiry : the first deadline is rounded up to a tick of the wheel. */
+    long gaps_nb = periods_nb - 1;
+    uint64_t period_ns = (uint64_t) period * 1000000;
+    uint64_t * jitters = malloc((size_t) gaps_nb * sizeof(uint64_t));
+    if(jitters == NULL) {
+        return -1;
+    }
+    for(long id = 0; id < gaps_nb; id++) {
+        int64_t gap = (int64_t) (expiries[id + 1] - expiries[id]) - (int64_t) period_ns;
+        jitters[id] = (uint64_t) (gap < 0 ? -gap : gap);
+    }
+    int64_t drift = (int64_t) (expiries[gaps_nb] - expiries[0]) - (int64_t) (gaps_nb * period_ns);
+    qsort(jitters, (size_t) gaps_nb, sizeof(uint64_t), BENCH_compare);
+    printf("mode %s\n", mode);
+    printf("period_ms %ld\n", period);
+    printf("periods %ld\n", periods_nb);
+    printf("loads %ld\n", loads_nb);
+    printf("first_expiry_ms %.3f\n", (expiries[0] - start) / 1e6);
+    printf("period_mean_us %.2f\n", (expiries[gaps_nb] - expiries[0]) / 1e3 / gaps_nb);
+    printf("jitter_p50_us %.2f\n", jitters[gaps_nb / 2] / 1e3);
+    printf("jitter_p99_us %.2f\n", jitters[gaps_nb * 99 / 100] / 1e3);
+    printf("jitter_max_us %.2f\n", jitters[gaps_nb - 1] / 1e3);
+    printf("drift_ms %.3f\n\n", drift / 1e6);
+    free(jitters);
+    free(expiries);
+    return 0;
+}
+
+static int BENCH_perform(int action, void * msg) {
+    if(action != A_CHECK) {
+        return 0;
+    }
+    long id = __atomic_load_n(&measured, __ATOMIC_RELAXED);
+    if(id >= periods_nb) {
+        return 0;
+    }
+    expiries[id] = BENCH_now();
+    /* The read of the radar. */
+    uint64_t end = expiries[id] + (uint64_t) work * 1000;
+    while(BENCH_now() < end) {
+    }
+    if(is_rearmed) {
+        watchdog_start(watchdog);
+    }
+    __atomic_store_n(&measured, id + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+static void * BENCH_load(void * arg) {
+    volatile unsigned long spins = 0;
+    while(__atomic_load_n(&is_loaded, __ATOMIC_RELAXED)) {
+        spins++;
+    }
+    return NULL;
+}
+
+static int BENCH_compare(const void * a, const void * b) {
+    uint64_t first = *(const uint64_t *) a;
+    uint64_t second = *(const uint64_t *) b;
+    return (first > second) - (first < second);
+}
+
+static uint64_t BENCH_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
@@ -40,14 +40,13 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
-#include <pthread.h>
-#include <mqueue.h>
 #include <stdbool.h>
-#include <errno.h>
-#include <sys/stat.h>
 
 #include "camera.h"
+#include "../lib/actor.h"
+#include "../config.h"
 #include "../logs/controller_logger.h"
 #include <gst/gst.h>
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
@@ -100,23 +99,16 @@ typedef enum {
     A_SET_INFO,
     A_START_STREAMING,
     A_STOP_STREAMING,
+    A_CHANGE_INFO,
     ACTION_NB
 } action_e ;
-/**
- * \struct transition_t
- * \brief Contains the dest_state and the action to perform. It is used to switch state inside the module.
- */
-typedef struct {
-    mae_state_e dest_state;
-    action_e action;
-} transition_t;
 /**
  * \struct mq_msg_data_t
  * \brief Contains the data that can be passed through the message.
  */
 typedef struct {
     event_e event;
-    char * ip_address;
+    char ip_address[16];
     uint16_t port;
 } mq_msg_data_t;
 /**
@@ -136,14 +128,6 @@ typedef int (*action_ptr)(mq_msg *msg);
 /* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
 /* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
-/**
- * \fn static int CAMERA_get_msg_from_queue(mq_msg * msg)
- * \brief gets the last message of the queue
- * \author Louison LEGROS
- * \param msg [out] message received from the queue
- * \return int error code, 0 if successfull, -1 if unable to access the queue
- */
-static int CAMERA_get_msg_from_queue(mq_msg * msg);
 /**
  * \fn static int CAMERA_add_msg_to_queue(mq_msg * msg)
  * \brief adds a new message on top of the queue
@@ -154,13 +138,16 @@ static int CAMERA_get_msg_from_queue(mq_msg * msg);
  */
 static int CAMERA_add_msg_to_queue(mq_msg * msg);
 /**
- * \fn static void * CAMERA_run()
- * \brief running function that runs the state machine
- * \author Louison LEGROS
+ * \fn static int CAMERA_perform(int action, void * msg)
+ * \brief Performs an action of the state machine for the actor of the module.
+ * \author Prose A2
  *
- * \return void* value used by the thread that joins this thread
+ * \param action : action to perform.
+ * \param msg : message that triggered the action.
+ *
+ * \return On success, returns 0. On error, returns -1.
  */
-static void * CAMERA_run(void * arg);
+static int CAMERA_perform(int action, void * msg);
 /**
  * \fn static int CAMERA_no_operation(mq_msg * msg)
  * \brief For transitions without action needed.
@@ -201,17 +188,22 @@ static int CAMERA_stop_streaming(mq_msg * msg);
  * \return On success, returns 0. On error, returns -1.
  */
 static int CAMERA_set_ihm_info(mq_msg * msg);
-/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
- * \var camera_thread
- * \brief Thread used by the module to execute the run method.
+ * \fn static int CAMERA_change_ihm_info(mq_msg * msg)
+ * \brief Points the running stream to a new destination. The pipeline is kept when the destination is the same.
+ * \author Prose A2
+ *
+ * \param msg data structure pushed by the trigger event.
+ *
+ * \return On success, returns 0. On error, returns -1.
  */
-static pthread_t camera_thread;
+static int CAMERA_change_ihm_info(mq_msg * msg);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
- * \var camera_message_queue
- * \brief Message queue used by the module to handle events and manage module state machine.
+ * \var camera_actor
+ * \brief Actor running the state machine of the module on the events of its mailbox.
  */
-static mqd_t camera_message_queue;
+static Actor * camera_actor;
 /**
  * \var *pipeline
  * \brief Pipeline used by gstreamer to handle the camera stream.
@@ -227,9 +219,10 @@ char *pipeline_string;
  * \brief Struct describing the machine state of the module
  */
 
-static transition_t camera_state_machine [S_NB-1][E_NB] =
+static const Actor_Transition camera_state_machine [S_NB-1][E_NB] =
         {
                 [S_WAITING_INFO] [E_SET_IHM_INFO]   = {S_ON,            A_SET_INFO},
+                [S_ON]  [E_SET_IHM_INFO]            = {S_ON,            A_CHANGE_INFO},
                 [S_OFF] [E_DISCONNECT_CAMERA]       = {S_WAITING_INFO,  A_NOP},
                 [S_ON]  [E_DISCONNECT_CAMERA]       = {S_WAITING_INFO,  A_STOP_STREAMING},
                 [S_OFF] [E_ENABLE_CAMERA]           = {S_ON,            A_START_STREAMING},
@@ -248,6 +241,27 @@ static const action_ptr actions_tab[ACTION_NB] = {
     &CAMERA_set_ihm_info,
     &CAMERA_start_streaming,
     &CAMERA_stop_streaming,
+    &CAMERA_change_ihm_info,
+};
+/**
+ * \var camera_descriptor
+ * \brief Mailbox and state machine of the camera actor.
+ */
+static const Actor_Descriptor camera_descriptor = {
+    .name = "camera",
+    .mailbox_name = NAME_MQ_BOX,
+    .msg_size = sizeof(mq_msg),
+    .msg_count = MQ_MSG_COUNT,
+    .priorities_nb = 1,
+    .mailbox_kind = CONFIG_MAILBOX_CAMERA,
+    .state_machine = &camera_state_machine[0][0],
+    .states_nb = S_NB,
+    .events_nb = E_NB,
+    .event_offset = offsetof(mq_msg_data_t, event),
+    .initial_state = S_WAITING_INFO,
+    .initial_action = A_NOP,
+    .perform = CAMERA_perform,
+    .is_logged = TRUE
 };
 /**
  * \var gui_ip
@@ -267,22 +281,9 @@ extern int CAMERA_create(void) {
     int size = snprintf(NULL, 0, PIPELINE_DESCRIPTION, gui_ip, gui_port);
     pipeline_string = (char *)malloc((size + 1) * sizeof(char));
 
-    struct mq_attr mq_a = {
-            .mq_maxmsg = MQ_MSG_COUNT,
-            .mq_msgsize = sizeof(mq_msg),
-            .mq_flags = 0,
-    };
-    if((camera_message_queue = mq_open(NAME_MQ_BOX, O_CREAT | O_RDWR | O_EXCL , 0644 ,&mq_a )) == -1 ) {
-        if(errno == EEXIST) {
-            mq_unlink(NAME_MQ_BOX);
-            if((camera_message_queue = mq_open(NAME_MQ_BOX, O_CREAT | O_RDWR , 0644 ,&mq_a )) == -1 ) {
-                CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for camera after unlinking the mq.");
-                goto error_mq;
-            }
-        } else {
-            CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for camera.");
-            goto error_mq;
-        }
+    if((camera_actor = ACTOR_create(&camera_descriptor)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_create(): actor failed to be created for camera.");
+        goto error_mq;
     }
     return 0;
 
@@ -292,14 +293,8 @@ extern int CAMERA_create(void) {
 }
 
 extern int CAMERA_destroy(void) {
-    if(mq_close(camera_message_queue) == -1)
-    {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_close(): error while closing the mq of camera.");
-        return -1;
-    }
-    if(mq_unlink(NAME_MQ_BOX) == -1)
-    {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_unlink(): error while unlinking the mq of camera.");
+    if(ACTOR_destroy(camera_actor) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_destroy(): error while destroying the actor of camera.");
         return -1;
     }
 
@@ -309,8 +304,8 @@ extern int CAMERA_destroy(void) {
 }
 
 extern int CAMERA_start(void) {
-    if(pthread_create(&camera_thread, NULL, CAMERA_run, NULL) != 0) {
-        CONTROLLER_LOGGER_log(ERROR, "On pthread_create() : error while creating camera thread.");
+    if(ACTOR_start(camera_actor) != 0) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_start() : error while starting camera actor.");
         return -1;
     }
     return 0;
@@ -319,8 +314,8 @@ extern int CAMERA_start(void) {
 extern int CAMERA_stop(void) {
     mq_msg msg = {.data.event = E_STOP};
     if(CAMERA_add_msg_to_queue(&msg) == 0) {
-        if(pthread_join(camera_thread, NULL) != 0) {
-            CONTROLLER_LOGGER_log(ERROR, "On pthread_join(): error while waiting the termination of camera thread.");
+        if(ACTOR_join(camera_actor) != 0) {
+            CONTROLLER_LOGGER_log(ERROR, "On ACTOR_join(): error while waiting the termination of camera actor.");
             return -1;
         }
     }
@@ -331,7 +326,7 @@ extern int CAMERA_stop(void) {
 }
 
 extern int CAMERA_enable_camera(void) {
-    mq_msg msg = {.data.event = E_ENABLE_CAMERA, .data.ip_address = NULL, .data.port = 0};
+    mq_msg msg = {.data.event = E_ENABLE_CAMERA, .data.port = 0};
     if(CAMERA_add_msg_to_queue(&msg) == -1) {
         return -1;
     }
@@ -339,7 +334,7 @@ extern int CAMERA_enable_camera(void) {
 }
 
 extern int CAMERA_disable_camera(void) {
-    mq_msg msg = {.data.event = E_DISABLE_CAMERA, .data.ip_address = NULL, .data.port = 0};
+    mq_msg msg = {.data.event = E_DISABLE_CAMERA, .data.port = 0};
     if(CAMERA_add_msg_to_queue(&msg) == -1) {
         return -1;
     }
@@ -347,7 +342,9 @@ extern int CAMERA_disable_camera(void) {
 }
 
 extern int CAMERA_set_up_ihm_info(char * ip_address, uint16_t port) {
-    mq_msg msg = {.data.event = E_SET_IHM_INFO, .data.ip_address = ip_address, .data.port = port};
+    mq_msg msg = {.data.event = E_SET_IHM_INFO, .data.port = port};
+    /* The address is copied : the caller may reuse its buffer before the camera thread reads the message. */
+    snprintf(msg.data.ip_address, sizeof(msg.data.ip_address), "%s", ip_address);
     if(CAMERA_add_msg_to_queue(&msg) == -1) {
         return -1;
     }
@@ -355,48 +352,23 @@ extern int CAMERA_set_up_ihm_info(char * ip_address, uint16_t port) {
 }
 
 extern int CAMERA_disconnect_camera(void) {
-    mq_msg msg = {.data.event = E_DISCONNECT_CAMERA, .data.ip_address = NULL, .data.port = 0};
+    mq_msg msg = {.data.event = E_DISCONNECT_CAMERA, .data.port = 0};
     if(CAMERA_add_msg_to_queue(&msg) == -1) {
         return -1;
     }
     return 0;
 }
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
-static int CAMERA_get_msg_from_queue(mq_msg * msg) {
-    if(mq_receive(camera_message_queue, msg->buffer, sizeof(mq_msg), NULL) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_receive(): CAMERA has failed to receive a message on the mq.");
-        return -1;
-    }
-    return 0;
-}
-
 static int CAMERA_add_msg_to_queue(mq_msg * msg) {
-    if(mq_send(camera_message_queue, msg->buffer, sizeof(mq_msg), 0) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_send(): CAMERA has failed to receive a message on the mq.");
+    if(ACTOR_send(camera_actor, msg->buffer, 0) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_send(): CAMERA has failed to send a message on the mailbox.");
         return -1;
     }
     return 0;
 }
 
-static void* CAMERA_run(void * arg){
-    mq_msg msg;
-    mae_state_e mae_state = S_WAITING_INFO;
-    transition_t * current_transition;
-
-    while (mae_state != S_DEATH) {
-        if(CAMERA_get_msg_from_queue(&msg) == -1) {
-            return NULL;
-        }
-        current_transition = &camera_state_machine[mae_state][msg.data.event];
-        if (current_transition->dest_state != S_FORGET) {
-            if (actions_tab[current_transition->action](&msg) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action for CAMERA.");
-                return NULL;
-            }
-            mae_state = current_transition->dest_state;
-        }
-    }
-    return NULL;
+static int CAMERA_perform(int action, void * msg) {
+    return actions_tab[action]((mq_msg *) msg);
 }
 
 static int CAMERA_no_operation(mq_msg * msg) {
@@ -439,12 +411,23 @@ static int CAMERA_set_ihm_info(mq_msg * msg) {
     sprintf(gui_port, "%u", msg->data.port);
     sprintf(pipeline_string, PIPELINE_DESCRIPTION, gui_ip, gui_port);
 
-    char log_msg[100];
-    sprintf(log_msg, "CAMERA : ihm info setup with ip = %s, port = %s", gui_ip, gui_port);
-    CONTROLLER_LOGGER_log(DEBUG, log_msg);
+    CONTROLLER_LOGGER_LOG(DEBUG, "CAMERA : ihm info setup with ip = %s, port = %s", gui_ip, gui_port);
 
     if(CAMERA_start_streaming(NULL) == -1) {
         return -1;
     }
     return 0;
-}
\ No newline at end of file
+}
+
+static int CAMERA_change_ihm_info(mq_msg * msg) {
+    char port[sizeof(gui_port)];
+    sprintf(port, "%u", msg->data.port);
+    if(strcmp(gui_ip, msg->data.ip_address) == 0 && strcmp(gui_port, port) == 0) {
+        CONTROLLER_LOGGER_log(DEBUG, "CAMERA : same ihm info, the stream goes on.");
+        return 0;
+    }
+    if(CAMERA_stop_streaming(NULL) == -1) {
+        return -1;
+    }
+    return CAMERA_set_ihm_info(msg);
+}
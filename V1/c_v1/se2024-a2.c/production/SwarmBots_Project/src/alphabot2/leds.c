@@ -39,13 +39,11 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <unistd.h>
-#include <pthread.h>
-#include <mqueue.h>
 #include <stdbool.h>
-#include <errno.h>
-#include <sys/stat.h>
 
 #include "../lib/defs.h"
+#include "../lib/actor.h"
+#include "../config.h"
 #include "leds.h"
 #include "../lib/watchdog.h"
 #include "../logs/controller_logger.h"
@@ -121,18 +119,11 @@ typedef enum {
     A_CHANGE_COLOR,
     A_CHECK_COLOR,
     A_STOP_BLINK,
+    A_START_BLINK,
     A_BLINK_SET_ON,
     A_BLINK_SET_OFF,
     ACTION_NB
 } action_e ;
-/**
- * \struct transition_t
- * \brief Contains the dest_state and the action to perform. It is used to switch state inside the module.
- */
-typedef struct {
-    mae_state_e dest_state;
-    action_e action;
-} transition_t;
 /**
  * \struct mq_msg_data_t
  * \brief Contains the data that can be passed through the message.
@@ -156,16 +147,6 @@ typedef union {
  */
 typedef int (*action_ptr)(mq_msg *msg);
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
-/**
- * \fn static int LEDS_add_msg_to_queue(mq_msg* msg)
- * \brief gets a new message from the message queue
- * \author Louison LEGROS
- * 
- * \param msg [out] message received from the queue
- * 
- * \return On success, returns 0. On error, returns -1.
- */
-static int LEDS_get_msg_from_queue(mq_msg * msg);
 /**
  * \fn static int LEDS_add_msg_to_queue(mq_msg* msg)
  * \brief adds a new message on top of the queue
@@ -177,13 +158,16 @@ static int LEDS_get_msg_from_queue(mq_msg * msg);
  */
 static int LEDS_add_msg_to_queue(mq_msg * msg);
 /**
- * \fn static void* LEDS_run(void* param)
- * \brief Blocking function running machine state of the module
- * \author Louison LEGROS
+ * \fn static int LEDS_perform(int action, void * msg)
+ * \brief Performs an action of the state machine for the actor of the module.
+ * \author Prose A2
+ *
+ * \param action : action to perform.
+ * \param msg : message that triggered the action.
  *
- * \param param: to be used if needed
+ * \return On success, returns 0. On error, returns -1.
  */
-static void * LEDS_run(void* param);
+static int LEDS_perform(int action, void * msg);
 /**
  * \fn static int LEDS_action_nop(mq_msg * msg)
  * \brief For transitions without action needed.
@@ -224,6 +208,16 @@ static int LEDS_action_check_color(mq_msg * msg);
  * \return On success, returns 0. On error, returns -1.
  */
 static int LEDS_action_stop_blinking(mq_msg * msg);
+/**
+ * \fn static int LEDS_action_start_blinking(mq_msg * msg)
+ * \brief Starts the blinking of the led, set to on, with the periodic watchdog toggling it.
+ * \author Prose A2
+ *
+ * \param msg : data structure pushed by the trigger event.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int LEDS_action_start_blinking(mq_msg * msg);
 /**
  * \fn static int LEDS_action_blink_set_on(mq_msg * msg)
  * \brief Sets the blinking of the led to on.
@@ -260,14 +254,6 @@ static int LEDS_render(void);
  * \return On success, returns 0. On error, returns -1.
  */
 static int LEDS_render_no_color(void);
-/**
- * \fn static int LEDS_action_blinking_time_out(mq_msg * msg)
- * \brief Callback function called when the blinking time out is reached.
- * \author Louison LEGROS
- * 
- * \param watchdog : watchdog used to trigger the radar check
- */
-static void LEDS_blinking_time_out(watchdog_t * watchdog);
 /**
  * \fn static void LEDS_change_current_color(id_led_t id_led, color_e color)
  * \brief Changes the current color of the led.
@@ -279,27 +265,22 @@ static void LEDS_blinking_time_out(watchdog_t * watchdog);
 static void LEDS_change_current_color(id_led_t id_led, color_e color);
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
- * \var leds_thread
- * \brief Thread used by the module to execute the run method.
- */
-static pthread_t leds_thread;
-/**
- * \var leds_message_queue
- * \brief Message queue used by the module to handle events and manage module state machine.
+ * \var leds_actor
+ * \brief Actor running the state machine of the module on the events of its mailbox.
  */
-static mqd_t leds_message_queue;
+static Actor * leds_actor;
 /**
  * \var led_blink_watchdog
- * \brief watchdog used to notify the end of the emergency state
+ * \brief periodic watchdog toggling the leds while they blink
  */
 watchdog_t *led_blink_watchdog;
 /**
  * \var leds_state_machine
  * \brief Struct describing the machine state of the module
  */
-static transition_t leds_state_machine [S_NB-1][E_NB] = {
+static const Actor_Transition leds_state_machine [S_NB-1][E_NB] = {
     [S_STILL]       [E_ASK_BLINK]       = {S_CHOICE, A_CHECK_COLOR},
-    [S_CHOICE]      [E_GO_BLINK]        = {S_BLINK_ON, A_BLINK_SET_ON},
+    [S_CHOICE]      [E_GO_BLINK]        = {S_BLINK_ON, A_START_BLINK},
     [S_CHOICE]      [E_GO_STILL]        = {S_STILL, A_NOP},
     [S_STILL]       [E_SET_COLOR]       = {S_STILL, A_CHANGE_COLOR},
     [S_BLINK_OFF]   [E_BLINK_TIME_OUT]  = {S_BLINK_ON, A_BLINK_SET_ON},
@@ -319,9 +300,30 @@ static const action_ptr actions_tab[ACTION_NB] = {
     &LEDS_action_change_color,
     &LEDS_action_check_color,
     &LEDS_action_stop_blinking,
+    &LEDS_action_start_blinking,
     &LEDS_action_blink_set_on,
     &LEDS_action_blink_set_off
 };
+/**
+ * \var leds_descriptor
+ * \brief Mailbox and state machine of the leds actor.
+ */
+static const Actor_Descriptor leds_descriptor = {
+    .name = "leds",
+    .mailbox_name = NAME_MQ_BOX,
+    .msg_size = sizeof(mq_msg),
+    .msg_count = MQ_MSG_COUNT,
+    .priorities_nb = 1,
+    .mailbox_kind = CONFIG_MAILBOX_LEDS,
+    .state_machine = &leds_state_machine[0][0],
+    .states_nb = S_NB,
+    .events_nb = E_NB,
+    .event_offset = offsetof(mq_msg_data_t, event),
+    .initial_state = S_STILL,
+    .initial_action = A_NOP,
+    .perform = LEDS_perform,
+    .is_logged = TRUE
+};
 /* Our led strip that contains our configuration and each of our leds */
 static ws2811_t led_strip =
 {
@@ -352,27 +354,20 @@ extern int LEDS_create() {
         CONTROLLER_LOGGER_log(ERROR, "On ws2811_init(&led_strip): Failed to init leds strip.");
         return -1;
     }
-    led_blink_watchdog = watchdog_create(BLINKING_TIME_OUT, LEDS_blinking_time_out);
 
-    struct mq_attr mq_a = {
-            .mq_maxmsg = MQ_MSG_COUNT,
-            .mq_msgsize = sizeof(mq_msg),
-            .mq_flags = 0,
-    };
-    if((leds_message_queue = mq_open(NAME_MQ_BOX, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR, &mq_a)) == -1 ) {
-        if(errno == EEXIST) {
-            mq_unlink(NAME_MQ_BOX);
-            if((leds_message_queue = mq_open(NAME_MQ_BOX, O_CREAT | O_RDWR , 0644 ,&mq_a )) == -1 ) {
-                CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for leds after unlinking the mq.");
-                goto error_mq;
-            }
-        } else {
-            CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for leds.");
-            goto error_mq;
-        }
+    if((leds_actor = ACTOR_create(&leds_descriptor)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_create(): actor failed to be created for leds.");
+        goto error_mq;
+    }
+    mq_msg blink_msg = {.data.event = E_BLINK_TIME_OUT, .data.id_led = 0, .data.color = 0};
+    if((led_blink_watchdog = watchdog_create_event(BLINKING_TIME_OUT, leds_actor, &blink_msg)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On watchdog_create_event(): blink watchdog failed to be created for leds.");
+        goto error_watchdog;
     }
     return 0;
 
+    error_watchdog:
+    ACTOR_destroy(leds_actor);
     error_mq:
     ws2811_fini(&led_strip);
     return-1;
@@ -381,12 +376,10 @@ extern int LEDS_create() {
 extern int LEDS_destroy(void) {
     int ret = 0;
 
-    if(mq_close(leds_message_queue) == -1 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_close(): error while closing the mq of leds.");
-        ret = -1;
-    }
-    if(mq_unlink(NAME_MQ_BOX) == -1 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_unlink(): error while unlinking the mq of leds.");
+    watchdog_destroy(led_blink_watchdog);
+
+    if(ACTOR_destroy(leds_actor) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_destroy(): error while destroying the actor of leds.");
         ret = -1;
     }
     ws2811_fini(&led_strip);
@@ -395,9 +388,9 @@ extern int LEDS_destroy(void) {
 }
 
 extern int LEDS_start(void) {
-    if(pthread_create(&leds_thread, NULL, LEDS_run, NULL) != 0)
+    if(ACTOR_start(leds_actor) != 0)
     {
-        CONTROLLER_LOGGER_log(ERROR, "On pthread_create() : error while creating leds thread.");
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_start() : error while starting leds actor.");
         return -1;
     }
     return 0;
@@ -408,8 +401,8 @@ extern int LEDS_stop(void) {
     mq_msg msg = {.data.event = E_STOP, .data.id_led = 0, .data.color = 0};
 
     if(LEDS_add_msg_to_queue(&msg) == 0) {
-        if(pthread_join(leds_thread, NULL) != 0) {
-            CONTROLLER_LOGGER_log(ERROR, "On pthread_join(): error while waiting the termination of leds thread.");
+        if(ACTOR_join(leds_actor) != 0) {
+            CONTROLLER_LOGGER_log(ERROR, "On ACTOR_join(): error while waiting the termination of leds actor.");
             ret = -1;
         }
     }
@@ -446,42 +439,18 @@ extern int LEDS_start_blinking()
     return 0;
 }
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
-static int LEDS_get_msg_from_queue(mq_msg * msg) {
-    if(mq_receive(leds_message_queue, msg->buffer, sizeof(mq_msg), NULL) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_receive(): LEDS has failed to receive a message on the mq.");
-        return -1;
-    }
-    return 0;
-}
-
 static int LEDS_add_msg_to_queue(mq_msg * msg) {
-    if(mq_send(leds_message_queue, msg->buffer, sizeof(mq_msg), 0) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_send(): LEDS has failed to send a message on the mq.");
+    if(ACTOR_send(leds_actor, msg->buffer, 0) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_send(): LEDS has failed to send a message on the mailbox.");
         return -1;
     }
     return 0;
 }
 
-static void* LEDS_run(void* param){
-    mq_msg msg;
-    transition_t * current_transition;
-    mae_state_e mae_state = S_STILL;
-
-    while (mae_state != S_DEATH) {
-        if(LEDS_get_msg_from_queue(&msg) == -1) {
-           return NULL;
-        }
-        current_transition = &leds_state_machine[mae_state][msg.data.event];
-        if (current_transition->dest_state != S_FORGET) {
-            if (actions_tab[current_transition->action](&msg) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action for LEDS.");
-                return NULL;
-            }
-            mae_state = current_transition->dest_state;
-        }
-    }
-    return NULL;
+static int LEDS_perform(int action, void * msg) {
+    return actions_tab[action]((mq_msg *) msg);
 }
+
 static int LEDS_action_nop(mq_msg * msg) {
     return 0;
 }
@@ -528,8 +497,12 @@ static int LEDS_action_stop_blinking(mq_msg * msg) {
     return 0;
 }
 
+static int LEDS_action_start_blinking(mq_msg * msg) {
+    watchdog_start_periodic(led_blink_watchdog);
+    return LEDS_action_blink_set_on(msg);
+}
+
 static int LEDS_action_blink_set_on(mq_msg * msg) {
-    watchdog_start(led_blink_watchdog);
     if(LEDS_render() == -1) {
         return -1;
     }
@@ -537,21 +510,12 @@ static int LEDS_action_blink_set_on(mq_msg * msg) {
 }
 
 static int LEDS_action_blink_set_off(mq_msg * msg) {
-    watchdog_start(led_blink_watchdog);
     if(LEDS_render_no_color() == -1) {
         return -1;
     }
     return 0;
 }
 
-static void LEDS_blinking_time_out(watchdog_t * watchdog)
-{
-    mq_msg msg = {.data.event = E_BLINK_TIME_OUT, .data.id_led = 0, .data.color = 0};
-    if(LEDS_add_msg_to_queue(&msg) != 0) {
-        CONTROLLER_LOGGER_log(ERROR, "On LEDS_add_msg_to_queue(&msg) : LEDS_check_radar_time_out callback failed to send a message to the mq.");
-    }
-}
-
 static int LEDS_render()
 {
     if(ws2811_render(&led_strip) != WS2811_SUCCESS)
@@ -0,0 +1,103 @@
+/**
+ * \file  capabilities.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Capabilities negotiated with SB_IHM. Old SB_IHM keep the protocol they know.
+ *
+ * \see capabilities.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <pthread.h>
+#include "capabilities.h"
+#include "../config.h"
+#include "../lib/protocol.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def OFFERED_CAPABILITIES
+ * Capabilities SB_C has : the teleoperation channel may be disabled at build time.
+ */
+#define OFFERED_CAPABILITIES ((uint32_t) (CONFIG_CAPABILITIES) & (CONFIG_POSTMAN_TELEOP_PORT != 0 ? ~0u : ~(uint32_t) CAPABILITY_TELEOP_UDP))
+/* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static uint8_t peer_version
+ * \brief Version of the protocol spoken by SB_IHM.
+ */
+static uint8_t peer_version = PROTOCOL_VERSION_LEGACY;
+/**
+ * \var static uint32_t enabled_capabilities
+ * \brief Capabilities of both SB_C and SB_IHM.
+ */
+static uint32_t enabled_capabilities = 0;
+/**
+ * \var static pthread_mutex_t capabilities_mutex
+ * \brief Negotiated by the dispatcher, read by the postman and the proxies.
+ */
+static pthread_mutex_t capabilities_mutex = PTHREAD_MUTEX_INITIALIZER;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+void CAPABILITIES_reset(void) {
+    pthread_mutex_lock(&capabilities_mutex);
+    peer_version = PROTOCOL_VERSION_LEGACY;
+    enabled_capabilities = 0;
+    pthread_mutex_unlock(&capabilities_mutex);
+}
+
+uint32_t CAPABILITIES_negotiate(uint8_t version, uint32_t peer_capabilities) {
+    pthread_mutex_lock(&capabilities_mutex);
+    peer_version = version;
+    /* Bits unknown to SB_C come from newer SB_IHM, they are left out. */
+    enabled_capabilities = peer_capabilities & OFFERED_CAPABILITIES;
+    uint32_t capabilities = enabled_capabilities;
+    pthread_mutex_unlock(&capabilities_mutex);
+    return capabilities;
+}
+
+uint8_t CAPABILITIES_get_peer_version(void) {
+    pthread_mutex_lock(&capabilities_mutex);
+    uint8_t version = peer_version;
+    pthread_mutex_unlock(&capabilities_mutex);
+    return version;
+}
+
+uint32_t CAPABILITIES_get_enabled(void) {
+    pthread_mutex_lock(&capabilities_mutex);
+    uint32_t capabilities = enabled_capabilities;
+    pthread_mutex_unlock(&capabilities_mutex);
+    return capabilities;
+}
+
+bool_e CAPABILITIES_is_enabled(Capability capability) {
+    return (CAPABILITIES_get_enabled() & (uint32_t) capability) ? TRUE : FALSE;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
@@ -0,0 +1,91 @@
+/**
+ * \file  capabilities.h
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Header file of the capabilities. Keeps the optional features of the protocol both SB_C and SB_IHM have.
+ *
+ * \see capabilities.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#ifndef SRC_COM_CAPABILITIES_H_
+#define SRC_COM_CAPABILITIES_H_
+/* ----------------------  INCLUDES ------------------------------------------*/
+#include <stdint.h>
+#include "../lib/defs.h"
+/* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
+/* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/* ----------------------  PUBLIC VARIABLES -----------------------------------*/
+/* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
+/**
+ * \fn extern void CAPABILITIES_reset(void)
+ * \brief Goes back to the protocol of the legacy SB_IHM : every capability is disabled until the next negotiation.
+ * \author Prose A2
+ */
+extern void CAPABILITIES_reset(void);
+/**
+ * \fn extern uint32_t CAPABILITIES_negotiate(uint8_t version, uint32_t peer_capabilities)
+ * \brief Enables the capabilities offered by both SB_C and SB_IHM.
+ * \author Prose A2
+ *
+ * \param version : version of the protocol spoken by SB_IHM.
+ * \param peer_capabilities : capability bitmap of SB_IHM.
+ *
+ * \return The capabilities enabled.
+ */
+extern uint32_t CAPABILITIES_negotiate(uint8_t version, uint32_t peer_capabilities);
+/**
+ * \fn extern uint8_t CAPABILITIES_get_peer_version(void)
+ * \brief Gives the version of the protocol spoken by SB_IHM.
+ * \author Prose A2
+ *
+ * \return The version, PROTOCOL_VERSION_LEGACY until SB_IHM has sent its capabilities.
+ */
+extern uint8_t CAPABILITIES_get_peer_version(void);
+/**
+ * \fn extern uint32_t CAPABILITIES_get_enabled(void)
+ * \brief Gives the capabilities enabled by the last negotiation.
+ * \author Prose A2
+ *
+ * \return The capability bitmap.
+ */
+extern uint32_t CAPABILITIES_get_enabled(void);
+/**
+ * \fn extern bool_e CAPABILITIES_is_enabled(Capability capability)
+ * \brief Tells if an optional feature may be used with the current SB_IHM.
+ * \author Prose A2
+ *
+ * \param capability : the feature.
+ *
+ * \return TRUE if both SB_C and SB_IHM have it, FALSE otherwise.
+ */
+extern bool_e CAPABILITIES_is_enabled(Capability capability);
+
+#endif /* SRC_COM_CAPABILITIES_H_ */
@@ -45,6 +45,8 @@
 #include <time.h>
 #include "dispatcher.h"
 #include "postman.h"
+#include "../lib/protocol.h"
+#include "capabilities.h"
 #include "../alphabot2/camera.h"
 #include "../controller/controller_ringer.h"
 #include "../controller/controller_core.h"
@@ -56,8 +58,31 @@
 typedef enum {STATE_GENERATION STATE_NB} State_Machine;
 #undef STATE_GENERATION
 #undef S
+/**
+ * \def DISPATCHER_TYPES_NB
+ * Size of the registry : one entry for each value of the high byte of a message type.
+ */
+#define DISPATCHER_TYPES_NB 256
 /* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
+/**
+ * \typedef Dispatcher_Handler
+ * \brief Handles a received message.
+ *
+ * \param payload : payload of the message, left in the receive buffer of postman.
+ * \param payload_size : size of the payload, at least the minimum declared in the registry.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+typedef int (*Dispatcher_Handler)(const uint8_t * payload, uint16_t payload_size);
 /* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Dispatcher_Entry
+ * \brief Entry of the registry for a message type.
+ */
+typedef struct {
+    Dispatcher_Handler handler; /**< Handler of the type, NULL for the types SB_IHM does not send. */
+    uint16_t min_payload_size;  /**< Shorter payloads are rejected without calling the handler. */
+} Dispatcher_Entry;
 /* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
 /**
@@ -73,34 +98,104 @@ typedef enum {STATE_GENERATION STATE_NB} State_Machine;
  */
 static void * DISPATCHER_run(void * arg);
 /**
- * \fn static void DISPATCHER_dispatch_received_msg(Communication_Protocol_Head msg)
- * \brief Used to parse the incoming msg and to dispatch and pass data to the right functions.
+ * \fn static int DISPATCHER_dispatch_received_msg(const Dispatcher_Message * msg)
+ * \brief Looks the handler of the message up in the registry, calls it with the payload and updates the statistics
+ * of the type. Unknown types and payloads too short are rejected.
  * \author Joshua MONTREUIL
  *
- * \see CONTROLLER_CORE_ask_set_state(int id_robot, State state)
- * \see CONTROLLER_CORE_ask_mode(int id_robot)
- * \see CONTROLLER_CORE_ask_set_mode(int id_robot, Operating_Mode operating_mode)
- * \see CONTROLLER_RINGER_ask_availability(int id_robot)
- * \see PILOT_ask_cmd(Command cmd)
- * \see CONTROLLER_LOGGER_ask_logs(int id_robot)
- *
- * \param msg : message received from postman's socket. Type : Communication_Protocol_Head.
- * \see Communication_Protocol_Head
+ * \param msg : message decoded from postman's socket.
+ * \see Dispatcher_Message
+ * \see dispatcher_registry
  *
- * \return On success, returns 0. On error, returns -1.
+ * \return On success or on a rejected message, returns 0. On failure of the handler, returns -1.
  */
-static int DISPATCHER_dispatch_received_msg(Communication_Protocol_Head msg);
+static int DISPATCHER_dispatch_received_msg(const Dispatcher_Message * msg);
 /**
- * \fn static Communication_Protocol_Head DISPATCHER_decode_message(uint8_t* raw_message)
+ * \fn static Dispatcher_Message DISPATCHER_decode_message(const uint8_t* raw_message, size_t raw_message_size)
  * \brief Used to decode the raw message from the socket. Separation between the message type, the data size and the rest of the informations.
  * \author Joshua MONTREUIL
  *
- * \param raw_message : raw message from the socket.
+ * \param raw_message : raw message from the socket, left in the receive buffer of postman.
+ * \param raw_message_size : size of the raw message, head included.
  *
- * \return The header of the message.
- * \see Communication_Protocol_Head
+ * \return The message, its payload pointing into raw_message.
+ * \see Dispatcher_Message
+ */
+static Dispatcher_Message DISPATCHER_decode_message(const uint8_t* raw_message, size_t raw_message_size);
+/**
+ * \fn static int DISPATCHER_handle_ask_availability(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles ASK_AVAILABILITY : passes the ping to the controller ringer. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_ask_availability(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_ask_cmd(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles ASK_CMD : [command]. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_ask_cmd(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_set_state(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles SET_STATE : [state]. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_set_state(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_ask_mode(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles ASK_MODE. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_ask_mode(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_set_mode(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles SET_MODE : [camera][radar][buzzer][leds]. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_set_mode(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_ask_logs(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles ASK_LOGS. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_ask_logs(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_ask_to_disconnect(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles ASK_TO_DISCONNECT : the dispatcher then waits for the next connection. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_ask_to_disconnect(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_set_current_time(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles SET_CURRENT_TIME : [unused][year - 2000][month][day][hour][minute][second]. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_set_current_time(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_set_ip_port(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles SET_IP_PORT : [ip 4][port 1 or 2]. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_set_ip_port(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_ask_resume(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles ASK_RESUME : [session token 4]. See Dispatcher_Handler.
+ */
+static int DISPATCHER_handle_ask_resume(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_handle_ask_batch(const uint8_t * payload, uint16_t payload_size)
+ * \brief Checks every message of the batch, then dispatches them in order. If one of them is invalid, none is
+ * dispatched. The dispatch stops at the first message whose handler fails, the ones before stay applied.
+ */
+static int DISPATCHER_handle_ask_batch(const uint8_t * payload, uint16_t payload_size);
+/**
+ * \fn static int DISPATCHER_read_batched_msg(const uint8_t * payload, uint16_t payload_size, uint16_t offset, Dispatcher_Message * msg)
+ * \brief Reads the message of a batch starting at offset.
+ *
+ * \param payload : payload of the batch.
+ * \param payload_size : size of the payload of the batch.
+ * \param offset : offset of the head of the message in the payload.
+ * \param msg : the message read, its payload pointing into the batch.
+ *
+ * \return Offset of the next message. -1 if the message does not fit in the batch, has an unknown type or a
+ * payload too short, or is itself a batch.
+ */
+static int DISPATCHER_read_batched_msg(const uint8_t * payload, uint16_t payload_size, uint16_t offset, Dispatcher_Message * msg);
+/**
+ * \fn static int DISPATCHER_handle_logs_received(const uint8_t * payload, uint16_t payload_size)
+ * \brief Handles LOGS_RECEIVED. See Dispatcher_Handler.
  */
-static Communication_Protocol_Head DISPATCHER_decode_message(uint8_t* raw_message);
+static int DISPATCHER_handle_logs_received(const uint8_t * payload, uint16_t payload_size);
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
  * \var static State_Machine state
@@ -112,19 +207,54 @@ static State_Machine state;
  * \brief Dispatcher thread.
  */
 static pthread_t dispatcher_thread;
-/**
- * \var static uint8_t * data_received
- * \brief raw data received from socket;
- */
-static uint8_t * data_received;
 /**
  * \var static pthread_mutex_t dispatcher_mutex
  * \brief Mutex used to safely read state from state machine
  */
 static pthread_mutex_t dispatcher_mutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * \var static pthread_cond_t dispatcher_condition
+ * \brief Signaled on each change of state, wakes up the dispatcher thread while it waits for a connection.
+ */
+static pthread_cond_t dispatcher_condition = PTHREAD_COND_INITIALIZER;
+/**
+ * \var static unsigned int connection_number
+ * \brief Incremented on each DISPATCHER_start_reading(), tells the end of a connection from the start of the next one.
+ */
+static unsigned int connection_number;
+/**
+ * \var static const Dispatcher_Entry dispatcher_registry[DISPATCHER_TYPES_NB]
+ * \brief Handlers of the messages, indexed by the high byte of their type.
+ */
+static const Dispatcher_Entry dispatcher_registry[DISPATCHER_TYPES_NB] = {
+    /* Older SB_IHM send no capabilities. */
+    [ASK_AVAILABILITY >> 8]  = {&DISPATCHER_handle_ask_availability,  0},
+    [ASK_CMD >> 8]           = {&DISPATCHER_handle_ask_cmd,           PROTOCOL_ASK_CMD_SIZE},
+    [SET_STATE >> 8]         = {&DISPATCHER_handle_set_state,         PROTOCOL_SET_STATE_SIZE},
+    [ASK_MODE >> 8]          = {&DISPATCHER_handle_ask_mode,          PROTOCOL_ASK_MODE_SIZE},
+    [SET_MODE >> 8]          = {&DISPATCHER_handle_set_mode,          PROTOCOL_SET_MODE_SIZE},
+    [ASK_LOGS >> 8]          = {&DISPATCHER_handle_ask_logs,          PROTOCOL_ASK_LOGS_SIZE},
+    [ASK_TO_DISCONNECT >> 8] = {&DISPATCHER_handle_ask_to_disconnect, PROTOCOL_ASK_TO_DISCONNECT_SIZE},
+    [SET_CURRENT_TIME >> 8]  = {&DISPATCHER_handle_set_current_time,  PROTOCOL_SET_CURRENT_TIME_SIZE},
+    /* Older SB_IHM send the port on a single byte. */
+    [SET_IP_PORT >> 8]       = {&DISPATCHER_handle_set_ip_port,       PROTOCOL_SET_IP_PORT_SIZE - 1},
+    [LOGS_RECEIVED >> 8]     = {&DISPATCHER_handle_logs_received,     PROTOCOL_LOGS_RECEIVED_SIZE},
+    [ASK_RESUME >> 8]        = {&DISPATCHER_handle_ask_resume,        PROTOCOL_ASK_RESUME_SIZE},
+    [ASK_BATCH >> 8]         = {&DISPATCHER_handle_ask_batch,         PROTOCOL_ASK_BATCH_SIZE},
+};
+/**
+ * \var static Dispatcher_Stats dispatcher_stats[DISPATCHER_TYPES_NB]
+ * \brief Statistics of the received messages, indexed by the high byte of their type.
+ */
+static Dispatcher_Stats dispatcher_stats[DISPATCHER_TYPES_NB];
+/**
+ * \var static pthread_mutex_t stats_mutex
+ * \brief Mutex used to safely read the statistics while the dispatcher thread updates them.
+ */
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 int DISPATCHER_create(void) {
-    data_received = (uint8_t *) malloc(MAX_RECEIVED_BYTES);
+    memset(dispatcher_stats, 0, sizeof(dispatcher_stats));
     return 0;
 }
 
@@ -140,195 +270,303 @@ int DISPATCHER_start(void) {
 void DISPATCHER_start_reading(void) {
     pthread_mutex_lock(&dispatcher_mutex);
     state = S_READING_MSG;
+    connection_number++;
+    pthread_cond_signal(&dispatcher_condition);
     pthread_mutex_unlock(&dispatcher_mutex);
 }
 
 int DISPATCHER_stop(void) {
     pthread_mutex_lock(&dispatcher_mutex);
     state = S_STOP;
+    pthread_cond_signal(&dispatcher_condition);
     pthread_mutex_unlock(&dispatcher_mutex);
     if(pthread_join(dispatcher_thread, NULL) != 0) {
         CONTROLLER_LOGGER_log(ERROR, "On pthread_join(): error while waiting the termination of dispatcher thread.");
         return -1;
     }
+    /* A single entry : type messages/bytes/rejects/us in handler, for each type received. */
+    char log_msg_stats[512] = "Dispatcher stats :";
+    size_t length = strlen(log_msg_stats);
+    for(int type_id = 0; type_id < DISPATCHER_TYPES_NB && length < sizeof(log_msg_stats); type_id++) {
+        if(dispatcher_stats[type_id].messages > 0) {
+            length += snprintf(log_msg_stats + length, sizeof(log_msg_stats) - length, " 0x%04X %lu/%llu/%lu/%llu",
+                               type_id << 8, (unsigned long) dispatcher_stats[type_id].messages,
+                               (unsigned long long) dispatcher_stats[type_id].bytes, (unsigned long) dispatcher_stats[type_id].rejects,
+                               (unsigned long long) dispatcher_stats[type_id].handler_ns / 1000);
+        }
+    }
+    CONTROLLER_LOGGER_log(INFO, log_msg_stats);
+    return 0;
+}
+
+int DISPATCHER_get_stats(Message_Type type, Dispatcher_Stats * stats) {
+    if(stats == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On DISPATCHER_get_stats() : no statistics to fill.");
+        return -1;
+    }
+    pthread_mutex_lock(&stats_mutex);
+    *stats = dispatcher_stats[(uint16_t) type >> 8];
+    pthread_mutex_unlock(&stats_mutex);
     return 0;
 }
 
 int DISPATCHER_destroy(void) {
-    free(data_received);
     return 0;
 }
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
 static void * DISPATCHER_run(void * arg) {
-    State_Machine my_state;
+    unsigned int my_connection;
     pthread_mutex_lock(&dispatcher_mutex);
-    my_state = state;
-    pthread_mutex_unlock(&dispatcher_mutex);
-    while(my_state != S_STOP) {
-        pthread_mutex_lock(&dispatcher_mutex);
-        my_state = state;
-        pthread_mutex_unlock(&dispatcher_mutex);
-        if(my_state == S_READING_MSG) {
-            uint8_t* raw_message = POSTMAN_read_request();
-            if(raw_message == NULL) {
-                CONTROLLER_LOGGER_log(ERROR,"Dispatcher has received an empty message.");
-                return NULL;
-            }
-            else {
-                uint8_t error_value = *raw_message;
-                if(error_value == EBADF) {
-                    CONTROLLER_LOGGER_log(WARNING, "On POSTMAN_read_request() : The data socket for reading has been closed, a disconnection has been asked or detected.");
-                    pthread_mutex_lock(&dispatcher_mutex);
-                    state = S_WAITING_RECONNECTION;
-                    pthread_mutex_unlock(&dispatcher_mutex);
-                }
-                else {
-                    Communication_Protocol_Head msg_decoded = DISPATCHER_decode_message(raw_message);
-                    DISPATCHER_dispatch_received_msg(msg_decoded);
-                }
-                free(raw_message);
-            }
-        }
-    }
-    return 0;
-}
-
-static int DISPATCHER_dispatch_received_msg(Communication_Protocol_Head msg) {
-    switch(msg.msg_type)
-    {
-        case ASK_AVAILABILITY :
-        {
-            if(CONTROLLER_RINGER_ask_availability(ID_ROBOT) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_RINGER_ask_availability() : Dispatcher has failed to put a msg into Controller Ringer's mq.");
-                return -1;
-            }
-            break;
-        }
-        case ASK_CMD :
-        {
-            char log_msg_cmd[20];
-            sprintf(log_msg_cmd, "Command asked : %d",data_received[0]);
-            CONTROLLER_LOGGER_log(DEBUG,log_msg_cmd);
-            Command command_from_msg = (Command) data_received[0];
-            if(PILOT_ask_cmd(command_from_msg) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On PILOT_ask_cmd() : Dispatcher has failed to put a msg into Pilot's mq.");
-                return -1;
-            }
-            break;
+    while(state != S_STOP) {
+        if(state != S_READING_MSG) {
+            /* S_IDLE or S_WAITING_RECONNECTION : sleeps until DISPATCHER_start_reading() or DISPATCHER_stop(). */
+            pthread_cond_wait(&dispatcher_condition, &dispatcher_mutex);
+            continue;
         }
-        case SET_STATE :
-        {
-            char log_msg_state[20];
-            sprintf(log_msg_state, "State asked : %d",data_received[0]);
-            CONTROLLER_LOGGER_log(DEBUG,log_msg_state);
-            State state_from_msg = (State) data_received[0];
-            if(CONTROLLER_CORE_ask_set_state(ID_ROBOT, state_from_msg) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_set_state() : Dispatcher has failed to put a msg into Controller Core's mq.");
-                return -1;
-            }
-            break;
-        }
-        case ASK_MODE :
-        {
-            if(CONTROLLER_CORE_ask_mode(ID_ROBOT) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_mode() : Dispatcher has failed to put a msg into Controller Core's mq.");
-                return -1;
-            }
-            break;
+        my_connection = connection_number;
+        pthread_mutex_unlock(&dispatcher_mutex);
+        /* Blocks on the socket until a message comes or the connection ends. */
+        const uint8_t* raw_message;
+        int raw_message_size = POSTMAN_read_request(&raw_message);
+        if(raw_message_size == -1) {
+            CONTROLLER_LOGGER_log(ERROR,"Dispatcher has received an empty message.");
+            return NULL;
         }
-        case SET_MODE :
-        {
-            Operating_Mode operating_mode_from_msg;
-            operating_mode_from_msg.camera_mode = (Mode) data_received[0];
-            operating_mode_from_msg.radar_mode = (Mode) data_received[1];
-            operating_mode_from_msg.buzzer_mode = (Mode) data_received[2];
-            operating_mode_from_msg.leds_mode = (Mode) data_received[3];
-            if(CONTROLLER_CORE_ask_set_mode(ID_ROBOT,operating_mode_from_msg) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_set_mode() : Dispatcher has failed to put a msg into Controller Core's mq.");
-                return -1;
-            }
-            break;
+        else if(raw_message_size == 0) {
+            CONTROLLER_LOGGER_log(WARNING, "On POSTMAN_read_request() : The data socket for reading has been closed, a disconnection has been asked or detected.");
         }
-        case ASK_LOGS :
-        {
-            if(CONTROLLER_LOGGER_ask_logs(ID_ROBOT) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_LOGGER_ask_logs() : Dispatcher has failed to put a msg into controller logger's mq.");
-                return -1;
-            }
-            break;
+        else {
+            Dispatcher_Message msg_decoded = DISPATCHER_decode_message(raw_message, (size_t) raw_message_size);
+            DISPATCHER_dispatch_received_msg(&msg_decoded);
         }
-        case ASK_TO_DISCONNECT :
-        {
-            if(CONTROLLER_CORE_ask_to_disconnect(ID_ROBOT) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_to_disconnect() : Dispatcher has failed to put a msg into Controller Core's mq.");
-                return -1;
-            }
-            pthread_mutex_lock(&dispatcher_mutex);
+        pthread_mutex_lock(&dispatcher_mutex);
+        /* A new connection may already have started the reading again. */
+        if(raw_message_size == 0 && state == S_READING_MSG && connection_number == my_connection) {
             state = S_WAITING_RECONNECTION;
-            pthread_mutex_unlock(&dispatcher_mutex);
-            break;
         }
-        case SET_CURRENT_TIME : {
-            struct tm rtc;
-            rtc.tm_year = ((data_received[1] + 2000) - 1900);
-            rtc.tm_mon  = (int) data_received[2] -1;
-            rtc.tm_mday = (int) data_received[3];
-            rtc.tm_hour = (int) data_received[4];
-            rtc.tm_min  = (int) data_received[5];
-            rtc.tm_sec  = (int) data_received[6];
-            rtc.tm_isdst = -1;
+    }
+    pthread_mutex_unlock(&dispatcher_mutex);
+    return 0;
+}
 
-            time_t rtc_timestamp = mktime(&rtc);
-            if(CONTROLLER_LOGGER_ask_set_rtc(ID_ROBOT,rtc_timestamp) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_LOGGER_ask_set_rtc() : Dispatcher has failed to put a msg into Controller Logger's mq.");
-                return -1;
-            }
-            break;
-        }
-        case SET_IP_PORT : {
-            char ip_address[16];
-            uint16_t port;
-            sprintf(ip_address,"%d.%d.%d.%d",(uint8_t)(data_received[0]),(uint8_t)(data_received[1]),(uint8_t)(data_received[2]),(uint8_t)(data_received[3]));
-            if(msg.msg_size > 5) {
-                port = (uint16_t)(data_received[4] << 8) | data_received[5];
-            }
-            else {
-                port = (0x00 << 8) | data_received[4];
-            }
-            if(CAMERA_set_up_ihm_info(ip_address, port) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CAMERA_set_up_ihm_info() : Dispatcher has failed to put a msg into Camera's mq.");
-                return -1;
-            }
-            break;
-        }
-        case LOGS_RECEIVED : {
-            if(CONTROLLER_LOGGER_logs_saved(ID_ROBOT) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_LOGGER_logs_saved() : Dispatcher has failed to put a msg into Controller Logger's mq.");
-                return -1;
-            }
-            break;
+static int DISPATCHER_dispatch_received_msg(const Dispatcher_Message * msg) {
+    uint8_t type_id = (uint16_t) msg->head.msg_type >> 8;
+    const Dispatcher_Entry * entry = &dispatcher_registry[type_id];
+    uint16_t payload_size = msg->payload_size;
+    int ret = 0;
+    bool_e is_rejected = FALSE;
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if(entry->handler == NULL) {
+        char log_msg_unknown[48];
+        sprintf(log_msg_unknown, "Dispatcher has skipped the unknown type %d.", msg->head.msg_type);
+        CONTROLLER_LOGGER_log(WARNING, log_msg_unknown);
+        is_rejected = TRUE;
+    }
+    else if(payload_size < entry->min_payload_size) {
+        char log_msg_short[64];
+        sprintf(log_msg_short, "Dispatcher has skipped a type %d with a payload too short.", msg->head.msg_type);
+        CONTROLLER_LOGGER_log(WARNING, log_msg_short);
+        is_rejected = TRUE;
+    }
+    else if((ret = entry->handler(msg->payload, payload_size)) == -1) {
+        is_rejected = TRUE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    pthread_mutex_lock(&stats_mutex);
+    dispatcher_stats[type_id].messages++;
+    dispatcher_stats[type_id].bytes += payload_size;
+    dispatcher_stats[type_id].handler_ns += (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+    if(is_rejected) {
+        dispatcher_stats[type_id].rejects++;
+    }
+    pthread_mutex_unlock(&stats_mutex);
+    return ret;
+}
+
+static int DISPATCHER_handle_ask_availability(const uint8_t * payload, uint16_t payload_size) {
+    /* Negotiated before the answer, which gives the capabilities enabled. */
+    if(payload_size >= PROTOCOL_ASK_AVAILABILITY_SIZE) {
+        CAPABILITIES_negotiate(PROTOCOL_get_ASK_AVAILABILITY_version(payload), PROTOCOL_get_ASK_AVAILABILITY_capabilities(payload));
+    }
+    if(CONTROLLER_RINGER_ask_availability(ID_ROBOT) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_RINGER_ask_availability() : Dispatcher has failed to put a msg into Controller Ringer's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_ask_cmd(const uint8_t * payload, uint16_t payload_size) {
+    Command command_from_msg = (Command) PROTOCOL_get_ASK_CMD_command(payload);
+    CONTROLLER_LOGGER_LOG(DEBUG, "Command asked : %d", command_from_msg);
+    if(PILOT_ask_cmd(command_from_msg) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On PILOT_ask_cmd() : Dispatcher has failed to put a msg into Pilot's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_set_state(const uint8_t * payload, uint16_t payload_size) {
+    State state_from_msg = (State) PROTOCOL_get_SET_STATE_state(payload);
+    CONTROLLER_LOGGER_LOG(DEBUG, "State asked : %d", state_from_msg);
+    if(CONTROLLER_CORE_ask_set_state(ID_ROBOT, state_from_msg) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_set_state() : Dispatcher has failed to put a msg into Controller Core's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_ask_mode(const uint8_t * payload, uint16_t payload_size) {
+    if(CONTROLLER_CORE_ask_mode(ID_ROBOT) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_mode() : Dispatcher has failed to put a msg into Controller Core's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_set_mode(const uint8_t * payload, uint16_t payload_size) {
+    Operating_Mode operating_mode_from_msg;
+    operating_mode_from_msg.camera_mode = (Mode) PROTOCOL_get_SET_MODE_camera_mode(payload);
+    operating_mode_from_msg.radar_mode = (Mode) PROTOCOL_get_SET_MODE_radar_mode(payload);
+    operating_mode_from_msg.buzzer_mode = (Mode) PROTOCOL_get_SET_MODE_buzzer_mode(payload);
+    operating_mode_from_msg.leds_mode = (Mode) PROTOCOL_get_SET_MODE_leds_mode(payload);
+    if(CONTROLLER_CORE_ask_set_mode(ID_ROBOT,operating_mode_from_msg) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_set_mode() : Dispatcher has failed to put a msg into Controller Core's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_ask_logs(const uint8_t * payload, uint16_t payload_size) {
+    if(CONTROLLER_LOGGER_ask_logs(ID_ROBOT) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_LOGGER_ask_logs() : Dispatcher has failed to put a msg into controller logger's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_ask_to_disconnect(const uint8_t * payload, uint16_t payload_size) {
+    if(CONTROLLER_CORE_ask_to_disconnect(ID_ROBOT) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_to_disconnect() : Dispatcher has failed to put a msg into Controller Core's mq.");
+        return -1;
+    }
+    pthread_mutex_lock(&dispatcher_mutex);
+    state = S_WAITING_RECONNECTION;
+    pthread_mutex_unlock(&dispatcher_mutex);
+    return 0;
+}
+
+static int DISPATCHER_handle_set_current_time(const uint8_t * payload, uint16_t payload_size) {
+    struct tm rtc;
+    rtc.tm_year = PROTOCOL_get_SET_CURRENT_TIME_century(payload) * 100 + PROTOCOL_get_SET_CURRENT_TIME_year(payload) - 1900;
+    rtc.tm_mon  = (int) PROTOCOL_get_SET_CURRENT_TIME_month(payload) - 1;
+    rtc.tm_mday = (int) PROTOCOL_get_SET_CURRENT_TIME_day(payload);
+    rtc.tm_hour = (int) PROTOCOL_get_SET_CURRENT_TIME_hour(payload);
+    rtc.tm_min  = (int) PROTOCOL_get_SET_CURRENT_TIME_minute(payload);
+    rtc.tm_sec  = (int) PROTOCOL_get_SET_CURRENT_TIME_second(payload);
+    rtc.tm_isdst = -1;
+
+    time_t rtc_timestamp = mktime(&rtc);
+    if(CONTROLLER_LOGGER_ask_set_rtc(ID_ROBOT,rtc_timestamp) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_LOGGER_ask_set_rtc() : Dispatcher has failed to put a msg into Controller Logger's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_set_ip_port(const uint8_t * payload, uint16_t payload_size) {
+    char ip_address[16];
+    uint16_t port;
+    uint32_t ip = PROTOCOL_get_SET_IP_PORT_ip(payload);
+    sprintf(ip_address,"%d.%d.%d.%d",(uint8_t)(ip >> 24),(uint8_t)(ip >> 16),(uint8_t)(ip >> 8),(uint8_t)ip);
+    if(payload_size >= PROTOCOL_SET_IP_PORT_SIZE) {
+        port = PROTOCOL_get_SET_IP_PORT_port(payload);
+    }
+    else {
+        port = PROTOCOL_get_U8(payload + PROTOCOL_SET_IP_PORT_port_OFFSET);
+    }
+    if(CAMERA_set_up_ihm_info(ip_address, port) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CAMERA_set_up_ihm_info() : Dispatcher has failed to put a msg into Camera's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_ask_resume(const uint8_t * payload, uint16_t payload_size) {
+    uint32_t session_token = PROTOCOL_get_ASK_RESUME_session_token(payload);
+    if(CONTROLLER_CORE_ask_resume(ID_ROBOT, session_token) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_ask_resume() : Dispatcher has failed to put a msg into Controller Core's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static int DISPATCHER_handle_ask_batch(const uint8_t * payload, uint16_t payload_size) {
+    Dispatcher_Message msg;
+    int offset;
+    if(!CAPABILITIES_is_enabled(CAPABILITY_BATCH)) {
+        CONTROLLER_LOGGER_log(WARNING, "Dispatcher has skipped a batch : SB_IHM has not negotiated the batches.");
+        return -1;
+    }
+    for(offset = 0; offset < payload_size; ) {
+        if((offset = DISPATCHER_read_batched_msg(payload, payload_size, (uint16_t) offset, &msg)) == -1) {
+            CONTROLLER_LOGGER_log(WARNING, "Dispatcher has skipped a batch holding an invalid message.");
+            return -1;
         }
-        default :
-        {
-            //Should not get here
-            break;
+    }
+    /* Not transactional : the messages dispatched before a failing one are not undone. */
+    for(offset = 0; offset < payload_size; ) {
+        offset = DISPATCHER_read_batched_msg(payload, payload_size, (uint16_t) offset, &msg);
+        if(DISPATCHER_dispatch_received_msg(&msg) == -1) {
+            CONTROLLER_LOGGER_log(WARNING, "Dispatcher has stopped a batch : one of its messages has failed.");
+            return -1;
         }
     }
     return 0;
 }
 
-static Communication_Protocol_Head DISPATCHER_decode_message(uint8_t* raw_message) {
-    Communication_Protocol_Head msg;
-    msg.msg_size = (raw_message[0] << 8) | raw_message[1];
-    char log_msg_size[22];
-    sprintf(log_msg_size, "Message size : %d",msg.msg_size);
-    CONTROLLER_LOGGER_log(DEBUG,log_msg_size);
-    msg.msg_type = ntohs((raw_message[2] << 8) | raw_message[3]);
-    char log_msg_type[21];
-    sprintf(log_msg_type, "Message type : %d",msg.msg_type);
-    CONTROLLER_LOGGER_log(DEBUG,log_msg_type);
-    if(msg.msg_size > 2) {
-        memcpy(data_received, raw_message + 4,  msg.msg_size - 2);
+static int DISPATCHER_read_batched_msg(const uint8_t * payload, uint16_t payload_size, uint16_t offset, Dispatcher_Message * msg) {
+    if(payload_size - offset < PROTOCOL_HEAD_SIZE) {
+        return -1;
+    }
+    const uint8_t * raw_message = payload + offset;
+    msg->head.msg_size = PROTOCOL_get_U16(raw_message);
+    msg->head.msg_type = PROTOCOL_get_type(raw_message);
+    msg->payload = raw_message + PROTOCOL_HEAD_SIZE;
+    msg->payload_size = PROTOCOL_get_payload_size(raw_message);
+    const Dispatcher_Entry * entry = &dispatcher_registry[(uint16_t) msg->head.msg_type >> 8];
+    if((uint16_t) msg->head.msg_size < 2 || msg->payload_size > payload_size - offset - PROTOCOL_HEAD_SIZE
+       || entry->handler == NULL || msg->payload_size < entry->min_payload_size || msg->head.msg_type == ASK_BATCH) {
+        return -1;
+    }
+    return offset + PROTOCOL_HEAD_SIZE + msg->payload_size;
+}
+
+static int DISPATCHER_handle_logs_received(const uint8_t * payload, uint16_t payload_size) {
+    if(CONTROLLER_LOGGER_logs_saved(ID_ROBOT) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_LOGGER_logs_saved() : Dispatcher has failed to put a msg into Controller Logger's mq.");
+        return -1;
+    }
+    return 0;
+}
+
+static Dispatcher_Message DISPATCHER_decode_message(const uint8_t* raw_message, size_t raw_message_size) {
+    Dispatcher_Message msg;
+    msg.head.msg_size = PROTOCOL_get_U16(raw_message);
+    CONTROLLER_LOGGER_LOG(DEBUG, "Message size : %d", msg.head.msg_size);
+    msg.head.msg_type = PROTOCOL_get_type(raw_message);
+    CONTROLLER_LOGGER_LOG(DEBUG, "Message type : %d", msg.head.msg_type);
+    /* The payload is read in place, postman keeps the frame until the next read. Its size is bounded by what
+     * has really been received, whatever the size field announces. */
+    msg.payload = raw_message + PROTOCOL_HEAD_SIZE;
+    msg.payload_size = PROTOCOL_get_payload_size(raw_message);
+    if(raw_message_size < PROTOCOL_HEAD_SIZE) {
+        msg.payload_size = 0;
+    }
+    else if(msg.payload_size > raw_message_size - PROTOCOL_HEAD_SIZE) {
+        msg.payload_size = (uint16_t) (raw_message_size - PROTOCOL_HEAD_SIZE);
     }
     return msg;
 }
\ No newline at end of file
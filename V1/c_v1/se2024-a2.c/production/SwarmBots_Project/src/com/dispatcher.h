@@ -37,9 +37,33 @@
 #ifndef SRC_COM_DISPATCHER_H_
 #define SRC_COM_DISPATCHER_H_
 /* ----------------------  INCLUDES ------------------------------------------*/
+#include <stdint.h>
+
+#include "../lib/defs.h"
 /* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
 /* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
 /* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/**
+ * \struct Dispatcher_Message dispatcher.h "com/dispatcher.h"
+ * \brief Decoded message : its head and a view of its payload.
+ *
+ * The payload is not copied, it stays in the receive buffer of postman until the next read.
+ */
+typedef struct {
+    Communication_Protocol_Head head; /**< Size and type of the message. */
+    const uint8_t * payload;          /**< First byte of the payload. */
+    uint16_t payload_size;            /**< Bytes of the payload received with the head. */
+} Dispatcher_Message;
+/**
+ * \struct Dispatcher_Stats dispatcher.h "com/dispatcher.h"
+ * \brief Statistics of the messages of a type received since the creation of the dispatcher.
+ */
+typedef struct {
+    uint32_t messages;   /**< Messages received, rejected ones included. */
+    uint64_t bytes;      /**< Payload bytes received. */
+    uint32_t rejects;    /**< Messages rejected : unknown type, payload too short or failure of the handler. */
+    uint64_t handler_ns; /**< Time spent handling the messages, in nanoseconds. */
+} Dispatcher_Stats;
 /* ----------------------  PUBLIC VARIABLES ----------------------------------*/
 /* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
 /**
@@ -76,5 +100,16 @@ extern int DISPATCHER_stop(void);
  * \author Joshua MONTREUIL.
  */
 extern void DISPATCHER_start_reading(void);
+/**
+ * \fn extern int DISPATCHER_get_stats(Message_Type type, Dispatcher_Stats * stats)
+ * \brief Gives the statistics of the messages of a type. Can be called at any time from any thread.
+ * \author Prose A2
+ *
+ * \param type : message type.
+ * \param stats : filled with the statistics of the type.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int DISPATCHER_get_stats(Message_Type type, Dispatcher_Stats * stats);
 
 #endif /* SRC_COM_DISPATCHER_H_ */
@@ -0,0 +1,269 @@
+/**
+ * \file  frame_pool.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Source file of the frame pool. Lends the outbound TCP frames to the proxies.
+ *
+ * \see frame_pool.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdlib.h>
+#include <pthread.h>
+#include "frame_pool.h"
+#include "../config.h"
+#include "../logs/controller_logger.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def LARGE_FRAME_SIZE
+ * Size in bytes of the frames of the large class : the biggest frame of the protocol.
+ */
+#define LARGE_FRAME_SIZE        (2 + 0xFFFF)
+/**
+ * \def SLOT_SIZE
+ * Size in bytes of a slot of a class : the slot head followed by the frame, rounded up to keep heads aligned.
+ */
+#define SLOT_SIZE(frame_size)   (sizeof(Frame_Slot_Head) + (((frame_size) + 7) & ~(size_t) 7))
+/**
+ * \def ARENA_WORDS
+ * Amount of 64 bits words of the arena of a class.
+ */
+#define ARENA_WORDS(frame_size, frames_nb) ((SLOT_SIZE(frame_size) * (frames_nb)) / sizeof(uint64_t))
+/* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Frame_Slot_Head
+ * \brief Bookkeeping written just before every lent frame.
+ */
+typedef struct {
+    uint16_t class_id;   /**< Class owning the slot, HEAP_CLASS for a frame allocated on the heap. */
+    uint16_t slot;       /**< Index of the slot in the arena of its class. */
+    uint32_t references; /**< Amount of owners left before the frame goes back to its class. */
+} Frame_Slot_Head;
+/**
+ * \struct Frame_Class
+ * \brief Slab of frames of the same size.
+ */
+typedef struct {
+    size_t frame_size;      /**< Size in bytes of the biggest frame a slot can hold. */
+    uint16_t slots_nb;      /**< Amount of slots of the class. */
+    uint8_t * arena;        /**< Storage of the slots. */
+    uint16_t * free_slots;  /**< Stack of the indexes of the free slots. */
+    uint16_t free_slots_nb; /**< Amount of free slots in the stack. */
+} Frame_Class;
+/* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/**
+ * \enum Class_Id
+ * \brief Classes of the pool, from the smallest frames to the biggest ones.
+ */
+typedef enum {
+    SMALL_CLASS = 0,
+    MEDIUM_CLASS,
+    LARGE_CLASS,
+    CLASS_NB,
+    HEAP_CLASS = CLASS_NB /**< Frames allocated on the heap when the pool is exhausted. */
+} Class_Id;
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static Frame_Slot_Head * FRAME_POOL_take_slot(size_t frame_size)
+ * \brief Takes a free slot in the smallest class able to hold a frame and updates the counters.
+ * \author Prose A2
+ *
+ * \param frame_size : size in bytes of the frame.
+ *
+ * \return The head of the slot, NULL if every class able to hold the frame is empty.
+ */
+static Frame_Slot_Head * FRAME_POOL_take_slot(size_t frame_size);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static uint64_t small_arena
+ * Storage of the small class.
+ */
+static uint64_t small_arena[ARENA_WORDS(CONFIG_FRAME_POOL_SMALL_SIZE, CONFIG_FRAME_POOL_SMALL_FRAMES)];
+/**
+ * \var static uint64_t medium_arena
+ * Storage of the medium class.
+ */
+static uint64_t medium_arena[ARENA_WORDS(CONFIG_FRAME_POOL_MEDIUM_SIZE, CONFIG_FRAME_POOL_MEDIUM_FRAMES)];
+/**
+ * \var static uint64_t large_arena
+ * Storage of the large class.
+ */
+static uint64_t large_arena[ARENA_WORDS(LARGE_FRAME_SIZE, CONFIG_FRAME_POOL_LARGE_FRAMES)];
+/**
+ * \var static uint16_t small_free_slots
+ * Free slots of the small class.
+ */
+static uint16_t small_free_slots[CONFIG_FRAME_POOL_SMALL_FRAMES];
+/**
+ * \var static uint16_t medium_free_slots
+ * Free slots of the medium class.
+ */
+static uint16_t medium_free_slots[CONFIG_FRAME_POOL_MEDIUM_FRAMES];
+/**
+ * \var static uint16_t large_free_slots
+ * Free slots of the large class.
+ */
+static uint16_t large_free_slots[CONFIG_FRAME_POOL_LARGE_FRAMES];
+/**
+ * \var static Frame_Class frame_classes
+ * Classes of the pool, sorted by frame size.
+ */
+static Frame_Class frame_classes[CLASS_NB] = {
+    [SMALL_CLASS] = {CONFIG_FRAME_POOL_SMALL_SIZE, CONFIG_FRAME_POOL_SMALL_FRAMES, (uint8_t *) small_arena, small_free_slots, 0},
+    [MEDIUM_CLASS] = {CONFIG_FRAME_POOL_MEDIUM_SIZE, CONFIG_FRAME_POOL_MEDIUM_FRAMES, (uint8_t *) medium_arena, medium_free_slots, 0},
+    [LARGE_CLASS] = {LARGE_FRAME_SIZE, CONFIG_FRAME_POOL_LARGE_FRAMES, (uint8_t *) large_arena, large_free_slots, 0},
+};
+/**
+ * \var static Frame_Pool_Stats pool_stats
+ * Counters of the pool.
+ */
+static Frame_Pool_Stats pool_stats;
+/**
+ * \var static pthread_mutex_t pool_mutex
+ * Protects the classes and the counters : frames are lent by the proxies and released by the postman.
+ */
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int FRAME_POOL_create(void) {
+    pthread_mutex_lock(&pool_mutex);
+    for(int class_id = 0; class_id < CLASS_NB; class_id++) {
+        Frame_Class * frame_class = &frame_classes[class_id];
+        /* The lowest slots are lent first. */
+        for(uint16_t i = 0; i < frame_class->slots_nb; i++) {
+            frame_class->free_slots[i] = frame_class->slots_nb - 1 - i;
+        }
+        frame_class->free_slots_nb = frame_class->slots_nb;
+    }
+    pool_stats = (Frame_Pool_Stats) {0};
+    pthread_mutex_unlock(&pool_mutex);
+    return 0;
+}
+
+int FRAME_POOL_destroy(void) {
+    pthread_mutex_lock(&pool_mutex);
+    uint32_t in_use = pool_stats.in_use;
+    for(int class_id = 0; class_id < CLASS_NB; class_id++) {
+        frame_classes[class_id].free_slots_nb = 0;
+    }
+    pthread_mutex_unlock(&pool_mutex);
+    if(in_use != 0) {
+        CONTROLLER_LOGGER_log(WARNING, "The frame pool has been destroyed while frames were still lent.");
+    }
+    return 0;
+}
+
+uint8_t * FRAME_POOL_new_frame(Message_Type type, uint16_t payload_size) {
+    if(payload_size > FRAME_POOL_MAX_PAYLOAD) {
+        CONTROLLER_LOGGER_log(ERROR, "On FRAME_POOL_new_frame() : the payload does not fit in a frame.");
+        return NULL;
+    }
+    size_t frame_size = FRAME_POOL_HEAD_SIZE + payload_size;
+    pthread_mutex_lock(&pool_mutex);
+    Frame_Slot_Head * head = FRAME_POOL_take_slot(frame_size);
+    pthread_mutex_unlock(&pool_mutex);
+    if(head == NULL) {
+        head = (Frame_Slot_Head *) malloc(sizeof(Frame_Slot_Head) + frame_size);
+        if(head == NULL) {
+            pthread_mutex_lock(&pool_mutex);
+            pool_stats.in_use--;
+            pthread_mutex_unlock(&pool_mutex);
+            CONTROLLER_LOGGER_log(ERROR, "On malloc() : the frame pool is exhausted and failed to allocate a frame.");
+            return NULL;
+        }
+        head->class_id = HEAP_CLASS;
+        head->slot = 0;
+    }
+    head->references = 1;
+    uint8_t * frame = (uint8_t *) (head + 1);
+    PROTOCOL_put_head(frame, type, payload_size);
+    return frame;
+}
+
+void FRAME_POOL_retain(uint8_t * frame) {
+    Frame_Slot_Head * head = ((Frame_Slot_Head *) frame) - 1;
+    pthread_mutex_lock(&pool_mutex);
+    head->references++;
+    pthread_mutex_unlock(&pool_mutex);
+}
+
+void FRAME_POOL_release(uint8_t * frame) {
+    if(frame == NULL) {
+        return;
+    }
+    Frame_Slot_Head * head = ((Frame_Slot_Head *) frame) - 1;
+    pthread_mutex_lock(&pool_mutex);
+    if(--head->references != 0) {
+        pthread_mutex_unlock(&pool_mutex);
+        return;
+    }
+    pool_stats.in_use--;
+    if(head->class_id != HEAP_CLASS) {
+        Frame_Class * frame_class = &frame_classes[head->class_id];
+        frame_class->free_slots[frame_class->free_slots_nb++] = head->slot;
+        head = NULL;
+    }
+    pthread_mutex_unlock(&pool_mutex);
+    free(head);
+}
+
+void FRAME_POOL_get_stats(Frame_Pool_Stats * stats) {
+    pthread_mutex_lock(&pool_mutex);
+    *stats = pool_stats;
+    pthread_mutex_unlock(&pool_mutex);
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static Frame_Slot_Head * FRAME_POOL_take_slot(size_t frame_size) {
+    bool_e is_best_fit = TRUE;
+    pool_stats.in_use++;
+    for(int class_id = 0; class_id < CLASS_NB; class_id++) {
+        Frame_Class * frame_class = &frame_classes[class_id];
+        if(frame_class->frame_size < frame_size) {
+            continue;
+        }
+        if(frame_class->free_slots_nb == 0) {
+            is_best_fit = FALSE;
+            continue;
+        }
+        uint16_t slot = frame_class->free_slots[--frame_class->free_slots_nb];
+        Frame_Slot_Head * head = (Frame_Slot_Head *) (frame_class->arena + slot * SLOT_SIZE(frame_class->frame_size));
+        head->class_id = (uint16_t) class_id;
+        head->slot = slot;
+        if(is_best_fit) {
+            pool_stats.hits++;
+        }
+        else {
+            pool_stats.misses++;
+        }
+        return head;
+    }
+    pool_stats.exhaustions++;
+    return NULL;
+}
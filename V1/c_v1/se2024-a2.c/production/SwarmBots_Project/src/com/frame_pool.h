@@ -0,0 +1,123 @@
+/**
+ * \file  frame_pool.h
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Header file of the frame pool. Lends the outbound TCP frames to the proxies.
+ *
+ * \see frame_pool.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#ifndef SRC_COM_FRAME_POOL_H_
+#define SRC_COM_FRAME_POOL_H_
+/* ----------------------  INCLUDES ------------------------------------------*/
+#include <stdint.h>
+#include "../lib/defs.h"
+#include "../lib/protocol.h"
+/* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/**
+ * \def FRAME_POOL_HEAD_SIZE
+ * Size of the size and type fields written at the beginning of every frame.
+ */
+#define FRAME_POOL_HEAD_SIZE      PROTOCOL_HEAD_SIZE
+/**
+ * \def FRAME_POOL_MAX_PAYLOAD
+ * Biggest payload a frame can carry : msg_size counts the type and the payload on 16 bits.
+ */
+#define FRAME_POOL_MAX_PAYLOAD    (0xFFFF - 2)
+/* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
+/* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/**
+ * \struct Frame_Pool_Stats
+ * \brief Counters of the frame pool since its creation.
+ */
+typedef struct {
+    uint32_t hits;        /**< Frames lent by the smallest class able to hold them. */
+    uint32_t misses;      /**< Frames lent by a bigger class because the fitting one was empty. */
+    uint32_t exhaustions; /**< Frames allocated on the heap because every fitting class was empty. */
+    uint32_t in_use;      /**< Frames currently lent and not released yet. */
+} Frame_Pool_Stats;
+/* ----------------------  PUBLIC VARIABLES -----------------------------------*/
+/* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
+/**
+ * \fn extern int FRAME_POOL_create(void)
+ * \brief Fills the free lists of every class of the pool.
+ * \author Prose A2
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int FRAME_POOL_create(void);
+/**
+ * \fn extern int FRAME_POOL_destroy(void)
+ * \brief Destroys the frame pool.
+ * \author Prose A2
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int FRAME_POOL_destroy(void);
+/**
+ * \fn extern uint8_t * FRAME_POOL_new_frame(Message_Type type, uint16_t payload_size)
+ * \brief Lends a frame and writes its size and type fields in place.
+ * \author Prose A2
+ *
+ * The payload is written by the caller from FRAME_POOL_HEAD_SIZE. The frame is
+ * lent with one reference, given to the postman by POSTMAN_send_request().
+ *
+ * \param type : message type of the frame.
+ * \param payload_size : size in bytes of the payload following the type.
+ *
+ * \return On success, returns the frame. On error, returns NULL.
+ */
+extern uint8_t * FRAME_POOL_new_frame(Message_Type type, uint16_t payload_size);
+/**
+ * \fn extern void FRAME_POOL_retain(uint8_t * frame)
+ * \brief Adds a reference to a frame, to write it on several sockets without copy.
+ * \author Prose A2
+ *
+ * \param frame : frame lent by FRAME_POOL_new_frame().
+ */
+extern void FRAME_POOL_retain(uint8_t * frame);
+/**
+ * \fn extern void FRAME_POOL_release(uint8_t * frame)
+ * \brief Drops a reference to a frame, which goes back to its class when none is left.
+ * \author Prose A2
+ *
+ * \param frame : frame lent by FRAME_POOL_new_frame(). NULL is ignored.
+ */
+extern void FRAME_POOL_release(uint8_t * frame);
+/**
+ * \fn extern void FRAME_POOL_get_stats(Frame_Pool_Stats * stats)
+ * \brief Copies the counters of the pool.
+ * \author Prose A2
+ *
+ * \param stats : receives the counters.
+ */
+extern void FRAME_POOL_get_stats(Frame_Pool_Stats * stats);
+
+#endif /* SRC_COM_FRAME_POOL_H_ */
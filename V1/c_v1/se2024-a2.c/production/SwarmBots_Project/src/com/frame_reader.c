@@ -0,0 +1,89 @@
+/**
+ * \file  frame_reader.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Source file of the frame reader. Cuts the TCP stream of SB_IHM into frames.
+ *
+ * \see frame_reader.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <string.h>
+#include <sys/socket.h>
+#include "frame_reader.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def SIZE_FIELD_SIZE
+ * Size in bytes of the size field starting every frame.
+ */
+#define SIZE_FIELD_SIZE   2
+/* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+void FRAME_READER_reset(Frame_Reader * reader) {
+    reader->start = 0;
+    reader->end = 0;
+}
+
+ssize_t FRAME_READER_fill(Frame_Reader * reader, int socket) {
+    if(reader->start == reader->end) {
+        FRAME_READER_reset(reader);
+    }
+    else if(reader->start != 0) {
+        /* Only the beginning of one frame is left : it is moved to the front so that every frame stays contiguous. */
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+    ssize_t amount_read = recv(socket, reader->buffer + reader->end, FRAME_READER_BUFFER_SIZE - reader->end, 0);
+    if(amount_read > 0) {
+        reader->end += (size_t) amount_read;
+    }
+    return amount_read;
+}
+
+size_t FRAME_READER_next(Frame_Reader * reader, const uint8_t ** frame) {
+    size_t available = reader->end - reader->start;
+    if(available < SIZE_FIELD_SIZE) {
+        return 0;
+    }
+    const uint8_t * head = reader->buffer + reader->start;
+    size_t frame_size = SIZE_FIELD_SIZE + (size_t) (head[0] << 8 | head[1]);
+    if(available < frame_size) {
+        return 0;
+    }
+    reader->start += frame_size;
+    *frame = head;
+    return frame_size;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
@@ -0,0 +1,96 @@
+/**
+ * \file  frame_reader.h
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Header file of the frame reader. Cuts the TCP stream of SB_IHM into frames.
+ *
+ * \see frame_reader.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#ifndef SRC_COM_FRAME_READER_H_
+#define SRC_COM_FRAME_READER_H_
+/* ----------------------  INCLUDES ------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+/* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/**
+ * \def FRAME_READER_BUFFER_SIZE
+ * Size in bytes of the receive buffer : the biggest frame of the protocol always fits.
+ */
+#define FRAME_READER_BUFFER_SIZE   (2 + 0xFFFF)
+/* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
+/* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/**
+ * \struct Frame_Reader
+ * \brief Receive buffer of a connection. Bytes between start and end are received but not parsed yet.
+ */
+typedef struct {
+    uint8_t buffer[FRAME_READER_BUFFER_SIZE]; /**< Bytes received from the socket. */
+    size_t start;                             /**< First byte of the next frame. */
+    size_t end;                               /**< First free byte of the buffer. */
+} Frame_Reader;
+/* ----------------------  PUBLIC VARIABLES -----------------------------------*/
+/* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
+/**
+ * \fn extern void FRAME_READER_reset(Frame_Reader * reader)
+ * \brief Forgets every byte received, for a new connection.
+ * \author Prose A2
+ *
+ * \param reader : receive buffer of the connection.
+ */
+extern void FRAME_READER_reset(Frame_Reader * reader);
+/**
+ * \fn extern ssize_t FRAME_READER_fill(Frame_Reader * reader, int socket)
+ * \brief Receives as many bytes as the socket holds and the buffer can take, with a single recv().
+ * \author Prose A2
+ *
+ * To be called once FRAME_READER_next() has no complete frame left. The frames it gave before are no longer
+ * valid afterwards.
+ *
+ * \param reader : receive buffer of the connection.
+ * \param socket : socket of the connection.
+ *
+ * \return The amount of bytes received, 0 at the end of the stream. On error, returns -1 and errno is set.
+ */
+extern ssize_t FRAME_READER_fill(Frame_Reader * reader, int socket);
+/**
+ * \fn extern size_t FRAME_READER_next(Frame_Reader * reader, const uint8_t ** frame)
+ * \brief Gives the next complete frame of the buffer, without copy.
+ * \author Prose A2
+ *
+ * \param reader : receive buffer of the connection.
+ * \param frame : set to the beginning of the frame (size field included), valid until the next fill.
+ *
+ * \return The size in bytes of the frame, 0 when the next frame is not fully received yet.
+ */
+extern size_t FRAME_READER_next(Frame_Reader * reader, const uint8_t ** frame);
+
+#endif /* SRC_COM_FRAME_READER_H_ */
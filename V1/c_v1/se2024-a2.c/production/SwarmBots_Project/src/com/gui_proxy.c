@@ -40,6 +40,7 @@
 #include <arpa/inet.h>
 #include "gui_proxy.h"
 #include "postman.h"
+#include "frame_pool.h"
 #include "../logs/controller_logger.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
 /* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
@@ -49,14 +50,13 @@
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 int GUI_PROXY_raise_memory_alert(Id_Robot id_robot) {
-    Communication_Protocol_Head msg_to_send;
-    msg_to_send.msg_size = htons(0x0003);
-    msg_to_send.msg_type = htons(ALERT);
-    uint8_t buf[1] = {MEMORY};
-    uint8_t * data = (uint8_t*) malloc(2 + msg_to_send.msg_size);
-    memcpy(data,&msg_to_send,4);
-    memcpy(data + 4,buf,sizeof(buf));
+    uint8_t * data = FRAME_POOL_new_frame(ALERT, PROTOCOL_ALERT_SIZE);
+    if(data == NULL) {
+        return -1;
+    }
+    PROTOCOL_put_ALERT_alert(data + FRAME_POOL_HEAD_SIZE, MEMORY);
     if(POSTMAN_send_request(data) == -1) {
+        FRAME_POOL_release(data);
         CONTROLLER_LOGGER_log(ERROR,"On POSTMAN_send_request() : gui proxy has failed to request a data write on postman's mq.");
         return -1;
     }
@@ -41,6 +41,9 @@
 #include <arpa/inet.h>
 #include "gui_ringer_proxy.h"
 #include "postman.h"
+#include "frame_pool.h"
+#include "capabilities.h"
+#include "../lib/protocol.h"
 #include "../logs/controller_logger.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
 /* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
@@ -50,12 +53,19 @@
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /* ----------------------  PUBLIC  FUNCTIONS  -------------------------------- */
 int GUI_RINGER_PROXY_set_availability(Id_Robot id_robot) {
-    Communication_Protocol_Head msg_to_send;
-    msg_to_send.msg_type = htons(SET_AVAILABILITY);
-    msg_to_send.msg_size = htons(sizeof(msg_to_send.msg_type));
-    uint8_t * data = (uint8_t*) malloc(4);
-    memcpy(data,&msg_to_send,4);
+    /* An older SB_IHM gets the answer it knows, without any field. */
+    bool_e is_legacy = CAPABILITIES_get_peer_version() <= PROTOCOL_VERSION_LEGACY;
+    uint8_t * data = FRAME_POOL_new_frame(SET_AVAILABILITY, is_legacy ? 0 : PROTOCOL_SET_AVAILABILITY_SIZE);
+    if(data == NULL) {
+        return -1;
+    }
+    if(!is_legacy) {
+        uint8_t * payload = data + FRAME_POOL_HEAD_SIZE;
+        PROTOCOL_put_SET_AVAILABILITY_version(payload, PROTOCOL_VERSION);
+        PROTOCOL_put_SET_AVAILABILITY_capabilities(payload, CAPABILITIES_get_enabled());
+    }
     if(POSTMAN_send_request(data) == -1) {
+        FRAME_POOL_release(data);
         CONTROLLER_LOGGER_log(ERROR,"On POSTMAN_send_request() : gui ringer proxy has failed to request a data write on postman's mq.");
         return -1;
     }
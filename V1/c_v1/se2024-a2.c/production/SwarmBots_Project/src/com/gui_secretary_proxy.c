@@ -42,6 +42,7 @@
 
 #include "gui_secretary_proxy.h"
 #include "postman.h"
+#include "frame_pool.h"
 #include "../logs/controller_logger.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
 /* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
@@ -51,16 +52,17 @@
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 int GUI_SECRETARY_PROXY_set_mode(Id_Robot id_robot, Operating_Mode operating_mode) {
-    Communication_Protocol_Head msg_to_send;
-    msg_to_send.msg_size = 0x0006;
-    uint8_t buf[4] = {operating_mode.camera_mode, operating_mode.radar_mode, operating_mode.buzzer_mode, operating_mode.leds_mode};
-    uint8_t * data = (uint8_t*) malloc(2 + msg_to_send.msg_size);
-    msg_to_send.msg_size = htons(0x0006);
-    msg_to_send.msg_type = htons(SET_MODE);
-
-    memcpy(data,&msg_to_send,4);
-    memcpy(data + 4,buf,sizeof(buf));
+    uint8_t * data = FRAME_POOL_new_frame(SET_MODE, PROTOCOL_SET_MODE_SIZE);
+    if(data == NULL) {
+        return -1;
+    }
+    uint8_t * payload = data + FRAME_POOL_HEAD_SIZE;
+    PROTOCOL_put_SET_MODE_camera_mode(payload, operating_mode.camera_mode);
+    PROTOCOL_put_SET_MODE_radar_mode(payload, operating_mode.radar_mode);
+    PROTOCOL_put_SET_MODE_buzzer_mode(payload, operating_mode.buzzer_mode);
+    PROTOCOL_put_SET_MODE_leds_mode(payload, operating_mode.leds_mode);
     if(POSTMAN_send_request(data) == -1) {
+        FRAME_POOL_release(data);
         CONTROLLER_LOGGER_log(ERROR,"On POSTMAN_send_request() : gui secretary proxy has failed to request a data write on postman's mq.");
         return -1;
     }
@@ -72,12 +74,12 @@ void GUI_SECRETARY_PROXY_ack_connection(Id_Robot id_robot) {
 }
 
 int GUI_SECRETARY_PROXY_disconnected_ok(Id_Robot id_robot) {
-    Communication_Protocol_Head msg_to_send;
-    msg_to_send.msg_size = htons(0x0002);
-    msg_to_send.msg_type = htons(ACK_DISCONNECTION);
-    uint8_t * data = (uint8_t*) malloc(2 + msg_to_send.msg_size);
-    memcpy(data,&msg_to_send,4);
+    uint8_t * data = FRAME_POOL_new_frame(ACK_DISCONNECTION, PROTOCOL_ACK_DISCONNECTION_SIZE);
+    if(data == NULL) {
+        return -1;
+    }
     if(POSTMAN_send_request(data) == -1) {
+        FRAME_POOL_release(data);
         CONTROLLER_LOGGER_log(ERROR,"On POSTMAN_send_request() : gui secretary proxy has failed to request a data write on postman's mq.");
         return -1;
     }
@@ -85,17 +87,32 @@ int GUI_SECRETARY_PROXY_disconnected_ok(Id_Robot id_robot) {
 }
 
 int GUI_SECRETARY_PROXY_set_radar(Id_Robot id_robot, bool_e radar) {
-    Communication_Protocol_Head msg_to_send;
-    msg_to_send.msg_size = htons(0x0003);
-    msg_to_send.msg_type = htons(SET_RADAR);
-    uint8_t buf[1] = {radar};
-    uint8_t * data = (uint8_t*) malloc(2 + msg_to_send.msg_size);
-    memcpy(data,&msg_to_send,4);
-    memcpy(data + 4,buf,sizeof(buf));
+    uint8_t * data = FRAME_POOL_new_frame(SET_RADAR, PROTOCOL_SET_RADAR_SIZE);
+    if(data == NULL) {
+        return -1;
+    }
+    PROTOCOL_put_SET_RADAR_radar(data + FRAME_POOL_HEAD_SIZE, radar);
     if(POSTMAN_send_request(data) == -1) {
+        FRAME_POOL_release(data);
         CONTROLLER_LOGGER_log(ERROR,"On POSTMAN_send_request() : viewer proxy has failed to request a data write on postman's mq.");
         return -1;
     }
     return 0;
 }
+
+int GUI_SECRETARY_PROXY_set_session(Id_Robot id_robot, uint32_t session_token, bool_e is_resumed) {
+    uint8_t * data = FRAME_POOL_new_frame(SET_SESSION, PROTOCOL_SET_SESSION_SIZE);
+    if(data == NULL) {
+        return -1;
+    }
+    uint8_t * payload = data + FRAME_POOL_HEAD_SIZE;
+    PROTOCOL_put_SET_SESSION_session_token(payload, session_token);
+    PROTOCOL_put_SET_SESSION_is_resumed(payload, is_resumed);
+    if(POSTMAN_send_request(data) == -1) {
+        FRAME_POOL_release(data);
+        CONTROLLER_LOGGER_log(ERROR,"On POSTMAN_send_request() : gui secretary proxy has failed to request a data write on postman's mq.");
+        return -1;
+    }
+    return 0;
+}
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
\ No newline at end of file
@@ -87,5 +87,17 @@ extern int GUI_SECRETARY_PROXY_disconnected_ok(Id_Robot id_robot);
  * \return On success, returns 0. On error, returns -1.
  */
 extern int GUI_SECRETARY_PROXY_set_radar(Id_Robot id_robot, bool_e radar);
+/**
+ * \fn extern int GUI_SECRETARY_PROXY_set_session(Id_Robot id_robot, uint32_t session_token, bool_e is_resumed)
+ * \brief Gives the token of the session, to be presented by SB_IHM to resume it after a reconnection.
+ * \author Prose A2
+ *
+ * \param id_robot : robot identifier.
+ * \param session_token : token of the session.
+ * \param is_resumed : TRUE when the previous session of SB_IHM has been resumed.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int GUI_SECRETARY_PROXY_set_session(Id_Robot id_robot, uint32_t session_token, bool_e is_resumed);
 
 #endif /* SRC_COM_GUI_SECRETARY_PROXY_H_ */
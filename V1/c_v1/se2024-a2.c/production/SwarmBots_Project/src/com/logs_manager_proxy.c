@@ -37,34 +37,210 @@
 /* ----------------------  INCLUDES  ---------------------------------------- */
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
 #include <arpa/inet.h>
 #include "logs_manager_proxy.h"
 #include "postman.h"
+#include "frame_pool.h"
+#include "capabilities.h"
+#include "../lib/lz4_block.h"
 #include "../logs/controller_logger.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def ENCODING_SIZE
+ * Size of the Logs_Encoding written before the logs of a page when CAPABILITY_COMPRESSION is enabled.
+ */
+#define ENCODING_SIZE 1
 /* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
 /* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
 /* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static uint8_t * LOGS_MANAGER_PROXY_next_page(bool_e is_aborted)
+ * \brief Reads the next page of the logs into a frame. Called by the postman thread, see Postman_Page_Source.
+ * \author Prose A2
+ *
+ * \param is_aborted : TRUE when the upload is aborted.
+ *
+ * \return The frame of the next page, NULL once every page has been given or on error.
+ */
+static uint8_t * LOGS_MANAGER_PROXY_next_page(bool_e is_aborted);
+/**
+ * \fn static void LOGS_MANAGER_PROXY_end_stream(void)
+ * \brief Closes the file of the logs being sent.
+ * \author Prose A2
+ */
+static void LOGS_MANAGER_PROXY_end_stream(void);
+/**
+ * \fn static uint16_t LOGS_MANAGER_PROXY_encode_page(uint8_t * payload, uint16_t logs_size)
+ * \brief Compresses the logs of a page in place when the page gets smaller, and writes their encoding before them.
+ * \author Prose A2
+ *
+ * \param payload : payload of a SET_LOGS frame, the logs written ENCODING_SIZE bytes after the page fields.
+ * \param logs_size : size in bytes of the logs.
+ *
+ * \return The size in bytes of the encoding and of the logs as sent.
+ */
+static uint16_t LOGS_MANAGER_PROXY_encode_page(uint8_t * payload, uint16_t logs_size);
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static int stream_file
+ * \brief File of the logs being sent, -1 when no upload is running.
+ */
+static int stream_file = -1;
+/**
+ * \var static uint32_t stream_size
+ * \brief Size in bytes of the logs being sent.
+ */
+static uint32_t stream_size;
+/**
+ * \var static uint32_t stream_offset
+ * \brief Offset in the file of the next page.
+ */
+static uint32_t stream_offset;
+/**
+ * \var static uint8_t stream_page
+ * \brief Number of the next page, from 1.
+ */
+static uint8_t stream_page;
+/**
+ * \var static uint8_t stream_max_page
+ * \brief Amount of pages of the upload.
+ */
+static uint8_t stream_max_page;
+/**
+ * \var static bool_e is_stream_compressed
+ * \brief TRUE when the pages of the upload are encoded, as negotiated when the upload started.
+ */
+static bool_e is_stream_compressed;
+/**
+ * \var static uint16_t stream_page_size
+ * \brief Max amount of log bytes in a page of the upload.
+ */
+static uint16_t stream_page_size;
+/**
+ * \var static uint8_t compressed_logs
+ * \brief Block of the page being compressed, copied into the frame when smaller than the logs.
+ */
+static uint8_t compressed_logs[LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE];
+/**
+ * \var static pthread_mutex_t compression_mutex
+ * \brief Pages are compressed by the logger (set_logs) and by the postman (upload).
+ */
+static pthread_mutex_t compression_mutex = PTHREAD_MUTEX_INITIALIZER;
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
-int LOGS_MANAGER_PROXY_set_logs(Log_List log_list) {
-    Communication_Protocol_Head msg_to_send;
-    uint8_t log_buff_size = (uint8_t) (log_list[0] << 8 | log_list[1]);
-    msg_to_send.msg_size = (int16_t) (2 + log_buff_size);
-    uint8_t * data = (uint8_t*) malloc(2 + msg_to_send.msg_size);
-    uint8_t buff[log_buff_size];
-    memcpy(buff,(log_list + 2) ,sizeof(buff));
-    free(log_list);
-    msg_to_send.msg_type = htons(SET_LOGS);
-    msg_to_send.msg_size = htons(msg_to_send.msg_size);
-    memcpy(data,&msg_to_send,4);
-    memcpy(data + 4,buff,sizeof(buff));
-
+int LOGS_MANAGER_PROXY_set_logs(uint8_t page, uint8_t max_page, const uint8_t * logs, uint16_t logs_size) {
+    bool_e is_compressed = CAPABILITIES_is_enabled(CAPABILITY_COMPRESSION);
+    uint16_t encoding_size = is_compressed ? ENCODING_SIZE : 0;
+    if(logs_size > LOGS_MANAGER_PROXY_MAX_PAGE_SIZE - encoding_size) {
+        CONTROLLER_LOGGER_log(ERROR,"On LOGS_MANAGER_PROXY_set_logs() : the log page does not fit in a frame.");
+        return -1;
+    }
+    uint8_t * data = FRAME_POOL_new_frame(SET_LOGS, PROTOCOL_SET_LOGS_SIZE + encoding_size + logs_size);
+    if(data == NULL) {
+        return -1;
+    }
+    uint8_t * payload = data + FRAME_POOL_HEAD_SIZE;
+    PROTOCOL_put_SET_LOGS_page(payload, page);
+    PROTOCOL_put_SET_LOGS_max_page(payload, max_page);
+    memcpy(payload + PROTOCOL_SET_LOGS_SIZE + encoding_size, logs, logs_size);
+    if(is_compressed) {
+        PROTOCOL_put_head(data, SET_LOGS, PROTOCOL_SET_LOGS_SIZE + LOGS_MANAGER_PROXY_encode_page(payload, logs_size));
+    }
     if(POSTMAN_send_request(data) == -1) {
+        FRAME_POOL_release(data);
         CONTROLLER_LOGGER_log(ERROR,"On POSTMAN_send_request() : logs manager proxy has failed to request a data write on postman's mq.");
         return -1;
     }
     return 0;
 }
-/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
\ No newline at end of file
+
+int LOGS_MANAGER_PROXY_stream_logs(int logs_file, uint32_t logs_size) {
+    bool_e is_compressed = CAPABILITIES_is_enabled(CAPABILITY_COMPRESSION);
+    uint16_t page_size = is_compressed ? LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE : LOGS_MANAGER_PROXY_MAX_PAGE_SIZE;
+    uint32_t max_page = (logs_size + page_size - 1) / page_size;
+    if(max_page == 0 || max_page > UINT8_MAX) {
+        CONTROLLER_LOGGER_log(ERROR,"On LOGS_MANAGER_PROXY_stream_logs() : the logs do not fit in the pages of an upload.");
+        close(logs_file);
+        return -1;
+    }
+    /* One upload at a time : controller_logger waits for LOGS_RECEIVED before loading the logs again. */
+    stream_file = logs_file;
+    stream_size = logs_size;
+    stream_offset = 0;
+    stream_page = 1;
+    stream_max_page = (uint8_t) max_page;
+    is_stream_compressed = is_compressed;
+    stream_page_size = page_size;
+    if(POSTMAN_stream(&LOGS_MANAGER_PROXY_next_page) == -1) {
+        LOGS_MANAGER_PROXY_end_stream();
+        CONTROLLER_LOGGER_log(ERROR,"On POSTMAN_stream() : logs manager proxy has failed to start the upload of the logs.");
+        return -1;
+    }
+    return 0;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static uint8_t * LOGS_MANAGER_PROXY_next_page(bool_e is_aborted) {
+    if(is_aborted || stream_offset >= stream_size) {
+        LOGS_MANAGER_PROXY_end_stream();
+        return NULL;
+    }
+    uint32_t logs_left = stream_size - stream_offset;
+    uint16_t logs_size = logs_left < stream_page_size ? (uint16_t) logs_left : stream_page_size;
+    uint16_t encoding_size = is_stream_compressed ? ENCODING_SIZE : 0;
+    uint8_t * data = FRAME_POOL_new_frame(SET_LOGS, PROTOCOL_SET_LOGS_SIZE + encoding_size + logs_size);
+    if(data == NULL) {
+        LOGS_MANAGER_PROXY_end_stream();
+        return NULL;
+    }
+    uint8_t * payload = data + FRAME_POOL_HEAD_SIZE;
+    uint8_t * logs = payload + PROTOCOL_SET_LOGS_SIZE + encoding_size;
+    PROTOCOL_put_SET_LOGS_page(payload, stream_page);
+    PROTOCOL_put_SET_LOGS_max_page(payload, stream_max_page);
+    for(uint16_t amount_read = 0; amount_read < logs_size; ) {
+        ssize_t read_size = pread(stream_file, logs + amount_read, logs_size - amount_read, stream_offset + amount_read);
+        if(read_size <= 0) {
+            if(read_size == -1 && errno == EINTR) {
+                continue;
+            }
+            CONTROLLER_LOGGER_log(ERROR,"On pread() : logs manager proxy has failed to read a page of the logs.");
+            FRAME_POOL_release(data);
+            LOGS_MANAGER_PROXY_end_stream();
+            return NULL;
+        }
+        amount_read += (uint16_t) read_size;
+    }
+    if(is_stream_compressed) {
+        PROTOCOL_put_head(data, SET_LOGS, PROTOCOL_SET_LOGS_SIZE + LOGS_MANAGER_PROXY_encode_page(payload, logs_size));
+    }
+    stream_offset += logs_size;
+    stream_page++;
+    return data;
+}
+
+static void LOGS_MANAGER_PROXY_end_stream(void) {
+    if(stream_file != -1) {
+        close(stream_file);
+        stream_file = -1;
+    }
+}
+
+static uint16_t LOGS_MANAGER_PROXY_encode_page(uint8_t * payload, uint16_t logs_size) {
+    uint8_t * encoding = payload + PROTOCOL_SET_LOGS_SIZE;
+    uint8_t * logs = encoding + ENCODING_SIZE;
+    pthread_mutex_lock(&compression_mutex);
+    /* A block not smaller than the logs is dropped : the page is sent as it is. */
+    int block_size = LZ4_BLOCK_compress(logs, logs_size, compressed_logs, logs_size);
+    if(block_size != -1 && block_size < logs_size) {
+        memcpy(logs, compressed_logs, (size_t) block_size);
+        logs_size = (uint16_t) block_size;
+        *encoding = LOGS_ENCODING_LZ4;
+    }
+    else {
+        *encoding = LOGS_ENCODING_RAW;
+    }
+    pthread_mutex_unlock(&compression_mutex);
+    return ENCODING_SIZE + logs_size;
+}
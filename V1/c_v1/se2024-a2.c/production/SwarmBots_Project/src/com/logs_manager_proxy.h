@@ -39,19 +39,46 @@
 /* ----------------------  INCLUDES ------------------------------------------*/
 #include "../lib/defs.h"
 /* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/**
+ * \def LOGS_MANAGER_PROXY_MAX_PAGE_SIZE
+ * Max amount of log bytes in a page : the payload also carries the page number and the page count.
+ */
+#define LOGS_MANAGER_PROXY_MAX_PAGE_SIZE   0xFFFB
+/**
+ * \def LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE
+ * Max amount of log bytes in a page when CAPABILITY_COMPRESSION is enabled : the encoding of the page comes before them.
+ */
+#define LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE   (LOGS_MANAGER_PROXY_MAX_PAGE_SIZE - 1)
 /* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
 /* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
 /* ----------------------  PUBLIC VARIABLES ----------------------------------*/
 /* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
 /**
- * \fn extern int LOGS_MANAGER_PROXY_set_logs(Log_List log_list)
- * \brief Sends the logs of SB_C.
+ * \fn extern int LOGS_MANAGER_PROXY_set_logs(uint8_t page, uint8_t max_page, const uint8_t * logs, uint16_t logs_size)
+ * \brief Sends a page of the logs of SB_C, compressed when SB_IHM has CAPABILITY_COMPRESSION.
  * \author Joshua MONTREUIL
  *
- * \param log_list : Logs to send.
+ * \param page : number of the page, from 1.
+ * \param max_page : amount of pages of the logs.
+ * \param logs : logs of the page, copied into the frame.
+ * \param logs_size : size in bytes of the logs of the page, up to LOGS_MANAGER_PROXY_MAX_PAGE_SIZE, or
+ * LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE when CAPABILITY_COMPRESSION is enabled.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-extern int LOGS_MANAGER_PROXY_set_logs(Log_List log_list);
+extern int LOGS_MANAGER_PROXY_set_logs(uint8_t page, uint8_t max_page, const uint8_t * logs, uint16_t logs_size);
+/**
+ * \fn extern int LOGS_MANAGER_PROXY_stream_logs(int logs_file, uint32_t logs_size)
+ * \brief Sends the logs of SB_C page by page, each page being read from the file only when the postman pulls it.
+ * The pages are compressed one by one when SB_IHM has CAPABILITY_COMPRESSION at the start of the upload.
+ * \author Prose A2
+ *
+ * \param logs_file : file descriptor of the logs, read from its beginning and closed by the proxy at the end of the
+ * upload.
+ * \param logs_size : size in bytes of the logs to send, up to 255 pages.
+ *
+ * \return On success, returns 0. On error, returns -1 and the file is closed.
+ */
+extern int LOGS_MANAGER_PROXY_stream_logs(int logs_file, uint32_t logs_size);
 
 #endif /* SRC_COM_LOGS_MANAGER_PROXY_H_ */
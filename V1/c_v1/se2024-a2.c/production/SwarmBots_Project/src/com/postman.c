@@ -41,14 +41,27 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <string.h>
+#include <limits.h>
+#include <time.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
 #include <sys/socket.h>
-#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
 #include <pthread.h>
-#include <mqueue.h>
+#include "../config.h"
+#include "../lib/defs.h"
+#include "../lib/actor.h"
+#include "../lib/protocol.h"
+#include "capabilities.h"
+#include "frame_pool.h"
+#include "frame_reader.h"
 #include "../controller/controller_core.h"
+#include "../controller/pilot.h"
 #include "../logs/controller_logger.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
 #define STATE_GENERATION S(S_FORGET) S(S_WAITING_CONNECTION) S(S_WRITE_MSG_ON_SOCKET) S(S_DEATH)
@@ -57,22 +70,27 @@ typedef enum {STATE_GENERATION STATE_NB} State_Machine;
 #undef STATE_GENERATION
 #undef S
 
-#define ACTION_GENERATION A(A_NOP) A(A_DISCONNECT) A(A_CONNECTED) A(A_CONNECTION_POLLING) A(A_SEND) A(A_STOP)
+#define ACTION_GENERATION A(A_NOP) A(A_DISCONNECT) A(A_CONNECTED) A(A_OBSERVER_CONNECTED) A(A_CONNECTION_LOST) A(A_SEND) A(A_FLUSH) A(A_DRAIN_OBSERVER) A(A_DRIVE) A(A_DRAIN_TELEOP) A(A_STREAM) A(A_STOP)
 #define A(x) x,
 typedef enum {ACTION_GENERATION ACTION_NB} Action;
 #undef ACTION_GENERATION
 #undef A
 
-#define EVENT_GENERATION E(E_CONNECTION) E(E_WRITE_REQUEST) E(E_DISCONNECTION) E(E_POLL_CONNECTION) E(E_STOP)
+#define EVENT_GENERATION E(E_CONNECTION) E(E_WRITE_REQUEST) E(E_DISCONNECTION) E(E_HANG_UP) E(E_WRITABLE) E(E_OBSERVER_INPUT) E(E_TELEOP_INPUT) E(E_STREAM) E(E_STOP)
 #define E(x) x,
 typedef enum {EVENT_GENERATION EVENT_NB} Event;
 #undef EVENT_GENERATION
 #undef E
 /**
 * \def MAX_PENDING_CONNECTIONS
-* Max amount of connected clients.
+* Max amount of connections waiting to be accepted.
 */
-#define MAX_PENDING_CONNECTIONS 1
+#define MAX_PENDING_CONNECTIONS CONFIG_POSTMAN_MAX_CLIENTS
+/**
+ * \def OPERATOR_SLOT
+ * Index of the operator in the connection table. The other slots hold the observers.
+ */
+#define OPERATOR_SLOT 0
 /**
  * \def MQ_POSTMAN_BOX_NAME
  * Name of the message queue
@@ -88,6 +106,40 @@ typedef enum {EVENT_GENERATION EVENT_NB} Event;
  * Server port.
  */
 #define SERVER_PORT 12345
+/**
+ * \def MAX_EPOLL_EVENTS
+ * Max amount of events returned by a single epoll_wait() call (one per watched source).
+ */
+#define MAX_EPOLL_EVENTS (CONFIG_POSTMAN_MAX_CLIENTS + 3)
+/**
+ * \def MAX_FRAMES_PER_SEND
+ * Max amount of queued frames handed to a single sendmsg() call.
+ */
+#if CONFIG_POSTMAN_CLIENT_QUEUE_SIZE * LANE_NB < IOV_MAX
+#define MAX_FRAMES_PER_SEND (CONFIG_POSTMAN_CLIENT_QUEUE_SIZE * LANE_NB)
+#else
+#define MAX_FRAMES_PER_SEND IOV_MAX
+#endif
+#if CONFIG_POSTMAN_STREAM_WINDOW > CONFIG_POSTMAN_CLIENT_QUEUE_SIZE
+#error "The window of a stream must fit in the queue of a lane."
+#endif
+/**
+ * \def DRAIN_BUFFER_SIZE
+ * Size of the buffer used to throw away what the observers send.
+ */
+#define DRAIN_BUFFER_SIZE 256
+/**
+ * \def TELEOP_DATAGRAM_SIZE
+ * Size of a teleoperation datagram : an ASK_CMD frame whose payload is a 32 bits sequence number, a 32 bits
+ * timestamp in milliseconds from the clock of SB_IHM and the command, all big endian. The clocks are not
+ * synchronized : the timestamp only tells how late a command is compared to the fastest one.
+ */
+#define TELEOP_DATAGRAM_SIZE 13
+/**
+ * \def LANE_PRIORITY(lane)
+ * Priority of the requests of a lane in the mail box, the control lane being the highest.
+ */
+#define LANE_PRIORITY(lane) ((unsigned int)(LANE_NB - 1 - (lane)))
 /* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
 /**
  * \struct Mq_Msg_Data postman.c "com/postman.c"
@@ -98,6 +150,10 @@ typedef enum {EVENT_GENERATION EVENT_NB} Event;
 typedef struct {
     Event event; /**< Event to change the state of the state machine. */
     uint8_t * data; /**< Data to send through socket. */
+    Postman_Lane lane; /**< Priority lane of the data to send. */
+    uint64_t request_time; /**< Time of the write request, in microseconds. */
+    Postman_Page_Source page_source; /**< Source of the pages of a stream. */
+    int client; /**< Slot of the connection the event comes from (socket events only). */
 } Mq_Msg_Data;
 /**
  * \union Mq_Msg postman.c "com/postman.c"
@@ -110,148 +166,510 @@ typedef union {
 	char buffer[sizeof(Mq_Msg_Data)]; /**< Raw message. */
 } Mq_Msg;
 /**
- * \struct Transition postman.c "com/postman.c"
- * \brief Gives an action and state destination for a transition.
- *
- * Transition gives the action to perform when an event has been fired. Also gives the destination state.
+ * \typedef int(*Action_Pt)(Mq_Msg_Data * msg_data)
+ * \brief Definition of function pointer for the actions to perform.
+ */
+typedef int(*Action_Pt)(Mq_Msg_Data * msg_data);
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Lane_Queue postman.c "com/postman.c"
+ * \brief Bounded queue of the frames of one priority lane waiting to be written to a client.
  */
 typedef struct {
-	State_Machine state_destination; /**< Next state. */
-	Action action; /**< Action to perform from previous the event. */
-} Transition;
+    uint8_t * frames[CONFIG_POSTMAN_CLIENT_QUEUE_SIZE]; /**< Frames waiting to be written, oldest first. */
+    uint64_t request_times[CONFIG_POSTMAN_CLIENT_QUEUE_SIZE]; /**< Time of the write request of each frame, in microseconds. */
+    int first_frame; /**< Index of the oldest frame. */
+    int frames_nb; /**< Amount of frames waiting. */
+} Lane_Queue;
 /**
- * \typedef int(*Action_Pt)(uint8_t * raw_data)
- * \brief Definition of function pointer for the actions to perform.
+ * \struct Connection postman.c "com/postman.c"
+ * \brief Entry of the connection table : a client socket and its bounded queues of frames to write.
  */
-typedef int(*Action_Pt)(uint8_t * raw_data);
-/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+typedef struct {
+    int socket; /**< Socket of the client, -1 when the slot is free. */
+    bool_e is_hung_up; /**< The client hung up, frames for it are dropped until the slot is closed. */
+    bool_e is_watching_output; /**< EPOLLOUT is watched because the socket buffer was full. */
+    Lane_Queue lanes[LANE_NB]; /**< Frames waiting to be written, one queue per priority lane. */
+    int frames_nb; /**< Amount of frames waiting in every lane. */
+    Postman_Lane partial_lane; /**< Lane whose oldest frame is partially written, when offset is not 0. */
+    size_t offset; /**< Amount of bytes of the partially written frame already written. */
+} Connection;
 /* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/**
+ * \enum Event_Source postman.c "com/postman.c"
+ * \brief Tags the file descriptors watched by the postman epoll instance.
+ */
+typedef enum {
+    SOURCE_MAIL_BOX = 0, /**< Postman's message queue (write, disconnection and stop requests). */
+    SOURCE_LISTEN_SOCKET, /**< Listening socket, readable when a connection is pending. */
+    SOURCE_TELEOP, /**< Teleoperation socket, readable when drive commands have been received. */
+    SOURCE_CLIENT /**< First client of the connection table, SOURCE_CLIENT + n is the client of slot n. */
+} Event_Source;
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
 /* ----- PASSIVES ----- */
 /**
- * \fn static uint8_t* POSTMAN_read_msg(void)
- * \brief Reads messages on the socket.
+ * \fn static int POSTMAN_read_msg(const uint8_t ** frame)
+ * \brief Reads the next frame sent by the operator. The socket is only read when no complete frame is left
+ * in the receive buffer.
  * \author Joshua MONTREUIL
  *
- * \param raw_message : raw_message pointer.
+ * \param frame : set to the frame in the receive buffer, valid until the next read.
+ *
+ * \return The size in bytes of the frame, 0 when the connection is closed. On error, returns -1.
+ */
+static int POSTMAN_read_msg(const uint8_t ** frame);
+/**
+ * \fn static int POSTMAN_watch(int fd, int source, uint32_t events)
+ * \brief Adds a file descriptor to the postman epoll instance.
+ * \author Prose A2
+ *
+ * \param fd : file descriptor to watch.
+ * \param source : tag given back by epoll_wait() for this file descriptor.
+ * \param events : epoll events to watch.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_watch(int fd, int source, uint32_t events);
+/**
+ * \fn static int POSTMAN_unwatch(int fd)
+ * \brief Removes a file descriptor from the postman epoll instance.
+ * \author Prose A2
+ *
+ * \param fd : file descriptor to forget.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_unwatch(int fd);
+/**
+ * \fn static int POSTMAN_watch_output(int client, bool_e is_watching_output)
+ * \brief Starts or stops watching the writability of a client socket.
+ * \author Prose A2
+ *
+ * \param client : slot of the client.
+ * \param is_watching_output : TRUE to be woken up when the socket can be written again.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_watch_output(int client, bool_e is_watching_output);
+/**
+ * \fn static int POSTMAN_accept(int client)
+ * \brief Accepts a pending connection into a slot of the connection table.
+ * \author Prose A2
+ *
+ * \param client : free slot receiving the connection.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_accept(int client);
+/**
+ * \fn static void POSTMAN_close_connection(int client)
+ * \brief Closes the socket of a client, drops its waiting frames and frees its slot.
+ * \author Prose A2
+ *
+ * \param client : slot of the client.
+ */
+static void POSTMAN_close_connection(int client);
+/**
+ * \fn static void POSTMAN_hand_socket(int operator_socket)
+ * \brief Gives the dispatcher thread the socket to read from its next read on. A socket it has not taken is closed.
+ * \author Prose A2
+ *
+ * \param operator_socket : duplicate of the operator socket, -1 when there is nothing left to read.
+ */
+static void POSTMAN_hand_socket(int operator_socket);
+/**
+ * \fn static void POSTMAN_drop_frames(int client)
+ * \brief Releases every frame waiting in the queue of a client.
+ * \author Prose A2
+ *
+ * \param client : slot of the client.
+ */
+static void POSTMAN_drop_frames(int client);
+/**
+ * \fn static void POSTMAN_pop_frame(Connection * connection, Postman_Lane lane, bool_e is_written)
+ * \brief Releases the oldest frame of a lane of a client and accounts for it in the lane statistics.
+ * \author Prose A2
+ *
+ * \param connection : connection of the client.
+ * \param lane : lane of the frame.
+ * \param is_written : TRUE when the frame has been fully written, FALSE when it is dropped.
+ */
+static void POSTMAN_pop_frame(Connection * connection, Postman_Lane lane, bool_e is_written);
+/**
+ * \fn static void POSTMAN_pull_pages(void)
+ * \brief Asks the source of the running stream for pages until the window of the stream is full.
+ * \author Prose A2
+ */
+static void POSTMAN_pull_pages(void);
+/**
+ * \fn static void POSTMAN_abort_stream(void)
+ * \brief Aborts the running stream, if any.
+ * \author Prose A2
+ */
+static void POSTMAN_abort_stream(void);
+/**
+ * \fn static void POSTMAN_enqueue(int client, uint8_t * frame, Postman_Lane lane, uint64_t request_time)
+ * \brief Puts a frame into the queue of its lane for a client. The queues are written once every pending request
+ * has been received, see POSTMAN_flush_all(). A frame that still finds its queue full after a flush is dropped for
+ * this client only.
+ * \author Prose A2
+ *
+ * \param client : slot of the client.
+ * \param frame : frame to write, owned by the postman from now on.
+ * \param lane : lane of the frame.
+ * \param request_time : time of the write request, in microseconds.
+ */
+static void POSTMAN_enqueue(int client, uint8_t * frame, Postman_Lane lane, uint64_t request_time);
+/**
+ * \fn static int POSTMAN_flush(int client)
+ * \brief Writes the waiting frames of a client without blocking. Every waiting frame goes into one sendmsg()
+ * call : the end of a partially written frame first, then the lanes in priority order. A bulk frame thus yields to
+ * the frames of the other lanes as soon as it has been fully written.
+ * \author Prose A2
+ *
+ * \param client : slot of the client.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_flush(int client);
+/**
+ * \fn static int POSTMAN_flush_all(void)
+ * \brief Writes the waiting frames of every client whose socket is not known to be full.
+ * \author Prose A2
  *
- * \return uint8_t* : Raw message in a buffer from socket on success. NULL on failure.
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_flush_all(void);
+/**
+ * \fn static bool_e POSTMAN_is_broadcast(const uint8_t * frame)
+ * \brief Tells if a frame is sent to every client or only to the operator.
+ * \author Prose A2
+ *
+ * \param frame : frame to send.
+ *
+ * \return TRUE for SET_RADAR, ALERT and SET_MODE frames, FALSE otherwise.
+ */
+static bool_e POSTMAN_is_broadcast(const uint8_t * frame);
+/**
+ * \fn static Postman_Lane POSTMAN_get_lane(const uint8_t * frame)
+ * \brief Gives the priority lane of a frame from its type.
+ * \author Prose A2
+ *
+ * \param frame : frame to send.
+ *
+ * \return LANE_CONTROL for ALERT, SET_AVAILABILITY, ACK_DISCONNECTION and SET_SESSION frames, LANE_BULK for SET_LOGS
+ * frames, LANE_STATE otherwise.
+ */
+static Postman_Lane POSTMAN_get_lane(const uint8_t * frame);
+/**
+ * \fn static uint64_t POSTMAN_now_us(void)
+ * \brief Gives the time of the monotonic clock.
+ * \author Prose A2
+ *
+ * \return The time in microseconds.
  */
-static uint8_t* POSTMAN_read_msg(void);
+static uint64_t POSTMAN_now_us(void);
+/**
+ * \fn static int POSTMAN_enter_lane(Postman_Lane lane, bool_e is_waiting)
+ * \brief Accounts for a new frame in a lane. A bulk frame may wait for the bulk frames in flight to be written.
+ * \author Prose A2
+ *
+ * \param lane : lane of the frame.
+ * \param is_waiting : TRUE to wait while CONFIG_POSTMAN_BULK_FRAMES bulk frames are in flight.
+ *
+ * \return On success, returns 0. When no room has been made in time, returns -1.
+ */
+static int POSTMAN_enter_lane(Postman_Lane lane, bool_e is_waiting);
+/**
+ * \fn static void POSTMAN_leave_lane(Postman_Lane lane, uint64_t request_time, bool_e is_written)
+ * \brief Accounts for a frame leaving a lane, written or dropped.
+ * \author Prose A2
+ *
+ * \param lane : lane of the frame.
+ * \param request_time : time of the write request, in microseconds.
+ * \param is_written : TRUE when the frame has been fully written, FALSE when it is dropped.
+ */
+static void POSTMAN_leave_lane(Postman_Lane lane, uint64_t request_time, bool_e is_written);
 /* ----- ACTIVE ----- */
 /**
- * \fn static void * POSTMAN_run(void * arg)
- * \brief Called by a thread. This function is the "active" part of the postman. It connects SB_IHM? It reads messages received in the
- * message queue and sends it through socket.
+ * \fn static void * POSTMAN_run(Actor * actor)
+ * \brief Loop of the postman actor. It sleeps on an epoll instance watching the message queue, the listening
+ * socket and the client sockets, and turns every wake up into an event for the state machine. Nothing wakes the
+ * thread up while the robot is idle.
  * \author Joshua MONTREUIL
  *
- * \param arg : argument pointer.
+ * \param actor : the postman actor.
  *
- * \return void * : On success, returns 0. On error, returns -1.
+ * \return void * : NULL.
  */
-static void * POSTMAN_run(void * arg);
+static void * POSTMAN_run(Actor * actor);
 /**
- * \fn static int POSTMAN_mq_receive(Mq_Msg * a_msg)
- * \brief Receives the messages from the queue.
- * \author Joshua MONTREUIL
+ * \fn static int POSTMAN_perform(int action, void * msg)
+ * \brief Performs an action of the state machine for the postman actor, with the data of the message.
+ * \author Prose A2
  *
- * \param a_msg : pointer to Mq_Msg struct.
+ * \param action : action to perform.
+ * \param msg : pointer to the Mq_Msg that triggered the action.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-static int POSTMAN_mq_receive(Mq_Msg * a_msg);
+static int POSTMAN_perform(int action, void * msg);
 /**
- * \fn static int POSTMAN_mq_send(Mq_Msg * a_msg)
+ * \fn static int POSTMAN_mq_try_receive(Mq_Msg * a_msg)
+ * \brief Receives a message from the queue without waiting.
+ * \author Prose A2
+ *
+ * \param a_msg : pointer to Mq_Msg struct.
+ *
+ * \return Returns 1 when a message has been received, 0 when the queue is empty. On error, returns -1.
+ */
+static int POSTMAN_mq_try_receive(Mq_Msg * a_msg);
+/**
+ * \fn static int POSTMAN_mq_send(Mq_Msg * a_msg, Postman_Lane lane)
  * \brief Sends a message into the queue.
  * \author Joshua MONTREUIL
  *
  * \param a_msg : pointer to Mq_Msg struct.
+ * \param lane : lane giving the priority of the message, received before the messages of the next lanes.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-static int POSTMAN_mq_send(Mq_Msg * a_msg);
+static int POSTMAN_mq_send(Mq_Msg * a_msg, Postman_Lane lane);
 /* ----- ACTIONS ----- */
 /**
- * \fn static void POSTMAN_action_nop(uint8_t * raw_data)
+ * \fn static void POSTMAN_action_nop(Mq_Msg_Data * msg_data)
  * \brief Used to ignore state case that aren't into the state machine.
  * \author Joshua MONTREUIL
  *
- * \param raw_data : raw data to send.
+ * \param msg_data : data of the event.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-static int POSTMAN_action_nop(uint8_t * raw_data);
+static int POSTMAN_action_nop(Mq_Msg_Data * msg_data);
 /**
- * \fn static int POSTMAN_action_disconnection(uint8_t * raw_data)
- * \brief Handles a disconnection.
+ * \fn static int POSTMAN_action_disconnection(Mq_Msg_Data * msg_data)
+ * \brief Handles a disconnection of the operator : closes its socket and accepts connections again.
  * \author Joshua MONTREUIL
  *
- * \param raw_data : raw data to send.
+ * \param msg_data : data of the event.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-static int POSTMAN_action_disconnection(uint8_t * raw_data);
+static int POSTMAN_action_disconnection(Mq_Msg_Data * msg_data);
 /**
- * \fn static void POSTMAN_action_connected(uint8_t * raw_data)
- * \brief Passive function to log when SB_IHM is connected.
+ * \fn static void POSTMAN_action_connected(Mq_Msg_Data * msg_data)
+ * \brief Accepts the pending connection of the operator SB_IHM and notifies controller_core.
  * \author Joshua MONTREUIL
  *
- * \param raw_data : raw data to send.
+ * \param msg_data : data of the event.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-static int POSTMAN_action_connected(uint8_t * raw_data);
+static int POSTMAN_action_connected(Mq_Msg_Data * msg_data);
 /**
- * \fn static int POSTMAN_action_polling_connection(uint8_t * raw_data))
- * \brief Waits a connection to the socket.
- * \author Joshua MONTREUIL
+ * \fn static int POSTMAN_action_observer_connected(Mq_Msg_Data * msg_data)
+ * \brief Accepts the pending connection of an observer, or refuses it when the connection table is full.
+ * \author Prose A2
  *
- * \param a_msg : pointer to Mq_Msg struct.
+ * \param msg_data : data of the event.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_action_observer_connected(Mq_Msg_Data * msg_data);
+/**
+ * \fn static int POSTMAN_action_connection_lost(Mq_Msg_Data * msg_data)
+ * \brief Stops watching the socket of an operator who hung up and notifies controller_core of the lost connection.
+ * \author Prose A2
+ *
+ * \param msg_data : data of the event.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-static int POSTMAN_action_polling_connection(uint8_t * raw_data);
+static int POSTMAN_action_connection_lost(Mq_Msg_Data * msg_data);
 /**
- * \fn static int POSTMAN_action_send_msg(uint8_t * raw_data)
- * \brief Sends a message through socket.
+ * \fn static int POSTMAN_action_send_msg(Mq_Msg_Data * msg_data)
+ * \brief Routes a frame to the operator, or to every client for a broadcast frame.
  * \author Joshua MONTREUIL
  *
- * \param raw_data : raw data to send.
+ * \param msg_data : data of the event, holding the frame to send.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_action_send_msg(Mq_Msg_Data * msg_data);
+/**
+ * \fn static int POSTMAN_action_flush(Mq_Msg_Data * msg_data)
+ * \brief Writes the frames waiting for a client whose socket can be written again.
+ * \author Prose A2
+ *
+ * \param msg_data : data of the event, holding the slot of the client.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_action_flush(Mq_Msg_Data * msg_data);
+/**
+ * \fn static int POSTMAN_action_drain_observer(Mq_Msg_Data * msg_data)
+ * \brief Throws away what an observer sends and closes its slot when it hangs up.
+ * \author Prose A2
+ *
+ * \param msg_data : data of the event, holding the slot of the client.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_action_drain_observer(Mq_Msg_Data * msg_data);
+/**
+ * \fn static int POSTMAN_action_drive(Mq_Msg_Data * msg_data)
+ * \brief Reads every waiting teleoperation datagram and gives the newest command of the operator to pilot.
+ * Commands older than the last one applied, or delayed more than CONFIG_POSTMAN_TELEOP_MAX_AGE_MS, are dropped.
+ * \author Prose A2
+ *
+ * \param msg_data : data of the event.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_action_drive(Mq_Msg_Data * msg_data);
+/**
+ * \fn static int POSTMAN_action_drain_teleop(Mq_Msg_Data * msg_data)
+ * \brief Throws away the teleoperation datagrams received while no operator is connected.
+ * \author Prose A2
+ *
+ * \param msg_data : data of the event.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_action_drain_teleop(Mq_Msg_Data * msg_data);
+/**
+ * \fn static int POSTMAN_action_stream(Mq_Msg_Data * msg_data)
+ * \brief Starts pulling the pages of a stream, or aborts it at once when no operator can receive it.
+ * \author Prose A2
+ *
+ * \param msg_data : data of the event, holding the source of the pages.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-static int POSTMAN_action_send_msg(uint8_t * raw_data);
+static int POSTMAN_action_stream(Mq_Msg_Data * msg_data);
+/**
+ * \fn static int POSTMAN_action_stop(Mq_Msg_Data * msg_data)
+ * \brief Closes every client connection.
+ * \author Prose A2
+ *
+ * \param msg_data : data of the event.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int POSTMAN_action_stop(Mq_Msg_Data * msg_data);
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
  * \var static int listen_socket
  * \brief Listening socket identifier.
  */
-static int listen_socket;
+static int listen_socket = -1;
 /**
- * \var static int data_socket
- * \brief Listening socket identifier.
+ * \var static bool_e is_listening
+ * \brief Tells if the listening socket is watched by the epoll instance.
  */
-static int data_socket;
+static bool_e is_listening = FALSE;
 /**
- * \var static pthread_t postman_thread
- * \brief Postman thread.
+ * \var static Connection connections[CONFIG_POSTMAN_MAX_CLIENTS]
+ * \brief Connection table. The operator is in OPERATOR_SLOT, the observers in the other slots.
  */
-static pthread_t postman_thread;
+static Connection connections[CONFIG_POSTMAN_MAX_CLIENTS];
 /**
- * \var static mqd_t my_mail_box
- * \brief Message queue reference.
+ * \var static int teleop_socket
+ * \brief Teleoperation socket, -1 when the channel is disabled.
  */
-static mqd_t my_mail_box;
+static int teleop_socket = -1;
+/**
+ * \var static struct sockaddr_in operator_address
+ * \brief Address of the operator, the only one allowed to drive the robot.
+ */
+static struct sockaddr_in operator_address;
+/**
+ * \var static uint32_t last_teleop_sequence
+ * \brief Sequence number of the last drive command applied.
+ */
+static uint32_t last_teleop_sequence;
+/**
+ * \var static bool_e is_teleop_sequence_set
+ * \brief Tells if a drive command has been applied since the operator is connected.
+ */
+static bool_e is_teleop_sequence_set = FALSE;
+/**
+ * \var static uint32_t teleop_clock_offset
+ * \brief Smallest difference in milliseconds between our clock and the timestamp of a drive command since the
+ * operator is connected : the clock offset plus the fastest transit.
+ */
+static uint32_t teleop_clock_offset;
+/**
+ * \var static bool_e is_teleop_clock_set
+ * \brief Tells if teleop_clock_offset has been measured since the operator is connected.
+ */
+static bool_e is_teleop_clock_set = FALSE;
+/**
+ * \var static Postman_Lane_Stats lane_stats[LANE_NB]
+ * \brief Statistics of each priority lane.
+ */
+static Postman_Lane_Stats lane_stats[LANE_NB];
+/**
+ * \var static pthread_mutex_t lane_stats_mutex
+ * \brief Protects the wait of the bulk senders. The statistics themselves are updated with atomic operations.
+ */
+static pthread_mutex_t lane_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * \var static pthread_cond_t bulk_room
+ * \brief Signaled each time a bulk frame leaves its lane.
+ */
+static pthread_cond_t bulk_room = PTHREAD_COND_INITIALIZER;
+/**
+ * \var static Postman_Page_Source page_source
+ * \brief Source of the pages of the running stream, NULL when no stream is running.
+ */
+static Postman_Page_Source page_source = NULL;
+/**
+ * \var static Frame_Reader operator_reader
+ * Receive buffer of the operator connection, only used by the dispatcher thread.
+ */
+static Frame_Reader operator_reader;
+/**
+ * \var static int reading_socket
+ * \brief Duplicate of the operator socket read by the dispatcher thread, -1 when it has nothing to read. Only
+ * touched by the dispatcher thread : closing the operator socket can never hand its number over under a read.
+ */
+static int reading_socket = -1;
+/**
+ * \var static unsigned int reading_connection
+ * \brief Value of handed_connection when the dispatcher thread has taken reading_socket.
+ */
+static unsigned int reading_connection;
+/**
+ * \var static int handed_socket
+ * \brief Duplicate of the socket of the last operator accepted, -1 once taken by the dispatcher thread.
+ */
+static int handed_socket = -1;
+/**
+ * \var static unsigned int handed_connection
+ * \brief Incremented each time the operator connection is opened or closed by the postman thread.
+ */
+static unsigned int handed_connection;
+/**
+ * \var static pthread_mutex_t handed_socket_mutex
+ * \brief Protects handed_socket and handed_connection, shared by the postman thread and the dispatcher thread.
+ */
+static pthread_mutex_t handed_socket_mutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * \var static int epoll_fd
+ * \brief Epoll instance the postman thread sleeps on.
+ */
+static int epoll_fd = -1;
+/**
+ * \var static Actor * my_actor
+ * \brief Actor of the postman : its mailbox, one priority for each lane, and its state machine.
+ */
+static Actor * my_actor;
 /**
  * \var static struct sockaddr_in my_address
  * \brief Address parameters of the server.
  */
 static struct sockaddr_in my_address;
-/**
- * \var tatic bool_e is_in_waiting_connection
- * \brief Tells if the postman thread is blocked waiting a connection. (used only for stop).
- */
-static bool_e is_in_waiting_connection = FALSE;
 /**
  * \var static const Action_Pt actions_tab[ACTION_NB]
  * \brief Array of function pointer to call from action to perform.
@@ -260,59 +678,112 @@ static const Action_Pt actions_tab[ACTION_NB] = {
     &POSTMAN_action_nop,
     &POSTMAN_action_disconnection,
     &POSTMAN_action_connected,
-    &POSTMAN_action_polling_connection,
+    &POSTMAN_action_observer_connected,
+    &POSTMAN_action_connection_lost,
     &POSTMAN_action_send_msg,
-    &POSTMAN_action_nop
+    &POSTMAN_action_flush,
+    &POSTMAN_action_drain_observer,
+    &POSTMAN_action_drive,
+    &POSTMAN_action_drain_teleop,
+    &POSTMAN_action_stream,
+    &POSTMAN_action_stop
 };
 /**
  * \var static Transition my_state_machine [STATE_NB -1][EVENT_NB]
- * \brief Array representing the state machine.
+ * \brief Array representing the state machine. The states follow the operator connection, the observers
+ * can come and go in both states.
  */
-static Transition my_state_machine [STATE_NB -1][EVENT_NB] = {
-    [S_WAITING_CONNECTION]  [E_POLL_CONNECTION] = {S_WAITING_CONNECTION,    A_CONNECTION_POLLING},
+static const Actor_Transition my_state_machine [STATE_NB -1][EVENT_NB] = {
     [S_WAITING_CONNECTION]  [E_CONNECTION]      = {S_WRITE_MSG_ON_SOCKET,   A_CONNECTED},
+    [S_WAITING_CONNECTION]  [E_WRITE_REQUEST]   = {S_WAITING_CONNECTION,    A_SEND},
+    [S_WAITING_CONNECTION]  [E_WRITABLE]        = {S_WAITING_CONNECTION,    A_FLUSH},
+    [S_WAITING_CONNECTION]  [E_OBSERVER_INPUT]  = {S_WAITING_CONNECTION,    A_DRAIN_OBSERVER},
+    [S_WAITING_CONNECTION]  [E_TELEOP_INPUT]    = {S_WAITING_CONNECTION,    A_DRAIN_TELEOP},
+    [S_WAITING_CONNECTION]  [E_STREAM]          = {S_WAITING_CONNECTION,    A_STREAM},
     [S_WAITING_CONNECTION]  [E_STOP]            = {S_DEATH,                 A_STOP},
+    [S_WRITE_MSG_ON_SOCKET] [E_CONNECTION]      = {S_WRITE_MSG_ON_SOCKET,   A_OBSERVER_CONNECTED},
     [S_WRITE_MSG_ON_SOCKET] [E_WRITE_REQUEST]   = {S_WRITE_MSG_ON_SOCKET,   A_SEND},
+    [S_WRITE_MSG_ON_SOCKET] [E_WRITABLE]        = {S_WRITE_MSG_ON_SOCKET,   A_FLUSH},
+    [S_WRITE_MSG_ON_SOCKET] [E_OBSERVER_INPUT]  = {S_WRITE_MSG_ON_SOCKET,   A_DRAIN_OBSERVER},
+    [S_WRITE_MSG_ON_SOCKET] [E_TELEOP_INPUT]    = {S_WRITE_MSG_ON_SOCKET,   A_DRIVE},
     [S_WRITE_MSG_ON_SOCKET] [E_DISCONNECTION]   = {S_WAITING_CONNECTION,    A_DISCONNECT},
-    [S_WRITE_MSG_ON_SOCKET] [E_CONNECTION]      = {S_WRITE_MSG_ON_SOCKET,   A_CONNECTED},
+    [S_WRITE_MSG_ON_SOCKET] [E_HANG_UP]         = {S_WRITE_MSG_ON_SOCKET,   A_CONNECTION_LOST},
+    [S_WRITE_MSG_ON_SOCKET] [E_STREAM]          = {S_WRITE_MSG_ON_SOCKET,   A_STREAM},
     [S_WRITE_MSG_ON_SOCKET] [E_STOP]            = {S_DEATH,                 A_STOP},
 };
+/**
+ * \var static const Actor_Descriptor my_descriptor
+ * \brief Mailbox and state machine of the postman, run by its own loop on the sockets and the mailbox.
+ */
+static const Actor_Descriptor my_descriptor = {
+    .name = "postman",
+    .mailbox_name = MQ_POSTMAN_BOX_NAME,
+    .msg_size = sizeof(Mq_Msg),
+    .msg_count = MQ_MSG_COUNT,
+    .priorities_nb = LANE_NB,
+    .mailbox_kind = CONFIG_MAILBOX_POSTMAN,
+    .state_machine = &my_state_machine[0][0],
+    .states_nb = STATE_NB,
+    .events_nb = EVENT_NB,
+    .event_offset = offsetof(Mq_Msg_Data, event),
+    .initial_state = S_WAITING_CONNECTION,
+    .initial_action = A_NOP,
+    .perform = POSTMAN_perform,
+    .run = POSTMAN_run,
+    .is_logged = TRUE
+};
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 int POSTMAN_create(void) {
-    struct mq_attr mqa;
-    mqa.mq_maxmsg = MQ_MSG_COUNT;
-    mqa.mq_msgsize = sizeof(Mq_Msg);
-
-    errno = 0;
-    if((my_mail_box = mq_open(MQ_POSTMAN_BOX_NAME, O_CREAT | O_RDWR | O_EXCL , 0644 ,&mqa )) == -1 ) {
-        if(errno == EEXIST) {
-            mq_unlink(MQ_POSTMAN_BOX_NAME);
-            if((my_mail_box = mq_open(MQ_POSTMAN_BOX_NAME, O_CREAT | O_RDWR , 0644 ,&mqa )) == -1 ) {
-                CONTROLLER_LOGGER_log(ERROR, "On mq_open : mq failed to be opened for postman.");
-                return -1;
-            }
-        }
-        else {
-            CONTROLLER_LOGGER_log(ERROR, "On mq_open : mq failed to be opened for postman.");
-            return -1;
-        }
+    if((my_actor = ACTOR_create(&my_descriptor)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_create : actor failed to be created for postman.");
+        return -1;
     }
     if((listen_socket =  socket(AF_INET, SOCK_STREAM, 0)) == -1) {
         CONTROLLER_LOGGER_log(ERROR, "On socket() : socket failed to be created for the listening socket.");
         goto error_socket;
     }
+    if(CONFIG_POSTMAN_TELEOP_PORT != 0 && (teleop_socket = socket(AF_INET, SOCK_DGRAM, 0)) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On socket() : socket failed to be created for the teleoperation channel.");
+        goto error_teleop_socket;
+    }
+    if((epoll_fd = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On epoll_create1() : epoll instance failed to be created for postman.");
+        goto error_epoll;
+    }
+    if(POSTMAN_watch(MAILBOX_get_fd(ACTOR_get_mailbox(my_actor)), SOURCE_MAIL_BOX, EPOLLIN) == -1) {
+        goto error_watch;
+    }
+    for(int client = 0; client < CONFIG_POSTMAN_MAX_CLIENTS; client++) {
+        connections[client].socket = -1;
+        connections[client].frames_nb = 0;
+    }
+    memset(lane_stats, 0, sizeof(lane_stats));
     my_address.sin_family = AF_INET;
     my_address.sin_port = htons(SERVER_PORT);
     my_address.sin_addr.s_addr = htonl(INADDR_ANY);
     return 0;
 
+    error_watch :
+    close(epoll_fd);
+    epoll_fd = -1;
+    error_epoll :
+    if(teleop_socket != -1) {
+        close(teleop_socket);
+        teleop_socket = -1;
+    }
+    error_teleop_socket :
+    close(listen_socket);
+    listen_socket = -1;
     error_socket :
-    mq_close(my_mail_box);
-    mq_unlink(MQ_POSTMAN_BOX_NAME);
+    ACTOR_destroy(my_actor);
     return -1;
 }
 
 int POSTMAN_start(void) {
+    int reuse_address = 1;
+    if(setsockopt(listen_socket, SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address)) == -1) {
+        CONTROLLER_LOGGER_log(WARNING, "On setsockopt() : SO_REUSEADDR could not be set on the socket server.");
+    }
     if(bind(listen_socket, (struct sockaddr *)&my_address, sizeof(my_address)) == -1) {
         CONTROLLER_LOGGER_log(ERROR, "On bind() : error while binding the socket server.");
         return -1;
@@ -321,28 +792,58 @@ int POSTMAN_start(void) {
         CONTROLLER_LOGGER_log(ERROR, "On listen() : error while listening connections.");
         return -1;
     }
-    if(pthread_create(&postman_thread, NULL, POSTMAN_run, NULL) != 0 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On pthread_create() : error while creating postman thread.");
+    if(POSTMAN_watch(listen_socket, SOURCE_LISTEN_SOCKET, EPOLLIN) == -1) {
+        return -1;
+    }
+    is_listening = TRUE;
+    if(teleop_socket != -1) {
+        struct sockaddr_in teleop_address = {.sin_family = AF_INET, .sin_port = htons(CONFIG_POSTMAN_TELEOP_PORT)};
+        teleop_address.sin_addr.s_addr = htonl(INADDR_ANY);
+        if(bind(teleop_socket, (struct sockaddr *)&teleop_address, sizeof(teleop_address)) == -1) {
+            CONTROLLER_LOGGER_log(ERROR, "On bind() : error while binding the teleoperation socket.");
+            return -1;
+        }
+        if(POSTMAN_watch(teleop_socket, SOURCE_TELEOP, EPOLLIN) == -1) {
+            return -1;
+        }
+    }
+    if(ACTOR_start(my_actor) != 0 ) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_start() : error while starting postman actor.");
         return -1;
     }
     return 0;
 }
 
 int POSTMAN_send_request(uint8_t * data) {
-    Mq_Msg my_msg = {.msg_data.event = E_WRITE_REQUEST, .msg_data.data = data};
-    if(POSTMAN_mq_send(&my_msg) == -1) {
+    Mq_Msg my_msg = {.msg_data.event = E_WRITE_REQUEST, .msg_data.data = data, .msg_data.lane = POSTMAN_get_lane(data)};
+    if(POSTMAN_enter_lane(my_msg.msg_data.lane, TRUE) == -1) {
+        return -1;
+    }
+    my_msg.msg_data.request_time = POSTMAN_now_us();
+    if(POSTMAN_mq_send(&my_msg, my_msg.msg_data.lane) == -1) {
+        POSTMAN_leave_lane(my_msg.msg_data.lane, my_msg.msg_data.request_time, FALSE);
         return -1;
     }
     return 0;
 }
 
-uint8_t* POSTMAN_read_request(void) {
-    return POSTMAN_read_msg();
+int POSTMAN_read_request(const uint8_t ** frame) {
+    return POSTMAN_read_msg(frame);
+}
+
+int POSTMAN_stream(Postman_Page_Source next_page) {
+    Mq_Msg my_msg = {.msg_data.event = E_STREAM, .msg_data.page_source = next_page};
+    if(POSTMAN_mq_send(&my_msg, LANE_BULK) == -1) {
+        return -1;
+    }
+    return 0;
 }
 
 int POSTMAN_disconnect(void) {
     Mq_Msg my_msg = {.msg_data.event = E_DISCONNECTION,0};
-    if(POSTMAN_mq_send(&my_msg) == -1) {
+    /* Same lane as the disconnection ack : the ack requested before is queued first, and written before the socket
+     * is closed. */
+    if(POSTMAN_mq_send(&my_msg, LANE_CONTROL) == -1) {
         return -1;
     }
     return 0;
@@ -350,213 +851,705 @@ int POSTMAN_disconnect(void) {
 
 int POSTMAN_stop(void) {
     Mq_Msg my_msg = {.msg_data.event = E_STOP,0};
-    if(POSTMAN_mq_send(&my_msg) == 0 ) {
-        if(pthread_join(postman_thread, NULL) != 0) {
-            CONTROLLER_LOGGER_log(ERROR, "On pthread_join(): error while waiting the termination of postman thread.");
+    /* Lowest priority : every request sent before is handled before the postman stops. */
+    if(POSTMAN_mq_send(&my_msg, LANE_BULK) == 0 ) {
+        if(ACTOR_join(my_actor) != 0) {
+            CONTROLLER_LOGGER_log(ERROR, "On ACTOR_join(): error while waiting the termination of postman actor.");
             return -1;
         }
     }
     else {
         return -1;
     }
-    if(!listen_socket) {
+    if(listen_socket != -1) {
         if(close(listen_socket) == -1) {
             CONTROLLER_LOGGER_log(ERROR, "On close() : listen socket failed to be closed for postman.");
             return -1;
         }
+        listen_socket = -1;
     }
-    if(!data_socket) {
-        if(close(data_socket) == -1) {
-            CONTROLLER_LOGGER_log(ERROR, "On close() : data socket failed to be closed for postman.");
+    if(teleop_socket != -1) {
+        if(close(teleop_socket) == -1) {
+            CONTROLLER_LOGGER_log(ERROR, "On close() : teleoperation socket failed to be closed for postman.");
             return -1;
         }
-    }
-    if(mq_close(my_mail_box) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_close() : mq failed to be closed for postman.");
-        return -1;
+        teleop_socket = -1;
     }
     return 0;
 }
 
 int POSTMAN_destroy(void) {
-    if(mq_unlink(MQ_POSTMAN_BOX_NAME) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_unlink)( : mq failed to be unlinked for postman.");
+    if(epoll_fd != -1) {
+        close(epoll_fd);
+        epoll_fd = -1;
+    }
+    if(ACTOR_destroy(my_actor) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_destroy() : actor failed to be destroyed for postman.");
         return -1;
     }
     return 0;
 }
+
+void POSTMAN_get_lane_stats(Postman_Lane lane, Postman_Lane_Stats * stats) {
+    stats->depth = __atomic_load_n(&lane_stats[lane].depth, __ATOMIC_RELAXED);
+    stats->max_depth = __atomic_load_n(&lane_stats[lane].max_depth, __ATOMIC_RELAXED);
+    stats->written = __atomic_load_n(&lane_stats[lane].written, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&lane_stats[lane].dropped, __ATOMIC_RELAXED);
+    stats->total_wait_us = __atomic_load_n(&lane_stats[lane].total_wait_us, __ATOMIC_RELAXED);
+    stats->max_wait_us = __atomic_load_n(&lane_stats[lane].max_wait_us, __ATOMIC_RELAXED);
+}
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
-static int POSTMAN_action_send_msg(uint8_t * raw_data) {
-    int amount_sent;
-    int message_size = raw_data[0] << 8 | raw_data[1];
-    if((amount_sent = write(data_socket, raw_data, (message_size+2))) == -1 && errno != EPIPE) {
-        CONTROLLER_LOGGER_log(ERROR, "On write() : writing on the socket failed for postman.");
-        return -1;
+static int POSTMAN_read_msg(const uint8_t ** frame) {
+    size_t frame_size;
+    pthread_mutex_lock(&handed_socket_mutex);
+    if(reading_connection != handed_connection) {
+        /* The connection read has been closed or replaced since : what is left of it is never dispatched. */
+        if(reading_socket != -1) {
+            close(reading_socket);
+        }
+        reading_socket = handed_socket;
+        reading_connection = handed_connection;
+        handed_socket = -1;
+        FRAME_READER_reset(&operator_reader);
+    }
+    pthread_mutex_unlock(&handed_socket_mutex);
+    if(reading_socket == -1) {
+        CONTROLLER_LOGGER_log(WARNING, "Postman has no operator socket to read, the connection has been closed.");
+        return 0;
     }
-    else if(errno == EPIPE) {
-        CONTROLLER_LOGGER_log(WARNING, "Postman has detected an Unforeseen disconnection.");
-        Mq_Msg my_msg = {.msg_data.event = E_DISCONNECTION,0};
-        if(POSTMAN_mq_send(&my_msg) == -1) {
-            CONTROLLER_LOGGER_log(ERROR, "On POSTMAN_mq_send() : the message could not be put into postman's mq.");
+    while((frame_size = FRAME_READER_next(&operator_reader, frame)) < FRAME_POOL_HEAD_SIZE) {
+        if(frame_size != 0) {
+            /* A size field below 2 leaves no room for the type : the frame is skipped. */
+            CONTROLLER_LOGGER_log(WARNING, "Postman has skipped a frame without type.");
+            continue;
+        }
+        errno = 0;
+        ssize_t amount_read = FRAME_READER_fill(&operator_reader, reading_socket);
+        if(amount_read == 0) {
+            /* End of stream : SB_IHM has hung up or postman has shut the data socket down. */
+            CONTROLLER_LOGGER_log(WARNING, "On recv() : The data socket for reading has been closed, a disconnection has been asked or detected.");
+            close(reading_socket);
+            reading_socket = -1;
+            return 0;
+        }
+        if(amount_read == -1 && errno != EINTR) {
+            CONTROLLER_LOGGER_log(ERROR, "On recv() : reading data has encountered an issue on postman.");
             return -1;
         }
     }
-    else if(amount_sent < message_size + 2) {
-        if(write(data_socket, raw_data, sizeof(raw_data)) == -1) {
-            CONTROLLER_LOGGER_log(ERROR, "On write() : writing on the socket failed for postman.");
+    return (int) frame_size;
+}
+
+static int POSTMAN_watch(int fd, int source, uint32_t events) {
+    struct epoll_event event = {.events = events, .data.u32 = source};
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On epoll_ctl() : postman has failed to watch a file descriptor.");
+        return -1;
+    }
+    return 0;
+}
+
+static int POSTMAN_unwatch(int fd) {
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL) == -1 && errno != ENOENT) {
+        CONTROLLER_LOGGER_log(ERROR, "On epoll_ctl() : postman has failed to forget a file descriptor.");
+        return -1;
+    }
+    return 0;
+}
+
+static int POSTMAN_watch_output(int client, bool_e is_watching_output) {
+    /* The operator socket is read by the dispatcher : only its hang up is watched here. */
+    struct epoll_event event = {
+        .events = (client == OPERATOR_SLOT ? EPOLLRDHUP : EPOLLIN | EPOLLRDHUP) | (is_watching_output ? EPOLLOUT : 0),
+        .data.u32 = SOURCE_CLIENT + client
+    };
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connections[client].socket, &event) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On epoll_ctl() : postman has failed to change the events watched on a client.");
+        return -1;
+    }
+    connections[client].is_watching_output = is_watching_output;
+    return 0;
+}
+
+static int POSTMAN_accept(int client) {
+    Connection * connection = &connections[client];
+    socklen_t addr_len = sizeof(my_address);
+    connection->socket = accept(listen_socket, (struct sockaddr *)&my_address, &addr_len);
+    if(connection->socket == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On accept() : error while accepting connection.");
+        return -1;
+    }
+    connection->is_hung_up = FALSE;
+    connection->is_watching_output = FALSE;
+    for(int lane = 0; lane < LANE_NB; lane++) {
+        connection->lanes[lane].first_frame = 0;
+        connection->lanes[lane].frames_nb = 0;
+    }
+    connection->frames_nb = 0;
+    connection->offset = 0;
+    /* Frames handed to the kernel can no longer be overtaken : its share of the backlog is kept small. */
+    int unsent_bytes = CONFIG_POSTMAN_UNSENT_BYTES;
+    if(setsockopt(connection->socket, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &unsent_bytes, sizeof(unsent_bytes)) == -1) {
+        CONTROLLER_LOGGER_log(WARNING, "On setsockopt() : postman has failed to bound the unsent bytes of a client.");
+    }
+    if(client == OPERATOR_SLOT) {
+        /* The dispatcher reads its own duplicate : the number stays its own until it has seen the end of stream. */
+        int operator_socket = dup(connection->socket);
+        if(operator_socket == -1) {
+            CONTROLLER_LOGGER_log(ERROR, "On dup() : postman has failed to hand the operator socket to the dispatcher.");
+            close(connection->socket);
+            connection->socket = -1;
             return -1;
         }
+        POSTMAN_hand_socket(operator_socket);
     }
-    if(amount_sent == sizeof(raw_data)) {
-        CONTROLLER_LOGGER_log(INFO, "The message has been sent.");
+    else {
+        /* Nobody else reads the observers : their socket can be fully non blocking. */
+        fcntl(connection->socket, F_SETFL, fcntl(connection->socket, F_GETFL) | O_NONBLOCK);
+    }
+    if(POSTMAN_watch(connection->socket, SOURCE_CLIENT + client, client == OPERATOR_SLOT ? EPOLLRDHUP : EPOLLIN | EPOLLRDHUP) == -1) {
+        close(connection->socket);
+        connection->socket = -1;
+        return -1;
     }
-    free(raw_data);
     return 0;
 }
 
-static uint8_t* POSTMAN_read_msg(void) {
-    uint8_t size_check[2];
-    errno = 0;
-    if(read(data_socket, size_check, 2) == -1 ){
-        if(errno == EBADF) {
-            CONTROLLER_LOGGER_log(WARNING, "On read() : The data socket for reading has been closed, a disconnection has been asked or detected.");
-            uint8_t * error_buffer = NULL;
-            error_buffer = (uint8_t*)malloc(1);
-            *error_buffer = (uint8_t) errno;
-            return error_buffer;
+static void POSTMAN_close_connection(int client) {
+    Connection * connection = &connections[client];
+    if(connection->socket == -1) {
+        return;
+    }
+    POSTMAN_unwatch(connection->socket);
+    /* Shutting down first wakes the dispatcher up if it is blocked reading the socket. */
+    shutdown(connection->socket, SHUT_RDWR);
+    if(close(connection->socket) == -1) {
+        CONTROLLER_LOGGER_log(WARNING, "On close() : a client socket failed to be closed for postman.");
+    }
+    connection->socket = -1;
+    if(client == OPERATOR_SLOT) {
+        /* The dispatcher drops what it has not read yet of this connection. */
+        POSTMAN_hand_socket(-1);
+    }
+    POSTMAN_drop_frames(client);
+}
+
+static void POSTMAN_hand_socket(int operator_socket) {
+    pthread_mutex_lock(&handed_socket_mutex);
+    if(handed_socket != -1) {
+        close(handed_socket);
+    }
+    handed_socket = operator_socket;
+    handed_connection++;
+    pthread_mutex_unlock(&handed_socket_mutex);
+}
+
+static void POSTMAN_drop_frames(int client) {
+    Connection * connection = &connections[client];
+    for(int lane = 0; lane < LANE_NB; lane++) {
+        while(connection->lanes[lane].frames_nb > 0) {
+            POSTMAN_pop_frame(connection, lane, FALSE);
         }
-        else {
-            CONTROLLER_LOGGER_log(ERROR, "On read() : reading data header has encountered an issue on postman.");
-            return NULL;
+    }
+    connection->offset = 0;
+    if(client == OPERATOR_SLOT) {
+        POSTMAN_abort_stream();
+    }
+}
+
+static void POSTMAN_pull_pages(void) {
+    while(page_source != NULL && connections[OPERATOR_SLOT].lanes[LANE_BULK].frames_nb < CONFIG_POSTMAN_STREAM_WINDOW) {
+        uint8_t * page = page_source(FALSE);
+        if(page == NULL) {
+            page_source = NULL;
+            break;
         }
+        POSTMAN_enter_lane(LANE_BULK, FALSE);
+        POSTMAN_enqueue(OPERATOR_SLOT, page, LANE_BULK, POSTMAN_now_us());
     }
-    else {
-        int data_size = size_check[0] << 8 | size_check[1];
-        uint8_t data_buff[data_size];
-        if (read(data_socket, data_buff, data_size) == -1) {
-            CONTROLLER_LOGGER_log(ERROR, "On read() : reading data has encountered an issue on postman.");
-            return NULL;
+}
+
+static void POSTMAN_abort_stream(void) {
+    if(page_source != NULL) {
+        Postman_Page_Source aborted_source = page_source;
+        page_source = NULL;
+        aborted_source(TRUE);
+    }
+}
+
+static void POSTMAN_pop_frame(Connection * connection, Postman_Lane lane, bool_e is_written) {
+    Lane_Queue * queue = &connection->lanes[lane];
+    FRAME_POOL_release(queue->frames[queue->first_frame]);
+    POSTMAN_leave_lane(lane, queue->request_times[queue->first_frame], is_written);
+    queue->first_frame = (queue->first_frame + 1) % CONFIG_POSTMAN_CLIENT_QUEUE_SIZE;
+    queue->frames_nb--;
+    connection->frames_nb--;
+}
+
+static void POSTMAN_enqueue(int client, uint8_t * frame, Postman_Lane lane, uint64_t request_time) {
+    Connection * connection = &connections[client];
+    Lane_Queue * queue = &connection->lanes[lane];
+    if(connection->socket == -1 || connection->is_hung_up) {
+        FRAME_POOL_release(frame);
+        POSTMAN_leave_lane(lane, request_time, FALSE);
+        return;
+    }
+    if(queue->frames_nb == CONFIG_POSTMAN_CLIENT_QUEUE_SIZE && !connection->is_watching_output) {
+        POSTMAN_flush(client);
+    }
+    if(queue->frames_nb == CONFIG_POSTMAN_CLIENT_QUEUE_SIZE) {
+        CONTROLLER_LOGGER_log(WARNING, "Postman has dropped a frame : the queue of a slow client is full.");
+        FRAME_POOL_release(frame);
+        POSTMAN_leave_lane(lane, request_time, FALSE);
+        return;
+    }
+    int last_frame = (queue->first_frame + queue->frames_nb) % CONFIG_POSTMAN_CLIENT_QUEUE_SIZE;
+    queue->frames[last_frame] = frame;
+    queue->request_times[last_frame] = request_time;
+    queue->frames_nb++;
+    connection->frames_nb++;
+}
+
+static int POSTMAN_flush(int client) {
+    Connection * connection = &connections[client];
+    struct iovec frames_iov[MAX_FRAMES_PER_SEND];
+    Postman_Lane frames_lane[MAX_FRAMES_PER_SEND];
+    struct msghdr message = {.msg_iov = frames_iov};
+    for(;;) {
+        if(client == OPERATOR_SLOT) {
+            /* The pages of a stream are pulled as the socket takes the previous ones. */
+            POSTMAN_pull_pages();
+        }
+        if(connection->frames_nb == 0) {
+            break;
         }
-        uint8_t * raw_message = NULL;
-        if(data_size >= 2) {
-            data_size +=2;
-            raw_message = (uint8_t *) malloc(data_size);
-            memcpy(raw_message, size_check, 2);
-            memcpy(raw_message + 2, data_buff, data_size);
+        /* The operator socket stays blocking for the dispatcher : sendmsg() is writev() with MSG_DONTWAIT. */
+        int taken[LANE_NB] = {0};
+        message.msg_iovlen = 0;
+        if(connection->offset > 0) {
+            /* A frame is never cut : the partially written one is finished before any other. */
+            Lane_Queue * queue = &connection->lanes[connection->partial_lane];
+            uint8_t * frame = queue->frames[queue->first_frame];
+            frames_iov[0].iov_base = frame + connection->offset;
+            frames_iov[0].iov_len = (size_t)(frame[0] << 8 | frame[1]) + 2 - connection->offset;
+            frames_lane[0] = connection->partial_lane;
+            taken[connection->partial_lane] = 1;
+            message.msg_iovlen = 1;
         }
-        else {
-            raw_message = (uint8_t *) malloc(data_size);
-            memcpy(raw_message, size_check, 2);
+        for(int lane = 0; lane < LANE_NB && message.msg_iovlen < MAX_FRAMES_PER_SEND; lane++) {
+            Lane_Queue * queue = &connection->lanes[lane];
+            for(; taken[lane] < queue->frames_nb && message.msg_iovlen < MAX_FRAMES_PER_SEND; taken[lane]++) {
+                uint8_t * frame = queue->frames[(queue->first_frame + taken[lane]) % CONFIG_POSTMAN_CLIENT_QUEUE_SIZE];
+                frames_iov[message.msg_iovlen].iov_base = frame;
+                frames_iov[message.msg_iovlen].iov_len = (size_t)(frame[0] << 8 | frame[1]) + 2;
+                frames_lane[message.msg_iovlen] = lane;
+                message.msg_iovlen++;
+            }
         }
-        return raw_message;
+        ssize_t written = sendmsg(connection->socket, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if(written == -1) {
+            if(errno == EINTR) {
+                continue;
+            }
+            if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                return connection->is_watching_output ? 0 : POSTMAN_watch_output(client, TRUE);
+            }
+            if(errno == EPIPE || errno == ECONNRESET) {
+                /* The hang up is reported by epoll, the connection lost is handled from there. */
+                CONTROLLER_LOGGER_log(WARNING, "Postman has detected an Unforeseen disconnection.");
+                POSTMAN_drop_frames(client);
+                break;
+            }
+            CONTROLLER_LOGGER_log(ERROR, "On sendmsg() : writing on the socket failed for postman.");
+            return -1;
+        }
+        /* Releases the frames fully written, the first one left keeps the offset reached. */
+        for(size_t i = 0; written > 0; i++) {
+            if((size_t) written < frames_iov[i].iov_len) {
+                connection->offset += (size_t) written;
+                connection->partial_lane = frames_lane[i];
+                break;
+            }
+            written -= (ssize_t) frames_iov[i].iov_len;
+            POSTMAN_pop_frame(connection, frames_lane[i], TRUE);
+            connection->offset = 0;
+        }
+    }
+    if(connection->is_watching_output && !connection->is_hung_up) {
+        return POSTMAN_watch_output(client, FALSE);
     }
+    return 0;
 }
 
-static void * POSTMAN_run(void * arg) {
+static int POSTMAN_flush_all(void) {
+    for(int client = 0; client < CONFIG_POSTMAN_MAX_CLIENTS; client++) {
+        Connection * connection = &connections[client];
+        if(connection->socket != -1 && connection->frames_nb > 0 && !connection->is_watching_output) {
+            if(POSTMAN_flush(client) == -1) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static bool_e POSTMAN_is_broadcast(const uint8_t * frame) {
+    switch(PROTOCOL_get_type(frame)) {
+        case SET_RADAR :
+        case ALERT :
+        case SET_MODE :
+            return TRUE;
+        default :
+            return FALSE;
+    }
+}
+
+static Postman_Lane POSTMAN_get_lane(const uint8_t * frame) {
+    switch(PROTOCOL_get_type(frame)) {
+        case ALERT :
+        case SET_AVAILABILITY :
+        case ACK_DISCONNECTION :
+        case SET_SESSION :
+            return LANE_CONTROL;
+        case SET_LOGS :
+            return LANE_BULK;
+        default :
+            return LANE_STATE;
+    }
+}
+
+static uint64_t POSTMAN_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+static int POSTMAN_enter_lane(Postman_Lane lane, bool_e is_waiting) {
+    Postman_Lane_Stats * stats = &lane_stats[lane];
+    uint32_t depth;
+    if(is_waiting && lane == LANE_BULK) {
+        /* Bulk senders are held back here so that they never fill the mail box up. */
+        pthread_mutex_lock(&lane_stats_mutex);
+        if(__atomic_load_n(&stats->depth, __ATOMIC_RELAXED) >= CONFIG_POSTMAN_BULK_FRAMES) {
+            struct timespec time_out;
+            clock_gettime(CLOCK_REALTIME, &time_out);
+            time_out.tv_sec += CONFIG_POSTMAN_BULK_WAIT_MS / 1000;
+            time_out.tv_nsec += (CONFIG_POSTMAN_BULK_WAIT_MS % 1000) * 1000000L;
+            if(time_out.tv_nsec >= 1000000000L) {
+                time_out.tv_sec++;
+                time_out.tv_nsec -= 1000000000L;
+            }
+            int error = 0;
+            while(__atomic_load_n(&stats->depth, __ATOMIC_RELAXED) >= CONFIG_POSTMAN_BULK_FRAMES && error != ETIMEDOUT) {
+                error = pthread_cond_timedwait(&bulk_room, &lane_stats_mutex, &time_out);
+            }
+            if(__atomic_load_n(&stats->depth, __ATOMIC_RELAXED) >= CONFIG_POSTMAN_BULK_FRAMES) {
+                __atomic_add_fetch(&stats->dropped, 1, __ATOMIC_RELAXED);
+                pthread_mutex_unlock(&lane_stats_mutex);
+                CONTROLLER_LOGGER_log(ERROR, "On pthread_cond_timedwait() : postman has not written the bulk frames in time.");
+                return -1;
+            }
+        }
+        depth = __atomic_add_fetch(&stats->depth, 1, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&lane_stats_mutex);
+    }
+    else {
+        depth = __atomic_add_fetch(&stats->depth, 1, __ATOMIC_RELAXED);
+    }
+    uint32_t max_depth = __atomic_load_n(&stats->max_depth, __ATOMIC_RELAXED);
+    while(depth > max_depth && !__atomic_compare_exchange_n(&stats->max_depth, &max_depth, depth, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    return 0;
+}
+
+static void POSTMAN_leave_lane(Postman_Lane lane, uint64_t request_time, bool_e is_written) {
+    Postman_Lane_Stats * stats = &lane_stats[lane];
+    if(is_written) {
+        uint64_t wait_us = POSTMAN_now_us() - request_time;
+        __atomic_add_fetch(&stats->written, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&stats->total_wait_us, wait_us, __ATOMIC_RELAXED);
+        uint32_t max_wait_us = __atomic_load_n(&stats->max_wait_us, __ATOMIC_RELAXED);
+        while(wait_us > max_wait_us && !__atomic_compare_exchange_n(&stats->max_wait_us, &max_wait_us, (uint32_t) wait_us, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    }
+    else {
+        __atomic_add_fetch(&stats->dropped, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_sub_fetch(&stats->depth, 1, __ATOMIC_RELAXED);
+    if(lane == LANE_BULK) {
+        pthread_mutex_lock(&lane_stats_mutex);
+        pthread_cond_signal(&bulk_room);
+        pthread_mutex_unlock(&lane_stats_mutex);
+    }
+}
+
+static void * POSTMAN_run(Actor * actor) {
     Mq_Msg msg;
-    State_Machine my_state = S_WAITING_CONNECTION;
-    if(actions_tab[A_CONNECTION_POLLING](NULL) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action for postman.");
-        return NULL;
-    }
-    Transition * my_transition;
-    while(my_state != S_DEATH) {
-        if (POSTMAN_mq_receive(&msg) == -1) {
-            CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_mq_receive() : failed to read postman's mq.");
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+    while(!ACTOR_is_dead(actor)) {
+        int events_nb = epoll_wait(epoll_fd, events, MAX_EPOLL_EVENTS, -1);
+        if(events_nb == -1) {
+            if(errno == EINTR) {
+                continue;
+            }
+            CONTROLLER_LOGGER_log(ERROR, "On epoll_wait() : postman has failed to wait for events.");
             return NULL;
         }
-        my_transition = &my_state_machine[my_state][msg.msg_data.event];
-        uint8_t * raw_data = msg.msg_data.data;
-        if(my_transition->state_destination != S_FORGET) {
-            if(actions_tab[my_transition->action](raw_data) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action for postman.");
+        for(int i = 0; i < events_nb && !ACTOR_is_dead(actor); i++) {
+            if(events[i].data.u32 == SOURCE_MAIL_BOX) {
+                /* Drains the mailbox so that the frames requested meanwhile leave in a single write. */
+                int received;
+                if((received = POSTMAN_mq_try_receive(&msg)) == -1) {
+                    return NULL;
+                }
+                if(received == 0) {
+                    continue; /* Taken with the previous batch. */
+                }
+                for(int msg_nb = 1; ; msg_nb++) {
+                    if(ACTOR_handle(actor, &msg) == -1) {
+                        return NULL;
+                    }
+                    if(ACTOR_is_dead(actor) || msg_nb == MQ_MSG_COUNT) {
+                        break;
+                    }
+                    if((received = POSTMAN_mq_try_receive(&msg)) == -1) {
+                        return NULL;
+                    }
+                    if(received == 0) {
+                        break;
+                    }
+                }
+                continue;
+            }
+            else if(events[i].data.u32 == SOURCE_LISTEN_SOCKET) {
+                msg.msg_data.event = E_CONNECTION;
+            }
+            else if(events[i].data.u32 == SOURCE_TELEOP) {
+                msg.msg_data.event = E_TELEOP_INPUT;
+            }
+            else {
+                msg.msg_data.client = events[i].data.u32 - SOURCE_CLIENT;
+                if(connections[msg.msg_data.client].socket == -1) {
+                    continue; /* Closed earlier in this round. */
+                }
+                if(msg.msg_data.client != OPERATOR_SLOT && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                    msg.msg_data.event = E_OBSERVER_INPUT;
+                }
+                else if(events[i].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                    msg.msg_data.event = E_HANG_UP;
+                }
+                else {
+                    msg.msg_data.event = E_WRITABLE;
+                }
+            }
+            if(ACTOR_handle(actor, &msg) == -1) {
                 return NULL;
             }
-            my_state = my_transition->state_destination;
+        }
+        if(!ACTOR_is_dead(actor) && POSTMAN_flush_all() == -1) {
+            return NULL;
         }
     }
-    return 0;
+    return NULL;
 }
 
-static int POSTMAN_action_polling_connection(uint8_t * raw_data) {
-   socklen_t addr_len = sizeof(my_address);
+static int POSTMAN_perform(int action, void * msg) {
+    return actions_tab[action](&((Mq_Msg *) msg)->msg_data);
+}
 
-    struct timeval timeout;
-    timeout.tv_sec = 1;
-    timeout.tv_usec = 0;
+static int POSTMAN_mq_try_receive(Mq_Msg * a_msg) {
+    int received;
+    if((received = MAILBOX_try_receive(ACTOR_get_mailbox(my_actor), a_msg->buffer)) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On MAILBOX_try_receive() : Postman has failed to receive a message on the mailbox.");
+    }
+    return received;
+}
 
-    fd_set l_read_fds;
-    FD_ZERO(&l_read_fds);
-    FD_SET(listen_socket, &l_read_fds);
+static int POSTMAN_mq_send(Mq_Msg * a_msg, Postman_Lane lane) {
+    if(ACTOR_send(my_actor, a_msg->buffer, LANE_PRIORITY(lane)) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_send() : Postman has failed to send a message into the mailbox.");
+        return -1;
+    }
+    return 0;
+}
+
+static int POSTMAN_action_nop(Mq_Msg_Data * msg_data) { return 0; }
 
-    int select_state = select(listen_socket + 1, &l_read_fds, NULL, NULL, &timeout);
-    if (select_state == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On select() : error from postman in select.");
+static int POSTMAN_action_connected(Mq_Msg_Data * msg_data) {
+    if(POSTMAN_accept(OPERATOR_SLOT) == -1) {
         return -1;
-    } 
-    else if (select_state) {
-        // A connection is pending
-        data_socket = accept(listen_socket, (struct sockaddr *)&my_address, &addr_len);
-        if(data_socket == -1) {
-            CONTROLLER_LOGGER_log(ERROR, "On accept() : error while accepting connection.");
-            return -1;
-        }
+    }
+    operator_address = my_address;
+    is_teleop_sequence_set = FALSE;
+    is_teleop_clock_set = FALSE;
+    /* The new operator may be an older SB_IHM : nothing optional is used before it gives its capabilities. */
+    CAPABILITIES_reset();
+    CONTROLLER_LOGGER_log(INFO,"Postman has established a connection with SB_IHM");
+    CONTROLLER_CORE_ask_to_connect(ID_ROBOT);
+    return 0;
+}
 
-        Mq_Msg msg = {.msg_data.event = E_CONNECTION, NULL};
-        if (POSTMAN_mq_send(&msg) == -1) {
-            return -1;
+static int POSTMAN_action_observer_connected(Mq_Msg_Data * msg_data) {
+    for(int client = OPERATOR_SLOT + 1; client < CONFIG_POSTMAN_MAX_CLIENTS; client++) {
+        if(connections[client].socket == -1) {
+            if(POSTMAN_accept(client) == -1) {
+                return -1;
+            }
+            CONTROLLER_LOGGER_log(INFO,"Postman has established a connection with an observer.");
+            return 0;
         }
-        CONTROLLER_CORE_ask_to_connect(ID_ROBOT);
+    }
+    /* Table full : the connection is refused instead of staying in the backlog. */
+    int refused_socket = accept(listen_socket, NULL, NULL);
+    if(refused_socket != -1) {
+        close(refused_socket);
+    }
+    CONTROLLER_LOGGER_log(WARNING, "Postman has refused a connection : too many clients.");
+    return 0;
+}
 
-        is_in_waiting_connection = FALSE;
+static int POSTMAN_action_connection_lost(Mq_Msg_Data * msg_data) {
+    CONTROLLER_LOGGER_log(WARNING, "Postman has detected that SB_IHM hung up.");
+    /* Hang up stays signaled on the socket : stop watching it until controller_core asks the disconnection. */
+    if(POSTMAN_unwatch(connections[OPERATOR_SLOT].socket) == -1) {
+        return -1;
     }
-    else {
-        // No connection could be found
-        Mq_Msg msg = {.msg_data.event = E_POLL_CONNECTION, NULL};
-        if (POSTMAN_mq_send(&msg) == -1) {
+    connections[OPERATOR_SLOT].is_hung_up = TRUE;
+    POSTMAN_drop_frames(OPERATOR_SLOT);
+    /* The operator coming back must not be taken for an observer before the disconnection. */
+    if(is_listening) {
+        if(POSTMAN_unwatch(listen_socket) == -1) {
             return -1;
         }
+        is_listening = FALSE;
+    }
+    if(CONTROLLER_CORE_connection_lost() == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_connection_lost() : postman has failed to notify the lost connection.");
+        return -1;
     }
     return 0;
 }
 
-static int POSTMAN_mq_receive(Mq_Msg * a_msg) {
-    if((mq_receive(my_mail_box,a_msg->buffer,sizeof(Mq_Msg), NULL) == -1)) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_receive() : Postman has failed to receive a message on the mq.");
-        mq_close(my_mail_box);
-        mq_unlink(MQ_POSTMAN_BOX_NAME);
-        return -1;
+static int POSTMAN_action_send_msg(Mq_Msg_Data * msg_data) {
+    uint8_t * frame = msg_data->data;
+    if(POSTMAN_is_broadcast(frame)) {
+        /* Every observer shares the frame of the operator, the last one to write it releases it. */
+        for(int client = OPERATOR_SLOT + 1; client < CONFIG_POSTMAN_MAX_CLIENTS; client++) {
+            if(connections[client].socket != -1) {
+                FRAME_POOL_retain(frame);
+                POSTMAN_enter_lane(msg_data->lane, FALSE);
+                POSTMAN_enqueue(client, frame, msg_data->lane, msg_data->request_time);
+            }
+        }
     }
+    POSTMAN_enqueue(OPERATOR_SLOT, frame, msg_data->lane, msg_data->request_time);
     return 0;
 }
 
-static int POSTMAN_mq_send(Mq_Msg * a_msg) {
-    if(mq_send(my_mail_box,a_msg->buffer, sizeof(Mq_Msg),0) == -1 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_send() : Postman has failed to send a message into the mq.");
-        mq_close(my_mail_box);
-        mq_unlink(MQ_POSTMAN_BOX_NAME);
-        return -1;
+static int POSTMAN_action_flush(Mq_Msg_Data * msg_data) {
+    return POSTMAN_flush(msg_data->client);
+}
+
+static int POSTMAN_action_drain_observer(Mq_Msg_Data * msg_data) {
+    uint8_t drain_buffer[DRAIN_BUFFER_SIZE];
+    ssize_t amount_read;
+    while((amount_read = recv(connections[msg_data->client].socket, drain_buffer, sizeof(drain_buffer), MSG_DONTWAIT)) > 0);
+    if(amount_read == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        CONTROLLER_LOGGER_log(INFO, "An observer has left.");
+        POSTMAN_close_connection(msg_data->client);
     }
     return 0;
 }
 
-static int POSTMAN_action_nop(uint8_t * raw_data) { return 0; }
+static int POSTMAN_action_drive(Mq_Msg_Data * msg_data) {
+    uint8_t datagram[TELEOP_DATAGRAM_SIZE + 1];
+    struct sockaddr_in sender_address;
+    socklen_t addr_len;
+    ssize_t amount_read;
+    bool_e has_command = FALSE;
+    Command command = STOP;
+    if(!CAPABILITIES_is_enabled(CAPABILITY_TELEOP_UDP)) {
+        return POSTMAN_action_drain_teleop(msg_data);
+    }
+    uint32_t now_ms = (uint32_t) (POSTMAN_now_us() / 1000);
+    for(;;) {
+        addr_len = sizeof(sender_address);
+        amount_read = recvfrom(teleop_socket, datagram, sizeof(datagram), MSG_DONTWAIT, (struct sockaddr *)&sender_address, &addr_len);
+        if(amount_read == -1) {
+            break;
+        }
+        /* Only well formed commands of the operator are taken, a datagram never spans two commands. */
+        if(amount_read != TELEOP_DATAGRAM_SIZE
+            || PROTOCOL_get_payload_size(datagram) != TELEOP_DATAGRAM_SIZE - PROTOCOL_HEAD_SIZE
+            || PROTOCOL_get_type(datagram) != ASK_CMD
+            || datagram[12] > STOP
+            || sender_address.sin_addr.s_addr != operator_address.sin_addr.s_addr) {
+            continue;
+        }
+        /* Both clocks wrap around every 49 days : only differences are compared. */
+        uint32_t clock_offset = now_ms - PROTOCOL_get_U32(datagram + PROTOCOL_HEAD_SIZE + 4);
+        if(!is_teleop_clock_set || (int32_t)(clock_offset - teleop_clock_offset) < 0) {
+            teleop_clock_offset = clock_offset;
+            is_teleop_clock_set = TRUE;
+        }
+        if(CONFIG_POSTMAN_TELEOP_MAX_AGE_MS != 0 && (int32_t)(clock_offset - teleop_clock_offset) > CONFIG_POSTMAN_TELEOP_MAX_AGE_MS) {
+            continue;
+        }
+        uint32_t sequence = PROTOCOL_get_U32(datagram + PROTOCOL_HEAD_SIZE);
+        /* Serial number arithmetic : the sequence may wrap around during a long session. */
+        if(is_teleop_sequence_set && (int32_t)(sequence - last_teleop_sequence) <= 0) {
+            continue;
+        }
+        last_teleop_sequence = sequence;
+        is_teleop_sequence_set = TRUE;
+        command = (Command)datagram[12];
+        has_command = TRUE;
+    }
+    if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        CONTROLLER_LOGGER_log(WARNING, "On recvfrom() : error while reading the teleoperation socket.");
+    }
+    /* Only the newest command is worth applying, the older ones are already outdated. */
+    if(has_command && PILOT_ask_cmd(command) == -1) {
+        CONTROLLER_LOGGER_log(WARNING, "On PILOT_ask_cmd() : a teleoperation command has been lost.");
+    }
+    return 0;
+}
 
-static int POSTMAN_action_connected(uint8_t * raw_data) {
-    CONTROLLER_LOGGER_log(INFO,"Postman has established a connection with SB_IHM");
+static int POSTMAN_action_drain_teleop(Mq_Msg_Data * msg_data) {
+    uint8_t drain_buffer[DRAIN_BUFFER_SIZE];
+    while(recv(teleop_socket, drain_buffer, sizeof(drain_buffer), MSG_DONTWAIT) >= 0);
     return 0;
 }
 
-static int POSTMAN_action_disconnection(uint8_t * raw_data) {
-    CONTROLLER_LOGGER_log(INFO, "A disconnection has been asked or detected. postman is waiting for a connection.");
-    if(close(data_socket) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On close() : data socket failed to be closed for postman.");
-        return -1;
+static int POSTMAN_action_stream(Mq_Msg_Data * msg_data) {
+    POSTMAN_abort_stream();
+    if(connections[OPERATOR_SLOT].socket == -1 || connections[OPERATOR_SLOT].is_hung_up) {
+        CONTROLLER_LOGGER_log(WARNING, "Postman has aborted a stream : no operator to send it to.");
+        msg_data->page_source(TRUE);
+        return 0;
     }
-    Mq_Msg my_msg = {.msg_data.event = E_POLL_CONNECTION, NULL};
-    if(POSTMAN_mq_send(&my_msg) == -1) {
-        return -1;
+    page_source = msg_data->page_source;
+    POSTMAN_pull_pages();
+    return 0;
+}
+
+static int POSTMAN_action_stop(Mq_Msg_Data * msg_data) {
+    for(int client = 0; client < CONFIG_POSTMAN_MAX_CLIENTS; client++) {
+        POSTMAN_close_connection(client);
+    }
+    return 0;
+}
+
+static int POSTMAN_action_disconnection(Mq_Msg_Data * msg_data) {
+    CONTROLLER_LOGGER_log(INFO, "A disconnection has been asked or detected. postman is waiting for a connection.");
+    /* The frames are written at the end of the round : the ack requested in this round is written before closing,
+     * the pages of a stream are not. */
+    POSTMAN_abort_stream();
+    POSTMAN_flush(OPERATOR_SLOT);
+    POSTMAN_close_connection(OPERATOR_SLOT);
+    if(!is_listening) {
+        if(POSTMAN_watch(listen_socket, SOURCE_LISTEN_SOCKET, EPOLLIN) == -1) {
+            return -1;
+        }
+        is_listening = TRUE;
     }
-    is_in_waiting_connection = TRUE;
     return 0;
 }
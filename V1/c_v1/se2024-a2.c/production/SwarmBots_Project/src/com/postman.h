@@ -38,9 +38,38 @@
 #define SRC_COM_POSTMAN_H_
 /* ----------------------  INCLUDES ------------------------------------------*/
 #include <stdint.h>
+#include "../lib/defs.h"
 /* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/**
+ * \typedef uint8_t * (* Postman_Page_Source)(bool_e is_aborted)
+ * \brief Gives the next page of a stream, lent by FRAME_POOL_new_frame(), or NULL once the stream is over. Called by
+ * the postman thread. When is_aborted is TRUE, the source releases what it holds and returns NULL.
+ */
+typedef uint8_t * (* Postman_Page_Source)(bool_e is_aborted);
 /* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
+/**
+ * \enum Postman_Lane
+ * \brief Priority classes of the frames sent by the postman, a lane is written before the next ones.
+ */
+typedef enum {
+    LANE_CONTROL = 0, /**< LANE_CONTROL : alerts, pongs and disconnection acks. */
+    LANE_STATE, /**< LANE_STATE : state, mode and radar updates. */
+    LANE_BULK, /**< LANE_BULK : log pages, they yield to the other lanes at each frame boundary. */
+    LANE_NB /**< Amount of lanes. */
+} Postman_Lane;
 /* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/**
+ * \struct Postman_Lane_Stats postman.h "com/postman.h"
+ * \brief Statistics of a priority lane since the postman has been created.
+ */
+typedef struct {
+    uint32_t depth; /**< Frames waiting in the mail box or in the queue of a client. */
+    uint32_t max_depth; /**< Highest depth reached. */
+    uint32_t written; /**< Frames fully written to a client. */
+    uint32_t dropped; /**< Frames dropped because the queue of a client was full or the client has left. */
+    uint64_t total_wait_us; /**< Sum of the delays between the request and the end of the write of each frame written. */
+    uint32_t max_wait_us; /**< Longest of these delays. */
+} Postman_Lane_Stats;
 /* ----------------------  PUBLIC VARIABLES -----------------------------------*/
 /* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
 /**
@@ -80,24 +109,51 @@ extern int POSTMAN_stop(void);
  * \brief Sends a message through TCP.
  * \author Joshua MONTREUIL
  *
- * \param data : message data to be sent.
+ * The frame goes into the lane of its type. A bulk frame waits while CONFIG_POSTMAN_BULK_FRAMES bulk frames are
+ * in flight.
+ *
+ * \param data : frame lent by FRAME_POOL_new_frame(), released by the postman once written.
  *
  * \return On success, returns 0. On error, returns -1.
  */
 extern int POSTMAN_send_request(uint8_t * data);
 /**
- * \fn extern uint8_t * POSTMAN_read_request(void)
+ * \fn extern int POSTMAN_read_request(const uint8_t ** frame)
  * \brief Request a socket read action.
  * \author Joshua MONTREUIL
  *
- * \return uint8_t* : Raw message in a buffer from socket on success. NULL on failure.
+ * \param frame : set to the next frame sent by the operator, size field included. The frame stays in the
+ * receive buffer of the postman and is valid until the next read.
+ *
+ * \return The size in bytes of the frame, 0 when the connection is closed. On error, returns -1.
  */
-extern uint8_t* POSTMAN_read_request(void);
+extern int POSTMAN_read_request(const uint8_t ** frame);
 /**
  * \fn extern int POSTMAN_disconnect(void)
  * \brief Disconnect the socket link.
  * \author Joshua MONTREUIL
  */
 extern int POSTMAN_disconnect(void);
+/**
+ * \fn extern int POSTMAN_stream(Postman_Page_Source next_page)
+ * \brief Starts an upload of bulk pages to the operator, pulled by the postman. A page is asked to the source only
+ * when less than CONFIG_POSTMAN_STREAM_WINDOW pages of the stream wait to be written, so that the memory used does
+ * not depend on the size of the upload. A stream still running is aborted, as is the stream when the operator leaves.
+ * \author Prose A2
+ *
+ * \param next_page : source of the pages.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int POSTMAN_stream(Postman_Page_Source next_page);
+/**
+ * \fn extern void POSTMAN_get_lane_stats(Postman_Lane lane, Postman_Lane_Stats * stats)
+ * \brief Gives the statistics of a priority lane.
+ * \author Prose A2
+ *
+ * \param lane : lane to look at.
+ * \param stats : filled with the statistics of the lane.
+ */
+extern void POSTMAN_get_lane_stats(Postman_Lane lane, Postman_Lane_Stats * stats);
 
 #endif /* SRC_COM_POSTMAN_H_ */
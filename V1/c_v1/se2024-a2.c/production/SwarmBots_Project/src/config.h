@@ -56,11 +56,22 @@
  * ( 0:DEBUG | 1:INFO | 2:WARNING | 3:ERROR )
  */
 #define CONFIG_LOGGER_LOG_LEVEL    0
+/**
+ * \def CONFIG_LOGGER_LOG_FLOOR
+ * Lowest log level built into SB_C : the logs of CONTROLLER_LOGGER_LOG() below it are removed at build time,
+ * whatever the level set at run time. Can be given at build time.
+ * ( 0:DEBUG | 1:INFO | 2:WARNING | 3:ERROR )
+ */
+#ifndef CONFIG_LOGGER_LOG_FLOOR
+#define CONFIG_LOGGER_LOG_FLOOR    0
+#endif
 /**
  * \def CONFIG_LOGGER_PRINT_MODE
- * Logger print mode. ( 0:TERMINAL ONLY | 1:FILE ONLY | 2:BOTH )
+ * Logger print mode. ( 0:TERMINAL ONLY | 1:FILE ONLY | 2:BOTH ). Can be given at build time.
  */
+#ifndef CONFIG_LOGGER_PRINT_MODE
 #define CONFIG_LOGGER_PRINT_MODE   2
+#endif
 /**
  * \def CONFIG_LOGGER_LOG_SIZE
  * Log size.
@@ -68,20 +79,197 @@
 #define CONFIG_LOGGER_LOG_SIZE     2048
 /**
  * \def CONFIG_LOG_FILE_PATH
- * File path of the log file.
+ * File path of the log file. Can be given at build time (e.g. by the host build of the benchmarks).
  */
+#ifndef CONFIG_LOG_FILE_PATH
 #define CONFIG_LOG_FILE_PATH       "/home/pi/logs.txt"
+#endif
 /**
  * \def CONFIG_TEMP_LOG_FILE_PATH
- * File path of the temporary log file. (before the rtc is given).
+ * File path of the temporary log file. (before the rtc is given). Can be given at build time.
  */
+#ifndef CONFIG_TEMP_LOG_FILE_PATH
 #define CONFIG_TEMP_LOG_FILE_PATH  "/home/pi/temp_logs.txt"
+#endif
+
+/* CONTROLLER CORE */
+/**
+ * \def CONFIG_CORE_SESSION_GRACE_MS
+ * Delay after a lost connection during which SB_IHM can resume its session, in milliseconds. The camera keeps
+ * streaming meanwhile.
+ */
+#define CONFIG_CORE_SESSION_GRACE_MS       5000
+
+/* POSTMAN */
+/**
+ * \def CONFIG_POSTMAN_MAX_CLIENTS
+ * Max amount of SB_IHM connected at the same time : the operator and the observers.
+ */
+#define CONFIG_POSTMAN_MAX_CLIENTS         3
+/**
+ * \def CONFIG_POSTMAN_CLIENT_QUEUE_SIZE
+ * Max amount of frames of each priority lane waiting to be written for each connected client.
+ */
+#define CONFIG_POSTMAN_CLIENT_QUEUE_SIZE   32
+/**
+ * \def CONFIG_POSTMAN_BULK_FRAMES
+ * Max amount of bulk frames (log pages) requested and not written yet. Beyond, the sender waits for the postman.
+ */
+#define CONFIG_POSTMAN_BULK_FRAMES         8
+/**
+ * \def CONFIG_POSTMAN_BULK_WAIT_MS
+ * Max delay a bulk sender waits for the postman before its request fails, in milliseconds.
+ */
+#define CONFIG_POSTMAN_BULK_WAIT_MS        2000
+/**
+ * \def CONFIG_POSTMAN_UNSENT_BYTES
+ * Max amount of bytes left unsent in the socket buffer of a client. The frames beyond wait in the lanes of the
+ * postman, where an alert can still overtake them.
+ */
+#define CONFIG_POSTMAN_UNSENT_BYTES        16384
+/**
+ * \def CONFIG_POSTMAN_STREAM_WINDOW
+ * Max amount of pages of a stream (logs upload) pulled by the postman and not written yet.
+ */
+#define CONFIG_POSTMAN_STREAM_WINDOW       4
+/**
+ * \def CONFIG_POSTMAN_TELEOP_PORT
+ * UDP port of the teleoperation channel carrying the drive commands of the operator. 0 disables the channel.
+ */
+#define CONFIG_POSTMAN_TELEOP_PORT         12346
+/**
+ * \def CONFIG_POSTMAN_TELEOP_MAX_AGE_MS
+ * Max delay of a drive command over the fastest one received since the operator is connected. Slower commands
+ * are dropped. 0 disables the check.
+ */
+#define CONFIG_POSTMAN_TELEOP_MAX_AGE_MS   250
+
+/* CAPABILITIES */
+/**
+ * \def CONFIG_CAPABILITIES
+ * Capabilities offered to SB_IHM, see Capability in lib/defs.h.
+ */
+#define CONFIG_CAPABILITIES                (CAPABILITY_BATCH | CAPABILITY_TELEOP_UDP | CAPABILITY_COMPRESSION)
+
+/* FRAME POOL */
+/**
+ * \def CONFIG_FRAME_POOL_SMALL_SIZE
+ * Size in bytes of the frames of the small class : control frames (availability, mode, radar, alert).
+ */
+#define CONFIG_FRAME_POOL_SMALL_SIZE       16
+/**
+ * \def CONFIG_FRAME_POOL_SMALL_FRAMES
+ * Amount of frames of the small class.
+ */
+#define CONFIG_FRAME_POOL_SMALL_FRAMES     64
+/**
+ * \def CONFIG_FRAME_POOL_MEDIUM_SIZE
+ * Size in bytes of the frames of the medium class.
+ */
+#define CONFIG_FRAME_POOL_MEDIUM_SIZE      256
+/**
+ * \def CONFIG_FRAME_POOL_MEDIUM_FRAMES
+ * Amount of frames of the medium class.
+ */
+#define CONFIG_FRAME_POOL_MEDIUM_FRAMES    16
+/**
+ * \def CONFIG_FRAME_POOL_LARGE_FRAMES
+ * Amount of frames of the large class, big enough for a full log page (2 + 0xFFFF bytes each).
+ */
+#define CONFIG_FRAME_POOL_LARGE_FRAMES     4
+
+/* MAILBOXES */
+/* Mailbox of each module, see Mailbox_Kind in lib/mailbox.h : MAILBOX_RING keeps the events in the process,
+ * MAILBOX_POSIX_QUEUE sends them through the kernel. */
+/**
+ * \def CONFIG_MAILBOX_POSTMAN
+ * Mailbox of the postman.
+ */
+#ifndef CONFIG_MAILBOX_POSTMAN
+#define CONFIG_MAILBOX_POSTMAN             MAILBOX_RING
+#endif
+/**
+ * \def CONFIG_MAILBOX_CONTROLLER_CORE
+ * Mailbox of the controller core.
+ */
+#ifndef CONFIG_MAILBOX_CONTROLLER_CORE
+#define CONFIG_MAILBOX_CONTROLLER_CORE     MAILBOX_RING
+#endif
+/**
+ * \def CONFIG_MAILBOX_CONTROLLER_LOGGER
+ * Mailbox of the controller logger.
+ */
+#ifndef CONFIG_MAILBOX_CONTROLLER_LOGGER
+#define CONFIG_MAILBOX_CONTROLLER_LOGGER   MAILBOX_RING
+#endif
+/**
+ * \def CONFIG_MAILBOX_CONTROLLER_RINGER
+ * Mailbox of the controller ringer.
+ */
+#ifndef CONFIG_MAILBOX_CONTROLLER_RINGER
+#define CONFIG_MAILBOX_CONTROLLER_RINGER   MAILBOX_RING
+#endif
+/**
+ * \def CONFIG_MAILBOX_PILOT
+ * Mailbox of the pilot.
+ */
+#ifndef CONFIG_MAILBOX_PILOT
+#define CONFIG_MAILBOX_PILOT               MAILBOX_RING
+#endif
+/**
+ * \def CONFIG_MAILBOX_STATE_INDICATOR
+ * Mailbox of the state indicator.
+ */
+#ifndef CONFIG_MAILBOX_STATE_INDICATOR
+#define CONFIG_MAILBOX_STATE_INDICATOR     MAILBOX_RING
+#endif
+/**
+ * \def CONFIG_MAILBOX_LEDS
+ * Mailbox of the leds.
+ */
+#ifndef CONFIG_MAILBOX_LEDS
+#define CONFIG_MAILBOX_LEDS                MAILBOX_RING
+#endif
+/**
+ * \def CONFIG_MAILBOX_CAMERA
+ * Mailbox of the camera.
+ */
+#ifndef CONFIG_MAILBOX_CAMERA
+#define CONFIG_MAILBOX_CAMERA              MAILBOX_RING
+#endif
+
+/* ACTORS */
+/**
+ * \def CONFIG_ACTOR_TRACE
+ * 1 logs every transition of the modules in DEBUG : state, event, action and next state, as numbers of the
+ * enumerations of the module. Can be given at build time.
+ */
+#ifndef CONFIG_ACTOR_TRACE
+#define CONFIG_ACTOR_TRACE                 0
+#endif
+/**
+ * \def CONFIG_ACTOR_POOL
+ * 1 runs the modules on the workers of ACTOR_POOL_SCHEDULER, 0 gives a thread to each module. The postman keeps its
+ * thread, waiting on its sockets. Can be given at build time.
+ */
+#ifndef CONFIG_ACTOR_POOL
+#define CONFIG_ACTOR_POOL                  0
+#endif
+/**
+ * \def CONFIG_ACTOR_POOL_WORKERS
+ * Workers of ACTOR_POOL_SCHEDULER, 0 for one per core.
+ */
+#ifndef CONFIG_ACTOR_POOL_WORKERS
+#define CONFIG_ACTOR_POOL_WORKERS          0
+#endif
 
-/* DISPATCHER */
+/* WATCHDOGS */
 /**
- * \def MAX_RECEIVED_BYTES
- * Maximum of possible received bytes.
+ * \def CONFIG_WATCHDOG_TICK_MS
+ * Resolution of the watchdogs in milliseconds : a watchdog expires within a tick after its delay.
  */
-#define MAX_RECEIVED_BYTES         20
+#ifndef CONFIG_WATCHDOG_TICK_MS
+#define CONFIG_WATCHDOG_TICK_MS            10
+#endif
 
 #endif /* CONFIG_H_ */
@@ -39,8 +39,8 @@
 /* ----------------------  INCLUDES  ---------------------------------------- */
 #include "controller_core.h"
 #include <pthread.h>
-#include <mqueue.h>
-#include <errno.h>
+#include <time.h>
+#include <sys/random.h>
 
 #include "state_indicator.h"
 #include "controller_ringer.h"
@@ -52,20 +52,22 @@
 #include "../alphabot2/servo_motor.h"
 #include "../logs/controller_logger.h"
 #include "../lib/watchdog.h"
+#include "../lib/actor.h"
+#include "../config.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
-#define STATE_GENERATION S(S_FORGET) S(S_ON_DISCONNECTED) S(S_ON_CONNECTED_WAITING_ACTION) S(S_ON_CONNECTED_CHOICE) S(S_DEATH)
+#define STATE_GENERATION S(S_FORGET) S(S_ON_DISCONNECTED) S(S_ON_CONNECTED_WAITING_ACTION) S(S_ON_CONNECTED_CHOICE) S(S_ON_GRACE) S(S_DEATH)
 #define S(x) x,
 typedef enum {STATE_GENERATION STATE_NB} State_Machine;
 #undef STATE_GENERATION
 #undef S
 
-#define ACTION_GENERATION A(A_NOP) A(A_CONNECTION) A(A_SET_MODE) A(A_APPLY_MODE) A(A_SET_ROBOT_STATE) A(A_EVAL_ROBOT_STATE) A(A_DISCONNECT_OK) A(A_DISCONNECT) A(A_INIT) A(A_STOP)
+#define ACTION_GENERATION A(A_NOP) A(A_CONNECTION) A(A_SET_MODE) A(A_APPLY_MODE) A(A_SET_ROBOT_STATE) A(A_EVAL_ROBOT_STATE) A(A_DISCONNECT_OK) A(A_DISCONNECT) A(A_INIT) A(A_STOP) A(A_RESUME) A(A_END_SESSION) A(A_FORGET_SESSION) A(A_SLEEP_SERVO)
 #define A(x) x,
 typedef enum {ACTION_GENERATION ACTION_NB} Action;
 #undef ACTION_GENERATION
 #undef A
 
-#define EVENT_GENERATION E(E_ASK_TO_CONNECT) E(E_ASK_MODE) E(E_ASK_SET_MODE) E(E_ASK_SET_ROBOT_STATE) E(E_ROBOT_STATE_EVALUATED) E(E_DISCONNECTION) E(E_CONNECTION_LOST) E(E_STOP)
+#define EVENT_GENERATION E(E_ASK_TO_CONNECT) E(E_ASK_MODE) E(E_ASK_SET_MODE) E(E_ASK_SET_ROBOT_STATE) E(E_ROBOT_STATE_EVALUATED) E(E_DISCONNECTION) E(E_CONNECTION_LOST) E(E_STOP) E(E_ASK_RESUME) E(E_GRACE_EXPIRED) E(E_SERVO_IN_POSITION)
 #define E(x) x,
 typedef enum {EVENT_GENERATION EVENT_NB} Event;
 #undef EVENT_GENERATION
@@ -107,6 +109,7 @@ typedef struct {
     Id_Robot id_robot; /**< Robot identifier. */
     State robot_state; /**< Robot state. */
     Operating_Mode operating_mode; /**< Peripherals operating modes. */
+    uint32_t session_token; /**< Token of the session to resume. */
 } Action_Param_Data;
 /**
 * \struct Mq_Msg_Data controller_core.c "controller/controller_core.c"
@@ -128,16 +131,6 @@ typedef union {
     Mq_Msg_Data msg_data; /**< Data structure. */
     char buffer[sizeof(Mq_Msg_Data)]; /**< Raw message. */
 } Mq_Msg;
-/**
- * \struct Transition controller_core.c "controller/controller_core.c"
- * \brief Gives an action and state destination for a transition.
- *
- * Transition gives the action to perform when an event has been fired. Also gives the destination state.
- */
-typedef struct {
-    State_Machine state_destination; /**< Next state. */
-    Action action; /**< Action to perform from previous the event. */
-} Transition;
 /**
  * \typedef void(*Action_Pt)(Action_Param_Data * action_parameters)
  * \brief Definition of function pointer for the actions to perform.
@@ -183,17 +176,15 @@ static int CONTROLLER_CORE_apply_edit_mode(Operating_Mode operating_mode);
  * \return On success, returns 0. On error, returns -1.
  */
 static void CONTROLLER_CORE_init_hardware(void);
-/* ----- ACTIVE ----- */
 /**
- * \fn static int CONTROLLER_CORE_mq_receive(Mq_Msg * a_msg)
- * \brief Receives the messages from the queue.
- * \author Joshua MONTREUIL
- *
- * \param a_msg : pointer to Mq_Msg struct.
+ * \fn static uint32_t CONTROLLER_CORE_new_session_token(void)
+ * \brief Draws the token of a new session.
+ * \author Prose A2
  *
- * \return On success, returns 0. On error, returns -1.
+ * \return A token, never 0.
  */
-static int CONTROLLER_CORE_mq_receive(Mq_Msg * a_msg);
+static uint32_t CONTROLLER_CORE_new_session_token(void);
+/* ----- ACTIVE ----- */
 /**
  * \fn static int CONTROLLER_CORE_mq_send(Mq_Msg * a_msg)
  * \brief Sends a message into the queue.
@@ -205,23 +196,16 @@ static int CONTROLLER_CORE_mq_receive(Mq_Msg * a_msg);
  */
 static int CONTROLLER_CORE_mq_send(Mq_Msg * a_msg);
 /**
- * \fn static void * CONTROLLER_CORE_run(void * arg)
- * \brief Called by a thread. This function is the "active" part of controller core.
- * \author Joshua MONTREUIL
+ * \fn static int CONTROLLER_CORE_perform(int action, void * msg)
+ * \brief Performs an action of the state machine for the actor of controller core, with the data of the message.
+ * \author Prose A2
  *
- * \param arg : argument pointer.
+ * \param action : action to perform.
+ * \param msg : pointer to the Mq_Msg that triggered the action.
  *
- * \return void * : generic pointer.
- */
-static void * CONTROLLER_CORE_run(void* arg);
-/**
- * \fn static void CONTROLLER_CORE_stop_servo_motor(watchdog_t * watchdog)
- * \brief callback : stops the servo-motor pwm.
- * \author Joshua MOONTREUIL
- *
- * \param watchdog : watchdog used to trigger the radar check
+ * \return On success, returns 0. On error, returns -1.
  */
-static void CONTROLLER_CORE_stop_servo_motor(watchdog_t * watchdog);
+static int CONTROLLER_CORE_perform(int action, void * msg);
 /* ----- ACTIONS ----- */
 /**
  * \fn static int CONTROLLER_CORE_action_nop(Action_Param_Data * action_parameters)
@@ -295,7 +279,8 @@ static int CONTROLLER_CORE_action_evaluate_robot_state(Action_Param_Data * actio
 static int CONTROLLER_CORE_action_disconnect_ok(Action_Param_Data * action_parameters);
 /**
  * \fn static int CONTROLLER_CORE_action_disconnect(Action_Param_Data * action_parameters)
- * \brief Performs actions related to the "E_CONNECTION_LOST" event.
+ * \brief Performs actions related to the "E_CONNECTION_LOST" event. The camera keeps streaming and the session can be
+ * resumed until the end of the grace period.
  * \author Joshua MONTREUIL
  *
  * \param action_parameters : data struct with robot identifier, robot state and peripheral operating modes.
@@ -313,6 +298,46 @@ static int CONTROLLER_CORE_action_disconnect(Action_Param_Data * action_paramete
  * \return On success, returns 0. On error, returns -1.
  */
 static int CONTROLLER_CORE_action_init(Action_Param_Data * action_parameters);
+/**
+ * \fn static int CONTROLLER_CORE_action_resume(Action_Param_Data * action_parameters)
+ * \brief Performs actions related to the "E_ASK_RESUME" event : restores the lost session if the token matches.
+ * \author Prose A2
+ *
+ * \param action_parameters : data struct with robot identifier and session token.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int CONTROLLER_CORE_action_resume(Action_Param_Data * action_parameters);
+/**
+ * \fn static int CONTROLLER_CORE_action_end_session(Action_Param_Data * action_parameters)
+ * \brief Performs actions related to the "E_GRACE_EXPIRED" event while disconnected : tears down the camera.
+ * \author Prose A2
+ *
+ * \param action_parameters : data struct with robot identifier, robot state and peripheral operating modes.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int CONTROLLER_CORE_action_end_session(Action_Param_Data * action_parameters);
+/**
+ * \fn static int CONTROLLER_CORE_action_forget_session(Action_Param_Data * action_parameters)
+ * \brief Performs actions related to the "E_GRACE_EXPIRED" event while connected : the lost session is not resumed.
+ * \author Prose A2
+ *
+ * \param action_parameters : data struct with robot identifier, robot state and peripheral operating modes.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int CONTROLLER_CORE_action_forget_session(Action_Param_Data * action_parameters);
+/**
+ * \fn static int CONTROLLER_CORE_action_sleep_servo_motor(Action_Param_Data * action_parameters)
+ * \brief Performs actions related to the "E_SERVO_IN_POSITION" event : stops the servo-motor pwm.
+ * \author Joshua MONTREUIL
+ *
+ * \param action_parameters : data struct with robot identifier, robot state and peripheral operating modes.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int CONTROLLER_CORE_action_sleep_servo_motor(Action_Param_Data * action_parameters);
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
  * \var id_robot
@@ -331,15 +356,10 @@ static Operating_Mode robot_operating_mode;
  */
 static State robot_state;
 /**
- * \var static pthread_t controller_core_thread
- * \brief Postman thread.
+ * \var static Actor * my_actor
+ * \brief Actor of controller core : its mailbox and its state machine.
  */
-static pthread_t controller_core_thread;
-/**
- * \var static mqd_t my_mail_box
- * \brief Message queue reference.
- */
-static mqd_t my_mail_box;
+static Actor * my_actor;
 /**
  * \var static pthread_mutex_t controller_core_mutex_operating_mode
  * \brief Mutex used to safely read the operating mode
@@ -355,6 +375,26 @@ static pthread_mutex_t controller_core_mutex_id_robot = PTHREAD_MUTEX_INITIALIZE
  * \brief Used to wait until the servo is in position.
  */
 watchdog_t * controller_core_servo_motor_watchdog;
+/**
+ * \var controller_core_grace_watchdog
+ * \brief Ends the grace period of a lost session.
+ */
+watchdog_t * controller_core_grace_watchdog;
+/**
+ * \var static uint32_t session_token
+ * \brief Token of the session of the connected SB_IHM.
+ */
+static uint32_t session_token;
+/**
+ * \var static uint32_t lost_session_token
+ * \brief Token of the lost session, 0 when no session can be resumed.
+ */
+static uint32_t lost_session_token;
+/**
+ * \var static State lost_robot_state
+ * \brief State of the robot when the session has been lost.
+ */
+static State lost_robot_state;
 /**
  * \var static const Action_Pt actions_tab[ACTION_NB]
  * \brief Array of function pointer to call from action to perform.
@@ -370,31 +410,59 @@ static const Action_Pt actions_tab[ACTION_NB] = {
     &CONTROLLER_CORE_action_disconnect,
     &CONTROLLER_CORE_action_init,
     &CONTROLLER_CORE_action_nop,
+    &CONTROLLER_CORE_action_resume,
+    &CONTROLLER_CORE_action_end_session,
+    &CONTROLLER_CORE_action_forget_session,
+    &CONTROLLER_CORE_action_sleep_servo_motor,
 };
 /**
  * \var static Transition my_state_machine [STATE_NB -1][EVENT_NB]
  * \brief Array representing the state machine.
  */
-static Transition my_state_machine [STATE_NB -1][EVENT_NB] = {
+static const Actor_Transition my_state_machine [STATE_NB -1][EVENT_NB] = {
     [S_ON_DISCONNECTED]             [E_STOP]                  = {S_DEATH,                       A_STOP},
     [S_ON_DISCONNECTED]             [E_ASK_TO_CONNECT]        = {S_ON_CONNECTED_WAITING_ACTION, A_CONNECTION},
+    [S_ON_DISCONNECTED]             [E_SERVO_IN_POSITION]     = {S_ON_DISCONNECTED,             A_SLEEP_SERVO},
     [S_ON_CONNECTED_CHOICE]         [E_STOP]                  = {S_DEATH,                       A_STOP},
     [S_ON_CONNECTED_CHOICE]         [E_ROBOT_STATE_EVALUATED] = {S_ON_CONNECTED_WAITING_ACTION, A_SET_ROBOT_STATE},
+    [S_ON_CONNECTED_CHOICE]         [E_GRACE_EXPIRED]         = {S_ON_CONNECTED_CHOICE,         A_FORGET_SESSION},
+    [S_ON_CONNECTED_CHOICE]         [E_SERVO_IN_POSITION]     = {S_ON_CONNECTED_CHOICE,         A_SLEEP_SERVO},
     [S_ON_CONNECTED_WAITING_ACTION] [E_STOP]                  = {S_DEATH,                       A_STOP},
     [S_ON_CONNECTED_WAITING_ACTION] [E_ASK_MODE]              = {S_ON_CONNECTED_WAITING_ACTION, A_SET_MODE},
     [S_ON_CONNECTED_WAITING_ACTION] [E_ASK_SET_MODE]          = {S_ON_CONNECTED_WAITING_ACTION, A_APPLY_MODE},
     [S_ON_CONNECTED_WAITING_ACTION] [E_DISCONNECTION]         = {S_ON_DISCONNECTED,             A_DISCONNECT_OK},
-    [S_ON_CONNECTED_WAITING_ACTION] [E_CONNECTION_LOST]       = {S_ON_DISCONNECTED,             A_DISCONNECT},
+    [S_ON_CONNECTED_WAITING_ACTION] [E_CONNECTION_LOST]       = {S_ON_GRACE,                    A_DISCONNECT},
     [S_ON_CONNECTED_WAITING_ACTION] [E_ASK_SET_ROBOT_STATE]   = {S_ON_CONNECTED_CHOICE,         A_EVAL_ROBOT_STATE},
+    [S_ON_CONNECTED_WAITING_ACTION] [E_ASK_RESUME]            = {S_ON_CONNECTED_WAITING_ACTION, A_RESUME},
+    [S_ON_CONNECTED_WAITING_ACTION] [E_GRACE_EXPIRED]         = {S_ON_CONNECTED_WAITING_ACTION, A_FORGET_SESSION},
+    [S_ON_CONNECTED_WAITING_ACTION] [E_SERVO_IN_POSITION]     = {S_ON_CONNECTED_WAITING_ACTION, A_SLEEP_SERVO},
+    [S_ON_GRACE]                    [E_STOP]                  = {S_DEATH,                       A_STOP},
+    [S_ON_GRACE]                    [E_ASK_TO_CONNECT]        = {S_ON_CONNECTED_WAITING_ACTION, A_CONNECTION},
+    [S_ON_GRACE]                    [E_GRACE_EXPIRED]         = {S_ON_DISCONNECTED,             A_END_SESSION},
+    [S_ON_GRACE]                    [E_SERVO_IN_POSITION]     = {S_ON_GRACE,                    A_SLEEP_SERVO},
+};
+/**
+ * \var static const Actor_Descriptor my_descriptor
+ * \brief Mailbox and state machine of controller core, initializing the robot when it starts.
+ */
+static const Actor_Descriptor my_descriptor = {
+    .name = "controller_core",
+    .mailbox_name = MQ_CONTROLLER_CORE_BOX_NAME,
+    .msg_size = sizeof(Mq_Msg),
+    .msg_count = MQ_MSG_COUNT,
+    .priorities_nb = 1,
+    .mailbox_kind = CONFIG_MAILBOX_CONTROLLER_CORE,
+    .state_machine = &my_state_machine[0][0],
+    .states_nb = STATE_NB,
+    .events_nb = EVENT_NB,
+    .event_offset = offsetof(Mq_Msg_Data, event),
+    .initial_state = S_ON_DISCONNECTED,
+    .initial_action = A_INIT,
+    .perform = CONTROLLER_CORE_perform,
+    .is_logged = TRUE
 };
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 int CONTROLLER_CORE_create(void) {
-    struct mq_attr mqa;
-    mqa.mq_maxmsg = MQ_MSG_COUNT;
-    mqa.mq_msgsize = sizeof(Mq_Msg);
-
-    controller_core_servo_motor_watchdog = watchdog_create(SERVO_PERIOD_UNTIL_SLEEP,CONTROLLER_CORE_stop_servo_motor);
-
     if(SERVO_MOTOR_create() == -1) {
         CONTROLLER_LOGGER_log(ERROR, "On SERVO_MOTOR_create(): controller core failed to create the servo-motor.");
         return -1;
@@ -403,18 +471,20 @@ int CONTROLLER_CORE_create(void) {
         CONTROLLER_LOGGER_log(ERROR, "On CAMERA_create(): controller core failed to create the camera module.");
         goto error_camera;
     }
-    errno = 0;
-    if((my_mail_box = mq_open(MQ_CONTROLLER_CORE_BOX_NAME, O_CREAT | O_RDWR | O_EXCL , 0644 ,&mqa )) == -1 ) {
-        if(errno == EEXIST) {
-            mq_unlink(MQ_CONTROLLER_CORE_BOX_NAME);
-            if((my_mail_box = mq_open(MQ_CONTROLLER_CORE_BOX_NAME, O_CREAT | O_RDWR , 0644 ,&mqa )) == -1 ) {
-                CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for controller core after unlinking the mq.");
-                goto error_mq;
-            }
-        } else {
-            CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for controller core.");
-            goto error_mq;
-        }
+    if((my_actor = ACTOR_create(&my_descriptor)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_create(): actor failed to be created for controller core.");
+        goto error_mq;
+    }
+    Mq_Msg grace_msg = {.msg_data.event = E_GRACE_EXPIRED};
+    if((controller_core_grace_watchdog = watchdog_create_event(CONFIG_CORE_SESSION_GRACE_MS, my_actor, grace_msg.buffer)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On watchdog_create_event(): grace watchdog failed to be created for controller core.");
+        goto error_watchdog;
+    }
+    /* The pwm is stopped by the actor : the thread of the watchdogs does not wait for the I2C bus. */
+    Mq_Msg servo_msg = {.msg_data.event = E_SERVO_IN_POSITION};
+    if((controller_core_servo_motor_watchdog = watchdog_create_event(SERVO_PERIOD_UNTIL_SLEEP, my_actor, servo_msg.buffer)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On watchdog_create_event(): servo-motor watchdog failed to be created for controller core.");
+        goto error_servo_watchdog;
     }
     robot_operating_mode.buzzer_mode = ENABLED;
     robot_operating_mode.radar_mode = ENABLED;
@@ -422,6 +492,10 @@ int CONTROLLER_CORE_create(void) {
     robot_operating_mode.camera_mode = ENABLED;
     return 0;
 
+    error_servo_watchdog:
+        watchdog_destroy(controller_core_grace_watchdog);
+    error_watchdog:
+        ACTOR_destroy(my_actor);
     error_mq:
         CAMERA_destroy();
     error_camera:
@@ -434,8 +508,8 @@ int CONTROLLER_CORE_start(void) {
         CONTROLLER_LOGGER_log(ERROR, "On CAMERA_start(): controller core failed to start the camera module.");
         return -1;
     }
-    if(pthread_create(&controller_core_thread, NULL, CONTROLLER_CORE_run, NULL) != 0 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On pthread_create() : error while creating controller_core thread.");
+    if(ACTOR_start(my_actor) != 0 ) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_start() : error while starting controller_core actor.");
         CAMERA_stop();
         return -1;
     }
@@ -458,6 +532,14 @@ int CONTROLLER_CORE_ask_to_disconnect(Id_Robot id_robot) {
     return 0;
 }
 
+int CONTROLLER_CORE_ask_resume(Id_Robot id_robot, uint32_t session_token) {
+    Mq_Msg my_msg = {.msg_data.event = E_ASK_RESUME, {id_robot,0,{0,0,0,0},session_token}};
+    if(CONTROLLER_CORE_mq_send(&my_msg) == -1) {
+        return -1;
+    }
+    return 0;
+}
+
 int CONTROLLER_CORE_ask_set_state(Id_Robot id_robot, State state) {
     Mq_Msg my_msg = {.msg_data.event = E_ASK_SET_ROBOT_STATE, {id_robot,state, {0,0,0,0}}};
     if(CONTROLLER_CORE_mq_send(&my_msg) == -1) {
@@ -512,8 +594,8 @@ int CONTROLLER_CORE_stop(void) {
     }
     Mq_Msg my_msg = {.msg_data.event = E_STOP};
     if(CONTROLLER_CORE_mq_send(&my_msg) == 0) {
-        if(pthread_join(controller_core_thread, NULL) != 0) {
-            CONTROLLER_LOGGER_log(ERROR, "On pthread_join(): error while waiting the termination of controller core thread.");
+        if(ACTOR_join(my_actor) != 0) {
+            CONTROLLER_LOGGER_log(ERROR, "On ACTOR_join(): error while waiting the termination of controller core actor.");
             ret = -1;
         }
     }
@@ -534,60 +616,24 @@ int CONTROLLER_CORE_destroy(void) {
         CONTROLLER_LOGGER_log(ERROR, "On SERVO_MOTOR_destroy(): error while destroying the servo-motor.");
         ret = -1;
     }
-    if(mq_close(my_mail_box) == -1 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_close(): error while closing the mq of controller core.");
-        ret = -1;
-    }
-    if(mq_unlink(MQ_CONTROLLER_CORE_BOX_NAME) == -1 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_unlink(): error while unlinking the mq of controller core.");
+    watchdog_destroy(controller_core_servo_motor_watchdog);
+    watchdog_destroy(controller_core_grace_watchdog);
+    if(ACTOR_destroy(my_actor) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_destroy(): error while destroying the actor of controller core.");
         ret = -1;
     }
-    watchdog_destroy(controller_core_servo_motor_watchdog);
     return ret;
 }
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
 /* ACTIVE */
-static void * CONTROLLER_CORE_run(void* arg) {
-    Mq_Msg msg;
-    State_Machine my_state = S_ON_DISCONNECTED;
-    Transition * my_transition;
-    if(actions_tab[A_INIT](NULL) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action for controller core.");
-        return NULL;
-    }
-    while(my_state != S_DEATH) {
-        if(CONTROLLER_CORE_mq_receive(&msg) == -1) {
-            CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_CORE_mq_receive() : failed to read controller_core's mq.");
-            return NULL;
-        }
-        my_transition = &my_state_machine[my_state][msg.msg_data.event];
-        if(my_transition->state_destination != S_FORGET) {
-            if(actions_tab[my_transition->action](&msg.msg_data.action_data) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action for postman.");
-                return NULL;
-            }
-            my_state = my_transition->state_destination;
-        }
-    }
-    return 0;
-}
-
-static int CONTROLLER_CORE_mq_receive(Mq_Msg * a_msg) {
-    if((mq_receive(my_mail_box,a_msg->buffer,sizeof(Mq_Msg), 0) == -1)) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_receive() : Controller Core has failed to receive a message on the mq.");
-        mq_close(my_mail_box);
-        mq_unlink(MQ_CONTROLLER_CORE_BOX_NAME);
-        return -1;
-    }
-    return 0;
+static int CONTROLLER_CORE_perform(int action, void * msg) {
+    return actions_tab[action](&((Mq_Msg *) msg)->msg_data.action_data);
 }
 
 #ifndef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
 static int CONTROLLER_CORE_mq_send(Mq_Msg * a_msg) {
-    if(mq_send(my_mail_box,a_msg->buffer, sizeof(Mq_Msg),0) == -1 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_send() : Controller Core has failed to send a message into the mq.");
-        mq_close(my_mail_box);
-        mq_unlink(MQ_CONTROLLER_CORE_BOX_NAME);
+    if(ACTOR_send(my_actor, a_msg->buffer, 0) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_send() : Controller Core has failed to send a message into the mailbox.");
         return -1;
     }
     return 0;
@@ -596,10 +642,6 @@ static int CONTROLLER_CORE_mq_send(Mq_Msg * a_msg) {
 int CONTROLLER_CORE_mq_send(Mq_Msg * a_msg);
 #endif
 
-static void CONTROLLER_CORE_stop_servo_motor(watchdog_t * watchdog) {
-    SERVO_MOTOR_disable_servo_motor(); /* Then disable the servo-motor */
-}
-
 /* ACTION TRANSITIONS */
 static int CONTROLLER_CORE_action_nop(Action_Param_Data * action_parameters) { return 0; }
 
@@ -615,6 +657,11 @@ static int CONTROLLER_CORE_action_connection(Action_Param_Data * action_paramete
         CONTROLLER_LOGGER_log(ERROR, "On STATE_INDICATOR_set_state() : Putting a msg into state_indicator's mq has failed for controller_core.");
         return -1;
     }
+    session_token = CONTROLLER_CORE_new_session_token();
+    if(GUI_SECRETARY_PROXY_set_session(action_parameters->id_robot, session_token, FALSE) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On GUI_SECRETARY_PROXY_set_session() : Failed to put a msg into postman's mq.");
+        return -1;
+    }
     return 0;
 }
 
@@ -643,6 +690,7 @@ static int CONTROLLER_CORE_action_evaluate_robot_state(Action_Param_Data * actio
 }
 
 static int CONTROLLER_CORE_action_set_robot_state(Action_Param_Data * action_parameters) {
+    robot_state = action_parameters->robot_state;
     if(STATE_INDICATOR_set_state(action_parameters->robot_state) == -1) {
         CONTROLLER_LOGGER_log(ERROR, "On STATE_INDICATOR_set_state() : Putting a msg into state_indicator's mq has failed for controller_core.");
         return -1;
@@ -651,6 +699,9 @@ static int CONTROLLER_CORE_action_set_robot_state(Action_Param_Data * action_par
 }
 
 static int CONTROLLER_CORE_action_disconnect_ok(Action_Param_Data * action_parameters) {
+    /* SB_IHM has asked to leave : its previous session, if any, is not resumed. */
+    watchdog_cancel(controller_core_grace_watchdog);
+    lost_session_token = 0;
     if(GUI_SECRETARY_PROXY_disconnected_ok(action_parameters->id_robot) == -1) {
         CONTROLLER_LOGGER_log(ERROR, "On GUI_SECRETARY_PROXY_disconnected_ok() : The request to gui secretary proxy has failed.");
         return -1;
@@ -683,11 +734,11 @@ static int CONTROLLER_CORE_action_disconnect(Action_Param_Data * action_paramete
         CONTROLLER_LOGGER_log(ERROR, "On PILOT_ask_cmd() : Putting a msg into pilot's mq has failed for controller_core.");
         return -1;
     }
-    if(CAMERA_disconnect_camera() == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On  CAMERA_disconnect_camera() : Putting a msg into camera's mq has failed for controller_core.");
-        return -1;
-    }   
-    CONTROLLER_LOGGER_log(INFO,"Controller_core has been disconnected.");
+    /* The camera stays warm : SB_IHM coming back within the grace period resumes its session. */
+    lost_session_token = session_token;
+    lost_robot_state = robot_state;
+    watchdog_start(controller_core_grace_watchdog);
+    CONTROLLER_LOGGER_log(INFO,"Controller_core has been disconnected, the session can be resumed.");
     robot_state = WAITING_FOR_CONNECTION;
     if(STATE_INDICATOR_set_state(robot_state) == -1) {
         CONTROLLER_LOGGER_log(ERROR, "On STATE_INDICATOR_set_state() : Putting a msg into state_indicator's mq has failed for controller_core.");
@@ -706,6 +757,55 @@ static int CONTROLLER_CORE_action_init(Action_Param_Data * action_parameters) {
     return 0;
 }
 
+static int CONTROLLER_CORE_action_resume(Action_Param_Data * action_parameters) {
+    if(lost_session_token == 0 || action_parameters->session_token != lost_session_token) {
+        CONTROLLER_LOGGER_log(WARNING, "Controller_core has refused to resume a session.");
+        if(GUI_SECRETARY_PROXY_set_session(action_parameters->id_robot, session_token, FALSE) == -1) {
+            CONTROLLER_LOGGER_log(ERROR, "On GUI_SECRETARY_PROXY_set_session() : Failed to put a msg into postman's mq.");
+            return -1;
+        }
+        return 0;
+    }
+    watchdog_cancel(controller_core_grace_watchdog);
+    lost_session_token = 0;
+    robot_state = lost_robot_state;
+    if(STATE_INDICATOR_set_state(robot_state) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On STATE_INDICATOR_set_state() : Putting a msg into state_indicator's mq has failed for controller_core.");
+        return -1;
+    }
+    if(GUI_SECRETARY_PROXY_set_session(action_parameters->id_robot, session_token, TRUE) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On GUI_SECRETARY_PROXY_set_session() : Failed to put a msg into postman's mq.");
+        return -1;
+    }
+    /* The mode is given right away, SB_IHM does not have to ask it again. */
+    if(GUI_SECRETARY_PROXY_set_mode(action_parameters->id_robot, CONTROLLER_CORE_get_mode()) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On GUI_SECRETARY_PROXY_set_mode() : Failed to put a msg into postman's mq.");
+        return -1;
+    }
+    CONTROLLER_LOGGER_log(INFO,"Controller_core has resumed the session.");
+    return 0;
+}
+
+static int CONTROLLER_CORE_action_end_session(Action_Param_Data * action_parameters) {
+    lost_session_token = 0;
+    if(CAMERA_disconnect_camera() == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On  CAMERA_disconnect_camera() : Putting a msg into camera's mq has failed for controller_core.");
+        return -1;
+    }
+    CONTROLLER_LOGGER_log(INFO,"Controller_core has ended the session lost.");
+    return 0;
+}
+
+static int CONTROLLER_CORE_action_forget_session(Action_Param_Data * action_parameters) {
+    lost_session_token = 0;
+    return 0;
+}
+
+static int CONTROLLER_CORE_action_sleep_servo_motor(Action_Param_Data * action_parameters) {
+    SERVO_MOTOR_disable_servo_motor(); /* The servo-motor is in position : its pwm is no longer needed. */
+    return 0;
+}
+
 /* INTERNAL ACTIONS */
 #ifndef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
 static int CONTROLLER_CORE_disconnect_core(void) {
@@ -783,3 +883,13 @@ void CONTROLLER_CORE_init_hardware(void) {
 void CONTROLLER_CORE_init_hardware(void); 
 #endif
 
+static uint32_t CONTROLLER_CORE_new_session_token(void) {
+    uint32_t token;
+    if(getrandom(&token, sizeof(token), GRND_NONBLOCK) != sizeof(token)) {
+        /* Entropy pool not ready yet (early boot) : the clock is enough to tell two sessions apart. */
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        token = (uint32_t) now.tv_nsec ^ ((uint32_t) now.tv_sec * 2654435761u) ^ session_token;
+    }
+    return token != 0 ? token : 1;
+}
@@ -101,6 +101,18 @@ extern int CONTROLLER_CORE_ask_to_connect(Id_Robot id_robot);
  * \return On success, returns 0. On error, returns -1.
  */
 extern int CONTROLLER_CORE_ask_to_disconnect(Id_Robot id_robot);
+/**
+ * \fn extern int CONTROLLER_CORE_ask_resume(Id_Robot id_robot, uint32_t session_token)
+ * \brief Resumes the session lost by SB_IHM, if it presents the right token within the grace period.
+ * \author Prose A2
+ *
+ * \param id_robot : robot identifier.
+ * \see Id_Robot
+ * \param session_token : token given to SB_IHM at the beginning of its session.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int CONTROLLER_CORE_ask_resume(Id_Robot id_robot, uint32_t session_token);
 /**
  * \fn extern int CONTROLLER_CORE_ask_set_state(Id_Robot id_robot, State state)
  * \brief Changes the state of the robot.
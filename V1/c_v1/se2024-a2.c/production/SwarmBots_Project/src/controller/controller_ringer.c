@@ -39,12 +39,11 @@
 /* ----------------------  INCLUDES  ---------------------------------------- */
 #include <stdio.h>
 #include <stdlib.h>
-#include <pthread.h>
-#include <mqueue.h>
-#include <sys/stat.h>
-#include <errno.h>
+#include <stddef.h>
 
 #include "../lib/watchdog.h"
+#include "../lib/actor.h"
+#include "../config.h"
 #include "controller_ringer.h"
 #include "controller_core.h"
 #include "../logs/controller_logger.h"
@@ -112,14 +111,6 @@ typedef enum {
     ACTION_NB
 } action_e;
 /* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
-/**
- * \struct transition_t
- * \brief Contains the dest_state and the action to perform. It is used to switch state inside the module.
- */
-typedef struct {
-    state_e dest_state;
-    action_e action;
-} transition_t;
 /**
  * \struct mq_msg_data_t
  * \brief Contains the data that can be passed through the message.
@@ -143,23 +134,16 @@ typedef union {
 typedef int (*action_ptr)(mq_msg *msg);
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
 /**
- * \fn static void* CONTROLLER_RINGER_run(void* param)
- * \brief Blocking function running machine state of the module
- * \author Louison LEGROS
+ * \fn static int CONTROLLER_RINGER_perform(int action, void * msg)
+ * \brief Performs an action of the state machine for the actor of the module.
+ * \author Prose A2
+ *
+ * \param action : action to perform.
+ * \param msg : message that triggered the action.
  *
- * \param param: to be used if needed
- */
-static void *CONTROLLER_RINGER_run(void *param);
-/**
- * \fn static int CONTROLLER_RINGER_get_msg_from_queue(mq_msg* msg)
- * \brief Gets the last message from controller_ringer message queue
- * \author Louison LEGROS
- * 
- * \param msg : data structure to fill with the message queue data.
- * 
  * \return On success, returns 0. On error, returns -1.
  */
-static int CONTROLLER_RINGER_get_msg_from_queue(mq_msg *msg);
+static int CONTROLLER_RINGER_perform(int action, void *msg);
 /**
  * \fn static int CONTROLLER_RINGER_add_msg_to_queue(mq_msg* msg)
  * \brief Adds a new message to controller_ringer message queue
@@ -266,25 +250,12 @@ static int CONTROLLER_RINGER_can_still_fail_pings(void);
  * \return On success, returns 0. On error, returns -1.
  */
 static int CONTROLLER_RINGER_has_too_much_failed_pings(void);
-/**
- * \fn static void CONTROLLER_RINGER_ping_time_out(watchdog_t * watchdog)
- * \brief Callback function called when the ping watchdog is triggered.
- * \author Louison LEGROS
- *
- * \param watchdog : watchdog that triggered the callback.
- */
-static void CONTROLLER_RINGER_ping_time_out(watchdog_t *watchdog);
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
- * \var controller_ringer_thread
- * \brief Thread used by the module to execute the run method.
- */
-static pthread_t controller_ringer_thread;
-/**
- * \var controller_ringer_message_queue
- * \brief Message queue used by the module to handle events and manage module state machine.
+ * \var controller_ringer_actor
+ * \brief Actor running the state machine of the module on the events of its mailbox.
  */
-static mqd_t controller_ringer_message_queue;
+static Actor * controller_ringer_actor;
 /**
  * \var watchdog_t *controller_ringer_ping_watchdog
  * \brief watchdog used to trigger the radar check
@@ -307,7 +278,7 @@ static const action_ptr actions_tab[ACTION_NB] = {
  * \var controller_ringer_state_machine
  * \brief Struct describing the machine state of the module
  */
-static transition_t controller_ringer_state_machine[S_NB - 1][E_NB] = {
+static const Actor_Transition controller_ringer_state_machine[S_NB - 1][E_NB] = {
     [S_DISCONNECTED]    [E_INIT]                        = {S_WAITING_END_INIT,  A_INIT},
     [S_WAITING_END_INIT][E_ASK_AVAILABILITY]            = {S_WAITING_PING,      A_SET_AVAILABILITY},
     [S_WAITING_PING]    [E_TIME_OUT_PING]               = {S_CHOICE,            A_CHECK_FAILED_PINGS},
@@ -319,6 +290,26 @@ static transition_t controller_ringer_state_machine[S_NB - 1][E_NB] = {
     [S_WAITING_PING]    [E_STOP]                        = {S_DEATH,             A_NOP},
     [S_CHOICE]          [E_STOP]                        = {S_DEATH,             A_NOP}
 };
+/**
+ * \var controller_ringer_descriptor
+ * \brief Mailbox and state machine of the controller_ringer actor.
+ */
+static const Actor_Descriptor controller_ringer_descriptor = {
+    .name = "controller_ringer",
+    .mailbox_name = CONTROLLER_RINGER_MQ_BOX,
+    .msg_size = sizeof(mq_msg),
+    .msg_count = MQ_MSG_COUNT,
+    .priorities_nb = 1,
+    .mailbox_kind = CONFIG_MAILBOX_CONTROLLER_RINGER,
+    .state_machine = &controller_ringer_state_machine[0][0],
+    .states_nb = S_NB,
+    .events_nb = E_NB,
+    .event_offset = offsetof(mq_msg_data_t, event),
+    .initial_state = S_DISCONNECTED,
+    .initial_action = A_NOP,
+    .perform = CONTROLLER_RINGER_perform,
+    .is_logged = TRUE
+};
 /**
  * \var failed_pings
  * \brief Numbers of non-received pings.
@@ -327,51 +318,35 @@ static int failed_pings;
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 int CONTROLLER_RINGER_create()
 {
-    controller_ringer_ping_watchdog = watchdog_create(TIME_OUT_PINGS, CONTROLLER_RINGER_ping_time_out);
-
-    struct mq_attr mq_a = {
-        .mq_maxmsg = MQ_MSG_COUNT,
-        .mq_msgsize = sizeof(mq_msg),
-        .mq_flags = 0,
-    };
-
-    if((controller_ringer_message_queue = mq_open(CONTROLLER_RINGER_MQ_BOX, O_CREAT | O_RDWR | O_EXCL , 0644 ,&mq_a )) == -1 ) {
-        if(errno == EEXIST) {
-            mq_unlink(CONTROLLER_RINGER_MQ_BOX);
-            if((controller_ringer_message_queue = mq_open(CONTROLLER_RINGER_MQ_BOX, O_CREAT | O_RDWR , 0644 ,&mq_a )) == -1 ) {
-                CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for controller ringer after unlinking the mq.");
-                return -1;
-            }
-        } else {
-            CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for controller ringer.");
-            return -1;
-        }
+    if((controller_ringer_actor = ACTOR_create(&controller_ringer_descriptor)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_create(): actor failed to be created for controller ringer.");
+        return -1;
+    }
+    mq_msg ping_msg = {.data.event = E_TIME_OUT_PING};
+    if((controller_ringer_ping_watchdog = watchdog_create_event(TIME_OUT_PINGS, controller_ringer_actor, &ping_msg)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On watchdog_create_event(): ping watchdog failed to be created for controller ringer.");
+        ACTOR_destroy(controller_ringer_actor);
+        return -1;
     }
     return 0;
 }
 
 int CONTROLLER_RINGER_destroy() {
     int ret = 0;
-    if (mq_close(controller_ringer_message_queue) == -1)
-    {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_close(): error while closing the mq of controller ringer.");
-        ret = -1;
-    }
-    else if (mq_unlink(CONTROLLER_RINGER_MQ_BOX) == -1)
-    {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_unlink(): error while unlinking the mq of controller ringer.");
+    watchdog_destroy(controller_ringer_ping_watchdog);
+
+    if(ACTOR_destroy(controller_ringer_actor) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_destroy(): error while destroying the actor of controller ringer.");
         ret = -1;
     }
-
-    watchdog_destroy(controller_ringer_ping_watchdog);
     return ret;
 }
 
 int CONTROLLER_RINGER_start()
 {
-    if (pthread_create(&controller_ringer_thread, NULL, CONTROLLER_RINGER_run, NULL) != 0)
+    if (ACTOR_start(controller_ringer_actor) != 0)
     {
-        CONTROLLER_LOGGER_log(ERROR, "On pthread_create() : error while creating controller ringer thread.");
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_start() : error while starting controller ringer actor.");
         return -1;
     }
     return 0;
@@ -381,9 +356,9 @@ int CONTROLLER_RINGER_stop()
 {
     mq_msg msg = {.data.event = E_STOP};
     if(CONTROLLER_RINGER_add_msg_to_queue(&msg) == 0) {
-        if (pthread_join(controller_ringer_thread, NULL) != 0)
+        if (ACTOR_join(controller_ringer_actor) != 0)
         {
-            CONTROLLER_LOGGER_log(ERROR, "On pthread_join(): error while waiting the termination of controller ringer thread.");
+            CONTROLLER_LOGGER_log(ERROR, "On ACTOR_join(): error while waiting the termination of controller ringer actor.");
             return -1;
         }
     }
@@ -413,20 +388,11 @@ int CONTROLLER_RINGER_init_failed_pings_var(void)
     return 0;
 }
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
-static int CONTROLLER_RINGER_get_msg_from_queue(mq_msg *msg)
-{
-    if (mq_receive(controller_ringer_message_queue, msg->buffer, sizeof(mq_msg), NULL) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_receive(): CONTROLLER RINGER has failed to receive a message on the mq.");
-        return -1;
-    }
-    return 0;
-}
-
 #ifndef _WRAP_MQ_CONTROLLER_RINGER_MOCKERY_CMOCKA
 static int CONTROLLER_RINGER_add_msg_to_queue(mq_msg *msg)
 {
-    if (mq_send(controller_ringer_message_queue, msg->buffer, sizeof(mq_msg), 0) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_send(): CONTROLLER RINGER has failed to send a message on the mq.");
+    if (ACTOR_send(controller_ringer_actor, msg->buffer, 0) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_send(): CONTROLLER RINGER has failed to send a message on the mailbox.");
         return -1;
     }
     return 0;
@@ -435,30 +401,9 @@ static int CONTROLLER_RINGER_add_msg_to_queue(mq_msg *msg)
 int CONTROLLER_RINGER_add_msg_to_queue(mq_msg *msg);
 #endif
 
-static void *CONTROLLER_RINGER_run(void *param)
+static int CONTROLLER_RINGER_perform(int action, void *msg)
 {
-    mq_msg msg;
-    state_e current_state = S_DISCONNECTED;
-    transition_t *current_transition;
-    while (current_state != S_DEATH)
-    {
-        if (CONTROLLER_RINGER_get_msg_from_queue(&msg) != 0)
-        {
-            CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_RINGER_mq_receive() : failed to read controller_ringer's mq.");
-            return NULL;
-        }
-        current_transition = &controller_ringer_state_machine[current_state][msg.data.event];
-        if (current_transition->dest_state != S_FORGET)
-        {
-            if (actions_tab[current_transition->action](&msg) == -1)
-            {
-                CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action.");
-                return NULL;
-            }
-            current_state = current_transition->dest_state;
-        }
-    }
-    return NULL;
+    return actions_tab[action]((mq_msg *) msg);
 }
 
 /* ACTION METHODS */
@@ -565,12 +510,3 @@ static int CONTROLLER_RINGER_can_still_fail_pings()
 #else
 int CONTROLLER_RINGER_can_still_fail_pings();
 #endif
-
-static void CONTROLLER_RINGER_ping_time_out(watchdog_t *watchdog)
-{
-    CONTROLLER_LOGGER_log(DEBUG, "CONTROLLER RINGER : ping time out reached");
-    mq_msg msg = {.data.event = E_TIME_OUT_PING};
-    if (CONTROLLER_RINGER_add_msg_to_queue(&msg) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On CONTROLLER_RINGER_add_msg_to_queue() : Putting a request into controller_ringer's mq has failed.");
-    }
-}
\ No newline at end of file
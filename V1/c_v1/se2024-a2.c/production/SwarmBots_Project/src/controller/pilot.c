@@ -41,12 +41,11 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <pthread.h>
-#include <mqueue.h>
-#include <sys/stat.h>
-#include <errno.h>
 
 #include "../lib/watchdog.h"
 #include "../lib/defs.h"
+#include "../lib/actor.h"
+#include "../config.h"
 #include "../logs/controller_logger.h"
 #include "../com/gui_secretary_proxy.h"
 #include "alphabot2/radar.h"
@@ -112,15 +111,6 @@ typedef enum  {
     ACTION_NB
 } action_e ;
 /* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
-/**
- * \struct transition_t
- * \brief Contains the dest_state and the action to perform. It is used to switch state inside the module.
- */
-typedef struct
-{
-    state_e dest_state;
-    action_e action;
-} transition_t;
 /**
  * \struct mq_msg_data_t
  * \brief Contains the data that can be passed through the message.
@@ -139,6 +129,17 @@ typedef union
     mq_msg_data_t data;
     char buffer[sizeof(mq_msg_data_t)];
 } mq_msg;
+/**
+ * \struct cmd_register_t
+ * \brief Desired command : the dispatcher overwrites it, the pilot takes only the most recent one.
+ */
+typedef struct
+{
+    Command cmd;
+    uint32_t sequence;          /**< Incremented by each PILOT_ask_cmd(). */
+    uint32_t taken_sequence;    /**< Sequence of the last command taken by the pilot. */
+    bool_e is_notified;         /**< An E_ASK_CMD is on its way to the pilot. */
+} cmd_register_t;
 /**
  * \typedef int (*action_ptr)(mq_msg *msg)
  * \brief Definition of function pointer for the actions to perform.
@@ -147,16 +148,6 @@ typedef int (*action_ptr)(mq_msg *msg);
 
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
 /*------------------------STATE MACHINE RELATED FUNCTIONS------------------------*/
-/**
- * \fn static int PILOT_get_msg_from_queue(mq_msg* msg)
- * \brief Gets the last message from pilot message queue
- * \author Florentin LEPELTIER
- * 
- * \param msg [out] message received from the queue
- *
- * \return On success, returns 0. On error, returns -1.
- */
-static int PILOT_get_msg_from_queue(mq_msg* msg);
 /**
  * \fn static int PILOT_add_msg_to_queue(mq_msg* msg)
  * \brief Adds a new message to pilot message queue
@@ -168,13 +159,34 @@ static int PILOT_get_msg_from_queue(mq_msg* msg);
  */
 static int PILOT_add_msg_to_queue(mq_msg* msg);
 /**
- * \fn static void* PILOT_run(void* param)
- * \brief Blocking function running machine state of the module
- * \author Florentin LEPELTIER
+ * \fn static bool_e PILOT_take_cmd(Command * cmd)
+ * \brief Takes the most recent command asked, the older ones are never applied.
+ * \author Prose A2
+ *
+ * \param cmd [out] command to apply, left unchanged when no command is waiting.
  *
- * \param param: to be used if needed
+ * \return TRUE when a command was waiting, FALSE otherwise.
  */
-static void* PILOT_run(void* param);
+static bool_e PILOT_take_cmd(Command * cmd);
+/**
+ * \fn static int PILOT_release_cmd(void)
+ * \brief Tells that the command taken is applied : the pilot is notified again if a newer one came meanwhile.
+ * \author Prose A2
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int PILOT_release_cmd(void);
+/**
+ * \fn static int PILOT_perform(int action, void * msg)
+ * \brief Performs an action of the state machine for the actor of the module.
+ * \author Prose A2
+ *
+ * \param action : action to perform.
+ * \param msg : message that triggered the action.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int PILOT_perform(int action, void * msg);
 /*------------------------ACTIONS RELATED FUNCTIONS------------------------*/
 /**
  * \fn static int PILOT_action_nop(mq_msg * msg)
@@ -256,28 +268,15 @@ static int PILOT_action_stop_to_obstacle(mq_msg *msg);
  * \return On success, returns 0. On error, returns -1.
  */
 static int PILOT_action_stop(mq_msg *msg);
-/**
- * \fn static void PILOT_check_radar_time_out(watchdog_t * watchdog)
- * \brief callback : check radar and send the value if a change is detected.
- * \author Louison LEGROS
- *
- * \param watchdog : watchdog used to trigger the radar check
- */
-static void PILOT_check_radar_time_out(watchdog_t * watchdog);
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
- * \var pilot_thread
- * \brief Thread used by the module to execute the run method.
+ * \var pilot_actor
+ * \brief Actor running the state machine of the module on the events of its mailbox.
  */
-static pthread_t pilot_thread;
-/**
- * \var pilot_message_queue
- * \brief Message queue used by the module to handle events and manage module state machine.
- */
-static 	mqd_t pilot_message_queue;
+static Actor * pilot_actor;
 /**
  * \var watchdog_t *pilot_radar_check_watchdog
- * \brief watchdog used to trigger the radar check
+ * \brief periodic watchdog used to trigger the radar check, from PILOT_start() to the stop of the pilot
  */
 watchdog_t *pilot_radar_check_watchdog;
 /**
@@ -294,7 +293,7 @@ char *command_to_string[] = {
  * \var pilot_state_machine
  * \brief Struct describing the machine state of the module
  */
-static transition_t pilot_state_machine [S_NB-1][E_NB] = {
+static const Actor_Transition pilot_state_machine [S_NB-1][E_NB] = {
         [S_IDLE][E_ASK_CMD]                     = {S_CHOICE, A_EVALUATE_COMMAND},
         [S_IDLE][E_TIME_OUT_RADAR]              = {S_IDLE, A_CHECK_RADAR},
         [S_MODE_FORWARD][E_ASK_CMD]             = {S_CHOICE, A_EVALUATE_COMMAND},
@@ -321,15 +320,43 @@ static const action_ptr actions_tab[ACTION_NB] = {
     &PILOT_action_stop_to_obstacle,
     &PILOT_action_stop
 };
+/**
+ * \var pilot_descriptor
+ * \brief Mailbox and state machine of the pilot actor.
+ */
+static const Actor_Descriptor pilot_descriptor = {
+    .name = "pilot",
+    .mailbox_name = NAME_MQ_BOX,
+    .msg_size = sizeof(mq_msg),
+    .msg_count = MQ_MSG_COUNT,
+    .priorities_nb = 1,
+    .mailbox_kind = CONFIG_MAILBOX_PILOT,
+    .state_machine = &pilot_state_machine[0][0],
+    .states_nb = S_NB,
+    .events_nb = E_NB,
+    .event_offset = offsetof(mq_msg_data_t, event),
+    .initial_state = S_IDLE,
+    .initial_action = A_NOP,
+    .perform = PILOT_perform,
+    .is_logged = TRUE
+};
 /**
  * \var obstacle_state
  * \brief actual obstacle state from the radar.
  */
 static bool_e obstacle_state = FALSE;
+/**
+ * \var cmd_register
+ * \brief Most recent command asked by the dispatcher.
+ */
+static cmd_register_t cmd_register = {.cmd = STOP, .sequence = 0, .taken_sequence = 0, .is_notified = FALSE};
+/**
+ * \var cmd_register_mutex
+ * \brief Written by the dispatcher, read by the pilot.
+ */
+static pthread_mutex_t cmd_register_mutex = PTHREAD_MUTEX_INITIALIZER;
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 extern int PILOT_create(void) {
-    pilot_radar_check_watchdog = watchdog_create(OBSTACLE_REFRESH_PERIOD_CHECK, PILOT_check_radar_time_out);
-
     if(MOTOR_create() != 0) {
         CONTROLLER_LOGGER_log(ERROR, "On MOTOR_create(): motor creation failed.");
         return -1;
@@ -340,26 +367,19 @@ extern int PILOT_create(void) {
         goto error_radar;
     }
 
-    struct mq_attr mq_a = {
-            .mq_maxmsg = MQ_MSG_COUNT,
-            .mq_msgsize = sizeof(mq_msg),
-            .mq_flags = 0,
-    };
-
-    if((pilot_message_queue = mq_open(NAME_MQ_BOX, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR, &mq_a)) == -1 ) {
-        if(errno == EEXIST) {
-            mq_unlink(NAME_MQ_BOX);
-            if((pilot_message_queue = mq_open(NAME_MQ_BOX, O_CREAT | O_RDWR , 0644 ,&mq_a )) == -1 ) {
-                CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for pilot after unlinking the mq.");
-                goto error_mq;
-            }
-        } else {
-            CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for pilot.");
-            goto error_mq;
-        }
+    if((pilot_actor = ACTOR_create(&pilot_descriptor)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_create(): actor failed to be created for pilot.");
+        goto error_mq;
+    }
+    mq_msg radar_msg = {.data.event = E_TIME_OUT_RADAR};
+    if((pilot_radar_check_watchdog = watchdog_create_event(OBSTACLE_REFRESH_PERIOD_CHECK, pilot_actor, &radar_msg)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On watchdog_create_event(): radar watchdog failed to be created for pilot.");
+        goto error_watchdog;
     }
     return 0;
 
+    error_watchdog:
+    ACTOR_destroy(pilot_actor);
     error_mq:
     if(RADAR_destroy() != 0) {
         CONTROLLER_LOGGER_log(ERROR, "On RADAR_destroy(): radar destroy failed.");
@@ -374,17 +394,13 @@ extern int PILOT_create(void) {
 extern int PILOT_destroy(void) {
     int ret = 0;
 
-    if(mq_close(pilot_message_queue) == -1 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_close(): error while closing the mq of pilot.");
-        ret = -1;
-    }
-    if(mq_unlink(NAME_MQ_BOX) == -1 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_unlink(): error while unlinking the mq of pilot.");
+    watchdog_destroy(pilot_radar_check_watchdog);
+
+    if(ACTOR_destroy(pilot_actor) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_destroy(): error while destroying the actor of pilot.");
         ret = -1;
     }
 
-    watchdog_destroy(pilot_radar_check_watchdog);
-
     if(RADAR_destroy() != 0) {
         CONTROLLER_LOGGER_log(ERROR, "On RADAR_destroy(): radar creation failed.");
         ret = -1;
@@ -397,18 +413,19 @@ extern int PILOT_destroy(void) {
 }
 
 extern int PILOT_start(void) {
-    if(pthread_create(&pilot_thread, NULL, PILOT_run, NULL) != 0 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On pthread_create() : error while creating pilot thread.");
+    if(ACTOR_start(pilot_actor) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_start() : error while starting pilot actor.");
         return -1;
     }
+    watchdog_start_periodic(pilot_radar_check_watchdog);
     return 0;
 }
 
 extern int PILOT_stop(void) {
     mq_msg msg = {.data.event = E_STOP, 0};
     if(PILOT_add_msg_to_queue(&msg) == 0) {
-        if(pthread_join(pilot_thread, NULL) != 0) {
-            CONTROLLER_LOGGER_log(ERROR, "On pthread_join(): error while waiting the termination of pilot thread.");
+        if(ACTOR_join(pilot_actor) != 0) {
+            CONTROLLER_LOGGER_log(ERROR, "On ACTOR_join(): error while waiting the termination of pilot actor.");
             return -1;
         }
     }
@@ -416,26 +433,63 @@ extern int PILOT_stop(void) {
 }
 
 extern int PILOT_ask_cmd(Command cmd) {
+    pthread_mutex_lock(&cmd_register_mutex);
+    cmd_register.cmd = cmd;
+    cmd_register.sequence++;
+    bool_e is_to_notify = !cmd_register.is_notified;
+    cmd_register.is_notified = TRUE;
+    pthread_mutex_unlock(&cmd_register_mutex);
+
+    /* Already notified : the pilot will take this command in place of the previous one. */
+    if(!is_to_notify) {
+        return 0;
+    }
     mq_msg msg = {.data.event = E_ASK_CMD ,.data.cmd = cmd};
     if(PILOT_add_msg_to_queue(&msg) == -1) {
+        pthread_mutex_lock(&cmd_register_mutex);
+        cmd_register.is_notified = FALSE;
+        pthread_mutex_unlock(&cmd_register_mutex);
         return -1;
     }
 
     return 0;
 }
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
-static int PILOT_get_msg_from_queue(mq_msg* msg) {
-    if(mq_receive(pilot_message_queue, msg->buffer, sizeof(mq_msg), NULL) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_receive(): Pilot has failed to receive a message on the mq.");
-        return -1;
+static bool_e PILOT_take_cmd(Command * cmd) {
+    bool_e is_waiting = FALSE;
+    pthread_mutex_lock(&cmd_register_mutex);
+    if(cmd_register.sequence != cmd_register.taken_sequence) {
+        *cmd = cmd_register.cmd;
+        cmd_register.taken_sequence = cmd_register.sequence;
+        is_waiting = TRUE;
+    }
+    pthread_mutex_unlock(&cmd_register_mutex);
+    return is_waiting;
+}
+
+static int PILOT_release_cmd(void) {
+    pthread_mutex_lock(&cmd_register_mutex);
+    /* Stays notified until the newer command is taken, an E_ASK_CMD would be forgotten in S_CHOICE. */
+    bool_e is_to_notify = cmd_register.sequence != cmd_register.taken_sequence;
+    cmd_register.is_notified = is_to_notify;
+    pthread_mutex_unlock(&cmd_register_mutex);
+
+    if(is_to_notify) {
+        mq_msg msg = {.data.event = E_ASK_CMD, .data.cmd = STOP};
+        if(PILOT_add_msg_to_queue(&msg) == -1) {
+            pthread_mutex_lock(&cmd_register_mutex);
+            cmd_register.is_notified = FALSE;
+            pthread_mutex_unlock(&cmd_register_mutex);
+            return -1;
+        }
     }
     return 0;
 }
 
 #ifndef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
 static int PILOT_add_msg_to_queue(mq_msg* msg) {
-    if(mq_send(pilot_message_queue, msg->buffer, sizeof(mq_msg), 0) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_send(): Pilot has failed to send a message on the mq.");
+    if(ACTOR_send(pilot_actor, msg->buffer, 0) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_send(): Pilot has failed to send a message on the mailbox.");
         return -1;
     }
     return 0;
@@ -444,26 +498,8 @@ static int PILOT_add_msg_to_queue(mq_msg* msg) {
 int PILOT_add_msg_to_queue(mq_msg* msg);
 #endif
 
-static void* PILOT_run(void* param) {
-    mq_msg msg;
-    transition_t * current_transition;
-    state_e current_state = S_IDLE;
-    watchdog_start(pilot_radar_check_watchdog);
-
-    while (current_state != S_DEATH) {
-        if(PILOT_get_msg_from_queue(&msg) == -1) {
-            return NULL;
-        }
-        current_transition = &pilot_state_machine[current_state][msg.data.event];
-        if (current_transition->dest_state != S_FORGET) {
-            if (actions_tab[current_transition->action](&msg) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action for PILOT.");
-                return NULL;
-            }
-            current_state = current_transition->dest_state;
-        }
-    }
-    return NULL;
+static int PILOT_perform(int action, void * msg) {
+    return actions_tab[action]((mq_msg *) msg);
 }
 
 // ACTION METHODS
@@ -473,9 +509,8 @@ static int PILOT_action_nop(mq_msg * msg) {
 }
 
 static int PILOT_action_evaluate_cmd(mq_msg * msg) {
-    char log_msg_cmd[35];
-    sprintf(log_msg_cmd, "PILOT: Command asked : %s", command_to_string[msg->data.cmd]);
-    CONTROLLER_LOGGER_log(DEBUG,log_msg_cmd);
+    PILOT_take_cmd(&msg->data.cmd);
+    CONTROLLER_LOGGER_LOG(DEBUG, "PILOT: Command asked : %s", command_to_string[msg->data.cmd]);
 
     if(msg->data.cmd == FORWARD) {
         msg->data.event = E_GO_MOVE_FORWARD;
@@ -494,10 +529,8 @@ static int PILOT_action_evaluate_cmd(mq_msg * msg) {
 static int PILOT_action_move_robot(mq_msg * msg) {
 
     MOTOR_set_velocity(msg->data.cmd);
-    char log_msg[45];
-    sprintf(log_msg, "PILOT : robot direction changed to %s", command_to_string[msg->data.cmd]);
-    CONTROLLER_LOGGER_log(INFO, log_msg);
-    return 0;
+    CONTROLLER_LOGGER_LOG(INFO, "PILOT : robot direction changed to %s", command_to_string[msg->data.cmd]);
+    return PILOT_release_cmd();
 }
 
 static int PILOT_action_move_robot_forward(mq_msg * msg) {
@@ -513,7 +546,7 @@ static int PILOT_action_move_robot_forward(mq_msg * msg) {
             return -1;
         }
     }
-    return 0;
+    return PILOT_release_cmd();
 }
 
 #ifndef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
@@ -523,8 +556,9 @@ static int PILOT_action_check_radar(mq_msg * msg) {
     if(CONTROLLER_CORE_get_mode().radar_mode == ENABLED) {
         bool_e new_obstacle_state;
         if(RADAR_get_radar(&new_obstacle_state) != 0) {
+            /* A lost sample is not fatal : the periodic watchdog asks for the next one. */
             CONTROLLER_LOGGER_log(ERROR, "On RADAR_get_radar() : PILOT failed to get radar state.");
-            return -1;
+            return 0;
         }
         if(new_obstacle_state != obstacle_state)
         {
@@ -539,7 +573,6 @@ static int PILOT_action_check_radar(mq_msg * msg) {
             CONTROLLER_LOGGER_log(DEBUG,"PILOT : Radar changed state");
         }
     }
-    watchdog_start(pilot_radar_check_watchdog);
     return ret;
 }
 #else
@@ -580,12 +613,4 @@ static int PILOT_action_stop(mq_msg *msg) {
     watchdog_cancel(pilot_radar_check_watchdog);
     MOTOR_set_velocity(STOP);
     return 0;
-}
-
-// watchdog callback
-static void PILOT_check_radar_time_out(watchdog_t * watchdog) {
-    mq_msg msg = {.data.event = E_TIME_OUT_RADAR};
-    if(PILOT_add_msg_to_queue(&msg) != 0) {
-        CONTROLLER_LOGGER_log(ERROR, "On PILOT_add_msg_to_queue(&msg) : PILOT_check_radar_time_out callback failed to send a message to the mq.");
-    }
 }
\ No newline at end of file
@@ -79,7 +79,8 @@ extern int PILOT_start(void);
 extern int PILOT_stop(void);
 /**
  * \fn extern int PILOT_ask_cmd(Command cmd)
- * \brief Calls motor.c functions to change robot's behavior
+ * \brief Calls motor.c functions to change robot's behavior. Only the most recent command is applied : a command
+ * the pilot has not taken yet is replaced by the new one.
  * \author Florentin LEPELTIER
  *
  * \param cmd : Direction to go.
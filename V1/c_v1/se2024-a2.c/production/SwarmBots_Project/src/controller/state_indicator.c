@@ -35,16 +35,15 @@
  * 
  */
 /* ----------------------  INCLUDES  ---------------------------------------- */
-#include <pthread.h>
-#include <mqueue.h>
-#include <sys/stat.h>
+#include <stddef.h>
 #include <stdbool.h>
-#include <errno.h>
 
 #include "state_indicator.h"
 #include "../alphabot2/buzzer.h"
 #include "../alphabot2/leds.h"
 #include "../lib/watchdog.h"
+#include "../lib/actor.h"
+#include "../config.h"
 #include "../logs/controller_logger.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
 /**
@@ -114,14 +113,6 @@ typedef enum {
     A_STOP,
     ACTION_NB
 } action_e ;
-/**
- * \struct transition_t
- * \brief Contains the dest_state and the action to perform. It is used to switch state inside the module.
- */
-typedef struct {
-    mae_state_e dest_state;
-    action_e action;
-} transition_t;
 /**
  * \struct mq_msg_data_t
  * \brief Contains the data that can be passed through the message.
@@ -142,16 +133,6 @@ typedef union {
 /* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
 /* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
-/**
- * \fn static int STATE_INDICATOR_get_msg_from_queue(mq_msg* msg)
- * \brief Gets the last message from state indicator message queue
- * \author Louison LEGROS
- * 
- * \param msg [out] message received from the queue
- *
- * \return On success, returns 0. On error, returns -1.
- */
-static int STATE_INDICATOR_get_msg_from_queue(mq_msg * msg);
 /**
  * \fn static int STATE_INDICATOR_add_msg_to_queue(mq_msg* msg)
  * \brief Adds a message to the state indicator message queue
@@ -163,13 +144,16 @@ static int STATE_INDICATOR_get_msg_from_queue(mq_msg * msg);
  */
 static int STATE_INDICATOR_add_msg_to_queue(mq_msg * msg);
 /**
- * \fn static void* STATE_INDICATOR_run(void* param)
- * \brief Function running machine state of the module
- * \author Louison LEGROS
+ * \fn static int STATE_INDICATOR_perform(int action, void * msg)
+ * \brief Performs an action of the state machine for the actor of the module, the actions reading mae_state.
+ * \author Prose A2
+ *
+ * \param action : action to perform.
+ * \param msg : message that triggered the action.
  *
- * \param param: to be used if needed
+ * \return On success, returns 0. On error, returns -1.
  */
-static void * STATE_INDICATOR_run(void * param);
+static int STATE_INDICATOR_perform(int action, void * msg);
 /**
  * \fn static STATE_INDICATOR_action_nop(mq_msg * msg)
  * \brief For transitions without action needed.
@@ -291,14 +275,6 @@ static int STATE_INDICATOR_action_deactivate_buzzer(mq_msg * msg);
  * \return On success, returns 0. On error, returns -1.
  */
 static int STATE_INDICATOR_action_stop(mq_msg * msg);
-/**
- * \fn static void STATE_INDICATOR_emergency_time_out(watchdog_t * watchdog)
- * \brief Callback function when the emergency time out is reached.
- * \author Louison LEGROS
- * 
- * \param watchdog pointer on the watchdog that called this event
- */
-static void STATE_INDICATOR_emergency_time_out(watchdog_t * watchdog);
 /**
  * \typedef int (*action_ptr)(mq_msg *msg)
  * \brief Definition of function pointer for the actions to perform.
@@ -306,15 +282,10 @@ static void STATE_INDICATOR_emergency_time_out(watchdog_t * watchdog);
 typedef int (*action_ptr)(mq_msg *msg);
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
 /**
- * \var static pthread_t state_indicator_thread
- * \brief Thread used by the module to execute the run method.
+ * \var static Actor * state_indicator_actor
+ * \brief Actor running the state machine of the module on the events of its mailbox.
  */
-static pthread_t state_indicator_thread;
-/**
- * \var static mqd_t state_indicator_message_queue
- * \brief Message queue used by the module to handle events and manage module state machine.
- */
-static mqd_t state_indicator_message_queue;
+static Actor * state_indicator_actor;
 /**
  * \var watchdog_t *state_indicator_emergency_watchdog
  * \brief watchdog used to notify the end of the emergency state
@@ -324,7 +295,7 @@ watchdog_t *state_indicator_emergency_watchdog;
  * \var static transition_t state_indicator_state_machine
  * \brief Struct describing the machine state of the module
  */
-static transition_t state_indicator_state_machine [S_NB-1][E_NB] = {
+static const Actor_Transition state_indicator_state_machine [S_NB-1][E_NB] = {
     [S_WAITING_CONNECTION]  [E_SET_STATE]               = {S_CHOICE,                A_CHECK_STATE},
     [S_EMERGENCY]           [E_SET_STATE]               = {S_CHOICE,                A_CHECK_STATE},
     [S_SELECTED]            [E_SET_STATE]               = {S_CHOICE,                A_CHECK_STATE},
@@ -362,6 +333,26 @@ static const action_ptr actions_tab[ACTION_NB] = {
     &STATE_INDICATOR_action_deactivate_buzzer,
     &STATE_INDICATOR_action_stop
 };
+/**
+ * \var static const Actor_Descriptor state_indicator_descriptor
+ * \brief Mailbox and state machine of the state indicator actor, flashing for the connection when it starts.
+ */
+static const Actor_Descriptor state_indicator_descriptor = {
+    .name = "state_indicator",
+    .mailbox_name = NAME_MQ_BOX,
+    .msg_size = sizeof(mq_msg),
+    .msg_count = MQ_MSG_COUNT,
+    .priorities_nb = 1,
+    .mailbox_kind = CONFIG_MAILBOX_STATE_INDICATOR,
+    .state_machine = &state_indicator_state_machine[0][0],
+    .states_nb = S_NB,
+    .events_nb = E_NB,
+    .event_offset = offsetof(mq_msg_data_t, event),
+    .initial_state = S_WAITING_CONNECTION,
+    .initial_action = A_NOTIFY_WAITING_CONNECTION,
+    .perform = STATE_INDICATOR_perform,
+    .is_logged = TRUE
+};
 /**
  * \var led_activated
  * \brief Current state of the led peripheral
@@ -380,37 +371,30 @@ static State current_state;
 
 /**
  * \var mae_state
- * \brief State machine state.
+ * \brief State machine state, when the action being performed began.
  */
 static mae_state_e mae_state;
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 extern int STATE_INDICATOR_create(void) {
-    state_indicator_emergency_watchdog = watchdog_create(EMERGENCY_TIME_OUT, STATE_INDICATOR_emergency_time_out);
     if(LEDS_create() == -1) {
         CONTROLLER_LOGGER_log(ERROR, "On LEDS_create(): state indicator failed to create the leds.");
         return -1;
     }
     BUZZER_create();
     
-    struct mq_attr mq_a = {
-            .mq_maxmsg = MQ_MSG_COUNT,
-            .mq_msgsize = sizeof(mq_msg),
-            .mq_flags = 0,
-    };
-    if((state_indicator_message_queue = mq_open(NAME_MQ_BOX, O_CREAT | O_RDWR | O_EXCL , 0644 ,&mq_a )) == -1 ) {
-        if(errno == EEXIST) {
-            mq_unlink(NAME_MQ_BOX);
-            if((state_indicator_message_queue = mq_open(NAME_MQ_BOX, O_CREAT | O_RDWR , 0644 ,&mq_a )) == -1 ) {
-                CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for state indicator after unlinking the mq.");
-                goto error_mq;
-            }
-        } else {
-            CONTROLLER_LOGGER_log(ERROR, "On mq_open(): mq failed to be opened for state indicator.");
-            goto error_mq;
-        }
+    if((state_indicator_actor = ACTOR_create(&state_indicator_descriptor)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_create(): actor failed to be created for state indicator.");
+        goto error_mq;
+    }
+    mq_msg emergency_msg = {.data.event = E_TIME_OUT_EMERGENCY, 0};
+    if((state_indicator_emergency_watchdog = watchdog_create_event(EMERGENCY_TIME_OUT, state_indicator_actor, &emergency_msg)) == NULL) {
+        CONTROLLER_LOGGER_log(ERROR, "On watchdog_create_event(): emergency watchdog failed to be created for state indicator.");
+        goto error_watchdog;
     }
     return 0;
 
+    error_watchdog:
+    ACTOR_destroy(state_indicator_actor);
     error_mq:
     if(LEDS_destroy() == -1) {
         CONTROLLER_LOGGER_log(ERROR, "On LEDS_destroy(): state indicator failed to destroy leds.");
@@ -420,18 +404,12 @@ extern int STATE_INDICATOR_create(void) {
 
 extern int STATE_INDICATOR_destroy(void) {
     int ret = 0;
-    if(mq_close(state_indicator_message_queue) == -1)
-    {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_close(): error while closing the mq of state indicator.");
-        ret = -1;
-    }
-    if(mq_unlink(NAME_MQ_BOX) == -1)
-    {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_unlink(): error while unlinking the mq of state indicator.");
+    watchdog_destroy(state_indicator_emergency_watchdog);
+
+    if(ACTOR_destroy(state_indicator_actor) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_destroy(): error while destroying the actor of state indicator.");
         ret = -1;
     }
-    
-    watchdog_destroy(state_indicator_emergency_watchdog);
 
     if(LEDS_destroy() != 0) {
         CONTROLLER_LOGGER_log(ERROR, "On LEDS_destroy(): leds creation failed.");
@@ -446,8 +424,8 @@ extern int STATE_INDICATOR_start(void) {
         CONTROLLER_LOGGER_log(ERROR, "On LEDS_start(): state indicator failed to start the leds.");
         return -1;
     }
-    if(pthread_create(&state_indicator_thread, NULL, STATE_INDICATOR_run, NULL) != 0 ) {
-        CONTROLLER_LOGGER_log(ERROR, "On pthread_create() : error while creating state indicator thread.");
+    if(ACTOR_start(state_indicator_actor) != 0 ) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_start() : error while starting state indicator actor.");
         if(LEDS_stop() == -1) {
             CONTROLLER_LOGGER_log(ERROR, "On LEDS_stop(): state indicator failed to stop the leds.");
             return -1;
@@ -461,8 +439,8 @@ extern int STATE_INDICATOR_stop(void) {
     int ret = 0;
     mq_msg msg = {.data.event = E_STOP, 0};
     if(STATE_INDICATOR_add_msg_to_queue(&msg) == 0) {
-        if(pthread_join(state_indicator_thread, NULL) != 0) {
-            CONTROLLER_LOGGER_log(ERROR, "On pthread_join(): error while waiting the termination of state indicator thread.");
+        if(ACTOR_join(state_indicator_actor) != 0) {
+            CONTROLLER_LOGGER_log(ERROR, "On ACTOR_join(): error while waiting the termination of state indicator actor.");
             ret = -1;
         }
     }
@@ -524,18 +502,10 @@ extern int STATE_INDICATOR_disable_buzzer(void) {
 }
 
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
-static int STATE_INDICATOR_get_msg_from_queue(mq_msg* msg) {
-    if(mq_receive(state_indicator_message_queue, msg->buffer, sizeof(mq_msg), NULL) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_receive(): STATE INDICATOR has failed to receive a message on the mq.");
-        return -1;
-    }
-    return 0;
-}
-
 #ifndef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
 static int STATE_INDICATOR_add_msg_to_queue(mq_msg* msg) {
-    if(mq_send(state_indicator_message_queue, msg->buffer, sizeof(mq_msg), 0) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On mq_send(): STATE INDICATOR has failed to send a message on the mq.");
+    if(ACTOR_send(state_indicator_actor, msg->buffer, 0) == -1) {
+        CONTROLLER_LOGGER_log(ERROR, "On ACTOR_send(): STATE INDICATOR has failed to send a message on the mailbox.");
         return -1;
     }
     return 0;
@@ -544,29 +514,9 @@ static int STATE_INDICATOR_add_msg_to_queue(mq_msg* msg) {
 int STATE_INDICATOR_add_msg_to_queue(mq_msg* msg);
 #endif
 
-static void* STATE_INDICATOR_run(void * param) {
-    mq_msg msg;
-    mae_state = S_WAITING_CONNECTION;
-    if(STATE_INDICATOR_action_flashing_for_connection(&msg) == -1) {
-        CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the first action for STATE INDICATOR.");
-        return NULL;
-    }
-
-    transition_t * current_transition;
-    while (mae_state != S_DEATH) {
-        if(STATE_INDICATOR_get_msg_from_queue(&msg) == -1) {
-            return NULL;
-        }
-        current_transition = &state_indicator_state_machine[mae_state][msg.data.event];
-        if (current_transition->dest_state != S_FORGET) {
-            if (actions_tab[current_transition->action](&msg) == -1) {
-                CONTROLLER_LOGGER_log(ERROR, "On actions_tab() : failed to execute the action for STATE INDICATOR.");
-                return NULL;
-            }
-            mae_state = current_transition->dest_state;
-        }
-    }
-    return NULL;
+static int STATE_INDICATOR_perform(int action, void * msg) {
+    mae_state = ACTOR_get_state(state_indicator_actor);
+    return actions_tab[action]((mq_msg *) msg);
 }
 
 static int STATE_INDICATOR_action_nop(mq_msg * msg) {
@@ -753,10 +703,3 @@ static int STATE_INDICATOR_action_stop(mq_msg * msg) {
     return 0;
 }
 
-static void STATE_INDICATOR_emergency_time_out(watchdog_t * watchdog)
-{
-    mq_msg msg = {.data.event = E_TIME_OUT_EMERGENCY, 0};
-    if(STATE_INDICATOR_add_msg_to_queue(&msg) != 0) {
-        CONTROLLER_LOGGER_log(ERROR, "On STATE_INDICATOR_add_msg_to_queue() : STATE_INDICATOR_emergency_time_out callback failed to send a message to the mq.");
-    }
-}
@@ -0,0 +1,675 @@
+/**
+ * \file  actor.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Actors of SB_C. Every module gives its state machine, its actions and its mailbox once ; the runtime
+ * receives the events, looks up the transitions, performs the actions, traces them and measures them.
+ *
+ * \see actor.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "actor.h"
+#include "../config.h"
+#include "../logs/controller_logger.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def ACTOR_MAX
+ * Most actors registered at the same time.
+ */
+#define ACTOR_MAX 16
+/**
+ * \def THREAD_NAME_SIZE
+ * Longest name of a thread on Linux, ending zero included.
+ */
+#define THREAD_NAME_SIZE 16
+/**
+ * \def ACTOR_POOL_WORKERS_MAX
+ * Most workers of ACTOR_POOL_SCHEDULER.
+ */
+#define ACTOR_POOL_WORKERS_MAX 16
+/**
+ * \def ACTOR_POOL_BATCH
+ * Messages handled in a row by a worker before the actor goes back at the end of the run queue, so that a busy actor
+ * does not starve the others.
+ */
+#define ACTOR_POOL_BATCH 16
+/* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Actor
+ * \brief A module : its descriptor, its mailbox, its state and its measures.
+ */
+struct Actor {
+    const Actor_Descriptor * descriptor;  /**< Given at the creation. */
+    Mailbox * mailbox;                    /**< Events sent to the actor. */
+    int state;                            /**< Current state, read by any thread. */
+    void * msg;                           /**< Message handled by the loop of the actor. */
+    void * raised;                        /**< Event raised by an action, handled before the mailbox. */
+    bool_e is_raised;                     /**< TRUE while raised waits to be handled. */
+    const Actor_Scheduler * scheduler;    /**< Scheduler the actor was started with. */
+    pthread_t thread;                     /**< Thread of the actor, for ACTOR_THREAD_SCHEDULER. */
+    unsigned long long events;            /**< Events handled, read by any thread. */
+    unsigned long long forgotten;         /**< Events forgotten, read by any thread. */
+    unsigned long long action_time;       /**< Time spent in the actions in nanoseconds, read by any thread. */
+    unsigned long long action_time_max;   /**< Longest action in nanoseconds, read by any thread. */
+    unsigned int pending;                 /**< Messages sent and not handled yet, plus one until the actor has begun. */
+    bool_e is_begun;                      /**< TRUE once a worker has performed the initial action. */
+    bool_e is_over;                       /**< TRUE once a worker has left the actor for good, dead or failed. */
+    Actor * next;                         /**< Next actor in the run queue of ACTOR_POOL_SCHEDULER. */
+};
+/**
+ * \struct Actor_Pool
+ * \brief Workers of ACTOR_POOL_SCHEDULER and the actors waiting for one of them.
+ */
+typedef struct {
+    pthread_mutex_t mutex;  /**< Protects the pool. */
+    pthread_cond_t work;    /**< Signaled when an actor is queued or when the workers stop. */
+    pthread_cond_t over;    /**< Signaled when an actor is over or when a worker ends. */
+    Actor * first;          /**< Head of the run queue. */
+    Actor * last;           /**< Tail of the run queue. */
+    int staff_nb;           /**< Workers kept while the run queue is empty. */
+    int workers_nb;         /**< Workers running, more than staff_nb while some wait for room in a mailbox. */
+    int idle_nb;            /**< Workers waiting for an actor to run. */
+    int actors_nb;          /**< Actors started and not joined yet. */
+    bool_e is_stopping;     /**< TRUE to end the workers once the run queue is empty. */
+} Actor_Pool;
+/* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static int ACTOR_begin(Actor * actor)
+ * \brief Puts an actor in its initial state and performs its initial action, on the thread of the actor.
+ * \return On success, returns 0. When the action fails, returns -1.
+ */
+static int ACTOR_begin(Actor * actor);
+/**
+ * \fn static void * ACTOR_loop(Actor * actor)
+ * \brief Loop of the actors without their own : receives the events of the mailbox until S_DEATH.
+ */
+static void * ACTOR_loop(Actor * actor);
+/**
+ * \fn static int ACTOR_fire(Actor * actor, void * msg)
+ * \brief Fires the transition of a message in the current state.
+ * \return On success, returns 0. When the action fails, returns -1.
+ */
+static int ACTOR_fire(Actor * actor, void * msg);
+/**
+ * \fn static int ACTOR_post(Actor * actor)
+ * \brief Counts a message sent to an actor, and wakes the actor up with its first message waiting.
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int ACTOR_post(Actor * actor);
+/**
+ * \fn static int ACTOR_perform(Actor * actor, int action, void * msg)
+ * \brief Performs and measures an action.
+ * \return The return of the action.
+ */
+static int ACTOR_perform(Actor * actor, int action, void * msg);
+/**
+ * \fn static void ACTOR_report(const Actor * actor, const char * error)
+ * \brief Logs an error of an actor, or prints it for the logger.
+ */
+static void ACTOR_report(const Actor * actor, const char * error);
+/**
+ * \fn static void * ACTOR_thread_run(void * arg)
+ * \brief Thread of an actor for ACTOR_THREAD_SCHEDULER.
+ */
+static void * ACTOR_thread_run(void * arg);
+/**
+ * \fn static int ACTOR_thread_start(Actor * actor)
+ * \brief Starts the thread of an actor, named after it.
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int ACTOR_thread_start(Actor * actor);
+/**
+ * \fn static int ACTOR_thread_join(Actor * actor)
+ * \brief Waits for the end of the thread of an actor.
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int ACTOR_thread_join(Actor * actor);
+/**
+ * \fn static int ACTOR_pool_start(Actor * actor)
+ * \brief Queues an actor for its initial action, hiring the workers with the first actor.
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int ACTOR_pool_start(Actor * actor);
+/**
+ * \fn static int ACTOR_pool_join(Actor * actor)
+ * \brief Waits for an actor to be over, waiting for the end of the workers with the last actor.
+ * \return Returns 0.
+ */
+static int ACTOR_pool_join(Actor * actor);
+/**
+ * \fn static int ACTOR_pool_notify(Actor * actor)
+ * \brief Queues an actor which has a message waiting.
+ * \return Returns 0.
+ */
+static int ACTOR_pool_notify(Actor * actor);
+/**
+ * \fn static int ACTOR_pool_send(Actor * actor, const void * msg, unsigned int priority)
+ * \brief Sends a message from a worker. When the mailbox is full, another worker is hired before waiting for room, so
+ * that the receiver can still be run.
+ * \return On success, returns 0. On error, returns -1.
+ */
+static int ACTOR_pool_send(Actor * actor, const void * msg, unsigned int priority);
+/**
+ * \fn static void ACTOR_pool_hire(int workers_nb)
+ * \brief Starts workers up to workers_nb, ACTOR_POOL_WORKERS_MAX at most. The mutex of the pool is taken.
+ */
+static void ACTOR_pool_hire(int workers_nb);
+/**
+ * \fn static void ACTOR_pool_queue(Actor * actor)
+ * \brief Puts an actor at the end of the run queue and wakes a worker up. The mutex of the pool is taken.
+ */
+static void ACTOR_pool_queue(Actor * actor);
+/**
+ * \fn static void * ACTOR_pool_work(void * arg)
+ * \brief Thread of a worker : runs the actors of the run queue until the workers stop.
+ */
+static void * ACTOR_pool_work(void * arg);
+/**
+ * \fn static void ACTOR_pool_run(Actor * actor)
+ * \brief Handles the messages waiting for an actor, on the worker owning it.
+ */
+static void ACTOR_pool_run(Actor * actor);
+/**
+ * \fn static bool_e ACTOR_pool_release(Actor * actor)
+ * \brief Counts a message handled, and gives up the actor when no other message waits.
+ * \return TRUE when the actor is given up : the next message sent queues it again.
+ */
+static bool_e ACTOR_pool_release(Actor * actor);
+/**
+ * \fn static void ACTOR_pool_end(Actor * actor)
+ * \brief Leaves an actor for good and wakes ACTOR_pool_join() up.
+ */
+static void ACTOR_pool_end(Actor * actor);
+/**
+ * \fn static uint64_t ACTOR_now(void)
+ * \brief Reads the monotonic clock, in nanoseconds.
+ */
+static uint64_t ACTOR_now(void);
+/* ----------------------  PUBLIC VARIABLES  -------------------------------- */
+const Actor_Scheduler ACTOR_THREAD_SCHEDULER = {
+    .start = ACTOR_thread_start,
+    .join = ACTOR_thread_join,
+    .notify = NULL,
+};
+
+const Actor_Scheduler ACTOR_POOL_SCHEDULER = {
+    .start = ACTOR_pool_start,
+    .join = ACTOR_pool_join,
+    .notify = ACTOR_pool_notify,
+};
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static Actor * actors[ACTOR_MAX]
+ * \brief Actors created, found by their name for their metrics.
+ */
+static Actor * actors[ACTOR_MAX];
+/**
+ * \var static pthread_mutex_t actors_mutex
+ * \brief Protects actors.
+ */
+static pthread_mutex_t actors_mutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * \var static const Actor_Scheduler * scheduler
+ * \brief Scheduler of the actors started next.
+ */
+static const Actor_Scheduler * scheduler = &ACTOR_THREAD_SCHEDULER;
+/**
+ * \var static __thread bool_e is_worker
+ * \brief TRUE on the threads of the workers.
+ */
+static __thread bool_e is_worker;
+/**
+ * \var static Actor_Pool pool
+ * \brief Workers of ACTOR_POOL_SCHEDULER, started with the first actor and stopped with the last one.
+ */
+static Actor_Pool pool = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .work = PTHREAD_COND_INITIALIZER,
+    .over = PTHREAD_COND_INITIALIZER,
+};
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+Actor * ACTOR_create(const Actor_Descriptor * descriptor) {
+    Actor * actor = calloc(1, sizeof(Actor));
+    if(actor == NULL) {
+        return NULL;
+    }
+    actor->descriptor = descriptor;
+    actor->state = descriptor->initial_state;
+    /* Held until the initial action is performed : the messages sent before do not wake the actor up. */
+    actor->pending = 1;
+    actor->msg = calloc(2, descriptor->msg_size);
+    if(actor->msg == NULL) {
+        free(actor);
+        return NULL;
+    }
+    actor->raised = (char *) actor->msg + descriptor->msg_size;
+    if((actor->mailbox = MAILBOX_open(descriptor->mailbox_name, descriptor->msg_size, descriptor->msg_count,
+                                      descriptor->priorities_nb, descriptor->mailbox_kind)) == NULL) {
+        free(actor->msg);
+        free(actor);
+        return NULL;
+    }
+    pthread_mutex_lock(&actors_mutex);
+    for(int id = 0; id < ACTOR_MAX; id++) {
+        if(actors[id] == NULL) {
+            actors[id] = actor;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&actors_mutex);
+    return actor;
+}
+
+int ACTOR_destroy(Actor * actor) {
+    pthread_mutex_lock(&actors_mutex);
+    for(int id = 0; id < ACTOR_MAX; id++) {
+        if(actors[id] == actor) {
+            actors[id] = NULL;
+        }
+    }
+    pthread_mutex_unlock(&actors_mutex);
+    int ret = MAILBOX_close(actor->mailbox);
+    free(actor->msg);
+    free(actor);
+    return ret;
+}
+
+void ACTOR_set_scheduler(const Actor_Scheduler * a_scheduler) {
+    scheduler = a_scheduler;
+}
+
+int ACTOR_start(Actor * actor) {
+    /* Its loop waits on more than the mailbox : only a thread of its own can run it. */
+    actor->scheduler = actor->descriptor->run != NULL ? &ACTOR_THREAD_SCHEDULER : scheduler;
+    return actor->scheduler->start(actor);
+}
+
+int ACTOR_join(Actor * actor) {
+    return actor->scheduler->join(actor);
+}
+
+int ACTOR_send(Actor * actor, const void * msg, unsigned int priority) {
+    if((is_worker ? ACTOR_pool_send(actor, msg, priority) : MAILBOX_send(actor->mailbox, msg, priority)) == -1) {
+        return -1;
+    }
+    return ACTOR_post(actor);
+}
+
+int ACTOR_try_send(Actor * actor, const void * msg, unsigned int priority) {
+    int sent = MAILBOX_try_send(actor->mailbox, msg, priority);
+    if(sent != 1) {
+        return sent;
+    }
+    return ACTOR_post(actor) == -1 ? -1 : 1;
+}
+
+int ACTOR_raise(Actor * actor, const void * msg) {
+    if(actor->is_raised) {
+        return -1;
+    }
+    memcpy(actor->raised, msg, actor->descriptor->msg_size);
+    actor->is_raised = TRUE;
+    return 0;
+}
+
+int ACTOR_handle(Actor * actor, void * msg) {
+    if(ACTOR_fire(actor, msg) == -1) {
+        return -1;
+    }
+    /* Raised by the action : handled before the mailbox, which may be full of the events the actor waits for. */
+    while(actor->is_raised) {
+        memcpy(msg, actor->raised, actor->descriptor->msg_size);
+        actor->is_raised = FALSE;
+        if(ACTOR_fire(actor, msg) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int ACTOR_get_state(const Actor * actor) {
+    return __atomic_load_n(&actor->state, __ATOMIC_RELAXED);
+}
+
+bool_e ACTOR_is_dead(const Actor * actor) {
+    return ACTOR_get_state(actor) == actor->descriptor->states_nb - 1 ? TRUE : FALSE;
+}
+
+Mailbox * ACTOR_get_mailbox(Actor * actor) {
+    return actor->mailbox;
+}
+
+const Actor_Descriptor * ACTOR_get_descriptor(const Actor * actor) {
+    return actor->descriptor;
+}
+
+int ACTOR_get_metrics(const char * name, Actor_Metrics * metrics) {
+    int ret = -1;
+    pthread_mutex_lock(&actors_mutex);
+    for(int id = 0; id < ACTOR_MAX; id++) {
+        const Actor * actor = actors[id];
+        if(actor != NULL && strcmp(actor->descriptor->name, name) == 0) {
+            metrics->state = ACTOR_get_state(actor);
+            metrics->events = __atomic_load_n(&actor->events, __ATOMIC_RELAXED);
+            metrics->forgotten = __atomic_load_n(&actor->forgotten, __ATOMIC_RELAXED);
+            metrics->action_time = __atomic_load_n(&actor->action_time, __ATOMIC_RELAXED);
+            metrics->action_time_max = __atomic_load_n(&actor->action_time_max, __ATOMIC_RELAXED);
+            ret = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&actors_mutex);
+    return ret;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static int ACTOR_begin(Actor * actor) {
+    const Actor_Descriptor * descriptor = actor->descriptor;
+    __atomic_store_n(&actor->state, descriptor->initial_state, __ATOMIC_RELAXED);
+    if(descriptor->initial_action != 0) {
+        memset(actor->msg, 0, descriptor->msg_size);
+        if(ACTOR_perform(actor, descriptor->initial_action, actor->msg) == -1) {
+            ACTOR_report(actor, "On ACTOR_perform() : failed to execute the first action");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void * ACTOR_loop(Actor * actor) {
+    while(!ACTOR_is_dead(actor)) {
+        if(MAILBOX_receive(actor->mailbox, actor->msg) == -1) {
+            ACTOR_report(actor, "On MAILBOX_receive() : failed to receive a message on the mailbox");
+            break;
+        }
+        if(ACTOR_handle(actor, actor->msg) == -1) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static int ACTOR_fire(Actor * actor, void * msg) {
+    const Actor_Descriptor * descriptor = actor->descriptor;
+    int state = actor->state;
+    int event;
+    memcpy(&event, (const char *) msg + descriptor->event_offset, sizeof(event));
+    __atomic_store_n(&actor->events, actor->events + 1, __ATOMIC_RELAXED);
+
+    if(state >= descriptor->states_nb - 1 || event < 0 || event >= descriptor->events_nb
+       || descriptor->state_machine[state * descriptor->events_nb + event].destination == ACTOR_FORGET) {
+        __atomic_store_n(&actor->forgotten, actor->forgotten + 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    const Actor_Transition * transition = &descriptor->state_machine[state * descriptor->events_nb + event];
+#if CONFIG_ACTOR_TRACE
+    if(descriptor->is_logged) {
+        CONTROLLER_LOGGER_LOG(DEBUG, "ACTOR %s : state %d, event %d, action %d, next state %d", descriptor->name,
+                              state, event, transition->action, transition->destination);
+    }
+    else {
+        printf("ACTOR %s : state %d, event %d, action %d, next state %d\n", descriptor->name,
+               state, event, transition->action, transition->destination);
+    }
+#endif
+    if(ACTOR_perform(actor, transition->action, msg) == -1) {
+        ACTOR_report(actor, "On ACTOR_perform() : failed to execute the action");
+        return -1;
+    }
+    __atomic_store_n(&actor->state, transition->destination, __ATOMIC_RELAXED);
+    return 0;
+}
+
+static int ACTOR_post(Actor * actor) {
+    if(__atomic_fetch_add(&actor->pending, 1, __ATOMIC_ACQ_REL) == 0 && actor->scheduler->notify != NULL) {
+        return actor->scheduler->notify(actor);
+    }
+    return 0;
+}
+
+static int ACTOR_perform(Actor * actor, int action, void * msg) {
+    uint64_t start = ACTOR_now();
+    int ret = actor->descriptor->perform(action, msg);
+    unsigned long long duration = ACTOR_now() - start;
+    __atomic_store_n(&actor->action_time, actor->action_time + duration, __ATOMIC_RELAXED);
+    if(duration > actor->action_time_max) {
+        __atomic_store_n(&actor->action_time_max, duration, __ATOMIC_RELAXED);
+    }
+    return ret;
+}
+
+static void ACTOR_report(const Actor * actor, const char * error) {
+    if(actor->descriptor->is_logged) {
+        CONTROLLER_LOGGER_LOG(ERROR, "%s of %s.", error, actor->descriptor->name);
+    }
+    else {
+        /* Cannot be logged : the actor is the logger. */
+        printf("ERROR %s of %s.\n", error, actor->descriptor->name);
+    }
+}
+
+static void * ACTOR_thread_run(void * arg) {
+    Actor * actor = arg;
+    if(ACTOR_begin(actor) == -1) {
+        return NULL;
+    }
+    return actor->descriptor->run != NULL ? actor->descriptor->run(actor) : ACTOR_loop(actor);
+}
+
+static int ACTOR_thread_start(Actor * actor) {
+    if(pthread_create(&actor->thread, NULL, ACTOR_thread_run, actor) != 0) {
+        ACTOR_report(actor, "On pthread_create() : error while creating the thread");
+        return -1;
+    }
+    char name[THREAD_NAME_SIZE];
+    snprintf(name, sizeof(name), "%s", actor->descriptor->name);
+    pthread_setname_np(actor->thread, name);
+    return 0;
+}
+
+static int ACTOR_thread_join(Actor * actor) {
+    if(pthread_join(actor->thread, NULL) != 0) {
+        ACTOR_report(actor, "On pthread_join() : error while waiting the termination of the thread");
+        return -1;
+    }
+    return 0;
+}
+
+static int ACTOR_pool_start(Actor * actor) {
+    int ret = 0;
+    pthread_mutex_lock(&pool.mutex);
+    if(pool.workers_nb == 0) {
+        long staff_nb = CONFIG_ACTOR_POOL_WORKERS > 0 ? CONFIG_ACTOR_POOL_WORKERS : sysconf(_SC_NPROCESSORS_ONLN);
+        pool.staff_nb = staff_nb < 1 ? 1 : staff_nb > ACTOR_POOL_WORKERS_MAX ? ACTOR_POOL_WORKERS_MAX : (int) staff_nb;
+        ACTOR_pool_hire(pool.staff_nb);
+    }
+    if(pool.workers_nb == 0) {
+        ACTOR_report(actor, "On pthread_create() : error while creating the workers");
+        ret = -1;
+    }
+    else {
+        pool.actors_nb++;
+        ACTOR_pool_queue(actor);
+    }
+    pthread_mutex_unlock(&pool.mutex);
+    return ret;
+}
+
+static int ACTOR_pool_join(Actor * actor) {
+    pthread_mutex_lock(&pool.mutex);
+    while(!actor->is_over) {
+        pthread_cond_wait(&pool.over, &pool.mutex);
+    }
+    if(--pool.actors_nb == 0) {
+        pool.is_stopping = TRUE;
+        pthread_cond_broadcast(&pool.work);
+        while(pool.workers_nb > 0) {
+            pthread_cond_wait(&pool.over, &pool.mutex);
+        }
+        pool.is_stopping = FALSE;
+    }
+    pthread_mutex_unlock(&pool.mutex);
+    return 0;
+}
+
+static int ACTOR_pool_notify(Actor * actor) {
+    pthread_mutex_lock(&pool.mutex);
+    ACTOR_pool_queue(actor);
+    pthread_mutex_unlock(&pool.mutex);
+    return 0;
+}
+
+static int ACTOR_pool_send(Actor * actor, const void * msg, unsigned int priority) {
+    int sent = MAILBOX_try_send(actor->mailbox, msg, priority);
+    if(sent != 0) {
+        return sent == 1 ? 0 : -1;
+    }
+    /* This worker waits : the receiver may be queued behind its own actor, with no other worker free to run it. */
+    pthread_mutex_lock(&pool.mutex);
+    if(pool.idle_nb == 0) {
+        ACTOR_pool_hire(pool.workers_nb + 1);
+    }
+    pthread_mutex_unlock(&pool.mutex);
+    return MAILBOX_send(actor->mailbox, msg, priority);
+}
+
+static void ACTOR_pool_hire(int workers_nb) {
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    /* Not joined : ACTOR_pool_join() waits for workers_nb to drop to 0. */
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    pthread_t worker;
+    while(pool.workers_nb < workers_nb && pool.workers_nb < ACTOR_POOL_WORKERS_MAX
+          && pthread_create(&worker, &attributes, ACTOR_pool_work, NULL) == 0) {
+        char name[THREAD_NAME_SIZE];
+        snprintf(name, sizeof(name), "actor_pool_%u", (unsigned char) pool.workers_nb);
+        pthread_setname_np(worker, name);
+        pool.workers_nb++;
+    }
+    pthread_attr_destroy(&attributes);
+}
+
+static void ACTOR_pool_queue(Actor * actor) {
+    actor->next = NULL;
+    if(pool.last == NULL) {
+        pool.first = actor;
+    }
+    else {
+        pool.last->next = actor;
+    }
+    pool.last = actor;
+    pthread_cond_signal(&pool.work);
+}
+
+static void * ACTOR_pool_work(void * arg) {
+    is_worker = TRUE;
+    for(;;) {
+        pthread_mutex_lock(&pool.mutex);
+        pool.idle_nb++;
+        /* The workers hired while others waited for room leave as soon as they find nothing to do. */
+        while(pool.first == NULL && !pool.is_stopping && pool.workers_nb <= pool.staff_nb) {
+            pthread_cond_wait(&pool.work, &pool.mutex);
+        }
+        pool.idle_nb--;
+        Actor * actor = pool.first;
+        if(actor == NULL) {
+            pool.workers_nb--;
+            pthread_cond_broadcast(&pool.over);
+            pthread_mutex_unlock(&pool.mutex);
+            return NULL;
+        }
+        pool.first = actor->next;
+        if(pool.first == NULL) {
+            pool.last = NULL;
+        }
+        pthread_mutex_unlock(&pool.mutex);
+        ACTOR_pool_run(actor);
+    }
+}
+
+static void ACTOR_pool_run(Actor * actor) {
+    /* Only the worker which took the actor from the run queue handles its messages, until it gives it up. */
+    if(!actor->is_begun) {
+        actor->is_begun = TRUE;
+        if(ACTOR_begin(actor) == -1) {
+            ACTOR_pool_end(actor);
+            return;
+        }
+        if(ACTOR_pool_release(actor)) {
+            return;
+        }
+    }
+    for(int handled = 0; handled < ACTOR_POOL_BATCH; handled++) {
+        int received = MAILBOX_try_receive(actor->mailbox, actor->msg);
+        if(received == -1) {
+            ACTOR_report(actor, "On MAILBOX_try_receive() : failed to receive a message on the mailbox");
+            ACTOR_pool_end(actor);
+            return;
+        }
+        if(received == 0) {
+            break;
+        }
+        if(ACTOR_handle(actor, actor->msg) == -1 || ACTOR_is_dead(actor)) {
+            ACTOR_pool_end(actor);
+            return;
+        }
+        if(ACTOR_pool_release(actor)) {
+            return;
+        }
+    }
+    pthread_mutex_lock(&pool.mutex);
+    ACTOR_pool_queue(actor);
+    pthread_mutex_unlock(&pool.mutex);
+}
+
+static bool_e ACTOR_pool_release(Actor * actor) {
+    return __atomic_sub_fetch(&actor->pending, 1, __ATOMIC_ACQ_REL) == 0 ? TRUE : FALSE;
+}
+
+static void ACTOR_pool_end(Actor * actor) {
+    pthread_mutex_lock(&pool.mutex);
+    actor->is_over = TRUE;
+    pthread_cond_broadcast(&pool.over);
+    pthread_mutex_unlock(&pool.mutex);
+}
+
+static uint64_t ACTOR_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
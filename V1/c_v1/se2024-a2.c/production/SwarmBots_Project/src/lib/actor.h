@@ -0,0 +1,281 @@
+/**
+ * \file  actor.h
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Header file of the actors : the thread, the mailbox and the state machine shared by the modules of SB_C.
+ *
+ * \see actor.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+
+#ifndef SRC_LIB_ACTOR_H_
+#define SRC_LIB_ACTOR_H_
+/* ----------------------  INCLUDES ------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include "defs.h"
+#include "mailbox.h"
+/* ----------------------  PUBLIC CONFIGURATIONS  ----------------------------*/
+/**
+ * \def ACTOR_FORGET
+ * State 0 of every actor, S_FORGET : a transition to it forgets the event.
+ */
+#define ACTOR_FORGET 0
+/* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/**
+ * \typedef Actor
+ * \brief A module of SB_C : a mailbox and a state machine, run by a scheduler.
+ */
+typedef struct Actor Actor;
+/**
+ * \typedef int (*Actor_Perform)(int action, void * msg)
+ * \brief Performs an action of the actions table of the module, with the message that triggered it.
+ */
+typedef int (*Actor_Perform)(int action, void * msg);
+/**
+ * \typedef void * (*Actor_Run)(Actor * actor)
+ * \brief Loop of an actor waiting on more than its mailbox, ending with the death of the actor.
+ */
+typedef void * (*Actor_Run)(Actor * actor);
+/* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
+/* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/**
+ * \struct Actor_Transition
+ * \brief Transition of a state machine, for an event received in a state.
+ */
+typedef struct {
+    int destination; /**< Next state, ACTOR_FORGET to forget the event. */
+    int action;      /**< Action to perform before going to the next state. */
+} Actor_Transition;
+/**
+ * \struct Actor_Descriptor
+ * \brief Everything the runtime needs to know about a module, given once to ACTOR_create().
+ *
+ * The states are numbered from ACTOR_FORGET to S_DEATH, the last one, which has no row in the state machine.
+ */
+typedef struct {
+    const char * name;                       /**< Name of the actor in the traces, the metrics and the thread list. */
+    const char * mailbox_name;               /**< Name of the POSIX queue of the mailbox. */
+    size_t msg_size;                         /**< Size of the messages. */
+    unsigned int msg_count;                  /**< Messages waiting before the senders are blocked. */
+    unsigned int priorities_nb;              /**< Priorities of the messages, 1 when they are all equal. */
+    Mailbox_Kind mailbox_kind;               /**< How the messages are carried, see config.h. */
+    const Actor_Transition * state_machine;  /**< Table [states_nb - 1][events_nb] of the transitions. */
+    int states_nb;                           /**< States of the state machine, S_DEATH included. */
+    int events_nb;                           /**< Events of the state machine. */
+    size_t event_offset;                     /**< Offset of the event, an enumeration, in the messages. */
+    int initial_state;                       /**< State of the actor when it starts. */
+    int initial_action;                      /**< Action performed when the actor starts, before its first message. */
+    Actor_Perform perform;                   /**< Performs the actions. */
+    Actor_Run run;                           /**< Loop of the actor, NULL for the loop receiving its mailbox. */
+    bool_e is_logged;                        /**< FALSE for the logger : its traces and errors are printed instead. */
+} Actor_Descriptor;
+/**
+ * \struct Actor_Metrics
+ * \brief Measures of an actor since its creation.
+ */
+typedef struct {
+    int state;                           /**< Current state. */
+    unsigned long long events;           /**< Events handled. */
+    unsigned long long forgotten;        /**< Events forgotten by the state machine. */
+    unsigned long long action_time;      /**< Time spent in the actions, in nanoseconds. */
+    unsigned long long action_time_max;  /**< Longest action, in nanoseconds. */
+} Actor_Metrics;
+/**
+ * \struct Actor_Scheduler
+ * \brief Way the actors are given a thread to handle their events.
+ */
+typedef struct {
+    int (*start)(Actor * actor);   /**< Starts handling the events of an actor. */
+    int (*join)(Actor * actor);    /**< Waits for the death of an actor. */
+    int (*notify)(Actor * actor);  /**< Wakes the actor up for its first message waiting, NULL when it waits by itself. */
+} Actor_Scheduler;
+/* ----------------------  PUBLIC VARIABLES -----------------------------------*/
+/**
+ * \var extern const Actor_Scheduler ACTOR_THREAD_SCHEDULER
+ * \brief Scheduler by default : a thread for each actor, sleeping on its mailbox.
+ */
+extern const Actor_Scheduler ACTOR_THREAD_SCHEDULER;
+/**
+ * \var extern const Actor_Scheduler ACTOR_POOL_SCHEDULER
+ * \brief Scheduler of a few workers, see CONFIG_ACTOR_POOL_WORKERS : an actor with messages waiting is run by the first
+ * free worker until its mailbox is empty, by one worker at a time so that its messages are handled in order.
+ */
+extern const Actor_Scheduler ACTOR_POOL_SCHEDULER;
+/* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
+/**
+ * \fn extern Actor * ACTOR_create(const Actor_Descriptor * descriptor)
+ * \brief Creates an actor and opens its mailbox.
+ * \author Prose A2
+ *
+ * \param descriptor : description of the actor, kept until its destruction.
+ *
+ * \return On success, returns the actor. On error, returns NULL.
+ */
+extern Actor * ACTOR_create(const Actor_Descriptor * descriptor);
+/**
+ * \fn extern int ACTOR_destroy(Actor * actor)
+ * \brief Closes the mailbox of an actor and destroys it. The actor is dead or has never started.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int ACTOR_destroy(Actor * actor);
+/**
+ * \fn extern void ACTOR_set_scheduler(const Actor_Scheduler * scheduler)
+ * \brief Chooses the scheduler of the actors started afterwards.
+ * \author Prose A2
+ *
+ * \param scheduler : the scheduler.
+ */
+extern void ACTOR_set_scheduler(const Actor_Scheduler * scheduler);
+/**
+ * \fn extern int ACTOR_start(Actor * actor)
+ * \brief Starts an actor in its initial state. An actor with its own loop gets its own thread.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int ACTOR_start(Actor * actor);
+/**
+ * \fn extern int ACTOR_join(Actor * actor)
+ * \brief Waits for an actor to reach S_DEATH, once its stop event is sent.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int ACTOR_join(Actor * actor);
+/**
+ * \fn extern int ACTOR_send(Actor * actor, const void * msg, unsigned int priority)
+ * \brief Sends a message to an actor, waiting for room in its mailbox.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ * \param msg : message of the size of the descriptor.
+ * \param priority : priority of the message, from 0 to priorities_nb - 1.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int ACTOR_send(Actor * actor, const void * msg, unsigned int priority);
+/**
+ * \fn extern int ACTOR_try_send(Actor * actor, const void * msg, unsigned int priority)
+ * \brief Sends a message to an actor if its mailbox has room, without waiting.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ * \param msg : message of the size of the descriptor.
+ * \param priority : priority of the message, from 0 to priorities_nb - 1.
+ *
+ * \return 1 when the message is sent, 0 when the mailbox is full. On error, returns -1.
+ */
+extern int ACTOR_try_send(Actor * actor, const void * msg, unsigned int priority);
+/**
+ * \fn extern int ACTOR_raise(Actor * actor, const void * msg)
+ * \brief Raises an event from an action of the actor : it is handled right after the action, before the messages of
+ * the mailbox.
+ * \author Prose A2
+ *
+ * \param actor : the actor, running the action.
+ * \param msg : message of the size of the descriptor.
+ *
+ * \return On success, returns 0. Returns -1 when an event is already raised.
+ */
+extern int ACTOR_raise(Actor * actor, const void * msg);
+/**
+ * \fn extern int ACTOR_handle(Actor * actor, void * msg)
+ * \brief Handles a message in the current state of an actor : performs the action of the transition, then goes to its
+ * next state. Called by the loop of the actor only.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ * \param msg : the message, given to the action.
+ *
+ * \return On success, returns 0. When the action fails, returns -1.
+ */
+extern int ACTOR_handle(Actor * actor, void * msg);
+/**
+ * \fn extern int ACTOR_get_state(const Actor * actor)
+ * \brief Gives the current state of an actor.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ *
+ * \return The state, S_DEATH once the actor has stopped.
+ */
+extern int ACTOR_get_state(const Actor * actor);
+/**
+ * \fn extern bool_e ACTOR_is_dead(const Actor * actor)
+ * \brief Tells if an actor has reached S_DEATH.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ *
+ * \return TRUE once the actor has stopped.
+ */
+extern bool_e ACTOR_is_dead(const Actor * actor);
+/**
+ * \fn extern Mailbox * ACTOR_get_mailbox(Actor * actor)
+ * \brief Gives the mailbox of an actor, for the loop of an actor waiting on more than its mailbox.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ *
+ * \return The mailbox.
+ */
+extern Mailbox * ACTOR_get_mailbox(Actor * actor);
+/**
+ * \fn extern const Actor_Descriptor * ACTOR_get_descriptor(const Actor * actor)
+ * \brief Gives the descriptor of an actor.
+ * \author Prose A2
+ *
+ * \param actor : the actor.
+ *
+ * \return The descriptor given at the creation.
+ */
+extern const Actor_Descriptor * ACTOR_get_descriptor(const Actor * actor);
+/**
+ * \fn extern int ACTOR_get_metrics(const char * name, Actor_Metrics * metrics)
+ * \brief Reads the measures of an actor, from any thread.
+ * \author Prose A2
+ *
+ * \param name : name of the actor in its descriptor.
+ * \param metrics [out] receives the measures.
+ *
+ * \return On success, returns 0. When no actor has this name, returns -1.
+ */
+extern int ACTOR_get_metrics(const char * name, Actor_Metrics * metrics);
+
+#endif /* SRC_LIB_ACTOR_H_ */
@@ -133,7 +133,31 @@ typedef enum  __attribute__((__packed__)){
     SET_CURRENT_TIME = 0x1300,  /**< SET_CURRENT_TIME : SB_IHM sends its current system time to calibrate SB_C current time. */
     SET_IP_PORT = 0x1400,       /**< SET_IP_PORT : SB_IHM sends its camera udp information to SB_C in order to broadcast to SB_IHM. */
     LOGS_RECEIVED = 0x1500,     /**< LOGS_RECEIVED : SB_IHM indicates that the logs has been received fully. */
+    SET_SESSION = 0x1600,       /**< SET_SESSION : SB_C gives the token of the session to SB_IHM, and tells if the session has been resumed. */
+    ASK_RESUME = 0x1700,        /**< ASK_RESUME : SB_IHM reconnecting asks to resume its previous session with its token. */
+    ASK_BATCH = 0x1800,         /**< ASK_BATCH : SB_IHM sends several messages in one, applied in order. */
 } Message_Type;
+/**
+ * \enum Capability
+ * \brief Optional features of the protocol, negotiated with ASK_AVAILABILITY and SET_AVAILABILITY.
+ *
+ * Capability gives the bits of the capability bitmap. A feature is used only if both SB_C and SB_IHM have it.
+ */
+typedef enum {
+    CAPABILITY_BATCH = 0x01,       /**< CAPABILITY_BATCH : SB_C accepts ASK_BATCH. */
+    CAPABILITY_TELEOP_UDP = 0x02,  /**< CAPABILITY_TELEOP_UDP : SB_C takes the drive commands on its teleoperation UDP port. */
+    CAPABILITY_COMPRESSION = 0x04, /**< CAPABILITY_COMPRESSION : the logs of every SET_LOGS page follow a Logs_Encoding byte. */
+} Capability;
+/**
+ * \enum Logs_Encoding
+ * \brief Encodings of the logs of a SET_LOGS page, when CAPABILITY_COMPRESSION is enabled.
+ *
+ * Each page is encoded on its own : SB_IHM decodes a page without the pages before it.
+ */
+typedef enum {
+    LOGS_ENCODING_RAW = 0x00,      /**< LOGS_ENCODING_RAW : the logs are sent as they are. */
+    LOGS_ENCODING_LZ4 = 0x01,      /**< LOGS_ENCODING_LZ4 : the logs are one LZ4 block. */
+} Logs_Encoding;
 /**
  * \struct Communication_Protocol_Head defs.h "lib/defs.h"
  * \brief Lists the head sections of a message.
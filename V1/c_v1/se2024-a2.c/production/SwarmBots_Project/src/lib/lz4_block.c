@@ -0,0 +1,269 @@
+/**
+ * \file  lz4_block.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief LZ4 block codec : the block format of LZ4, written for the log pages. Greedy matches found by a hash
+ * of 4 bytes, no allocation.
+ *
+ * \see lz4_block.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <string.h>
+#include "lz4_block.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def MIN_MATCH
+ * Shortest match of the format, the match lengths of the tokens start from it.
+ */
+#define MIN_MATCH        4
+/**
+ * \def LAST_LITERALS
+ * The last bytes of a block are always literals.
+ */
+#define LAST_LITERALS    5
+/**
+ * \def MATCH_LIMIT
+ * The last match starts at least MATCH_LIMIT bytes before the end of the input.
+ */
+#define MATCH_LIMIT      12
+/**
+ * \def MAX_OFFSET
+ * Farthest match, the offset is written on 16 bits.
+ */
+#define MAX_OFFSET       0xFFFF
+/**
+ * \def HASH_LOG
+ * The hash table of the compressor has 2^HASH_LOG positions.
+ */
+#define HASH_LOG         12
+/**
+ * \def SKIP_TRIGGER
+ * Without any match for 2^SKIP_TRIGGER bytes, the compressor looks for matches less often.
+ */
+#define SKIP_TRIGGER     6
+/**
+ * \def RUN_MASK
+ * Length of a token nibble meaning that more length bytes follow.
+ */
+#define RUN_MASK         15
+/* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static uint32_t LZ4_BLOCK_read_32(const uint8_t * bytes)
+ * \brief Reads 4 bytes, whatever their alignment.
+ */
+static uint32_t LZ4_BLOCK_read_32(const uint8_t * bytes);
+/**
+ * \fn static uint32_t LZ4_BLOCK_hash(const uint8_t * bytes)
+ * \brief Gives the position of 4 bytes in the hash table.
+ */
+static uint32_t LZ4_BLOCK_hash(const uint8_t * bytes);
+/**
+ * \fn static size_t LZ4_BLOCK_length_size(size_t length)
+ * \brief Gives the amount of bytes following a token for a length of RUN_MASK or more.
+ */
+static size_t LZ4_BLOCK_length_size(size_t length);
+/**
+ * \fn static uint8_t * LZ4_BLOCK_put_length(uint8_t * block, size_t length)
+ * \brief Writes the bytes following a token for a length of RUN_MASK or more.
+ * \return The byte after them.
+ */
+static uint8_t * LZ4_BLOCK_put_length(uint8_t * block, size_t length);
+/**
+ * \fn static int LZ4_BLOCK_get_length(const uint8_t ** block, const uint8_t * block_end, size_t * length)
+ * \brief Adds the bytes following a token to a length of RUN_MASK.
+ * \return On success, returns 0. Returns -1 when the block ends before the length.
+ */
+static int LZ4_BLOCK_get_length(const uint8_t ** block, const uint8_t * block_end, size_t * length);
+/**
+ * \fn static uint8_t * LZ4_BLOCK_put_sequence(uint8_t * block, const uint8_t * block_end, const uint8_t * literals,
+ *                                            size_t literals_size, size_t offset, size_t match_size)
+ * \brief Writes a sequence : its token, its literals and its match. A match_size of 0 writes the last literals.
+ * \return The byte after the sequence, NULL when the sequence does not fit before block_end.
+ */
+static uint8_t * LZ4_BLOCK_put_sequence(uint8_t * block, const uint8_t * block_end, const uint8_t * literals,
+                                        size_t literals_size, size_t offset, size_t match_size);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+int LZ4_BLOCK_compress(const uint8_t * input, size_t input_size, uint8_t * block, size_t block_capacity) {
+    if(input_size > LZ4_BLOCK_MAX_INPUT_SIZE) {
+        return -1;
+    }
+    const uint8_t * block_end = block + block_capacity;
+    uint8_t * output = block;
+    size_t anchor = 0;
+
+    if(input_size > MATCH_LIMIT) {
+        /* Last position seen for each hash. A wrong position only costs a comparison. */
+        uint16_t positions[1 << HASH_LOG];
+        memset(positions, 0, sizeof(positions));
+        size_t match_end_limit = input_size - LAST_LITERALS;
+        size_t position = 1;
+        while(position < input_size - MATCH_LIMIT) {
+            uint32_t hash = LZ4_BLOCK_hash(input + position);
+            size_t candidate = positions[hash];
+            positions[hash] = (uint16_t) position;
+            if(position - candidate > MAX_OFFSET || LZ4_BLOCK_read_32(input + candidate) != LZ4_BLOCK_read_32(input + position)) {
+                position += 1 + ((position - anchor) >> SKIP_TRIGGER);
+                continue;
+            }
+            while(position > anchor && candidate > 0 && input[position - 1] == input[candidate - 1]) {
+                position--;
+                candidate--;
+            }
+            size_t match_size = MIN_MATCH;
+            while(position + match_size < match_end_limit && input[candidate + match_size] == input[position + match_size]) {
+                match_size++;
+            }
+            output = LZ4_BLOCK_put_sequence(output, block_end, input + anchor, position - anchor, position - candidate, match_size);
+            if(output == NULL) {
+                return -1;
+            }
+            position += match_size;
+            anchor = position;
+            /* The match ends where the next repetition of a line often starts. */
+            if(position - 2 < input_size - MATCH_LIMIT) {
+                positions[LZ4_BLOCK_hash(input + position - 2)] = (uint16_t) (position - 2);
+            }
+        }
+    }
+    output = LZ4_BLOCK_put_sequence(output, block_end, input + anchor, input_size - anchor, 0, 0);
+    if(output == NULL) {
+        return -1;
+    }
+    return (int) (output - block);
+}
+
+int LZ4_BLOCK_decompress(const uint8_t * block, size_t block_size, uint8_t * output, size_t output_capacity) {
+    const uint8_t * block_end = block + block_size;
+    size_t output_size = 0;
+    while(block < block_end) {
+        uint8_t token = *block++;
+        size_t literals_size = token >> 4;
+        if(literals_size == RUN_MASK && LZ4_BLOCK_get_length(&block, block_end, &literals_size) == -1) {
+            return -1;
+        }
+        if(literals_size > (size_t) (block_end - block) || literals_size > output_capacity - output_size) {
+            return -1;
+        }
+        memcpy(output + output_size, block, literals_size);
+        block += literals_size;
+        output_size += literals_size;
+        /* The last sequence has no match. */
+        if(block == block_end) {
+            break;
+        }
+        if(block_end - block < 2) {
+            return -1;
+        }
+        size_t offset = (size_t) block[0] | (size_t) block[1] << 8;
+        block += 2;
+        size_t match_size = token & RUN_MASK;
+        if(match_size == RUN_MASK && LZ4_BLOCK_get_length(&block, block_end, &match_size) == -1) {
+            return -1;
+        }
+        match_size += MIN_MATCH;
+        if(offset == 0 || offset > output_size || match_size > output_capacity - output_size) {
+            return -1;
+        }
+        /* Byte per byte : a match may overlap the bytes it writes. */
+        const uint8_t * match = output + output_size - offset;
+        for(size_t i = 0; i < match_size; i++) {
+            output[output_size + i] = match[i];
+        }
+        output_size += match_size;
+    }
+    return (int) output_size;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static uint32_t LZ4_BLOCK_read_32(const uint8_t * bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static uint32_t LZ4_BLOCK_hash(const uint8_t * bytes) {
+    return (LZ4_BLOCK_read_32(bytes) * 2654435761u) >> (32 - HASH_LOG);
+}
+
+static size_t LZ4_BLOCK_length_size(size_t length) {
+    return length < RUN_MASK ? 0 : (length - RUN_MASK) / 255 + 1;
+}
+
+static uint8_t * LZ4_BLOCK_put_length(uint8_t * block, size_t length) {
+    for(length -= RUN_MASK; length >= 255; length -= 255) {
+        *block++ = 255;
+    }
+    *block++ = (uint8_t) length;
+    return block;
+}
+
+static int LZ4_BLOCK_get_length(const uint8_t ** block, const uint8_t * block_end, size_t * length) {
+    uint8_t byte;
+    do {
+        if(*block == block_end) {
+            return -1;
+        }
+        byte = *(*block)++;
+        *length += byte;
+    } while(byte == 255);
+    return 0;
+}
+
+static uint8_t * LZ4_BLOCK_put_sequence(uint8_t * block, const uint8_t * block_end, const uint8_t * literals,
+                                        size_t literals_size, size_t offset, size_t match_size) {
+    size_t match_code = match_size == 0 ? 0 : match_size - MIN_MATCH;
+    size_t sequence_size = 1 + LZ4_BLOCK_length_size(literals_size) + literals_size;
+    if(match_size != 0) {
+        sequence_size += 2 + LZ4_BLOCK_length_size(match_code);
+    }
+    if(sequence_size > (size_t) (block_end - block)) {
+        return NULL;
+    }
+    uint8_t * token = block++;
+    *token = (uint8_t) ((literals_size < RUN_MASK ? literals_size : RUN_MASK) << 4);
+    if(literals_size >= RUN_MASK) {
+        block = LZ4_BLOCK_put_length(block, literals_size);
+    }
+    memcpy(block, literals, literals_size);
+    block += literals_size;
+    if(match_size != 0) {
+        *token |= (uint8_t) (match_code < RUN_MASK ? match_code : RUN_MASK);
+        *block++ = (uint8_t) offset;
+        *block++ = (uint8_t) (offset >> 8);
+        if(match_code >= RUN_MASK) {
+            block = LZ4_BLOCK_put_length(block, match_code);
+        }
+    }
+    return block;
+}
@@ -0,0 +1,84 @@
+/**
+ * \file  lz4_block.h
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Header file of the LZ4 block codec. Compresses a buffer into one LZ4 block, without allocation.
+ *
+ * \see lz4_block.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#ifndef SRC_LIB_LZ4_BLOCK_H_
+#define SRC_LIB_LZ4_BLOCK_H_
+/* ----------------------  INCLUDES ------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+/* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/**
+ * \def LZ4_BLOCK_MAX_INPUT_SIZE
+ * Biggest buffer compressed in one block : the positions of the compressor are kept on 16 bits.
+ */
+#define LZ4_BLOCK_MAX_INPUT_SIZE   0xFFFF
+/**
+ * \def LZ4_BLOCK_BOUND(input_size)
+ * Biggest block written for an input of input_size bytes, when nothing in it repeats.
+ */
+#define LZ4_BLOCK_BOUND(input_size) ((input_size) + (input_size) / 255 + 16)
+/* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
+/* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/* ----------------------  PUBLIC VARIABLES -----------------------------------*/
+/* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
+/**
+ * \fn extern int LZ4_BLOCK_compress(const uint8_t * input, size_t input_size, uint8_t * block, size_t block_capacity)
+ * \brief Compresses a buffer into one LZ4 block, decoded without the blocks before it.
+ * \author Prose A2
+ *
+ * \param input : bytes to compress.
+ * \param input_size : size of the input, up to LZ4_BLOCK_MAX_INPUT_SIZE.
+ * \param block : receives the block.
+ * \param block_capacity : size of block. LZ4_BLOCK_BOUND(input_size) always holds the block.
+ *
+ * \return The size of the block. Returns -1 when the block does not fit in block_capacity or the input is too big.
+ */
+extern int LZ4_BLOCK_compress(const uint8_t * input, size_t input_size, uint8_t * block, size_t block_capacity);
+/**
+ * \fn extern int LZ4_BLOCK_decompress(const uint8_t * block, size_t block_size, uint8_t * output, size_t output_capacity)
+ * \brief Decompresses one LZ4 block. Every length and offset of the block is checked : any block is safe to decode.
+ * \author Prose A2
+ *
+ * \param block : the block.
+ * \param block_size : size of the block.
+ * \param output : receives the bytes of the block.
+ * \param output_capacity : size of output.
+ *
+ * \return The size of the bytes decompressed. Returns -1 when the block is malformed or does not fit in output.
+ */
+extern int LZ4_BLOCK_decompress(const uint8_t * block, size_t block_size, uint8_t * output, size_t output_capacity);
+
+#endif /* SRC_LIB_LZ4_BLOCK_H_ */
@@ -0,0 +1,391 @@
+/**
+ * \file  mailbox.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Mailboxes of the modules. A ring is a bounded queue with many senders and one receiver : senders take
+ * their slot with a compare-and-swap, the threads wait on futexes only when the ring is empty or full.
+ *
+ * \see mailbox.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <mqueue.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include "mailbox.h"
+#include "defs.h"
+/* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def NAME_SIZE
+ * Longest name of a POSIX queue kept by a mailbox.
+ */
+#define NAME_SIZE 64
+/**
+ * \def SLOT_HEAD_SIZE
+ * Sequence of a slot, before its message : 8 bytes to keep the messages aligned.
+ */
+#define SLOT_HEAD_SIZE 8
+/* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
+/* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
+/**
+ * \struct Mailbox_Lane
+ * \brief Ring of the messages of one priority.
+ *
+ * The slot of position p is free for the sender taking p while its sequence is p, and holds a message for the
+ * receiver once its sequence is p + 1. The receiver frees it for position p + capacity.
+ */
+typedef struct {
+    uint32_t tail;  /**< Position of the next sender, taken by compare-and-swap. */
+    uint32_t head;  /**< Position of the next message, written by the receiver only. */
+    uint8_t * slots;/**< Slots of the ring, slot_size bytes each. */
+} Mailbox_Lane;
+/**
+ * \struct Mailbox
+ * \brief A POSIX queue, or the rings of every priority and the words the threads wait on.
+ */
+struct Mailbox {
+    Mailbox_Kind kind;              /**< How the messages are carried. */
+    size_t msg_size;                /**< Size of every message. */
+    mqd_t queue;                    /**< POSIX queue, for MAILBOX_POSIX_QUEUE. */
+    char name[NAME_SIZE];           /**< Name of the POSIX queue. */
+    uint32_t capacity;              /**< Slots of each ring, a power of two. */
+    unsigned int lanes_nb;          /**< One ring per priority. */
+    size_t slot_size;               /**< Size of a slot, sequence included. */
+    Mailbox_Lane * lanes;           /**< Rings, from the lowest priority. */
+    uint32_t receiver_futex;        /**< Changed by the senders to wake the receiver up. */
+    uint32_t is_receiver_waiting;   /**< 1 when the receiver found the mailbox empty and has not been woken up since. */
+    uint32_t sender_futex;          /**< Changed by the receiver to wake the senders up. */
+    uint32_t senders_waiting;       /**< Senders waiting for room. */
+    int event_fd;                   /**< Written with the receiver futex when the receiver watches it with epoll. */
+};
+/* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
+/* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
+/**
+ * \fn static Mailbox * MAILBOX_open_queue(Mailbox * mailbox, const char * name, unsigned int msg_count)
+ * \brief Opens the POSIX queue of a mailbox.
+ * \return On success, returns the mailbox. On error, frees it and returns NULL.
+ */
+static Mailbox * MAILBOX_open_queue(Mailbox * mailbox, const char * name, unsigned int msg_count);
+/**
+ * \fn static bool_e MAILBOX_put(Mailbox * mailbox, Mailbox_Lane * lane, const void * msg)
+ * \brief Copies a message into a ring if it has room.
+ * \return TRUE when the message is in the ring, FALSE when the ring is full.
+ */
+static bool_e MAILBOX_put(Mailbox * mailbox, Mailbox_Lane * lane, const void * msg);
+/**
+ * \fn static bool_e MAILBOX_take(Mailbox * mailbox, void * msg)
+ * \brief Takes the next message of the rings, from the highest priority, and wakes up the senders waiting for room.
+ * \return TRUE when a message is taken, FALSE when every ring is empty.
+ */
+static bool_e MAILBOX_take(Mailbox * mailbox, void * msg);
+/**
+ * \fn static void MAILBOX_wake_receiver(Mailbox * mailbox)
+ * \brief Wakes up the receiver if it found the mailbox empty.
+ */
+static void MAILBOX_wake_receiver(Mailbox * mailbox);
+/**
+ * \fn static int MAILBOX_signal(Mailbox * mailbox)
+ * \brief Makes the file descriptor of the mailbox readable, if the receiver watches it.
+ * \return On success, returns 0. Returns -1 when the counter of the descriptor is full : it is readable anyway.
+ */
+static int MAILBOX_signal(Mailbox * mailbox);
+/**
+ * \fn static void MAILBOX_futex_wait(uint32_t * futex, uint32_t value)
+ * \brief Sleeps while the futex keeps its value.
+ */
+static void MAILBOX_futex_wait(uint32_t * futex, uint32_t value);
+/**
+ * \fn static void MAILBOX_futex_wake(uint32_t * futex, int threads_nb)
+ * \brief Changes the value of a futex and wakes up the threads sleeping on it.
+ */
+static void MAILBOX_futex_wake(uint32_t * futex, int threads_nb);
+/* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
+Mailbox * MAILBOX_open(const char * name, size_t msg_size, unsigned int msg_count, unsigned int priorities_nb, Mailbox_Kind kind) {
+    if(msg_size == 0 || msg_count == 0 || msg_count > (1u << 30) || priorities_nb == 0) {
+        errno = EINVAL;
+        return NULL;
+    }
+    Mailbox * mailbox = (Mailbox *) calloc(1, sizeof(Mailbox));
+    if(mailbox == NULL) {
+        return NULL;
+    }
+    mailbox->kind = kind;
+    mailbox->msg_size = msg_size;
+    mailbox->event_fd = -1;
+    if(kind == MAILBOX_POSIX_QUEUE) {
+        return MAILBOX_open_queue(mailbox, name, msg_count);
+    }
+
+    mailbox->capacity = 1;
+    while(mailbox->capacity < msg_count) {
+        mailbox->capacity <<= 1;
+    }
+    mailbox->lanes_nb = priorities_nb;
+    mailbox->slot_size = SLOT_HEAD_SIZE + (msg_size + 7) / 8 * 8;
+    mailbox->lanes = (Mailbox_Lane *) calloc(priorities_nb, sizeof(Mailbox_Lane));
+    if(mailbox->lanes == NULL) {
+        free(mailbox);
+        return NULL;
+    }
+    for(unsigned int lane_id = 0; lane_id < priorities_nb; lane_id++) {
+        Mailbox_Lane * lane = &mailbox->lanes[lane_id];
+        lane->slots = (uint8_t *) malloc(mailbox->capacity * mailbox->slot_size);
+        if(lane->slots == NULL) {
+            MAILBOX_close(mailbox);
+            return NULL;
+        }
+        for(uint32_t position = 0; position < mailbox->capacity; position++) {
+            *(uint32_t *) (lane->slots + position * mailbox->slot_size) = position;
+        }
+    }
+    /* Nothing to receive yet : the first message wakes the receiver up. */
+    mailbox->is_receiver_waiting = 1;
+    return mailbox;
+}
+
+int MAILBOX_close(Mailbox * mailbox) {
+    int result = 0;
+    if(mailbox->kind == MAILBOX_POSIX_QUEUE) {
+        if(mq_close(mailbox->queue) == -1 || mq_unlink(mailbox->name) == -1) {
+            result = -1;
+        }
+    }
+    else {
+        if(mailbox->event_fd != -1 && close(mailbox->event_fd) == -1) {
+            result = -1;
+        }
+        for(unsigned int lane_id = 0; mailbox->lanes != NULL && lane_id < mailbox->lanes_nb; lane_id++) {
+            free(mailbox->lanes[lane_id].slots);
+        }
+        free(mailbox->lanes);
+    }
+    free(mailbox);
+    return result;
+}
+
+int MAILBOX_send(Mailbox * mailbox, const void * msg, unsigned int priority) {
+    if(mailbox->kind == MAILBOX_POSIX_QUEUE) {
+        return mq_send(mailbox->queue, (const char *) msg, mailbox->msg_size, priority);
+    }
+    if(priority >= mailbox->lanes_nb) {
+        errno = EINVAL;
+        return -1;
+    }
+    Mailbox_Lane * lane = &mailbox->lanes[priority];
+    while(!MAILBOX_put(mailbox, lane, msg)) {
+        uint32_t futex_value = __atomic_load_n(&mailbox->sender_futex, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&mailbox->senders_waiting, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        bool_e is_put = MAILBOX_put(mailbox, lane, msg);
+        if(!is_put) {
+            MAILBOX_futex_wait(&mailbox->sender_futex, futex_value);
+        }
+        __atomic_sub_fetch(&mailbox->senders_waiting, 1, __ATOMIC_SEQ_CST);
+        if(is_put) {
+            break;
+        }
+    }
+    MAILBOX_wake_receiver(mailbox);
+    return 0;
+}
+
+int MAILBOX_try_send(Mailbox * mailbox, const void * msg, unsigned int priority) {
+    if(mailbox->kind == MAILBOX_POSIX_QUEUE) {
+        static const struct timespec already_expired = {0, 0};
+        if(mq_timedsend(mailbox->queue, (const char *) msg, mailbox->msg_size, priority, &already_expired) == -1) {
+            return errno == ETIMEDOUT ? 0 : -1;
+        }
+        return 1;
+    }
+    if(priority >= mailbox->lanes_nb) {
+        errno = EINVAL;
+        return -1;
+    }
+    if(!MAILBOX_put(mailbox, &mailbox->lanes[priority], msg)) {
+        return 0;
+    }
+    MAILBOX_wake_receiver(mailbox);
+    return 1;
+}
+
+int MAILBOX_receive(Mailbox * mailbox, void * msg) {
+    if(mailbox->kind == MAILBOX_POSIX_QUEUE) {
+        return mq_receive(mailbox->queue, (char *) msg, mailbox->msg_size, NULL) == -1 ? -1 : 0;
+    }
+    while(!MAILBOX_take(mailbox, msg)) {
+        uint32_t futex_value = __atomic_load_n(&mailbox->receiver_futex, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&mailbox->is_receiver_waiting, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        /* A sender may have put its message before seeing the receiver waiting. */
+        if(MAILBOX_take(mailbox, msg)) {
+            __atomic_store_n(&mailbox->is_receiver_waiting, 0, __ATOMIC_SEQ_CST);
+            break;
+        }
+        MAILBOX_futex_wait(&mailbox->receiver_futex, futex_value);
+    }
+    return 0;
+}
+
+int MAILBOX_try_receive(Mailbox * mailbox, void * msg) {
+    if(mailbox->kind == MAILBOX_POSIX_QUEUE) {
+        static const struct timespec already_expired = {0, 0};
+        if(mq_timedreceive(mailbox->queue, (char *) msg, mailbox->msg_size, NULL, &already_expired) == -1) {
+            return errno == ETIMEDOUT ? 0 : -1;
+        }
+        return 1;
+    }
+    if(MAILBOX_take(mailbox, msg)) {
+        return 1;
+    }
+    /* Empty : the file descriptor is cleared, the next sender makes it readable again. */
+    if(mailbox->event_fd != -1) {
+        uint64_t events;
+        if(read(mailbox->event_fd, &events, sizeof(events)) == -1 && errno != EAGAIN) {
+            return -1;
+        }
+    }
+    __atomic_store_n(&mailbox->is_receiver_waiting, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(!MAILBOX_take(mailbox, msg)) {
+        return 0;
+    }
+    /* A message came meanwhile : the file descriptor stays readable for the ones after it. */
+    __atomic_store_n(&mailbox->is_receiver_waiting, 0, __ATOMIC_SEQ_CST);
+    MAILBOX_signal(mailbox);
+    return 1;
+}
+
+int MAILBOX_get_fd(Mailbox * mailbox) {
+    if(mailbox->kind == MAILBOX_POSIX_QUEUE) {
+        return (int) mailbox->queue;
+    }
+    if(mailbox->event_fd == -1) {
+        mailbox->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        /* Messages sent before are not signalled by their sender. */
+        if(mailbox->event_fd != -1) {
+            MAILBOX_signal(mailbox);
+        }
+    }
+    return mailbox->event_fd;
+}
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static Mailbox * MAILBOX_open_queue(Mailbox * mailbox, const char * name, unsigned int msg_count) {
+    struct mq_attr attributes = {.mq_maxmsg = (long) msg_count, .mq_msgsize = (long) mailbox->msg_size};
+    if(strlen(name) >= NAME_SIZE) {
+        free(mailbox);
+        errno = ENAMETOOLONG;
+        return NULL;
+    }
+    strcpy(mailbox->name, name);
+    errno = 0;
+    if((mailbox->queue = mq_open(name, O_CREAT | O_RDWR | O_EXCL, 0644, &attributes)) == -1 && errno == EEXIST) {
+        mq_unlink(name);
+        mailbox->queue = mq_open(name, O_CREAT | O_RDWR, 0644, &attributes);
+    }
+    if(mailbox->queue == -1) {
+        free(mailbox);
+        return NULL;
+    }
+    return mailbox;
+}
+
+static bool_e MAILBOX_put(Mailbox * mailbox, Mailbox_Lane * lane, const void * msg) {
+    uint32_t position = __atomic_load_n(&lane->tail, __ATOMIC_RELAXED);
+    for(;;) {
+        uint8_t * slot = lane->slots + (position & (mailbox->capacity - 1)) * mailbox->slot_size;
+        int32_t lag = (int32_t) (__atomic_load_n((uint32_t *) slot, __ATOMIC_ACQUIRE) - position);
+        if(lag < 0) {
+            return FALSE;
+        }
+        if(lag > 0) {
+            /* Another sender took this position. */
+            position = __atomic_load_n(&lane->tail, __ATOMIC_RELAXED);
+        }
+        else if(__atomic_compare_exchange_n(&lane->tail, &position, position + 1, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            memcpy(slot + SLOT_HEAD_SIZE, msg, mailbox->msg_size);
+            __atomic_store_n((uint32_t *) slot, position + 1, __ATOMIC_RELEASE);
+            return TRUE;
+        }
+    }
+}
+
+static bool_e MAILBOX_take(Mailbox * mailbox, void * msg) {
+    for(unsigned int lane_id = mailbox->lanes_nb; lane_id-- > 0; ) {
+        Mailbox_Lane * lane = &mailbox->lanes[lane_id];
+        uint8_t * slot = lane->slots + (lane->head & (mailbox->capacity - 1)) * mailbox->slot_size;
+        if(__atomic_load_n((uint32_t *) slot, __ATOMIC_ACQUIRE) != lane->head + 1) {
+            continue;
+        }
+        memcpy(msg, slot + SLOT_HEAD_SIZE, mailbox->msg_size);
+        __atomic_store_n((uint32_t *) slot, lane->head + mailbox->capacity, __ATOMIC_RELEASE);
+        lane->head++;
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if(__atomic_load_n(&mailbox->senders_waiting, __ATOMIC_SEQ_CST) != 0) {
+            MAILBOX_futex_wake(&mailbox->sender_futex, INT_MAX);
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static void MAILBOX_wake_receiver(Mailbox * mailbox) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&mailbox->is_receiver_waiting, __ATOMIC_SEQ_CST) == 0
+       || __atomic_exchange_n(&mailbox->is_receiver_waiting, 0, __ATOMIC_SEQ_CST) == 0) {
+        return;
+    }
+    MAILBOX_futex_wake(&mailbox->receiver_futex, 1);
+    MAILBOX_signal(mailbox);
+}
+
+static int MAILBOX_signal(Mailbox * mailbox) {
+    static const uint64_t event = 1;
+    if(mailbox->event_fd != -1 && write(mailbox->event_fd, &event, sizeof(event)) == -1) {
+        return -1;
+    }
+    return 0;
+}
+
+static void MAILBOX_futex_wait(uint32_t * futex, uint32_t value) {
+    syscall(SYS_futex, futex, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+static void MAILBOX_futex_wake(uint32_t * futex, int threads_nb) {
+    __atomic_add_fetch(futex, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, futex, FUTEX_WAKE_PRIVATE, threads_nb, NULL, NULL, 0);
+}
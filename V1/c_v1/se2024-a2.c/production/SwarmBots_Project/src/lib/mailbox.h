@@ -0,0 +1,142 @@
+/**
+ * \file  mailbox.h
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Header file of the mailboxes. Carries the events of the modules of SB_C, through the kernel or in the process.
+ *
+ * \see mailbox.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#ifndef SRC_LIB_MAILBOX_H_
+#define SRC_LIB_MAILBOX_H_
+/* ----------------------  INCLUDES ------------------------------------------*/
+#include <stddef.h>
+/* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/**
+ * \typedef Mailbox
+ * \brief Mailbox of a module : messages of a fixed size, sent by any thread and received by the thread of the module.
+ */
+typedef struct Mailbox Mailbox;
+/* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
+/**
+ * \enum Mailbox_Kind
+ * \brief Ways a mailbox carries its messages, chosen for each module in config.h.
+ */
+typedef enum {
+    MAILBOX_POSIX_QUEUE = 0, /**< MAILBOX_POSIX_QUEUE : a POSIX message queue, named in /dev/mqueue. */
+    MAILBOX_RING = 1,        /**< MAILBOX_RING : a ring in the memory of the process, threads waiting on futexes. */
+} Mailbox_Kind;
+/* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/* ----------------------  PUBLIC VARIABLES -----------------------------------*/
+/* ----------------------  PUBLIC FUNCTIONS PROTOTYPES  ----------------------*/
+/**
+ * \fn extern Mailbox * MAILBOX_open(const char * name, size_t msg_size, unsigned int msg_count, unsigned int priorities_nb, Mailbox_Kind kind)
+ * \brief Creates a mailbox. A POSIX queue left by a previous run under the same name is replaced.
+ * \author Prose A2
+ *
+ * \param name : name of the POSIX queue, starting with '/'.
+ * \param msg_size : size in bytes of every message.
+ * \param msg_count : messages waiting before the senders are blocked. A ring holds at least msg_count messages of
+ * each priority.
+ * \param priorities_nb : priorities of the messages, from 0 to priorities_nb - 1.
+ * \param kind : how the messages are carried.
+ *
+ * \return On success, returns the mailbox. On error, returns NULL.
+ */
+extern Mailbox * MAILBOX_open(const char * name, size_t msg_size, unsigned int msg_count, unsigned int priorities_nb, Mailbox_Kind kind);
+/**
+ * \fn extern int MAILBOX_close(Mailbox * mailbox)
+ * \brief Destroys a mailbox. No thread may use it any more.
+ * \author Prose A2
+ *
+ * \param mailbox : the mailbox.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int MAILBOX_close(Mailbox * mailbox);
+/**
+ * \fn extern int MAILBOX_send(Mailbox * mailbox, const void * msg, unsigned int priority)
+ * \brief Copies a message into a mailbox, waiting for room as mq_send() does.
+ * \author Prose A2
+ *
+ * \param mailbox : the mailbox.
+ * \param msg : message of the size given at the opening.
+ * \param priority : the messages of the highest priority are received first, in the order they were sent.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int MAILBOX_send(Mailbox * mailbox, const void * msg, unsigned int priority);
+/**
+ * \fn extern int MAILBOX_try_send(Mailbox * mailbox, const void * msg, unsigned int priority)
+ * \brief Copies a message into a mailbox if it has room, without waiting.
+ * \author Prose A2
+ *
+ * \param mailbox : the mailbox.
+ * \param msg : message of the size given at the opening.
+ * \param priority : the messages of the highest priority are received first, in the order they were sent.
+ *
+ * \return 1 when the message is sent, 0 when the mailbox is full. On error, returns -1.
+ */
+extern int MAILBOX_try_send(Mailbox * mailbox, const void * msg, unsigned int priority);
+/**
+ * \fn extern int MAILBOX_receive(Mailbox * mailbox, void * msg)
+ * \brief Takes the next message of a mailbox, waiting for one as mq_receive() does.
+ * \author Prose A2
+ *
+ * \param mailbox : the mailbox.
+ * \param msg [out] receives the message.
+ *
+ * \return On success, returns 0. On error, returns -1.
+ */
+extern int MAILBOX_receive(Mailbox * mailbox, void * msg);
+/**
+ * \fn extern int MAILBOX_try_receive(Mailbox * mailbox, void * msg)
+ * \brief Takes the next message of a mailbox if there is one, without waiting.
+ * \author Prose A2
+ *
+ * \param mailbox : the mailbox.
+ * \param msg [out] receives the message.
+ *
+ * \return 1 when a message is received, 0 when the mailbox is empty. On error, returns -1.
+ */
+extern int MAILBOX_try_receive(Mailbox * mailbox, void * msg);
+/**
+ * \fn extern int MAILBOX_get_fd(Mailbox * mailbox)
+ * \brief Gives a file descriptor to watch with epoll, readable when messages may be waiting. The messages are then
+ * taken with MAILBOX_try_receive() until it returns 0.
+ * \author Prose A2
+ *
+ * \param mailbox : the mailbox.
+ *
+ * \return On success, returns the file descriptor, closed with the mailbox. On error, returns -1.
+ */
+extern int MAILBOX_get_fd(Mailbox * mailbox);
+
+#endif /* SRC_LIB_MAILBOX_H_ */
@@ -0,0 +1,278 @@
+/**
+ * \file  protocol.h
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Schema of the TCP protocol between SB_C and SB_IHM. Generates the encoders and decoders of every message.
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#ifndef SRC_LIB_PROTOCOL_H_
+#define SRC_LIB_PROTOCOL_H_
+/* ----------------------  INCLUDES ------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include "defs.h"
+/* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
+/**
+ * \def PROTOCOL_HEAD_SIZE
+ * Size of the head of a frame : the size field then the type field, 2 bytes each.
+ *
+ * The size field counts the type and the payload. Every field is in network byte order.
+ */
+#define PROTOCOL_HEAD_SIZE 4
+/**
+ * \def PROTOCOL_VERSION
+ * Version of the protocol spoken by SB_C, sent in SET_AVAILABILITY.
+ */
+#define PROTOCOL_VERSION 2
+/**
+ * \def PROTOCOL_VERSION_LEGACY
+ * Version of the SB_IHM sending ASK_AVAILABILITY without any field : they get none of the capabilities.
+ */
+#define PROTOCOL_VERSION_LEGACY 1
+/**
+ * \def PROTOCOL_GENERATION
+ * Messages of the protocol, one M(Message_Type) for each of them.
+ *
+ * The fields of a message are listed by PROTOCOL_FIELDS_<message>(F, m) as F(m, kind, name),
+ * in the order of the payload. The kind is U8, U16 or U32. For each message the schema generates :
+ *  - PROTOCOL_<message>_SIZE : size of the payload, PROTOCOL_<message>_<name>_OFFSET for each field,
+ *  - PROTOCOL_put_<message>_<name>() and PROTOCOL_get_<message>_<name>() : access to a field of a payload,
+ *  - PROTOCOL_encode_<message>() and PROTOCOL_decode_<message>() : head of a frame.
+ */
+#define PROTOCOL_GENERATION M(ASK_AVAILABILITY) M(SET_AVAILABILITY) M(ASK_CMD) M(SET_STATE) M(ASK_MODE) \
+    M(SET_MODE) M(ASK_LOGS) M(SET_LOGS) M(ALERT) M(ASK_TO_DISCONNECT) M(ACK_DISCONNECTION) M(SET_RADAR) \
+    M(SET_CURRENT_TIME) M(SET_IP_PORT) M(LOGS_RECEIVED) M(SET_SESSION) M(ASK_RESUME) M(ASK_BATCH)
+
+/* SB_IHM of PROTOCOL_VERSION_LEGACY send ASK_AVAILABILITY without any field and expect SET_AVAILABILITY without any. */
+#define PROTOCOL_FIELDS_ASK_AVAILABILITY(F, m)  F(m, U8, version) F(m, U32, capabilities)
+#define PROTOCOL_FIELDS_SET_AVAILABILITY(F, m)  F(m, U8, version) F(m, U32, capabilities)
+#define PROTOCOL_FIELDS_ASK_CMD(F, m)           F(m, U8, command)
+#define PROTOCOL_FIELDS_SET_STATE(F, m)         F(m, U8, state)
+#define PROTOCOL_FIELDS_ASK_MODE(F, m)
+#define PROTOCOL_FIELDS_SET_MODE(F, m)          F(m, U8, camera_mode) F(m, U8, radar_mode) F(m, U8, buzzer_mode) F(m, U8, leds_mode)
+#define PROTOCOL_FIELDS_ASK_LOGS(F, m)
+/* The page of logs follows the fixed fields, up to the end of the frame. With CAPABILITY_COMPRESSION, a Logs_Encoding
+ * byte comes before the page. */
+#define PROTOCOL_FIELDS_SET_LOGS(F, m)          F(m, U8, page) F(m, U8, max_page)
+#define PROTOCOL_FIELDS_ALERT(F, m)             F(m, U8, alert)
+#define PROTOCOL_FIELDS_ASK_TO_DISCONNECT(F, m)
+#define PROTOCOL_FIELDS_ACK_DISCONNECTION(F, m)
+#define PROTOCOL_FIELDS_SET_RADAR(F, m)         F(m, U8, radar)
+/* SB_IHM splits the year in two : the century, then the year in the century. */
+#define PROTOCOL_FIELDS_SET_CURRENT_TIME(F, m)  F(m, U8, century) F(m, U8, year) F(m, U8, month) F(m, U8, day) \
+                                                F(m, U8, hour) F(m, U8, minute) F(m, U8, second)
+#define PROTOCOL_FIELDS_SET_IP_PORT(F, m)       F(m, U32, ip) F(m, U16, port)
+#define PROTOCOL_FIELDS_LOGS_RECEIVED(F, m)
+#define PROTOCOL_FIELDS_SET_SESSION(F, m)       F(m, U32, session_token) F(m, U8, is_resumed)
+#define PROTOCOL_FIELDS_ASK_RESUME(F, m)        F(m, U32, session_token)
+/* The messages of the batch follow, each one with its head, up to the end of the frame. The batch is validated
+ * as a whole but is not transactional : its messages are applied in order up to the first one failing. */
+#define PROTOCOL_FIELDS_ASK_BATCH(F, m)
+
+#define PROTOCOL_SIZE_U8  1
+#define PROTOCOL_SIZE_U16 2
+#define PROTOCOL_SIZE_U32 4
+#define PROTOCOL_TYPE_U8  uint8_t
+#define PROTOCOL_TYPE_U16 uint16_t
+#define PROTOCOL_TYPE_U32 uint32_t
+/* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
+/* Offsets of the fields, each one follows the previous : the size of a payload is the end of its last field. */
+#define F(m, kind, name) PROTOCOL_##m##_##name##_OFFSET, \
+    PROTOCOL_##m##_##name##_LAST = PROTOCOL_##m##_##name##_OFFSET + PROTOCOL_SIZE_##kind - 1,
+#define M(m) enum { PROTOCOL_FIELDS_##m(F, m) PROTOCOL_##m##_SIZE };
+PROTOCOL_GENERATION
+#undef M
+#undef F
+/* ----------------------  PUBLIC STRUCTURES ---------------------------------*/
+/* ----------------------  PUBLIC VARIABLES -----------------------------------*/
+/* ----------------------  PUBLIC FUNCTIONS  ---------------------------------*/
+/**
+ * \fn static inline void PROTOCOL_put_U8(uint8_t * field, uint8_t value)
+ * \brief Writes a field of 8 bits in network byte order.
+ * \author Prose A2
+ *
+ * \param field : first byte of the field.
+ * \param value : value of the field.
+ */
+static inline void PROTOCOL_put_U8(uint8_t * field, uint8_t value) {
+    field[0] = value;
+}
+
+/**
+ * \fn static inline void PROTOCOL_put_U16(uint8_t * field, uint16_t value)
+ * \brief Writes a field of 16 bits in network byte order.
+ * \author Prose A2
+ *
+ * \param field : first byte of the field.
+ * \param value : value of the field.
+ */
+static inline void PROTOCOL_put_U16(uint8_t * field, uint16_t value) {
+    field[0] = (uint8_t) (value >> 8);
+    field[1] = (uint8_t) value;
+}
+
+/**
+ * \fn static inline void PROTOCOL_put_U32(uint8_t * field, uint32_t value)
+ * \brief Writes a field of 32 bits in network byte order.
+ * \author Prose A2
+ *
+ * \param field : first byte of the field.
+ * \param value : value of the field.
+ */
+static inline void PROTOCOL_put_U32(uint8_t * field, uint32_t value) {
+    field[0] = (uint8_t) (value >> 24);
+    field[1] = (uint8_t) (value >> 16);
+    field[2] = (uint8_t) (value >> 8);
+    field[3] = (uint8_t) value;
+}
+
+/**
+ * \fn static inline uint8_t PROTOCOL_get_U8(const uint8_t * field)
+ * \brief Reads a field of 8 bits in network byte order.
+ * \author Prose A2
+ *
+ * \param field : first byte of the field.
+ * \return Value of the field.
+ */
+static inline uint8_t PROTOCOL_get_U8(const uint8_t * field) {
+    return field[0];
+}
+
+/**
+ * \fn static inline uint16_t PROTOCOL_get_U16(const uint8_t * field)
+ * \brief Reads a field of 16 bits in network byte order.
+ * \author Prose A2
+ *
+ * \param field : first byte of the field.
+ * \return Value of the field.
+ */
+static inline uint16_t PROTOCOL_get_U16(const uint8_t * field) {
+    return (uint16_t) (field[0] << 8 | field[1]);
+}
+
+/**
+ * \fn static inline uint32_t PROTOCOL_get_U32(const uint8_t * field)
+ * \brief Reads a field of 32 bits in network byte order.
+ * \author Prose A2
+ *
+ * \param field : first byte of the field.
+ * \return Value of the field.
+ */
+static inline uint32_t PROTOCOL_get_U32(const uint8_t * field) {
+    return (uint32_t) field[0] << 24 | (uint32_t) field[1] << 16 | (uint32_t) field[2] << 8 | field[3];
+}
+
+/**
+ * \fn static inline void PROTOCOL_put_head(uint8_t * frame, Message_Type type, uint16_t payload_size)
+ * \brief Writes the head of a frame. The payload starts PROTOCOL_HEAD_SIZE bytes after.
+ * \author Prose A2
+ *
+ * \param frame : frame of at least PROTOCOL_HEAD_SIZE + payload_size bytes.
+ * \param type : type of the message.
+ * \param payload_size : size of the payload, at most 0xFFFF - 2.
+ */
+static inline void PROTOCOL_put_head(uint8_t * frame, Message_Type type, uint16_t payload_size) {
+    PROTOCOL_put_U16(frame, (uint16_t) (payload_size + 2));
+    PROTOCOL_put_U16(frame + 2, (uint16_t) type);
+}
+
+/**
+ * \fn static inline uint16_t PROTOCOL_get_payload_size(const uint8_t * frame)
+ * \brief Reads the size of the payload in the head of a frame.
+ * \author Prose A2
+ *
+ * \param frame : frame of at least PROTOCOL_HEAD_SIZE bytes.
+ * \return Size of the payload, 0 if the size field is too small to hold the type.
+ */
+static inline uint16_t PROTOCOL_get_payload_size(const uint8_t * frame) {
+    uint16_t msg_size = PROTOCOL_get_U16(frame);
+    return msg_size > 2 ? (uint16_t) (msg_size - 2) : 0;
+}
+
+/**
+ * \fn static inline Message_Type PROTOCOL_get_type(const uint8_t * frame)
+ * \brief Reads the type in the head of a frame.
+ * \author Prose A2
+ *
+ * SB_C writes the identifier of the type in the first byte of the field, SB_IHM in the second one :
+ * both are read the same way, whatever the byte order of the host.
+ *
+ * \param frame : frame of at least PROTOCOL_HEAD_SIZE bytes.
+ * \return Type of the message.
+ */
+static inline Message_Type PROTOCOL_get_type(const uint8_t * frame) {
+    return (Message_Type) ((frame[2] | frame[3]) << 8);
+}
+
+/* Accessors of the fields : they read and write the payload in place. */
+#define F(m, kind, name) \
+    static inline void PROTOCOL_put_##m##_##name(uint8_t * payload, PROTOCOL_TYPE_##kind value) { \
+        PROTOCOL_put_##kind(payload + PROTOCOL_##m##_##name##_OFFSET, value); \
+    } \
+    static inline PROTOCOL_TYPE_##kind PROTOCOL_get_##m##_##name(const uint8_t * payload) { \
+        return PROTOCOL_get_##kind(payload + PROTOCOL_##m##_##name##_OFFSET); \
+    }
+/* Heads of the frames : encode writes the head with the size of the fields and returns the payload,
+ * decode returns the payload if the frame has the type and holds every field, NULL otherwise. */
+#define M(m) PROTOCOL_FIELDS_##m(F, m) \
+    static inline uint8_t * PROTOCOL_encode_##m(uint8_t * frame) { \
+        PROTOCOL_put_head(frame, m, PROTOCOL_##m##_SIZE); \
+        return frame + PROTOCOL_HEAD_SIZE; \
+    } \
+    static inline const uint8_t * PROTOCOL_decode_##m(const uint8_t * frame, size_t frame_size) { \
+        if(frame_size < PROTOCOL_HEAD_SIZE + PROTOCOL_##m##_SIZE || PROTOCOL_get_type(frame) != m \
+           || PROTOCOL_get_payload_size(frame) < PROTOCOL_##m##_SIZE) { \
+            return NULL; \
+        } \
+        return frame + PROTOCOL_HEAD_SIZE; \
+    }
+PROTOCOL_GENERATION
+#undef M
+#undef F
+
+/**
+ * \fn static inline int PROTOCOL_get_fields_size(Message_Type type)
+ * \brief Gives the size of the fields of a message, known at compile time.
+ * \author Prose A2
+ *
+ * \param type : type of the message.
+ * \return Size of the fields of the payload, -1 if the type is not in the schema.
+ */
+static inline int PROTOCOL_get_fields_size(Message_Type type) {
+#define M(m) case m : return PROTOCOL_##m##_SIZE;
+    switch(type) {
+        PROTOCOL_GENERATION
+        default :
+            return -1;
+    }
+#undef M
+}
+
+#endif /* SRC_LIB_PROTOCOL_H_ */
@@ -1,10 +1,18 @@
 /**
  * \file  watchdog.c
- * \version  1.1
+ * \version  1.3
  * \author Dimitri SOLET
  * \author Louison LEGROS
- * \date Mar 14, 2023
- * \brief Watchdog module for callback functions with timer.
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Watchdog module for callback functions with timer, or events sent to an actor.
+ *
+ * The watchdogs are kept in a hashed timer wheel : a watchdog expiring at tick t is in the slot t % WHEEL_SLOTS,
+ * started and cancelled in constant time. A single thread sleeps on CLOCK_MONOTONIC until the next slot holding a
+ * watchdog, then calls the callbacks and sends the messages of the watchdogs due.
+ *
+ * The deadline of a periodic watchdog is absolute : the next one is the previous deadline plus the delay, whenever the
+ * expiry was delivered, so the latency of the thread and of the mailboxes does not add up from period to period.
  *
  * \see watchdog.h
  *
@@ -38,11 +46,24 @@
 /* ----------------------  INCLUDES  ---------------------------------------- */
 #include "watchdog.h"
 
-#include <malloc.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <pthread.h>
-#include <signal.h>
+#include "../config.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
+/**
+ * \def WHEEL_SLOTS
+ * Slots of the wheel, a power of two : one turn lasts WHEEL_SLOTS ticks, longer delays stay for several turns.
+ */
+#define WHEEL_SLOTS 256
+/**
+ * \def TICK_NS
+ * Duration of a tick, in nanoseconds.
+ */
+#define TICK_NS ((uint64_t) CONFIG_WATCHDOG_TICK_MS * 1000000)
 /* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
 /* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
 /**
@@ -50,86 +71,349 @@
  * \brief definition of watchdog object.
  */
 struct watchdog_t {
-    timer_t timer;
-    unsigned int  delay;
-    watchdog_callback callback;
+    unsigned int delay;          /**< Delay before the expiry, in milliseconds. */
+    watchdog_callback callback;  /**< Called at the expiry, NULL for a message. */
+    Actor * actor;               /**< Receives msg at the expiry. */
+    void * msg;                  /**< Message sent to the actor. */
+    uint64_t deadline;           /**< Time of the expiry since the origin of the wheel, in nanoseconds. */
+    uint64_t expiry;             /**< Tick of the expiry, while started : the deadline rounded up, or later. */
+    bool_e is_started;           /**< TRUE while in the wheel. */
+    bool_e is_periodic;          /**< TRUE to start again at each expiry. */
+    watchdog_t * previous;       /**< Previous watchdog of the slot. */
+    watchdog_t * next;           /**< Next watchdog of the slot. */
 };
+/**
+ * \struct Wheel
+ * \brief The slots of the watchdogs started and the thread expiring them.
+ */
+typedef struct {
+    pthread_mutex_t mutex;             /**< Protects the wheel, recursive for the callbacks starting watchdogs. */
+    pthread_cond_t changed;            /**< Signaled when a watchdog is due before wake_tick, or to stop. */
+    watchdog_t * slots[WHEEL_SLOTS];   /**< Watchdogs started, by tick of expiry. */
+    uint64_t origin;                   /**< Monotonic time of tick 0, in nanoseconds. */
+    uint64_t tick;                     /**< Last tick expired. */
+    uint64_t wake_tick;                /**< Tick the thread sleeps until, UINT64_MAX without any watchdog started. */
+    unsigned int watchdogs_nb;         /**< Watchdogs created : the thread runs while there is one. */
+    unsigned int thread_number;        /**< Incremented at each start of the thread : an older one stops at once. */
+    pthread_t thread;                  /**< Thread of the wheel. */
+} Wheel;
 /* ----------------------  PRIVATE ENUMERATIONS  ---------------------------- */
 /* ----------------------  PRIVATE VARIABLES  ------------------------------- */
+/**
+ * \var static Wheel wheel
+ * \brief Wheel of every watchdog.
+ */
+static Wheel wheel = {
+    .wake_tick = UINT64_MAX,
+};
+/**
+ * \var static pthread_once_t wheel_once
+ * \brief Initializes the mutex and the condition of the wheel once.
+ */
+static pthread_once_t wheel_once = PTHREAD_ONCE_INIT;
 /* ----------------------  PRIVATE FUNCTIONS PROTOTYPES  -------------------- */
 /**
- * \fn static void watchdog_function(union sigval val)
- * \brief Init a watchdog callback.
- * \author Dimitri SOLET
+ * \fn static watchdog_t * watchdog_new(unsigned int delay)
+ * \brief Allocates a watchdog and starts the thread of the wheel with the first one.
+ * \author Prose A2
+ *
+ * \param delay : Timeout before the expiry, in milliseconds.
  *
- * \param val : signal value
+ * \return watchdog object, NULL on error.
  */
-static void watchdog_function(union sigval val);
+static watchdog_t * watchdog_new(unsigned int delay);
+/**
+ * \fn static void watchdog_arm(watchdog_t * watchdog, uint64_t expiry)
+ * \brief Puts a watchdog in the slot of its expiry, waking the thread up if it sleeps longer. The wheel is locked.
+ * \author Prose A2
+ *
+ * \param watchdog : watchdog object reference.
+ * \param expiry : tick of the expiry.
+ */
+static void watchdog_arm(watchdog_t * watchdog, uint64_t expiry);
+/**
+ * \fn static void watchdog_disarm(watchdog_t * watchdog)
+ * \brief Takes a watchdog out of its slot. The wheel is locked.
+ * \author Prose A2
+ *
+ * \param watchdog : watchdog object reference.
+ */
+static void watchdog_disarm(watchdog_t * watchdog);
+/**
+ * \fn static bool_e watchdog_deliver(watchdog_t * watchdog)
+ * \brief Calls the callback or sends the message of a watchdog.
+ * \author Prose A2
+ *
+ * \param watchdog : watchdog object reference.
+ *
+ * \return FALSE when the mailbox of the actor is full : the message is to be sent again.
+ */
+static bool_e watchdog_deliver(watchdog_t * watchdog);
+/**
+ * \fn static void * watchdog_run(void * arg)
+ * \brief Thread of the wheel : expires the slots of the ticks elapsed, then sleeps until the next watchdog.
+ * \author Prose A2
+ *
+ * \param arg : number of the thread, see thread_number.
+ */
+static void * watchdog_run(void * arg);
+/**
+ * \fn static void watchdog_expire_slot(uint64_t tick)
+ * \brief Expires the watchdogs due at a tick. The wheel is locked.
+ * \author Prose A2
+ *
+ * \param tick : tick expired.
+ */
+static void watchdog_expire_slot(uint64_t tick);
+/**
+ * \fn static uint64_t watchdog_tick_of(uint64_t deadline)
+ * \brief Tick of a deadline, rounded up : a watchdog never expires before its deadline.
+ * \author Prose A2
+ *
+ * \param deadline : time since the origin of the wheel, in nanoseconds.
+ */
+static uint64_t watchdog_tick_of(uint64_t deadline);
+/**
+ * \fn static void watchdog_init_wheel(void)
+ * \brief Initializes the recursive mutex and the monotonic condition of the wheel.
+ * \author Prose A2
+ */
+static void watchdog_init_wheel(void);
+/**
+ * \fn static uint64_t watchdog_now(void)
+ * \brief Reads the monotonic clock, in nanoseconds.
+ * \author Prose A2
+ */
+static uint64_t watchdog_now(void);
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 watchdog_t * watchdog_create(unsigned int delay, watchdog_callback callback) {
-	watchdog_t * this;
-
-	this = (watchdog_t *) malloc(sizeof(watchdog_t));
+    watchdog_t * this = watchdog_new(delay);
+    if(this != NULL) {
+        this->callback = callback;
+    }
+    return this;
+}
 
-	this->delay = delay;
-	this->callback = callback;
+watchdog_t * watchdog_create_event(unsigned int delay, Actor * actor, const void * msg) {
+    size_t msg_size = ACTOR_get_descriptor(actor)->msg_size;
+    void * msg_copy = malloc(msg_size);
+    if(msg_copy == NULL) {
+        perror("watchdog malloc");
+        return NULL;
+    }
+    memcpy(msg_copy, msg, msg_size);
+    watchdog_t * this = watchdog_new(delay);
+    if(this == NULL) {
+        free(msg_copy);
+        return NULL;
+    }
+    this->actor = actor;
+    this->msg = msg_copy;
+    return this;
+}
 
-	struct sigevent event;
+void watchdog_start(watchdog_t * watchdog) {
+    pthread_mutex_lock(&wheel.mutex);
+    watchdog_disarm(watchdog);
+    watchdog->is_periodic = FALSE;
+    watchdog->deadline = watchdog_now() - wheel.origin + (uint64_t) watchdog->delay * 1000000;
+    watchdog_arm(watchdog, watchdog_tick_of(watchdog->deadline));
+    pthread_mutex_unlock(&wheel.mutex);
+}
 
-	event.sigev_notify = SIGEV_THREAD;
-	event.sigev_value.sival_ptr = (void *)this;
-	event.sigev_notify_function = watchdog_function;
-	event.sigev_notify_attributes = NULL;
+void watchdog_start_periodic(watchdog_t * watchdog) {
+    pthread_mutex_lock(&wheel.mutex);
+    watchdog_start(watchdog);
+    watchdog->is_periodic = TRUE;
+    pthread_mutex_unlock(&wheel.mutex);
+}
 
-	if (timer_create(CLOCK_REALTIME, &event, &(this->timer)) != 0) {
-		perror("watchdog timer_create");
-	}
+void watchdog_cancel(watchdog_t * watchdog) {
+    pthread_mutex_lock(&wheel.mutex);
+    watchdog_disarm(watchdog);
+    watchdog->is_periodic = FALSE;
+    pthread_mutex_unlock(&wheel.mutex);
+}
 
-	return this;
+void watchdog_expire(watchdog_t * watchdog) {
+    pthread_mutex_lock(&wheel.mutex);
+    watchdog_deliver(watchdog);
+    pthread_mutex_unlock(&wheel.mutex);
 }
 
-void watchdog_start(watchdog_t * watchdog) {
-	struct itimerspec itimer;
+void watchdog_destroy(watchdog_t * watchdog) {
+    pthread_mutex_lock(&wheel.mutex);
+    watchdog_disarm(watchdog);
+    bool_e is_last = --wheel.watchdogs_nb == 0 ? TRUE : FALSE;
+    /* Copied under the lock : a watchdog created before the join starts another thread. */
+    pthread_t thread = wheel.thread;
+    if(is_last) {
+        pthread_cond_signal(&wheel.changed);
+    }
+    pthread_mutex_unlock(&wheel.mutex);
+    if(is_last && pthread_join(thread, NULL) != 0) {
+        perror("watchdog pthread_join");
+    }
+    free(watchdog->msg);
+    free(watchdog);
+}
 
-	int delay_sec = watchdog->delay/1000;
-	int delay_nsec = (watchdog->delay - delay_sec*1000)*1000000;
+/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
+static watchdog_t * watchdog_new(unsigned int delay) {
+    watchdog_t * this = calloc(1, sizeof(watchdog_t));
+    if(this == NULL) {
+        perror("watchdog malloc");
+        return NULL;
+    }
+    this->delay = delay;
+    pthread_once(&wheel_once, watchdog_init_wheel);
+    pthread_mutex_lock(&wheel.mutex);
+    if(wheel.watchdogs_nb == 0) {
+        wheel.origin = watchdog_now();
+        wheel.tick = 0;
+        wheel.wake_tick = UINT64_MAX;
+        wheel.thread_number++;
+        if(pthread_create(&wheel.thread, NULL, watchdog_run, (void *) (uintptr_t) wheel.thread_number) != 0) {
+            pthread_mutex_unlock(&wheel.mutex);
+            perror("watchdog pthread_create");
+            free(this);
+            return NULL;
+        }
+        pthread_setname_np(wheel.thread, "watchdog");
+    }
+    wheel.watchdogs_nb++;
+    pthread_mutex_unlock(&wheel.mutex);
+    return this;
+}
 
-	itimer.it_interval.tv_sec = 0;
-	itimer.it_interval.tv_nsec = 0;
-	itimer.it_value.tv_sec =  delay_sec;
-	itimer.it_value.tv_nsec = delay_nsec;
+static void watchdog_arm(watchdog_t * watchdog, uint64_t expiry) {
+    /* The ticks up to wheel.tick are expired already. */
+    if(expiry <= wheel.tick) {
+        expiry = wheel.tick + 1;
+    }
+    watchdog_t ** slot = &wheel.slots[expiry & (WHEEL_SLOTS - 1)];
+    watchdog->expiry = expiry;
+    watchdog->previous = NULL;
+    watchdog->next = *slot;
+    if(*slot != NULL) {
+        (*slot)->previous = watchdog;
+    }
+    *slot = watchdog;
+    watchdog->is_started = TRUE;
+    if(expiry < wheel.wake_tick) {
+        wheel.wake_tick = expiry;
+        pthread_cond_signal(&wheel.changed);
+    }
+}
 
-	if (timer_settime(watchdog->timer, 0, &itimer, NULL) != 0) {
-		perror("watchdog timer_settime");
-	}
+static void watchdog_disarm(watchdog_t * watchdog) {
+    if(!watchdog->is_started) {
+        return;
+    }
+    if(watchdog->previous != NULL) {
+        watchdog->previous->next = watchdog->next;
+    }
+    else {
+        wheel.slots[watchdog->expiry & (WHEEL_SLOTS - 1)] = watchdog->next;
+    }
+    if(watchdog->next != NULL) {
+        watchdog->next->previous = watchdog->previous;
+    }
+    watchdog->is_started = FALSE;
 }
 
-void watchdog_cancel(watchdog_t * watchdog) {
-	struct itimerspec itimer;
+static bool_e watchdog_deliver(watchdog_t * watchdog) {
+    if(watchdog->callback != NULL) {
+        watchdog->callback(watchdog);
+        return TRUE;
+    }
+    /* The thread of the wheel does not wait for room : the other watchdogs would be late. */
+    int sent = ACTOR_try_send(watchdog->actor, watchdog->msg, 0);
+    if(sent == -1) {
+        perror("watchdog ACTOR_try_send");
+    }
+    return sent == 0 ? FALSE : TRUE;
+}
 
-	itimer.it_interval.tv_sec = 0;
-	itimer.it_interval.tv_nsec = 0;
-	itimer.it_value.tv_sec = 0;
-	itimer.it_value.tv_nsec = 0;
+static void * watchdog_run(void * arg) {
+    unsigned int my_number = (unsigned int) (uintptr_t) arg;
+    pthread_mutex_lock(&wheel.mutex);
+    /* The last watchdog destroyed, a new thread may start before this one has woken up : it leaves the wheel to it. */
+    while(wheel.watchdogs_nb > 0 && wheel.thread_number == my_number) {
+        uint64_t now_tick = (watchdog_now() - wheel.origin) / TICK_NS;
+        /* A slot is a turn of ticks : after a whole turn, every slot has been seen. */
+        uint64_t first_tick = now_tick - wheel.tick > WHEEL_SLOTS ? now_tick - WHEEL_SLOTS : wheel.tick;
+        for(uint64_t tick = first_tick + 1; tick <= now_tick; tick++) {
+            wheel.tick = tick;
+            watchdog_expire_slot(tick);
+        }
+        wheel.tick = now_tick;
 
-	if (timer_settime(watchdog->timer, 0, &itimer, NULL) != 0) {
-		perror("watchdog timer_settime");
-	}
+        /* Sleeps until the first slot holding a watchdog, which may be due at a later turn only. The time is absolute,
+         * as with TIMER_ABSTIME : a late wake-up does not delay the next one. */
+        wheel.wake_tick = UINT64_MAX;
+        for(uint64_t tick = now_tick + 1; tick <= now_tick + WHEEL_SLOTS; tick++) {
+            if(wheel.slots[tick & (WHEEL_SLOTS - 1)] != NULL) {
+                wheel.wake_tick = tick;
+                break;
+            }
+        }
+        if(wheel.wake_tick == UINT64_MAX) {
+            pthread_cond_wait(&wheel.changed, &wheel.mutex);
+        }
+        else {
+            uint64_t wake_time = wheel.origin + wheel.wake_tick * TICK_NS;
+            struct timespec deadline = {.tv_sec = (time_t) (wake_time / 1000000000), .tv_nsec = (long) (wake_time % 1000000000)};
+            pthread_cond_timedwait(&wheel.changed, &wheel.mutex, &deadline);
+        }
+    }
+    pthread_mutex_unlock(&wheel.mutex);
+    return NULL;
 }
 
-void watchdog_destroy(watchdog_t * watchdog) {
-	watchdog_cancel(watchdog);
-
-	if (timer_delete(watchdog->timer)) {
-		perror("watchdog timer_delete");
-	}
+static void watchdog_expire_slot(uint64_t tick) {
+    for(;;) {
+        /* Read again from the head after each delivery : a callback may have cancelled or destroyed any watchdog of
+         * the slot. A watchdog delivered is armed again after tick only, it is never found twice. */
+        watchdog_t * watchdog = wheel.slots[tick & (WHEEL_SLOTS - 1)];
+        while(watchdog != NULL && watchdog->expiry > tick) {
+            watchdog = watchdog->next;
+        }
+        if(watchdog == NULL) {
+            return;
+        }
+        watchdog_disarm(watchdog);
+        if(!watchdog_deliver(watchdog)) {
+            /* Mailbox full : sent again at the next tick. */
+            watchdog_arm(watchdog, tick + 1);
+        }
+        else if(watchdog->is_periodic && !watchdog->is_started) {
+            /* From the deadline, not from now : a late period is caught up at the next tick. */
+            watchdog->deadline += (uint64_t) watchdog->delay * 1000000;
+            watchdog_arm(watchdog, watchdog_tick_of(watchdog->deadline));
+        }
+    }
+}
 
-	free(watchdog);	
+static uint64_t watchdog_tick_of(uint64_t deadline) {
+    return (deadline + TICK_NS - 1) / TICK_NS;
 }
 
-/* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
-static void watchdog_function(union sigval val) {
-    watchdog_t * watchdog = (watchdog_t *)(val.sival_ptr);
-    watchdog->callback(watchdog);
+static void watchdog_init_wheel(void) {
+    pthread_mutexattr_t mutex_attributes;
+    pthread_mutexattr_init(&mutex_attributes);
+    pthread_mutexattr_settype(&mutex_attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&wheel.mutex, &mutex_attributes);
+    pthread_mutexattr_destroy(&mutex_attributes);
+    pthread_condattr_t cond_attributes;
+    pthread_condattr_init(&cond_attributes);
+    pthread_condattr_setclock(&cond_attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&wheel.changed, &cond_attributes);
+    pthread_condattr_destroy(&cond_attributes);
 }
 
+static uint64_t watchdog_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
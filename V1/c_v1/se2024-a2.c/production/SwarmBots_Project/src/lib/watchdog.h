@@ -1,10 +1,11 @@
 /**
  * \file  watchdog.h
- * \version  1.1
+ * \version  1.2
  * \author Dimitri SOLET
  * \author Louison LEGROS
- * \date Mar 14, 2023
- * \brief Watchdog module for callback functions with timer.
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Watchdog module for callback functions with timer, or events sent to an actor.
  *
  * \see watchdog.c
  *
@@ -38,6 +39,7 @@
 #ifndef _WATCHDOG_H
 #define _WATCHDOG_H
 /* ----------------------  INCLUDES ------------------------------------------*/
+#include "actor.h"
 /* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
 /**
  * \typedef watchdog_t
@@ -46,7 +48,7 @@
 typedef struct watchdog_t watchdog_t;
 /**
  * \typedef void (* watchdog_callback)(watchdog_t * watchdog)
- * \brief callback watchdog definition
+ * \brief callback watchdog definition, called by the timer thread : it must be short and must not wait.
  */
 typedef void (* watchdog_callback)(watchdog_t * watchdog);
 /* ----------------------  PUBLIC ENUMERATIONS -------------------------------*/
@@ -64,6 +66,18 @@ typedef void (* watchdog_callback)(watchdog_t * watchdog);
  * \return watchdog object.
  */
 watchdog_t * watchdog_create(unsigned int delay, watchdog_callback callback);
+/**
+ * \fn watchdog_t * watchdog_create_event(unsigned int delay, Actor * actor, const void * msg)
+ * \brief Creation of a watchdog sending a message to an actor when its delay is over.
+ * \author Prose A2
+ *
+ * \param delay : Timeout before the message is sent, in milliseconds.
+ * \param actor : Actor receiving the message.
+ * \param msg : Message of the size of the messages of the actor, copied.
+ *
+ * \return watchdog object, NULL on error.
+ */
+watchdog_t * watchdog_create_event(unsigned int delay, Actor * actor, const void * msg);
 /**
  * \fn void watchdog_start(watchdog_t * watchdog)
  * \brief Creation of watchdog create.
@@ -73,6 +87,15 @@ watchdog_t * watchdog_create(unsigned int delay, watchdog_callback callback);
  * \param watchdog : watchdog object reference.
  */
 void watchdog_start(watchdog_t * watchdog);
+/**
+ * \fn void watchdog_start_periodic(watchdog_t * watchdog)
+ * \brief Starts a watchdog expiring every delay until it is cancelled. The deadlines are absolute, the n-th one is
+ * n delays after the start : an expiry delivered late neither shifts the next ones nor is skipped.
+ * \author Prose A2
+ *
+ * \param watchdog : watchdog object reference.
+ */
+void watchdog_start_periodic(watchdog_t * watchdog);
 /**
  * \fn void watchdog_cancel(watchdog_t * watchdog)
  * \brief Creation of watchdog create.
@@ -81,6 +104,15 @@ void watchdog_start(watchdog_t * watchdog);
  * \param watchdog : watchdog object reference.
  */
 void watchdog_cancel(watchdog_t * watchdog);
+/**
+ * \fn void watchdog_expire(watchdog_t * watchdog)
+ * \brief Calls the callback or sends the message of a watchdog at once, from the calling thread. A started watchdog
+ * keeps its deadline.
+ * \author Prose A2
+ *
+ * \param watchdog : watchdog object reference.
+ */
+void watchdog_expire(watchdog_t * watchdog);
 /**
  * \fn void watchdog_destroy(watchdog_t * watchdog)
  * \brief Creation of watchdog create.
@@ -40,13 +40,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <mqueue.h>
-#include <errno.h>
-#include <pthread.h>
-#include <math.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/time.h>
 
 #include "controller_logger.h"
+#include "../lib/actor.h"
 #include "../com/gui_proxy.h"
 #include "../com/logs_manager_proxy.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
@@ -126,17 +126,6 @@ typedef union {
     Mq_Msg_Data msg_data; /**< Data structure. */
     char buffer[sizeof(Mq_Msg_Data)]; /**< Raw message. */
 } Mq_Msg;
-/**
- * \struct Transition
- * \brief Gives an action and state destination for a transition.
- *
- * Transition gives the action to perform when an event has been fired. Also gives the destination state.
- */
-typedef struct {
-    State_Machine state_destination; /**< Next state. */
-    Action action; /**< Action to perform from previous the event. */
-} Transition;
-
 /**
  * \typedef void(*Action_Pt)(Action_param param)
  * \brief Definition of function pointer for the actions to perform.
@@ -200,13 +189,15 @@ static int CONTROLLER_LOGGER_save_temp_logs(void);
  */
 static int CONTROLLER_LOGGER_save_logs(const char * string_to_log, log_level_e level_to_log);
 /**
- * \fn static int CONTROLLER_LOGGER_load_logs(void)
- * \brief Reads the the log file.
+ * \fn static int CONTROLLER_LOGGER_load_logs(uint32_t * logs_size)
+ * \brief Flushes the log file and opens it for reading, the logs are read page by page while they are sent.
  * \author Joshua MONTREUIL
  *
- * \return On success, returns 0 and puts the logs into the global buffer. On error, returns -1.
+ * \param logs_size : set to the size in bytes of the log file.
+ *
+ * \return On success, returns a file descriptor of the log file. On error, returns -1.
  */
-static int CONTROLLER_LOGGER_load_logs(void);
+static int CONTROLLER_LOGGER_load_logs(uint32_t * logs_size);
 /**
  * \fn static int CONTROLLER_LOGGER_remove_logs(void)
  * \brief Remove the logs from the file.
@@ -314,7 +305,7 @@ static int CONTROLLER_LOGGER_action_remember_logs(const char * string_to_log, lo
 static int CONTROLLER_LOGGER_action_save_logs(const char * string_to_log, log_level_e level_to_log);
 /**
  * \fn static int CONTROLLER_LOGGER_action_load_and_send_logs(const char * string_to_log, log_level_e level_to_log)
- * \brief Loads, parse into different frames and sends it to logs manager proxy.
+ * \brief Opens the logs and hands them to logs manager proxy, which sends them page by page.
  * \author Joshua MONTREUIL
  *
  * \param string_to_log : string to be logged.
@@ -336,25 +327,16 @@ static int CONTROLLER_LOGGER_action_load_and_send_logs(const char * string_to_lo
 static int CONTROLLER_LOGGER_action_remove_logs(const char * string_to_log, log_level_e level_to_log);
 /* ----- ACTIVE ----- */
 /**
- * \fn static void * CONTROLLER_LOGGER_run(void * arg)
- * \brief Called by a thread. This function is the "active" part of controller logger.
- * \author Joshua MONTREUIL
- *
- * \param arg : argument pointer.
- *
- * \return void * : generic pointer.
- */
-static void * CONTROLLER_LOGGER_run(void* arg);
-/**
- * \fn static int CONTROLLER_LOGGER_mq_receive(Mq_Msg * a_msg)
- * \brief Receives the messages from the queue.
- * \author Joshua MONTREUIL
+ * \fn static int CONTROLLER_LOGGER_perform(int action, void * msg)
+ * \brief Performs an action of the state machine for the actor of controller logger, with the log of the message.
+ * \author Prose A2
  *
- * \param a_msg : pointer to Mq_Msg struct.
+ * \param action : action to perform.
+ * \param msg : pointer to the Mq_Msg that triggered the action.
  *
  * \return On success, returns 0. On error, returns -1.
  */
-static int CONTROLLER_LOGGER_mq_receive(Mq_Msg * a_msg);
+static int CONTROLLER_LOGGER_perform(int action, void * msg);
 /**
  * \fn static int CONTROLLER_LOGGER_mq_send(Mq_Msg * a_msg)
  * \brief Sends a message into the queue.
@@ -372,15 +354,10 @@ static int CONTROLLER_LOGGER_mq_send(Mq_Msg * a_msg);
  */
 static print_mode print_mode_set;
 /**
- * \var static pthread_t controller_logger_thread
- * \brief Postman thread.
- */
-static pthread_t controller_logger_thread;
-/**
- * \var static mqd_t my_mail_box
- * \brief Message queue reference.
+ * \var static Actor * my_actor
+ * \brief Actor of controller logger : its mailbox and its state machine.
  */
-static mqd_t my_mail_box;
+static Actor * my_actor;
 /**
  * \var filepath
  * \brief filepath of the log file
@@ -396,6 +373,16 @@ static time_t robot_rtc;
  * \brief Actual size of the log file.
  */
 static uint32_t current_file_size = 0;
+/**
+ * \var static char string[CONFIG_LOGGER_LOG_SIZE]
+ * \brief Log of the last E_LOG, kept for the action following the memory check.
+ */
+static char string[CONFIG_LOGGER_LOG_SIZE];
+/**
+ * \var static log_level_e level_to_log
+ * \brief Level of the log in string.
+ */
+static log_level_e level_to_log;
 /**
  * \var id_file
  * \brief Identifier of the log file.
@@ -413,9 +400,9 @@ static Id_file id_temp_file;
 static Log_List log_list;
 /**
  * \var level
- * \brief Log level, can be set to 0:DEBUG | 1:INFO | 2:WARNING | 3:ERROR |
+ * \brief Log level, can be set to 0:DEBUG | 1:INFO | 2:WARNING | 3:ERROR |. Read by every module logging.
  */
-static log_level_e level;
+static log_level_e level = CONFIG_LOGGER_LOG_LEVEL;
 /**
  * \var static const Action_Pt actions_tab[ACTION_NB]
  * \brief Array of function pointer to call from action to perform.
@@ -435,7 +422,7 @@ static const Action_Pt actions_tab[ACTION_NB] = {
  * \var static Transition my_state_machine [STATE_NB -1][EVENT_NB]
  * \brief Array representing the state machine.
  */
-static Transition my_state_machine [STATE_NB -1][EVENT_NB] = {
+static const Actor_Transition my_state_machine [STATE_NB -1][EVENT_NB] = {
     [S_IDLE]           [E_LOG]             = {S_IDLE,           A_REMEMBER_LOGS},
     [S_IDLE]           [E_STOP]            = {S_DEATH,          A_STOP},
     [S_IDLE]           [E_ASK_SET_RTC]     = {S_WAITING_ACTION, A_SETUP_RTC_SAVE_TEMP_LOGS},
@@ -451,27 +438,34 @@ static Transition my_state_machine [STATE_NB -1][EVENT_NB] = {
     [S_WAITING_ACTION] [E_STOP]            = {S_DEATH,          A_STOP},
     [S_WAITING_ACTION] [E_ASK_LOGS]        = {S_FLUSHING,       A_LOAD_LOGS},
 };
+/**
+ * \var static const Actor_Descriptor my_descriptor
+ * \brief Mailbox and state machine of controller logger. Its errors and traces cannot be logged.
+ */
+static const Actor_Descriptor my_descriptor = {
+    .name = "controller_logger",
+    .mailbox_name = MQ_CONTROLLER_LOGGER_BOX_NAME,
+    .msg_size = sizeof(Mq_Msg),
+    .msg_count = MQ_MSG_COUNT,
+    .priorities_nb = 1,
+    .mailbox_kind = CONFIG_MAILBOX_CONTROLLER_LOGGER,
+    .state_machine = &my_state_machine[0][0],
+    .states_nb = STATE_NB,
+    .events_nb = EVENT_NB,
+    .event_offset = offsetof(Mq_Msg_Data, event),
+    .initial_state = S_WAITING_ACTION,
+    .initial_action = A_NOP,
+    .perform = CONTROLLER_LOGGER_perform,
+    .is_logged = FALSE
+};
 /* ----------------------  PUBLIC FUNCTIONS  -------------------------------- */
 int CONTROLLER_LOGGER_create(void) {
-    struct mq_attr mqa;
-    mqa.mq_maxmsg = MQ_MSG_COUNT;
-    mqa.mq_msgsize = sizeof(Mq_Msg);
-    errno = 0;
-    if((my_mail_box = mq_open(MQ_CONTROLLER_LOGGER_BOX_NAME, O_CREAT | O_RDWR | O_EXCL , 0644 ,&mqa )) == -1 ) {
-        if(errno == EEXIST) {
-            mq_unlink(MQ_CONTROLLER_LOGGER_BOX_NAME);
-            if((my_mail_box = mq_open(MQ_CONTROLLER_LOGGER_BOX_NAME, O_CREAT | O_RDWR , 0644 ,&mqa )) == -1 ) {
-                /* Cannot be logged but error on mq_open here. */
-                printf("ERROR on mq_open for controller_logger\n");
-                return -1;
-            }
-        } else {
-            /* Cannot be logged but error on mq_open here. */
-            printf("ERROR on mq_open for controller_logger\n");
-            return -1;
-        }
+    if((my_actor = ACTOR_create(&my_descriptor)) == NULL) {
+        /* Cannot be logged but error on ACTOR_create here. */
+        printf("ERROR on ACTOR_create for controller_logger\n");
+        return -1;
     }
-    level = CONFIG_LOGGER_LOG_LEVEL;
+    CONTROLLER_LOGGER_set_level(CONFIG_LOGGER_LOG_LEVEL);
     print_mode_set = CONFIG_LOGGER_PRINT_MODE;
     if((id_file = fopen(filepath,"a+") ) == NULL) {
         Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "On fopen(): controller logger has failed to open the log file."};
@@ -483,14 +477,13 @@ int CONTROLLER_LOGGER_create(void) {
     return 0;
 
     error_fopen :
-        mq_close(my_mail_box);
-        mq_unlink(MQ_CONTROLLER_LOGGER_BOX_NAME);
+        ACTOR_destroy(my_actor);
         return -1;
 }
 
 int CONTROLLER_LOGGER_start(void) {
-    if(pthread_create(&controller_logger_thread,NULL, CONTROLLER_LOGGER_run, NULL) != 0 ) {
-        Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "On pthread_create() : error while creating controller logger thread."};
+    if(ACTOR_start(my_actor) != 0 ) {
+        Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "On ACTOR_start() : error while starting controller logger actor."};
         if (CONTROLLER_LOGGER_mq_send(&my_msg_log) == -1) {
             return -1;
         }
@@ -508,6 +501,10 @@ int CONTROLLER_LOGGER_ask_logs(Id_Robot id_robot) {
 }
 
 int CONTROLLER_LOGGER_log(log_level_e log_level, const char* msg) {
+    /* Not logged : the logger is not even asked. */
+    if(!CONTROLLER_LOGGER_is_enabled(log_level)) {
+        return 0;
+    }
     Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = log_level};
     memcpy(my_msg_log.msg_data.log_msg, msg, strlen(msg));
     if (CONTROLLER_LOGGER_mq_send(&my_msg_log) == -1) {
@@ -516,6 +513,14 @@ int CONTROLLER_LOGGER_log(log_level_e log_level, const char* msg) {
     return 0;
 }
 
+bool_e CONTROLLER_LOGGER_is_enabled(log_level_e log_level) {
+    return log_level >= __atomic_load_n(&level, __ATOMIC_RELAXED) ? TRUE : FALSE;
+}
+
+void CONTROLLER_LOGGER_set_level(log_level_e log_level) {
+    __atomic_store_n(&level, log_level, __ATOMIC_RELAXED);
+}
+
 int CONTROLLER_LOGGER_ask_set_rtc(Id_Robot id_robot,time_t rtc) {
     Mq_Msg my_msg_rtc = {.msg_data.event = E_ASK_SET_RTC, .msg_data.rtc = rtc};
     if (CONTROLLER_LOGGER_mq_send(&my_msg_rtc) == -1) {
@@ -536,9 +541,9 @@ int CONTROLLER_LOGGER_stop(void) {
     int ret = 0;
     Mq_Msg my_msg_stop = {.msg_data.event = E_STOP,0,""};
     if(CONTROLLER_LOGGER_mq_send(&my_msg_stop) == 0 ) {
-        if(pthread_join(controller_logger_thread, NULL) != 0) {
-            /* Cannot be logged but error on pthread_join here. */
-            printf("ERROR on pthread_join for controller_logger\n");
+        if(ACTOR_join(my_actor) != 0) {
+            /* Cannot be logged but error on ACTOR_join here. */
+            printf("ERROR on ACTOR_join for controller_logger\n");
             ret = -1;
         }
     }
@@ -550,14 +555,9 @@ int CONTROLLER_LOGGER_stop(void) {
 
 int CONTROLLER_LOGGER_destroy(void) {
     int ret = 0;
-    if(mq_close(my_mail_box) == -1 ) {
-        /* Cannot be logged but error on mq_close here. */
-        printf("ERROR on mq_close for controller_logger\n");
-        ret = -1;
-    }
-    if(mq_unlink(MQ_CONTROLLER_LOGGER_BOX_NAME) == -1 ) {
-        /* Cannot be logged but error on mq_unlink here. */
-        printf("ERROR on mq_unlink for controller_logger\n");
+    if(ACTOR_destroy(my_actor) == -1) {
+        /* Cannot be logged but error on ACTOR_destroy here. */
+        printf("ERROR on ACTOR_destroy for controller_logger\n");
         ret = -1;
     }
     return ret;
@@ -565,62 +565,29 @@ int CONTROLLER_LOGGER_destroy(void) {
 
 /* ----------------------  PRIVATE FUNCTIONS  ------------------------------- */
 /* ----- ACTIVE ----- */
-static void * CONTROLLER_LOGGER_run(void* arg) {
-    Mq_Msg msg;
-    State_Machine my_state = S_WAITING_ACTION;
-    Transition * my_transition;
-    char string[CONFIG_LOGGER_LOG_SIZE];
-    log_level_e level_to_log = 0;
-    while(my_state != S_DEATH) {
-        if(CONTROLLER_LOGGER_mq_receive(&msg) == -1) {
-            /* Cannot be logged but error on mq here. */
-            printf("ERROR on controller_logger_mq\n");
-            return NULL;
-        }
-        my_transition = &my_state_machine[my_state][msg.msg_data.event];
-        if(msg.msg_data.event == E_LOG) {
-            level_to_log = msg.msg_data.level;
-            memset(string,0,CONFIG_LOGGER_LOG_SIZE);
-            strcpy(string,msg.msg_data.log_msg);
-        }
-        else if(msg.msg_data.event == E_ASK_SET_RTC) {
-            robot_rtc = msg.msg_data.rtc;
-            level_to_log = 0;
-            memset(string,0,CONFIG_LOGGER_LOG_SIZE);
-        }
-        else if(msg.msg_data.event != E_MEMORY_OK) {
-            level_to_log = 0;
-            memset(string,0,CONFIG_LOGGER_LOG_SIZE);
-        }
-        if(my_transition->state_destination != S_FORGET) {
-            if(actions_tab[my_transition->action](string,level_to_log) == -1) {
-                /* Cannot be logged but error on actions_tab here. */
-                printf("ERROR on controller_logger action_tab\n");
-                return NULL;
-            }
-            my_state = my_transition->state_destination;
-        }
-    }
-    return 0;
-}
-
-static int CONTROLLER_LOGGER_mq_receive(Mq_Msg * a_msg) {
-    if((mq_receive(my_mail_box,a_msg->buffer,sizeof(Mq_Msg), 0) == -1)) {
-        /* Cannot be logged but error on mq_receive here. */
-        printf("ERROR on mq_receive for controller_logger\n");
-        mq_close(my_mail_box);
-        mq_unlink(MQ_CONTROLLER_LOGGER_BOX_NAME);
-        return -1;
-    }
-    return 0;
+static int CONTROLLER_LOGGER_perform(int action, void * msg) {
+    Mq_Msg * a_msg = msg;
+    if(a_msg->msg_data.event == E_LOG) {
+        level_to_log = a_msg->msg_data.level;
+        memset(string,0,CONFIG_LOGGER_LOG_SIZE);
+        strcpy(string,a_msg->msg_data.log_msg);
+    }
+    else if(a_msg->msg_data.event == E_ASK_SET_RTC) {
+        robot_rtc = a_msg->msg_data.rtc;
+        level_to_log = 0;
+        memset(string,0,CONFIG_LOGGER_LOG_SIZE);
+    }
+    else if(a_msg->msg_data.event != E_MEMORY_OK) {
+        level_to_log = 0;
+        memset(string,0,CONFIG_LOGGER_LOG_SIZE);
+    }
+    return actions_tab[action](string,level_to_log);
 }
 
 static int CONTROLLER_LOGGER_mq_send(Mq_Msg * a_msg) {
-    if(mq_send(my_mail_box,a_msg->buffer, sizeof(Mq_Msg),0) == -1 ) {
-        /* Cannot be logged but error on mq here. */
-        printf("ERROR on controller_logger_mq\n");
-        mq_close(my_mail_box);
-        mq_unlink(MQ_CONTROLLER_LOGGER_BOX_NAME);
+    if(ACTOR_send(my_actor, a_msg->buffer, 0) == -1) {
+        /* Cannot be logged but error on the mailbox here. */
+        printf("ERROR on controller_logger mailbox\n");
         return -1;
     }
     return 0;
@@ -654,25 +621,16 @@ static int CONTROLLER_LOGGER_action_evaluate_memory(const char * string_to_log,
         }
         return -1;
     }
+    Mq_Msg memory_msg = {.msg_data.event = E_MEMORY_CRITICAL};
     if(current_file_size < 1500000) {
-        Mq_Msg my_msg = {.msg_data.event = E_MEMORY_OK,0,""};
-        if(CONTROLLER_LOGGER_mq_send(&my_msg) == -1 ) {
-            return -1;
-        }
+        memory_msg.msg_data.event = E_MEMORY_OK;
     }
     else if(current_file_size < 2000000) {
-        Mq_Msg my_msg = {.msg_data.event = E_MEMORY_ALERT,0,""};
-        if(CONTROLLER_LOGGER_mq_send(&my_msg) == -1 ) {
-            return -1;
-        }
-    }
-    else {
-        Mq_Msg my_msg = {.msg_data.event = E_MEMORY_CRITICAL,0,""};
-        if(CONTROLLER_LOGGER_mq_send(&my_msg) == -1 ) {
-            return -1;
-        }
+        memory_msg.msg_data.event = E_MEMORY_ALERT;
     }
-    return 0;
+    /* The verdict on the memory is not queued : behind a full queue of logs, the logger would wait for itself,
+     * and the logs before it would be forgotten in S_CHOICE. */
+    return ACTOR_raise(my_actor, &memory_msg);
 }
 
 static int CONTROLLER_LOGGER_action_raise_alert(const char * string_to_log, log_level_e level_to_log) {
@@ -694,7 +652,7 @@ static int CONTROLLER_LOGGER_action_save_logs(const char * string_to_log, log_le
 }
 
 static int CONTROLLER_LOGGER_action_remember_logs(const char * string_to_log, log_level_e level_to_log) {
-    char string[strlen(string_to_log) + 1];
+    char string[strlen(string_to_log) + sizeof("4\n\n")];
     sprintf(string,"%d\n%s\n", level_to_log, string_to_log);
     if(CONTROLLER_LOGGER_store_temp_logs(string) == -1) {
         Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "On CONTROLLER_LOGGER_store_temp_logs() : error while saving log into a temp buffer."};
@@ -707,43 +665,34 @@ static int CONTROLLER_LOGGER_action_remember_logs(const char * string_to_log, lo
 }
 
 static int CONTROLLER_LOGGER_action_load_and_send_logs(const char * string_to_log, log_level_e level_to_log) {
-    if(CONTROLLER_LOGGER_load_logs() == -1) {
+    uint32_t logs_size;
+    int logs_file = CONTROLLER_LOGGER_load_logs(&logs_size);
+    if(logs_file == -1) {
         Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "On CONTROLLER_LOGGER_load_logs() : error while loading logs from the file."};
         if(CONTROLLER_LOGGER_mq_send(&my_msg_log) == -1 ) {
-            free(log_list);
             return -1;
         }
-        free(log_list);
         return -1;
     }
-    if(current_file_size != 0) {
-        uint32_t max_page = (uint32_t) ceil(((double)current_file_size)/((double)0xFFFB));
-        for(int i = 0; i < max_page; ++i) {
-            uint32_t page_log_size;
-            if((i+1) <= (max_page - 1)) {
-                page_log_size = 0xFFFB;
-            }
-            else {
-                page_log_size = current_file_size - (0xFFFB * i);
+    if(logs_size != 0) {
+        /* The file is read a page at a time, when the postman has room to send it. */
+        if(LOGS_MANAGER_PROXY_stream_logs(logs_file, logs_size) == -1) {
+            Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "On LOGS_MANAGER_PROXY_stream_logs() : error while sending the logs."};
+            if(CONTROLLER_LOGGER_mq_send(&my_msg_log) == -1 ) {
+                return -1;
             }
-            Log_List log_list_to_send = (Log_List) malloc(page_log_size + 4);
-            uint8_t size_and_page_buff[4] = {((page_log_size >> 8) & 0xFF),(page_log_size & 0xFF),(i+1),max_page};
-            memcpy(log_list_to_send,size_and_page_buff,sizeof(size_and_page_buff));
-            memcpy((log_list_to_send + 4),(log_list + (0xFFFB * i)), page_log_size);
-            LOGS_MANAGER_PROXY_set_logs(log_list_to_send);
+            return -1;
         }
     }
     else {
-        LOGS_MANAGER_PROXY_set_logs((unsigned char*)"Empty\n");
+        close(logs_file);
+        LOGS_MANAGER_PROXY_set_logs(1, 1, (const uint8_t *) "Empty\n", sizeof("Empty\n") - 1);
         Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "The log file has a size of 0."};
         if(CONTROLLER_LOGGER_mq_send(&my_msg_log) == -1 ) {
-            free(log_list);
             return -1;
         }
-        free(log_list);
         return -1;
     }
-    free(log_list);
     return 0;
 }
 
@@ -773,7 +722,7 @@ static uint32_t CONTROLLER_LOGGER_check_memory(void){
 
 static int CONTROLLER_LOGGER_save_logs(const char * string_to_log, log_level_e level_to_log){
     Log str_level ="";
-    if(level_to_log >= level) {
+    if(CONTROLLER_LOGGER_is_enabled(level_to_log)) {
         str_level = CONTROLLER_LOGGER_get_string_level(level_to_log);
     }
     char current_time[30];
@@ -784,7 +733,7 @@ static int CONTROLLER_LOGGER_save_logs(const char * string_to_log, log_level_e l
         }
         return -1;
     }
-    char log[strlen(string_to_log)+ strlen(current_time) + strlen(str_level)];
+    char log[strlen(string_to_log)+ strlen(current_time) + strlen(str_level) + sizeof(" :  - \n")];
     sprintf(log,"%s : %s - %s\n", str_level, current_time, string_to_log);
     if(print_mode_set == FILE_ONLY) {
         fprintf(id_file,"%s",log);
@@ -799,16 +748,27 @@ static int CONTROLLER_LOGGER_save_logs(const char * string_to_log, log_level_e l
     return 0;
 }
 
-static int CONTROLLER_LOGGER_load_logs(void){
-    log_list = (Log_List) malloc(current_file_size);
-    char line_read[100];
-    size_t current_size = 0;
-    while(fgets(line_read, sizeof(line_read),id_temp_file) != NULL) {
-        size_t line_read_size = strlen(line_read);
-        strcpy((char *)log_list + current_size, line_read + 1);
-        current_size += line_read_size;
+static int CONTROLLER_LOGGER_load_logs(uint32_t * logs_size){
+    if(fflush(id_file) != 0) {
+        Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "On fflush() : failed to write the logs into the file."};
+        if(CONTROLLER_LOGGER_mq_send(&my_msg_log) == -1 ) {
+            return -1;
+        }
+        return -1;
     }
-    return 0;
+    if((current_file_size = CONTROLLER_LOGGER_check_memory()) == -1) {
+        return -1;
+    }
+    int logs_file = open(filepath, O_RDONLY | O_CLOEXEC);
+    if(logs_file == -1) {
+        Mq_Msg my_msg_log = {.msg_data.event = E_LOG, .msg_data.level = ERROR, .msg_data.log_msg = "On open() : failed to open the log file for reading."};
+        if(CONTROLLER_LOGGER_mq_send(&my_msg_log) == -1 ) {
+            return -1;
+        }
+        return -1;
+    }
+    *logs_size = current_file_size;
+    return logs_file;
 }
 
 static int CONTROLLER_LOGGER_remove_logs(void) {
@@ -40,10 +40,25 @@
 #define SRC_LOGS_CONTROLLER_LOGGER_H_
 
 /* ----------------------  INCLUDES ------------------------------------------*/
+#include <stdio.h>
 #include "../config.h"
 #include "../lib/defs.h"
 #include "time.h"
 /* ----------------------  PUBLIC CONFIGURATIONS  ----------------------------*/
+/**
+ * \def CONTROLLER_LOGGER_LOG(log_level, ...)
+ * Formats and logs an entry only when its level is logged : the logs below CONFIG_LOGGER_LOG_FLOOR are removed at
+ * build time, the ones below the level set at run time are neither formatted nor sent to the logger.
+ * The arguments after the level are the ones of printf().
+ */
+#define CONTROLLER_LOGGER_LOG(log_level, ...) \
+    do { \
+        if((log_level) >= CONFIG_LOGGER_LOG_FLOOR && CONTROLLER_LOGGER_is_enabled(log_level)) { \
+            char controller_logger_entry[CONFIG_LOGGER_LOG_SIZE]; \
+            snprintf(controller_logger_entry, sizeof(controller_logger_entry), __VA_ARGS__); \
+            CONTROLLER_LOGGER_log((log_level), controller_logger_entry); \
+        } \
+    } while(0)
 /* ----------------------  PUBLIC TYPE DEFINITIONS ---------------------------*/
 /**
  * \enum log_level_e
@@ -124,6 +139,26 @@ extern int CONTROLLER_LOGGER_ask_logs(Id_Robot id_robot);
  */
 extern int CONTROLLER_LOGGER_log(log_level_e log_level, const char* msg);
 
+/**
+ * \fn extern bool_e CONTROLLER_LOGGER_is_enabled(log_level_e log_level)
+ * \brief Tells whether the logs of a level are logged, to skip the formatting of the other ones.
+ * \author Prose A2
+ *
+ * \param log_level : criticality level of the log.
+ *
+ * \return TRUE when the logs of this level are logged, FALSE otherwise.
+ */
+extern bool_e CONTROLLER_LOGGER_is_enabled(log_level_e log_level);
+
+/**
+ * \fn extern void CONTROLLER_LOGGER_set_level(log_level_e log_level)
+ * \brief Changes the lowest level logged while SB_C runs.
+ * \author Prose A2
+ *
+ * \param log_level : lowest criticality level logged.
+ */
+extern void CONTROLLER_LOGGER_set_level(log_level_e log_level);
+
 /**
  * \fn extern int CONTROLLER_LOGGER_ask_set_rtc(Id_Robot id_robot,time_t rtc)
  * \brief Requests to change the internal RTC.
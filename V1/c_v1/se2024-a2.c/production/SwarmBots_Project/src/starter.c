@@ -47,8 +47,11 @@
 #include "controller/controller_ringer.h"
 #include "com/postman.h"
 #include "com/dispatcher.h"
+#include "com/frame_pool.h"
 #include "logs/controller_logger.h"
+#include "lib/actor.h"
 #include "lib/defs.h"
+#include "config.h"
 /* ----------------------  PRIVATE CONFIGURATIONS  -------------------------- */
 /* ----------------------  PRIVATE TYPE DEFINITIONS  ------------------------ */
 /* ----------------------  PRIVATE STRUCTURES  ------------------------------ */
@@ -90,11 +93,18 @@ static bool_e quit_case = FALSE;
 int main (int argc, char * argv[])
 {
 	printf("Hello swarmbots\n\n");
+#if CONFIG_ACTOR_POOL
+    ACTOR_set_scheduler(&ACTOR_POOL_SCHEDULER);
+#endif
     /* MODULE CREATION */
     if(CONTROLLER_LOGGER_create() == -1) {
         printf("ERROR on controller_logger creation.\n");
         return -1;
     }
+    if(FRAME_POOL_create() == -1) {
+        printf("ERROR on frame_pool creation.\n");
+        goto error_frame_pool_create;
+    }
     if(STATE_INDICATOR_create() == -1) {
         printf("ERROR on state_indicator creation.\n");
         goto error_state_indicator_create;
@@ -178,6 +188,8 @@ error_controller_ringer_create :
 error_controller_core_create :
     STATE_INDICATOR_destroy();
 error_state_indicator_create :
+    FRAME_POOL_destroy();
+error_frame_pool_create :
     CONTROLLER_LOGGER_destroy();
     return -1;
 }
@@ -253,6 +265,9 @@ static void STARTER_stop_all(void) {
     if(STATE_INDICATOR_destroy() == -1) {
         printf("ERROR on state indicator destroy. \n");
     }
+    if(FRAME_POOL_destroy() == -1) {
+        printf("ERROR on frame pool destroy. \n");
+    }
     if(CONTROLLER_LOGGER_destroy() == -1) {
         printf("ERROR on controller logger destroy. \n");
     }
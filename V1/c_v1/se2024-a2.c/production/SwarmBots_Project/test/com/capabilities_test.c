@@ -0,0 +1,111 @@
+/**
+ * \file  capabilities_test.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Test module for the capabilities negotiated with SB_IHM.
+ *
+ * \see ../../src/com/capabilities.c
+ * \see ../../src/com/capabilities.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+
+#include "../../src/com/capabilities.c"
+
+static int set_up(void **state) {
+    CAPABILITIES_reset();
+    return 0;
+}
+
+/**
+ * \fn static void test_CAPABILITIES_reset(void **state)
+ * \brief Unit test of reset with CMOCKA : a new SB_IHM is an older one until it tells otherwise.
+ * \author Prose A2
+ *
+ * \see ../../src/com/capabilities.c
+ */
+static void test_CAPABILITIES_reset(void **state) {
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_BATCH);
+
+    CAPABILITIES_reset();
+
+    assert_int_equal(PROTOCOL_VERSION_LEGACY, CAPABILITIES_get_peer_version());
+    assert_int_equal(0, CAPABILITIES_get_enabled());
+    assert_false(CAPABILITIES_is_enabled(CAPABILITY_BATCH));
+}
+/**
+ * \fn static void test_CAPABILITIES_negotiate(void **state)
+ * \brief Unit test of negotiate with CMOCKA : only the capabilities of both sides are enabled.
+ * \author Prose A2
+ *
+ * \see ../../src/com/capabilities.c
+ */
+static void test_CAPABILITIES_negotiate(void **state) {
+    uint32_t enabled = CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_BATCH | 0x80000000u);
+
+    assert_int_equal(CAPABILITY_BATCH, enabled);
+    assert_int_equal(CAPABILITY_BATCH, CAPABILITIES_get_enabled());
+    assert_int_equal(PROTOCOL_VERSION, CAPABILITIES_get_peer_version());
+    assert_true(CAPABILITIES_is_enabled(CAPABILITY_BATCH));
+    assert_false(CAPABILITIES_is_enabled(CAPABILITY_TELEOP_UDP));
+}
+/**
+ * \fn static void test_CAPABILITIES_negotiate_not_offered(void **state)
+ * \brief Unit test of negotiate with CMOCKA : a capability SB_C does not offer is never enabled.
+ * \author Prose A2
+ *
+ * \see ../../src/com/capabilities.c
+ */
+static void test_CAPABILITIES_negotiate_not_offered(void **state) {
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_COMPRESSION);
+
+    assert_int_equal(OFFERED_CAPABILITIES & CAPABILITY_COMPRESSION, CAPABILITIES_get_enabled());
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup(test_CAPABILITIES_reset, set_up),
+    cmocka_unit_test_setup(test_CAPABILITIES_negotiate, set_up),
+    cmocka_unit_test_setup(test_CAPABILITIES_negotiate_not_offered, set_up),
+};
+
+/**
+ * \fn int CAPABILITIES_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int CAPABILITIES_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module capabilities", tests, NULL, NULL);
+}
@@ -46,28 +46,28 @@
 #include "../../src/lib/defs.h"
 
 /**
- * \fn Communication_Protocol_Head __wrap_DISPATCHER_decode_message(uint8_t* raw_message)
+ * \fn Dispatcher_Message __wrap_DISPATCHER_decode_message(const uint8_t* raw_message, size_t raw_message_size)
  * \brief Mock function of decode_message.
  * \author Fatoumata TRAORE
  *
  * \see ../../src/com/dispatcher.c
  */
-Communication_Protocol_Head __wrap_DISPATCHER_decode_message(uint8_t* raw_message) {
+Dispatcher_Message __wrap_DISPATCHER_decode_message(const uint8_t* raw_message, size_t raw_message_size) {
     function_called();
     check_expected_ptr(raw_message);
-    Communication_Protocol_Head msg = {mock(),mock()};
+    Dispatcher_Message msg = {{mock(),mock()}, raw_message + 4, (uint16_t) (raw_message_size - 4)};
     return msg;
 }
 /**
- * \fn int __wrap_DISPATCHER_dispatch_received_msg(Communication_Protocol_Head msg)
+ * \fn int __wrap_DISPATCHER_dispatch_received_msg(const Dispatcher_Message * msg)
  * \brief Mock function of received_msg.
  * \author Fatoumata TRAORE
  *
  * \see ../../src/com/dispatcher.c
  */
-int __wrap_DISPATCHER_dispatch_received_msg(Communication_Protocol_Head msg) {
+int __wrap_DISPATCHER_dispatch_received_msg(const Dispatcher_Message * msg) {
     function_called();
-    check_expected(msg.msg_size);
-    check_expected(msg.msg_type);
+    check_expected(msg->head.msg_size);
+    check_expected(msg->head.msg_type);
     return (int)mock();
 }
@@ -39,31 +39,56 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
+#include <unistd.h>
 
 #include "cmocka.h"
 #include "../../src/com/dispatcher.c"
 
 /*
- * \var static uint8_t *fake_data_received = NULL
- * Global variable for memory allocation simulation.
+ * \def IDLE_WINDOW_S
+ * Length in seconds of the window during which the dispatcher waits for a connection.
  */
-static uint8_t *fake_data_received = NULL;
+#define IDLE_WINDOW_S 10
+/*
+ * \def IDLE_MAX_CPU_MS
+ * CPU time the dispatcher thread may use during the idle window, in milliseconds.
+ */
+#define IDLE_MAX_CPU_MS 10
+
+/*
+ * \def FAKE_PAYLOAD_SIZE
+ * Size of the payload given to the handlers.
+ */
+#define FAKE_PAYLOAD_SIZE 64
+
+/*
+ * \var static uint8_t fake_data_received[FAKE_PAYLOAD_SIZE]
+ * Payload of the messages dispatched by the tests.
+ */
+static uint8_t fake_data_received[FAKE_PAYLOAD_SIZE];
 
 static int set_up(void **state)
 {
-    fake_data_received = (uint8_t *) malloc(sizeof(uint8_t) * MAX_RECEIVED_BYTES);
-    if (fake_data_received == NULL) {
-        return -1;
-    }
+    memset(fake_data_received, 0, sizeof(fake_data_received));
     return 0;
 }
 
 static int tear_down(void **state) {
-
-    free(fake_data_received);
-    fake_data_received = NULL;
     return 0;
 }
+
+/*
+ * \fn static Dispatcher_Message DISPATCHER_TEST_message(Message_Type type, int16_t msg_size)
+ * Builds a message whose payload is fake_data_received.
+ */
+static Dispatcher_Message DISPATCHER_TEST_message(Message_Type type, int16_t msg_size) {
+    Dispatcher_Message msg;
+    msg.head.msg_type = type;
+    msg.head.msg_size = msg_size;
+    msg.payload = fake_data_received;
+    msg.payload_size = (uint16_t) (msg_size - 2);
+    return msg;
+}
 /**
  * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY(void **state)
  * \brief Unit test of dispatch_received_msg when we have a ASK_AVAILABILITY message type with CMOCKA.
@@ -72,8 +97,7 @@ static int tear_down(void **state) {
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = ASK_AVAILABILITY;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_AVAILABILITY, 2);
     int ret_mock = 0;
     int ret = 0;
 
@@ -81,9 +105,62 @@ static void test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY(void** state)
     expect_value(__wrap_CONTROLLER_RINGER_ask_availability, id_robot, ID_ROBOT);
     will_return(__wrap_CONTROLLER_RINGER_ask_availability, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY_capabilities(void **state)
+ * \brief Unit test of dispatch_received_msg when a ASK_AVAILABILITY gives the capabilities of SB_IHM : the ones
+ * SB_C has are enabled before the answer.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY_capabilities(void** state) {
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_AVAILABILITY, 2 + PROTOCOL_ASK_AVAILABILITY_SIZE);
+    PROTOCOL_put_ASK_AVAILABILITY_version(fake_data_received, PROTOCOL_VERSION);
+    PROTOCOL_put_ASK_AVAILABILITY_capabilities(fake_data_received, CAPABILITY_BATCH | 0x80000000u);
+    CAPABILITIES_reset();
+
+    expect_function_call(__wrap_CONTROLLER_RINGER_ask_availability);
+    expect_value(__wrap_CONTROLLER_RINGER_ask_availability, id_robot, ID_ROBOT);
+    will_return(__wrap_CONTROLLER_RINGER_ask_availability, 0);
+
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), 0);
+
+    assert_int_equal(CAPABILITIES_get_peer_version(), PROTOCOL_VERSION);
+    assert_int_equal(CAPABILITIES_get_enabled(), CAPABILITY_BATCH);
+    CAPABILITIES_reset();
+}
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY_legacy(void **state)
+ * \brief Unit test of dispatch_received_msg when a ASK_AVAILABILITY comes from a SB_IHM of the first version, without
+ * capabilities : it gets its answer, no capability is enabled and a batch it would send is not dispatched.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY_legacy(void** state) {
+    const uint8_t batch[] = {
+        0x00, 0x03, 0x00, 0x03, FORWARD, /* ASK_CMD */
+    };
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_AVAILABILITY, 2);
+    Dispatcher_Message dt_batch = DISPATCHER_TEST_message(ASK_BATCH, 2 + sizeof(batch));
+    dt_batch.payload = batch;
+    CAPABILITIES_reset();
+
+    expect_function_call(__wrap_CONTROLLER_RINGER_ask_availability);
+    expect_value(__wrap_CONTROLLER_RINGER_ask_availability, id_robot, ID_ROBOT);
+    will_return(__wrap_CONTROLLER_RINGER_ask_availability, 0);
+
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), 0);
+
+    assert_int_equal(CAPABILITIES_get_peer_version(), PROTOCOL_VERSION_LEGACY);
+    assert_int_equal(CAPABILITIES_get_enabled(), 0);
+
+    /* No call to __wrap_PILOT_ask_cmd is expected. */
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_batch), -1);
+}
 /**
  * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_CMD(void **state)
  * \brief Unit test of dispatch_received_msg when we have a ASK_CMD message type with CMOCKA.
@@ -92,18 +169,19 @@ static void test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY(void** state)
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_ASK_CMD(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = ASK_CMD;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_CMD, 3);
     int ret_mock = 0;
     int ret = 0;
-    data_received[0] = 1;
+    fake_data_received[0] = 1;
 
     Command dt_cmd = RIGHT;
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
     expect_function_call(__wrap_PILOT_ask_cmd);
-    expect_value(__wrap_PILOT_ask_cmd, cmd,(Command)data_received[0]);
+    expect_value(__wrap_PILOT_ask_cmd, cmd,(Command)fake_data_received[0]);
     will_return(__wrap_PILOT_ask_cmd, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
 /**
@@ -114,17 +192,18 @@ static void test_DISPATCHER_dispatch_received_msg_ASK_CMD(void** state) {
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_SET_STATE(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = SET_STATE;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(SET_STATE, 3);
     int ret_mock = 0;
     int ret = 0;
-    data_received[0] = 1;
+    fake_data_received[0] = 1;
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
     expect_function_call(__wrap_CONTROLLER_CORE_ask_set_state);
     expect_value(__wrap_CONTROLLER_CORE_ask_set_state, id_robot, ID_ROBOT);
-    expect_value(__wrap_CONTROLLER_CORE_ask_set_state, state, (State)data_received[0]);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_state, state, (State)fake_data_received[0]);
     will_return(__wrap_CONTROLLER_CORE_ask_set_state, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
 /**
@@ -135,8 +214,7 @@ static void test_DISPATCHER_dispatch_received_msg_SET_STATE(void** state) {
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_ASK_MODE(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = ASK_MODE;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_MODE, 2);
     int ret_mock = 0;
     int ret = 0;
 
@@ -144,7 +222,7 @@ static void test_DISPATCHER_dispatch_received_msg_ASK_MODE(void** state) {
     expect_value(__wrap_CONTROLLER_CORE_ask_mode, id_robot, ID_ROBOT);
     will_return(__wrap_CONTROLLER_CORE_ask_mode, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
 /**
@@ -155,24 +233,23 @@ static void test_DISPATCHER_dispatch_received_msg_ASK_MODE(void** state) {
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_SET_MODE(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = SET_MODE;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(SET_MODE, 6);
     int ret_mock = 0;
     int ret = 0;
-    data_received[0] = 1;
-    data_received[1] = 2;
-    data_received[2] = 3;
-    data_received[3] = 4;
+    fake_data_received[0] = 1;
+    fake_data_received[1] = 2;
+    fake_data_received[2] = 3;
+    fake_data_received[3] = 4;
 
     expect_function_call(__wrap_CONTROLLER_CORE_ask_set_mode);
     expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, id_robot, ID_ROBOT);
-    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.camera_mode, (Mode)data_received[0]);
-    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.radar_mode, (Mode)data_received[1]);
-    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.buzzer_mode, (Mode)data_received[2]);
-    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.leds_mode, (Mode)data_received[3]);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.camera_mode, (Mode)fake_data_received[0]);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.radar_mode, (Mode)fake_data_received[1]);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.buzzer_mode, (Mode)fake_data_received[2]);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.leds_mode, (Mode)fake_data_received[3]);
     will_return(__wrap_CONTROLLER_CORE_ask_set_mode, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
 /**
@@ -183,8 +260,7 @@ static void test_DISPATCHER_dispatch_received_msg_SET_MODE(void** state) {
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_ASK_LOGS(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = ASK_LOGS;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_LOGS, 2);
     int ret_mock = 0;
     int ret = 0;
 
@@ -192,19 +268,18 @@ static void test_DISPATCHER_dispatch_received_msg_ASK_LOGS(void** state) {
     expect_value(__wrap_CONTROLLER_LOGGER_ask_logs, id_robot, ID_ROBOT);
     will_return(__wrap_CONTROLLER_LOGGER_ask_logs, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
 /**
- * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_TO_DISCONNECT(void **state)
+ * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_TO_DISCONNECT(void **test_state)
  * \brief Unit test of dispatch_received_msg when we have a ASK_TO_DISCONNECT message type with CMOCKA.
  * \author Fatoumata TRAORE
  *
  * \see ../../src/com/dispatcher.c
  */
-static void test_DISPATCHER_dispatch_received_msg_ASK_TO_DISCONNECT(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = ASK_TO_DISCONNECT;
+static void test_DISPATCHER_dispatch_received_msg_ASK_TO_DISCONNECT(void** test_state) {
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_TO_DISCONNECT, 2);
     int ret_mock = 0;
     int ret = 0;
     State_Machine ret_state = S_WAITING_RECONNECTION;
@@ -213,8 +288,9 @@ static void test_DISPATCHER_dispatch_received_msg_ASK_TO_DISCONNECT(void** state
     expect_value(__wrap_CONTROLLER_CORE_ask_to_disconnect, id_robot, ID_ROBOT);
     will_return(__wrap_CONTROLLER_CORE_ask_to_disconnect, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
+    /* State of the dispatcher, not the one of the test. */
     assert_int_equal(state, ret_state);
 }
 /**
@@ -225,23 +301,49 @@ static void test_DISPATCHER_dispatch_received_msg_ASK_TO_DISCONNECT(void** state
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_SET_CURRENT_TIME(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = SET_CURRENT_TIME;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(SET_CURRENT_TIME, 9);
     int ret_mock = 0;
     int ret = 0;
-    data_received[1] = 22;
-    data_received[2] = 6;
-    data_received[3] = 12;
-    data_received[4] = 10;
-    data_received[5] = 30;
-    data_received[6] = 0;
+    fake_data_received[0] = 20;
+    fake_data_received[1] = 22;
+    fake_data_received[2] = 6;
+    fake_data_received[3] = 12;
+    fake_data_received[4] = 10;
+    fake_data_received[5] = 30;
+    fake_data_received[6] = 0;
+    /* 12/06/2022 10:30:00, in the local time of SB_C. */
+    struct tm rtc = {.tm_year = 122, .tm_mon = 5, .tm_mday = 12, .tm_hour = 10, .tm_min = 30, .tm_sec = 0, .tm_isdst = -1};
 
     expect_function_call(__wrap_CONTROLLER_LOGGER_ask_set_rtc);
     expect_value(__wrap_CONTROLLER_LOGGER_ask_set_rtc, id_robot, ID_ROBOT);
-    expect_value(__wrap_CONTROLLER_LOGGER_ask_set_rtc, rtc, 1678915800);
+    expect_value(__wrap_CONTROLLER_LOGGER_ask_set_rtc, rtc, mktime(&rtc));
     will_return(__wrap_CONTROLLER_LOGGER_ask_set_rtc, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
+    assert_int_equal(expected, ret);
+}
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_RESUME(void **state)
+ * \brief Unit test of dispatch_received_msg when we have a ASK_RESUME message type with CMOCKA.
+ * \author Prose A2
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_ASK_RESUME(void** state) {
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_RESUME, 6);
+    int ret_mock = 0;
+    int ret = 0;
+    fake_data_received[0] = 0xCA;
+    fake_data_received[1] = 0xFE;
+    fake_data_received[2] = 0x12;
+    fake_data_received[3] = 0x34;
+
+    expect_function_call(__wrap_CONTROLLER_CORE_ask_resume);
+    expect_value(__wrap_CONTROLLER_CORE_ask_resume, id_robot, ID_ROBOT);
+    expect_value(__wrap_CONTROLLER_CORE_ask_resume, session_token, 0xCAFE1234);
+    will_return(__wrap_CONTROLLER_CORE_ask_resume, ret_mock);
+
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
 /**
@@ -252,23 +354,21 @@ static void test_DISPATCHER_dispatch_received_msg_SET_CURRENT_TIME(void** state)
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_SET_IP_PORT(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = SET_IP_PORT;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(SET_IP_PORT, 7);
     int ret_mock = 0;
     int ret = 0;
-    data_received[0] = 192;
-    data_received[1] = 168;
-    data_received[2] = 0;
-    data_received[3] = 1;
-    data_received[4] = 10;
+    fake_data_received[0] = 192;
+    fake_data_received[1] = 168;
+    fake_data_received[2] = 0;
+    fake_data_received[3] = 1;
+    fake_data_received[4] = 10;
 
     expect_function_call(__wrap_CAMERA_set_up_ihm_info);
-    expect_value(__wrap_CAMERA_set_up_ihm_info, id_robot, ID_ROBOT);
     expect_string(__wrap_CAMERA_set_up_ihm_info, ip_address, "192.168.0.1");
     expect_value(__wrap_CAMERA_set_up_ihm_info, port, 10);
     will_return(__wrap_CAMERA_set_up_ihm_info, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
 /**
@@ -279,8 +379,7 @@ static void test_DISPATCHER_dispatch_received_msg_SET_IP_PORT(void** state) {
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_dispatch_received_msg_LOGS_RECEIVED(void** state) {
-    Communication_Protocol_Head dt_msg;
-    dt_msg.msg_type = LOGS_RECEIVED;
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(LOGS_RECEIVED, 2);
     int ret_mock = 0;
     int ret = 0;
 
@@ -288,9 +387,246 @@ static void test_DISPATCHER_dispatch_received_msg_LOGS_RECEIVED(void** state) {
     expect_value(__wrap_CONTROLLER_LOGGER_logs_saved, id_robot, ID_ROBOT);
     will_return(__wrap_CONTROLLER_LOGGER_logs_saved, ret_mock);
 
-    int expected = DISPATCHER_dispatch_received_msg(dt_msg);
+    int expected = DISPATCHER_dispatch_received_msg(&dt_msg);
     assert_int_equal(expected, ret);
 }
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_unknown_type(void **state)
+ * \brief Unit test of dispatch_received_msg with a type SB_IHM does not send : rejected and counted.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_unknown_type(void **state) {
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(SET_RADAR, 3);
+    Dispatcher_Stats stats;
+    memset(dispatcher_stats, 0, sizeof(dispatcher_stats));
+
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), 0);
+
+    assert_int_equal(DISPATCHER_get_stats(SET_RADAR, &stats), 0);
+    assert_int_equal(stats.messages, 1);
+    assert_int_equal(stats.bytes, 1);
+    assert_int_equal(stats.rejects, 1);
+}
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_payload_too_short(void **state)
+ * \brief Unit test of dispatch_received_msg with a SET_MODE missing modes : rejected without calling the handler.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_payload_too_short(void **state) {
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(SET_MODE, 2 + 3);
+    Dispatcher_Stats stats;
+    memset(dispatcher_stats, 0, sizeof(dispatcher_stats));
+
+    /* No call to __wrap_CONTROLLER_CORE_ask_set_mode is expected. */
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), 0);
+
+    assert_int_equal(DISPATCHER_get_stats(SET_MODE, &stats), 0);
+    assert_int_equal(stats.messages, 1);
+    assert_int_equal(stats.rejects, 1);
+}
+/**
+ * \fn static void test_DISPATCHER_get_stats(void **state)
+ * \brief Unit test of the statistics : counted for each type, a failure of the handler counts as a reject.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_get_stats(void **state) {
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_CMD, 3);
+    Dispatcher_Stats stats;
+    fake_data_received[0] = FORWARD;
+    memset(dispatcher_stats, 0, sizeof(dispatcher_stats));
+
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    expect_function_call(__wrap_PILOT_ask_cmd);
+    expect_value(__wrap_PILOT_ask_cmd, cmd, FORWARD);
+    will_return(__wrap_PILOT_ask_cmd, 0);
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    expect_function_call(__wrap_PILOT_ask_cmd);
+    expect_value(__wrap_PILOT_ask_cmd, cmd, FORWARD);
+    will_return(__wrap_PILOT_ask_cmd, -1);
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), 0);
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), -1);
+
+    assert_int_equal(DISPATCHER_get_stats(ASK_CMD, &stats), 0);
+    assert_int_equal(stats.messages, 2);
+    assert_int_equal(stats.bytes, 2);
+    assert_int_equal(stats.rejects, 1);
+    assert_int_equal(DISPATCHER_get_stats(ASK_MODE, &stats), 0);
+    assert_int_equal(stats.messages, 0);
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    assert_int_equal(DISPATCHER_get_stats(ASK_CMD, NULL), -1);
+}
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_BATCH(void **state)
+ * \brief Unit test of dispatch_received_msg with a batch of a SET_MODE, a SET_STATE and an ASK_CMD : each one
+ * reaches its handler and is counted under its own type.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_ASK_BATCH(void **state) {
+    const uint8_t batch[] = {
+        0x00, 0x06, 0x00, 0x06, 0x01, 0x00, 0x01, 0x00, /* SET_MODE */
+        0x00, 0x03, 0x00, 0x04, SELECTED,               /* SET_STATE */
+        0x00, 0x03, 0x03, 0x00, FORWARD,                /* ASK_CMD, head written by SB_C */
+    };
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_BATCH, 2 + sizeof(batch));
+    Dispatcher_Stats stats;
+    dt_msg.payload = batch;
+    memset(dispatcher_stats, 0, sizeof(dispatcher_stats));
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_BATCH);
+
+    expect_function_call(__wrap_CONTROLLER_CORE_ask_set_mode);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, id_robot, ID_ROBOT);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.camera_mode, ENABLED);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.radar_mode, DISABLED);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.buzzer_mode, ENABLED);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_mode, operating_mode.leds_mode, DISABLED);
+    will_return(__wrap_CONTROLLER_CORE_ask_set_mode, 0);
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    expect_function_call(__wrap_CONTROLLER_CORE_ask_set_state);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_state, id_robot, ID_ROBOT);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_state, state, SELECTED);
+    will_return(__wrap_CONTROLLER_CORE_ask_set_state, 0);
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    expect_function_call(__wrap_PILOT_ask_cmd);
+    expect_value(__wrap_PILOT_ask_cmd, cmd, FORWARD);
+    will_return(__wrap_PILOT_ask_cmd, 0);
+
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), 0);
+
+    assert_int_equal(DISPATCHER_get_stats(ASK_BATCH, &stats), 0);
+    assert_int_equal(stats.messages, 1);
+    assert_int_equal(stats.bytes, sizeof(batch));
+    assert_int_equal(stats.rejects, 0);
+    assert_int_equal(DISPATCHER_get_stats(SET_MODE, &stats), 0);
+    assert_int_equal(stats.messages, 1);
+    assert_int_equal(DISPATCHER_get_stats(SET_STATE, &stats), 0);
+    assert_int_equal(stats.messages, 1);
+    assert_int_equal(DISPATCHER_get_stats(ASK_CMD, &stats), 0);
+    assert_int_equal(stats.messages, 1);
+    CAPABILITIES_reset();
+}
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_BATCH_invalid(void **state)
+ * \brief Unit test of dispatch_received_msg with batches holding an invalid message : none of their messages is
+ * dispatched.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_ASK_BATCH_invalid(void **state) {
+    const uint8_t truncated[] = {
+        0x00, 0x03, 0x00, 0x03, FORWARD, /* ASK_CMD */
+        0x00, 0x06, 0x00, 0x06, 0x01,    /* SET_MODE cut by the end of the batch */
+    };
+    const uint8_t nested[] = {
+        0x00, 0x03, 0x00, 0x03, FORWARD,                          /* ASK_CMD */
+        0x00, 0x07, 0x00, 0x18, 0x00, 0x03, 0x00, 0x03, FORWARD,  /* ASK_BATCH */
+    };
+    const uint8_t unknown[] = {
+        0x00, 0x03, 0x00, 0x03, FORWARD, /* ASK_CMD */
+        0x00, 0x03, 0x00, 0x12, 0x01,    /* SET_RADAR, only sent by SB_C */
+    };
+    const uint8_t * batches[] = {truncated, nested, unknown};
+    const size_t batch_sizes[] = {sizeof(truncated), sizeof(nested), sizeof(unknown)};
+    Dispatcher_Stats stats;
+    memset(dispatcher_stats, 0, sizeof(dispatcher_stats));
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_BATCH);
+
+    /* No call to __wrap_PILOT_ask_cmd is expected. */
+    for(int i = 0; i < 3; i++) {
+        Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_BATCH, 2 + batch_sizes[i]);
+        dt_msg.payload = batches[i];
+        expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+        will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+        assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), -1);
+    }
+
+    assert_int_equal(DISPATCHER_get_stats(ASK_BATCH, &stats), 0);
+    assert_int_equal(stats.messages, 3);
+    assert_int_equal(stats.rejects, 3);
+    assert_int_equal(DISPATCHER_get_stats(ASK_CMD, &stats), 0);
+    assert_int_equal(stats.messages, 0);
+    CAPABILITIES_reset();
+}
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_BATCH_failure(void **state)
+ * \brief Unit test of dispatch_received_msg with a batch whose SET_STATE fails : the ASK_CMD following it is not
+ * dispatched.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_ASK_BATCH_failure(void **state) {
+    const uint8_t batch[] = {
+        0x00, 0x03, 0x00, 0x04, SELECTED, /* SET_STATE */
+        0x00, 0x03, 0x00, 0x03, FORWARD,  /* ASK_CMD */
+    };
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_BATCH, 2 + sizeof(batch));
+    Dispatcher_Stats stats;
+    dt_msg.payload = batch;
+    memset(dispatcher_stats, 0, sizeof(dispatcher_stats));
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_BATCH);
+
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    expect_function_call(__wrap_CONTROLLER_CORE_ask_set_state);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_state, id_robot, ID_ROBOT);
+    expect_value(__wrap_CONTROLLER_CORE_ask_set_state, state, SELECTED);
+    will_return(__wrap_CONTROLLER_CORE_ask_set_state, -1);
+    /* The failure of SET_STATE, then the one of the batch. No call to __wrap_PILOT_ask_cmd is expected. */
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), -1);
+
+    assert_int_equal(DISPATCHER_get_stats(SET_STATE, &stats), 0);
+    assert_int_equal(stats.messages, 1);
+    assert_int_equal(DISPATCHER_get_stats(ASK_CMD, &stats), 0);
+    assert_int_equal(stats.messages, 0);
+    CAPABILITIES_reset();
+}
+/**
+ * \fn static void test_DISPATCHER_dispatch_received_msg_ASK_BATCH_not_negotiated(void **state)
+ * \brief Unit test of dispatch_received_msg with a batch sent by a SB_IHM which has not negotiated the batches :
+ * none of its messages is dispatched.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_dispatch_received_msg_ASK_BATCH_not_negotiated(void **state) {
+    const uint8_t batch[] = {
+        0x00, 0x03, 0x00, 0x03, FORWARD, /* ASK_CMD */
+    };
+    Dispatcher_Message dt_msg = DISPATCHER_TEST_message(ASK_BATCH, 2 + sizeof(batch));
+    Dispatcher_Stats stats;
+    dt_msg.payload = batch;
+    memset(dispatcher_stats, 0, sizeof(dispatcher_stats));
+    CAPABILITIES_reset();
+
+    /* No call to __wrap_PILOT_ask_cmd is expected. */
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    assert_int_equal(DISPATCHER_dispatch_received_msg(&dt_msg), -1);
+
+    assert_int_equal(DISPATCHER_get_stats(ASK_BATCH, &stats), 0);
+    assert_int_equal(stats.rejects, 1);
+    assert_int_equal(DISPATCHER_get_stats(ASK_CMD, &stats), 0);
+    assert_int_equal(stats.messages, 0);
+}
 /**
  * \fn static void test_DISPATCHER_decode_message(void **state)
  * \brief Unit test of decode_message with CMOCKA.
@@ -299,15 +635,74 @@ static void test_DISPATCHER_dispatch_received_msg_LOGS_RECEIVED(void** state) {
  * \see ../../src/com/dispatcher.c
  */
 static void test_DISPATCHER_decode_message(void **state) {
-    uint8_t raw_message[] = {0x00, 0x05, 0x12, 0x34, 0x56, 0x78};
+    /* SB_IHM writes the identifier of the type in the second byte, SB_C in the first one. */
+    uint8_t raw_message[] = {0x00, 0x05, 0x00, 0x12, 0x56, 0x78, 0x9A};
+    uint8_t raw_message_sb_c[] = {0x00, 0x03, 0x12, 0x00, 0x01};
     Communication_Protocol_Head expected_msg;
     expected_msg.msg_size = 5;
-    expected_msg.msg_type = 0x1234;
+    expected_msg.msg_type = SET_RADAR;
+    /* The size and the type are logged for each message decoded. */
+    for(int i = 0; i < 4; i++) {
+        expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+        will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    }
+
+    Dispatcher_Message result_msg = DISPATCHER_decode_message(raw_message, sizeof(raw_message));
+
+    assert_int_equal(result_msg.head.msg_size, expected_msg.msg_size);
+    assert_int_equal(result_msg.head.msg_type, expected_msg.msg_type);
+    assert_ptr_equal(result_msg.payload, raw_message + 4);
+    assert_int_equal(result_msg.payload_size, 3);
+
+    result_msg = DISPATCHER_decode_message(raw_message_sb_c, sizeof(raw_message_sb_c));
+
+    assert_int_equal(result_msg.head.msg_size, 3);
+    assert_int_equal(result_msg.head.msg_type, SET_RADAR);
+}
+/**
+ * \fn static void test_DISPATCHER_decode_message_large(void **state)
+ * \brief Unit test of decode_message with a payload far bigger than a command : it is left in place, with its size.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_decode_message_large(void **state) {
+    uint8_t raw_message[4 + 300] = {0x01, 0x2E, 0x00, 0x03};
+    for(int i = 0; i < 4; i++) {
+        expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+        will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    }
+
+    Dispatcher_Message result_msg = DISPATCHER_decode_message(raw_message, sizeof(raw_message));
+
+    assert_int_equal(result_msg.head.msg_type, ASK_CMD);
+    assert_ptr_equal(result_msg.payload, raw_message + 4);
+    assert_int_equal(result_msg.payload_size, 300);
+
+    /* A size field bigger than what has been received does not let the handlers read past the frame. */
+    result_msg = DISPATCHER_decode_message(raw_message, 4 + 100);
+
+    assert_int_equal(result_msg.payload_size, 100);
+}
+/**
+ * \fn static void test_DISPATCHER_run_idle(void **state)
+ * \brief Unit test of the dispatcher thread waiting for a connection : it sleeps instead of spinning.
+ *
+ * \see ../../src/com/dispatcher.c
+ */
+static void test_DISPATCHER_run_idle(void **state) {
+    clockid_t thread_clock;
+    struct timespec cpu_time;
 
-    Communication_Protocol_Head result_msg = DISPATCHER_decode_message(raw_message);
+    assert_int_equal(DISPATCHER_start(), 0);
+    sleep(IDLE_WINDOW_S);
+    assert_int_equal(pthread_getcpuclockid(dispatcher_thread, &thread_clock), 0);
+    assert_int_equal(clock_gettime(thread_clock, &cpu_time), 0);
+    /* No connection was made : stopping does not involve the postman. The statistics are logged. */
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+    assert_int_equal(DISPATCHER_stop(), 0);
 
-    assert_int_equal(result_msg.msg_size, expected_msg.msg_size);
-    assert_int_equal(result_msg.msg_type, expected_msg.msg_type);
+    assert_true(cpu_time.tv_sec * 1000 + cpu_time.tv_nsec / 1000000 < IDLE_MAX_CPU_MS);
 }
 
 /**
@@ -316,6 +711,8 @@ static void test_DISPATCHER_decode_message(void **state) {
  */
 static const struct CMUnitTest tests[] = {
     cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY_capabilities),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_AVAILABILITY_legacy),
     cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_CMD),
     cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_SET_STATE),
     cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_MODE),
@@ -325,7 +722,17 @@ static const struct CMUnitTest tests[] = {
     cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_SET_CURRENT_TIME),
     cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_SET_IP_PORT),
     cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_LOGS_RECEIVED),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_RESUME),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_unknown_type),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_payload_too_short),
+    cmocka_unit_test(test_DISPATCHER_get_stats),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_BATCH),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_BATCH_invalid),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_BATCH_failure),
+    cmocka_unit_test(test_DISPATCHER_dispatch_received_msg_ASK_BATCH_not_negotiated),
     cmocka_unit_test(test_DISPATCHER_decode_message),
+    cmocka_unit_test(test_DISPATCHER_decode_message_large),
+    cmocka_unit_test(test_DISPATCHER_run_idle),
 };
 
 /**
@@ -0,0 +1,208 @@
+/**
+ * \file  frame_pool_test.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Test module for the frame pool.
+ *
+ * \see ../../src/com/frame_pool.c
+ * \see ../../src/com/frame_pool.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+
+#include "../../src/com/frame_pool.c"
+
+static int set_up(void **state) {
+    return FRAME_POOL_create();
+}
+
+static int tear_down(void **state) {
+    return FRAME_POOL_destroy();
+}
+
+/**
+ * \fn static void test_FRAME_POOL_new_frame(void **state)
+ * \brief Unit test of new_frame with CMOCKA : the size and type fields are written in place.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_pool.c
+ */
+static void test_FRAME_POOL_new_frame(void **state) {
+    uint8_t expected_head[FRAME_POOL_HEAD_SIZE] = {0x00, 0x06, 0x06, 0x00};
+    Frame_Pool_Stats stats;
+
+    uint8_t * frame = FRAME_POOL_new_frame(SET_MODE, 4);
+
+    assert_non_null(frame);
+    assert_memory_equal(frame, expected_head, sizeof(expected_head));
+    FRAME_POOL_get_stats(&stats);
+    assert_int_equal(1, stats.hits);
+    assert_int_equal(1, stats.in_use);
+
+    FRAME_POOL_release(frame);
+
+    FRAME_POOL_get_stats(&stats);
+    assert_int_equal(0, stats.in_use);
+}
+/**
+ * \fn static void test_FRAME_POOL_release(void **state)
+ * \brief Unit test of release with CMOCKA : a released slot is lent again.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_pool.c
+ */
+static void test_FRAME_POOL_release(void **state) {
+    uint8_t * frame = FRAME_POOL_new_frame(SET_AVAILABILITY, 0);
+    FRAME_POOL_release(frame);
+
+    uint8_t * next_frame = FRAME_POOL_new_frame(SET_RADAR, 1);
+
+    assert_ptr_equal(frame, next_frame);
+    FRAME_POOL_release(next_frame);
+}
+/**
+ * \fn static void test_FRAME_POOL_retain(void **state)
+ * \brief Unit test of retain with CMOCKA : the frame goes back to the pool with its last reference.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_pool.c
+ */
+static void test_FRAME_POOL_retain(void **state) {
+    Frame_Pool_Stats stats;
+    uint8_t * frame = FRAME_POOL_new_frame(SET_RADAR, 1);
+
+    FRAME_POOL_retain(frame);
+    FRAME_POOL_release(frame);
+
+    FRAME_POOL_get_stats(&stats);
+    assert_int_equal(1, stats.in_use);
+
+    FRAME_POOL_release(frame);
+
+    FRAME_POOL_get_stats(&stats);
+    assert_int_equal(0, stats.in_use);
+}
+/**
+ * \fn static void test_FRAME_POOL_miss(void **state)
+ * \brief Unit test of new_frame with CMOCKA : a bigger class lends the frame when the fitting one is empty.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_pool.c
+ */
+static void test_FRAME_POOL_miss(void **state) {
+    uint8_t * frames[CONFIG_FRAME_POOL_SMALL_FRAMES];
+    Frame_Pool_Stats stats;
+    for(int i = 0; i < CONFIG_FRAME_POOL_SMALL_FRAMES; i++) {
+        frames[i] = FRAME_POOL_new_frame(SET_AVAILABILITY, 0);
+    }
+
+    uint8_t * frame = FRAME_POOL_new_frame(SET_AVAILABILITY, 0);
+
+    assert_non_null(frame);
+    FRAME_POOL_get_stats(&stats);
+    assert_int_equal(CONFIG_FRAME_POOL_SMALL_FRAMES, stats.hits);
+    assert_int_equal(1, stats.misses);
+    assert_int_equal(0, stats.exhaustions);
+
+    FRAME_POOL_release(frame);
+    for(int i = 0; i < CONFIG_FRAME_POOL_SMALL_FRAMES; i++) {
+        FRAME_POOL_release(frames[i]);
+    }
+}
+/**
+ * \fn static void test_FRAME_POOL_exhaustion(void **state)
+ * \brief Unit test of new_frame with CMOCKA : the frame is allocated on the heap when the pool is exhausted.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_pool.c
+ */
+static void test_FRAME_POOL_exhaustion(void **state) {
+    uint8_t * frames[CONFIG_FRAME_POOL_LARGE_FRAMES];
+    Frame_Pool_Stats stats;
+    for(int i = 0; i < CONFIG_FRAME_POOL_LARGE_FRAMES; i++) {
+        frames[i] = FRAME_POOL_new_frame(SET_LOGS, FRAME_POOL_MAX_PAYLOAD);
+    }
+
+    uint8_t * frame = FRAME_POOL_new_frame(SET_LOGS, FRAME_POOL_MAX_PAYLOAD);
+
+    assert_non_null(frame);
+    assert_int_equal(0xFF, frame[0]);
+    assert_int_equal(0xFF, frame[1]);
+    FRAME_POOL_get_stats(&stats);
+    assert_int_equal(CONFIG_FRAME_POOL_LARGE_FRAMES, stats.hits);
+    assert_int_equal(1, stats.exhaustions);
+    assert_int_equal(CONFIG_FRAME_POOL_LARGE_FRAMES + 1, stats.in_use);
+
+    FRAME_POOL_release(frame);
+    for(int i = 0; i < CONFIG_FRAME_POOL_LARGE_FRAMES; i++) {
+        FRAME_POOL_release(frames[i]);
+    }
+    FRAME_POOL_get_stats(&stats);
+    assert_int_equal(0, stats.in_use);
+}
+/**
+ * \fn static void test_FRAME_POOL_new_frame_too_big(void **state)
+ * \brief Unit test of new_frame with CMOCKA : a payload bigger than the protocol allows is refused.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_pool.c
+ */
+static void test_FRAME_POOL_new_frame_too_big(void **state) {
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+
+    uint8_t * frame = FRAME_POOL_new_frame(SET_LOGS, FRAME_POOL_MAX_PAYLOAD + 1);
+
+    assert_null(frame);
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_FRAME_POOL_new_frame, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_POOL_release, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_POOL_retain, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_POOL_miss, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_POOL_exhaustion, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_POOL_new_frame_too_big, set_up, tear_down),
+};
+
+/**
+ * \fn int FRAME_POOL_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int FRAME_POOL_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module frame_pool", tests, NULL, NULL);
+}
@@ -0,0 +1,179 @@
+/**
+ * \file  frame_reader_test.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Test module for the frame reader.
+ *
+ * \see ../../src/com/frame_reader.c
+ * \see ../../src/com/frame_reader.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include "cmocka.h"
+
+#include "../../src/com/frame_reader.c"
+
+/**
+ * \var static Frame_Reader reader
+ * Receive buffer under test.
+ */
+static Frame_Reader reader;
+/**
+ * \var static int sockets
+ * Both ends of the connection : the test writes on sockets[1], the reader receives on sockets[0].
+ */
+static int sockets[2];
+
+static int set_up(void **state) {
+    FRAME_READER_reset(&reader);
+    return socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+}
+
+static int tear_down(void **state) {
+    close(sockets[0]);
+    close(sockets[1]);
+    return 0;
+}
+
+/**
+ * \fn static void test_FRAME_READER_next_empty(void **state)
+ * \brief Unit test of next with CMOCKA : no frame is given before anything has been received.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_reader.c
+ */
+static void test_FRAME_READER_next_empty(void **state) {
+    const uint8_t * frame = NULL;
+
+    assert_int_equal(0, FRAME_READER_next(&reader, &frame));
+    assert_null(frame);
+}
+/**
+ * \fn static void test_FRAME_READER_pipelined_frames(void **state)
+ * \brief Unit test of fill and next with CMOCKA : a single recv() gives every pipelined frame, in place.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_reader.c
+ */
+static void test_FRAME_READER_pipelined_frames(void **state) {
+    uint8_t stream[] = {0x00, 0x02, 0x00, 0x01,              /* ASK_AVAILABILITY */
+                        0x00, 0x03, 0x00, 0x03, 0x02,        /* ASK_CMD */
+                        0x00, 0x02, 0x00, 0x05};             /* ASK_MODE */
+    const uint8_t * frame;
+    write(sockets[1], stream, sizeof(stream));
+
+    assert_int_equal(sizeof(stream), FRAME_READER_fill(&reader, sockets[0]));
+
+    assert_int_equal(4, FRAME_READER_next(&reader, &frame));
+    assert_ptr_equal(reader.buffer, frame);
+    assert_int_equal(5, FRAME_READER_next(&reader, &frame));
+    assert_memory_equal(stream + 4, frame, 5);
+    assert_int_equal(4, FRAME_READER_next(&reader, &frame));
+    assert_memory_equal(stream + 9, frame, 4);
+    assert_int_equal(0, FRAME_READER_next(&reader, &frame));
+}
+/**
+ * \fn static void test_FRAME_READER_fragmented_frame(void **state)
+ * \brief Unit test of fill and next with CMOCKA : a frame received byte after byte is given once complete.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_reader.c
+ */
+static void test_FRAME_READER_fragmented_frame(void **state) {
+    uint8_t stream[] = {0x00, 0x06, 0x00, 0x06, 0x01, 0x00, 0x01, 0x00}; /* SET_MODE */
+    const uint8_t * frame;
+    for(size_t i = 0; i < sizeof(stream) - 1; i++) {
+        write(sockets[1], stream + i, 1);
+        assert_int_equal(1, FRAME_READER_fill(&reader, sockets[0]));
+        assert_int_equal(0, FRAME_READER_next(&reader, &frame));
+    }
+    write(sockets[1], stream + sizeof(stream) - 1, 1);
+    FRAME_READER_fill(&reader, sockets[0]);
+
+    assert_int_equal(sizeof(stream), FRAME_READER_next(&reader, &frame));
+    assert_memory_equal(stream, frame, sizeof(stream));
+}
+/**
+ * \fn static void test_FRAME_READER_fill_keeps_partial_frame(void **state)
+ * \brief Unit test of fill with CMOCKA : the beginning of a frame is moved to the front of the buffer.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_reader.c
+ */
+static void test_FRAME_READER_fill_keeps_partial_frame(void **state) {
+    uint8_t stream[] = {0x00, 0x02, 0x00, 0x01, 0x00, 0x03, 0x00, 0x03, 0x04};
+    const uint8_t * frame;
+    write(sockets[1], stream, 6);
+    FRAME_READER_fill(&reader, sockets[0]);
+    assert_int_equal(4, FRAME_READER_next(&reader, &frame));
+    assert_int_equal(0, FRAME_READER_next(&reader, &frame));
+
+    write(sockets[1], stream + 6, 3);
+    FRAME_READER_fill(&reader, sockets[0]);
+
+    assert_int_equal(5, FRAME_READER_next(&reader, &frame));
+    assert_ptr_equal(reader.buffer, frame);
+    assert_memory_equal(stream + 4, frame, 5);
+}
+/**
+ * \fn static void test_FRAME_READER_fill_end_of_stream(void **state)
+ * \brief Unit test of fill with CMOCKA : the end of the stream is reported.
+ * \author Prose A2
+ *
+ * \see ../../src/com/frame_reader.c
+ */
+static void test_FRAME_READER_fill_end_of_stream(void **state) {
+    shutdown(sockets[1], SHUT_WR);
+
+    assert_int_equal(0, FRAME_READER_fill(&reader, sockets[0]));
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_FRAME_READER_next_empty, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_READER_pipelined_frames, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_READER_fragmented_frame, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_READER_fill_keeps_partial_frame, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_FRAME_READER_fill_end_of_stream, set_up, tear_down),
+};
+
+/**
+ * \fn int FRAME_READER_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int FRAME_READER_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module frame_reader", tests, NULL, NULL);
+}
@@ -98,7 +98,18 @@ int __wrap_GUI_SECRETARY_PROXY_set_radar(Id_Robot id_robot, bool_e radar) {
 
     return (int) mock();
 }
+/**
+ * \fn int __wrap_GUI_SECRETARY_PROXY_set_session(Id_Robot id_robot, uint32_t session_token, bool_e is_resumed)
+ * \brief Mock function of set_session.
+ * \author Prose A2
+ *
+ * \see ../../src/com/gui_secretary_proxy.c
+ */
+int __wrap_GUI_SECRETARY_PROXY_set_session(Id_Robot id_robot, uint32_t session_token, bool_e is_resumed) {
+    function_called();
 
+    check_expected(session_token);
+    check_expected(is_resumed);
 
-
-
+    return (int) mock();
+}
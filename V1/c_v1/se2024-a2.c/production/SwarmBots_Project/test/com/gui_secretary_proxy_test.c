@@ -64,15 +64,11 @@ static void test_GUI_SECRETARY_PROXY_set_mode(void **state) {
     expected_mode.radar_mode = ENABLED;
     expected_mode.buzzer_mode = ENABLED;
     expected_mode.leds_mode = ENABLED;
-    Communication_Protocol_Head expected_msg;
-    expected_msg.msg_size = htons(0x0006);
-    expected_msg.msg_type = htons(SET_MODE);
-    uint8_t expected_data[6] = {0x00, 0x01, 0x01, 0x00, 0x00, 0x00};
+    uint8_t expected_data[8] = {0x00, 0x06, 0x06, 0x00, 0x01, 0x01, 0x01, 0x01};
 
     expect_function_call(__wrap_POSTMAN_send_request);
-    expect_memory(__wrap_POSTMAN_send_request, data, &expected_msg, 4);
-    //expect_memory(__wrap_POSTMAN_send_request, data + 4, expected_data, 6);
-    will_return(__wrap___wrap_POSTMAN_send_request,0);
+    expect_memory(__wrap_POSTMAN_send_request, data, expected_data, sizeof(expected_data));
+    will_return(__wrap_POSTMAN_send_request, 0);
 
     int result = GUI_SECRETARY_PROXY_set_mode(ID_ROBOT, expected_mode);
 
@@ -86,14 +82,11 @@ static void test_GUI_SECRETARY_PROXY_set_mode(void **state) {
  * \see ../../src/com/gui_secretary_proxy.c
  */
 static void test_GUI_SECRETARY_PROXY_disconnected_ok(void **state) {
-        Communication_Protocol_Head expected_msg;
-        expected_msg.msg_size = htons(0x0002);
-        expected_msg.msg_type = htons(ACK_DISCONNECTION);
-        uint8_t expected_data[6] = {0x00, 0x02, 0x00, 0x04};
+        uint8_t expected_data[4] = {0x00, 0x02, 0x11, 0x00};
 
         expect_function_call(__wrap_POSTMAN_send_request);
         expect_memory(__wrap_POSTMAN_send_request, data, expected_data, sizeof(expected_data));
-        will_return(__wrap___wrap_POSTMAN_send_request,0);
+        will_return(__wrap_POSTMAN_send_request, 0);
 
         int expected = GUI_SECRETARY_PROXY_disconnected_ok(ID_ROBOT);
 
@@ -108,20 +101,36 @@ static void test_GUI_SECRETARY_PROXY_disconnected_ok(void **state) {
  */
 static void test_GUI_SECRETARY_PROXY_set_radar(void **state) {
     // Set up test data
-    Communication_Protocol_Head expected_msg;
-    expected_msg.msg_size = htons(0x0003);
-    expected_msg.msg_type = htons(SET_RADAR);
-    uint8_t expected_data[6] = {0x00, 0x03, 0x00, 0x05, 0x01};
+    uint8_t expected_data[5] = {0x00, 0x03, 0x12, 0x00, 0x01};
 
     expect_function_call(__wrap_POSTMAN_send_request);
     expect_memory(__wrap_POSTMAN_send_request, data, expected_data, sizeof(expected_data));
-    will_return(__wrap___wrap_POSTMAN_send_request,0);
+    will_return(__wrap_POSTMAN_send_request, 0);
     int result = GUI_SECRETARY_PROXY_set_radar(ID_ROBOT, TRUE);
 
     // Check the result and mock function calls
     assert_int_equal(result, 0);
 }   
 
+/**
+ * \fn static void test_GUI_SECRETARY_PROXY_set_session(void **state)
+ * \brief Unit test of set_session with CMOCKA.
+ * \author Prose A2
+ *
+ * \see ../../src/com/gui_secretary_proxy.c
+ */
+static void test_GUI_SECRETARY_PROXY_set_session(void **state) {
+    uint8_t expected_data[9] = {0x00, 0x07, 0x16, 0x00, 0xCA, 0xFE, 0x12, 0x34, 0x01};
+
+    expect_function_call(__wrap_POSTMAN_send_request);
+    expect_memory(__wrap_POSTMAN_send_request, data, expected_data, sizeof(expected_data));
+    will_return(__wrap_POSTMAN_send_request, 0);
+
+    int result = GUI_SECRETARY_PROXY_set_session(ID_ROBOT, 0xCAFE1234, TRUE);
+
+    assert_int_equal(result, 0);
+}
+
 /**
  * \struct CMUnitTest
  * \brief Lists the test suite for the module
@@ -129,8 +138,9 @@ static void test_GUI_SECRETARY_PROXY_set_radar(void **state) {
 static const struct CMUnitTest tests[] = {
 
         cmocka_unit_test(test_GUI_SECRETARY_PROXY_set_mode),
-        //cmocka_unit_test(test_GUI_SECRETARY_PROXY_disconnected_ok),
-        //cmocka_unit_test(test_GUI_SECRETARY_PROXY_set_radar),
+        cmocka_unit_test(test_GUI_SECRETARY_PROXY_set_session),
+        cmocka_unit_test(test_GUI_SECRETARY_PROXY_disconnected_ok),
+        cmocka_unit_test(test_GUI_SECRETARY_PROXY_set_radar),
 
 };
 
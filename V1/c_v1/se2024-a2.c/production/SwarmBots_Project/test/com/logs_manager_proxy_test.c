@@ -40,6 +40,7 @@
 #include <stddef.h>
 #include <setjmp.h>
 #include "cmocka.h"
+#include <stdio.h>
 
 #include "../../src/com/logs_manager_proxy.c"
 
@@ -59,22 +60,174 @@ static int tear_down(void **state) {
  * \see ../../src/com/logs_manager_proxy.c
  */
 static void test_LOGS_MANAGER_PROXY_set_logs(void **state) {
-    uint8_t log_list[] = {0x00, 0x04, 0x01, 0x02, 0x03, 0x04};
-    uint8_t expected_data [8];
-    Communication_Protocol_Head msg_to_send;
-    msg_to_send.msg_size = htons(0x0006);
-    msg_to_send.msg_type = htons(SET_MODE);
+    uint8_t logs[] = {0x01, 0x02, 0x03, 0x04};
+    uint8_t expected_data[10] = {0x00, 0x08, 0x08, 0x00, 0x01, 0x01, 0x01, 0x02, 0x03, 0x04};
+    CAPABILITIES_reset();
 
     expect_function_call(__wrap_POSTMAN_send_request);
-    expect_memory_count(__wrap_POSTMAN_send_request, data, expected_data,8,1);
+    expect_memory_count(__wrap_POSTMAN_send_request, data, expected_data,10,1);
     will_return(__wrap_POSTMAN_send_request,0);
 
     // Perform the function call
-    int result = LOGS_MANAGER_PROXY_set_logs(log_list);
+    int result = LOGS_MANAGER_PROXY_set_logs(1, 1, logs, sizeof(logs));
 
     // Check the result and mock function calls
     assert_int_equal(result, 0);
-    free(log_list);
+}
+
+/**
+ * \fn static void test_LOGS_MANAGER_PROXY_stream_logs(void **state)
+ * \brief Unit test of stream_logs with CMOCKA : the logs are read from the file one page per call.
+ * \author Prose A2
+ *
+ * \see ../../src/com/logs_manager_proxy.c
+ */
+static void test_LOGS_MANAGER_PROXY_stream_logs(void **state) {
+    uint32_t logs_size = LOGS_MANAGER_PROXY_MAX_PAGE_SIZE + 3;
+    FILE * logs = tmpfile();
+    assert_non_null(logs);
+    for(uint32_t i = 0; i < logs_size; i++) {
+        fputc('a' + (i % 26), logs);
+    }
+    fflush(logs);
+    CAPABILITIES_reset();
+
+    expect_function_call(__wrap_POSTMAN_stream);
+    expect_value(__wrap_POSTMAN_stream, next_page, &LOGS_MANAGER_PROXY_next_page);
+    will_return(__wrap_POSTMAN_stream, 0);
+
+    assert_int_equal(LOGS_MANAGER_PROXY_stream_logs(dup(fileno(logs)), logs_size), 0);
+    fclose(logs);
+
+    uint8_t * first_page = LOGS_MANAGER_PROXY_next_page(FALSE);
+    assert_non_null(first_page);
+    assert_int_equal(first_page[FRAME_POOL_HEAD_SIZE], 1);
+    assert_int_equal(first_page[FRAME_POOL_HEAD_SIZE + 1], 2);
+    assert_int_equal(first_page[FRAME_POOL_HEAD_SIZE + 2], 'a');
+    FRAME_POOL_release(first_page);
+
+    uint8_t * last_page = LOGS_MANAGER_PROXY_next_page(FALSE);
+    uint8_t expected_data[] = {0x00, 0x07, 0x08, 0x00, 0x02, 0x02, 'l', 'm', 'n'};
+    assert_non_null(last_page);
+    assert_memory_equal(last_page, expected_data, sizeof(expected_data));
+    FRAME_POOL_release(last_page);
+
+    assert_null(LOGS_MANAGER_PROXY_next_page(FALSE));
+    assert_int_equal(stream_file, -1);
+}
+
+/**
+ * \fn static void test_LOGS_MANAGER_PROXY_stream_logs_compressed(void **state)
+ * \brief Unit test of stream_logs with CMOCKA : with CAPABILITY_COMPRESSION, each page is an LZ4 block decoded on its
+ * own.
+ * \author Prose A2
+ *
+ * \see ../../src/com/logs_manager_proxy.c
+ */
+static void test_LOGS_MANAGER_PROXY_stream_logs_compressed(void **state) {
+    static const char line[] = "INFO : Mon Jan  8 10:42:00 2024 - Postman has established a connection\n";
+    uint32_t logs_size = LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE + 3;
+    FILE * logs = tmpfile();
+    assert_non_null(logs);
+    for(uint32_t i = 0; i < logs_size; i++) {
+        fputc(line[i % (sizeof(line) - 1)], logs);
+    }
+    fflush(logs);
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_COMPRESSION);
+
+    expect_function_call(__wrap_POSTMAN_stream);
+    expect_value(__wrap_POSTMAN_stream, next_page, &LOGS_MANAGER_PROXY_next_page);
+    will_return(__wrap_POSTMAN_stream, 0);
+
+    assert_int_equal(LOGS_MANAGER_PROXY_stream_logs(dup(fileno(logs)), logs_size), 0);
+    fclose(logs);
+
+    static uint8_t page_logs[LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE];
+    uint8_t * first_page = LOGS_MANAGER_PROXY_next_page(FALSE);
+    assert_non_null(first_page);
+    uint16_t first_page_size = PROTOCOL_get_U16(first_page) - 2;
+    assert_in_range(first_page_size, 1, LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE / 4);
+    const uint8_t * payload = first_page + FRAME_POOL_HEAD_SIZE;
+    assert_int_equal(PROTOCOL_get_SET_LOGS_page(payload), 1);
+    assert_int_equal(PROTOCOL_get_SET_LOGS_max_page(payload), 2);
+    assert_int_equal(payload[PROTOCOL_SET_LOGS_SIZE], LOGS_ENCODING_LZ4);
+    int decoded_size = LZ4_BLOCK_decompress(payload + PROTOCOL_SET_LOGS_SIZE + ENCODING_SIZE,
+                                            first_page_size - PROTOCOL_SET_LOGS_SIZE - ENCODING_SIZE, page_logs, sizeof(page_logs));
+    assert_int_equal(decoded_size, LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE);
+    assert_memory_equal(page_logs, line, sizeof(line) - 1);
+    FRAME_POOL_release(first_page);
+
+    /* Too short to get smaller : the last page is sent as it is. */
+    uint8_t * last_page = LOGS_MANAGER_PROXY_next_page(FALSE);
+    assert_non_null(last_page);
+    size_t last_offset = LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE % (sizeof(line) - 1);
+    uint8_t expected_data[] = {0x00, 0x08, 0x08, 0x00, 0x02, 0x02, LOGS_ENCODING_RAW,
+                               line[last_offset], line[last_offset + 1], line[last_offset + 2]};
+    assert_memory_equal(last_page, expected_data, sizeof(expected_data));
+    FRAME_POOL_release(last_page);
+
+    assert_null(LOGS_MANAGER_PROXY_next_page(FALSE));
+    CAPABILITIES_reset();
+}
+
+/**
+ * \fn static void test_LOGS_MANAGER_PROXY_stream_logs_incompressible(void **state)
+ * \brief Unit test of stream_logs with CMOCKA : with CAPABILITY_COMPRESSION, the encoding is chosen for each page. A
+ * page LZ4 does not make smaller is sent as it is, the next one is still compressed.
+ * \author Prose A2
+ *
+ * \see ../../src/com/logs_manager_proxy.c
+ */
+static void test_LOGS_MANAGER_PROXY_stream_logs_incompressible(void **state) {
+    uint32_t logs_size = LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE + 256;
+    uint32_t random = 0x12345678;
+    FILE * logs = tmpfile();
+    assert_non_null(logs);
+    /* A first page of noise, then a page of a single repeated byte. */
+    for(uint32_t i = 0; i < LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE; i++) {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        fputc((int) (random & 0xFF), logs);
+    }
+    for(uint32_t i = LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE; i < logs_size; i++) {
+        fputc('=', logs);
+    }
+    fflush(logs);
+    CAPABILITIES_negotiate(PROTOCOL_VERSION, CAPABILITY_COMPRESSION);
+
+    expect_function_call(__wrap_POSTMAN_stream);
+    expect_value(__wrap_POSTMAN_stream, next_page, &LOGS_MANAGER_PROXY_next_page);
+    will_return(__wrap_POSTMAN_stream, 0);
+
+    assert_int_equal(LOGS_MANAGER_PROXY_stream_logs(dup(fileno(logs)), logs_size), 0);
+
+    static uint8_t page_logs[LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE];
+    uint8_t * first_page = LOGS_MANAGER_PROXY_next_page(FALSE);
+    assert_non_null(first_page);
+    const uint8_t * payload = first_page + FRAME_POOL_HEAD_SIZE;
+    assert_int_equal(PROTOCOL_get_U16(first_page) - 2, PROTOCOL_SET_LOGS_SIZE + ENCODING_SIZE + LOGS_MANAGER_PROXY_MAX_ENCODED_PAGE_SIZE);
+    assert_int_equal(payload[PROTOCOL_SET_LOGS_SIZE], LOGS_ENCODING_RAW);
+    assert_int_equal(pread(fileno(logs), page_logs, sizeof(page_logs), 0), sizeof(page_logs));
+    assert_memory_equal(payload + PROTOCOL_SET_LOGS_SIZE + ENCODING_SIZE, page_logs, sizeof(page_logs));
+    FRAME_POOL_release(first_page);
+    fclose(logs);
+
+    uint8_t * last_page = LOGS_MANAGER_PROXY_next_page(FALSE);
+    assert_non_null(last_page);
+    uint16_t last_page_size = PROTOCOL_get_U16(last_page) - 2;
+    assert_in_range(last_page_size, PROTOCOL_SET_LOGS_SIZE + ENCODING_SIZE + 1, PROTOCOL_SET_LOGS_SIZE + ENCODING_SIZE + 255);
+    payload = last_page + FRAME_POOL_HEAD_SIZE;
+    assert_int_equal(payload[PROTOCOL_SET_LOGS_SIZE], LOGS_ENCODING_LZ4);
+    int decoded_size = LZ4_BLOCK_decompress(payload + PROTOCOL_SET_LOGS_SIZE + ENCODING_SIZE,
+                                            last_page_size - PROTOCOL_SET_LOGS_SIZE - ENCODING_SIZE, page_logs, sizeof(page_logs));
+    assert_int_equal(decoded_size, 256);
+    assert_int_equal(page_logs[0], '=');
+    assert_int_equal(page_logs[255], '=');
+    FRAME_POOL_release(last_page);
+
+    assert_null(LOGS_MANAGER_PROXY_next_page(FALSE));
+    CAPABILITIES_reset();
 }
 
 /**
@@ -83,6 +236,9 @@ static void test_LOGS_MANAGER_PROXY_set_logs(void **state) {
  */
 static const struct CMUnitTest tests[] = {
 	    cmocka_unit_test(test_LOGS_MANAGER_PROXY_set_logs),
+	    cmocka_unit_test(test_LOGS_MANAGER_PROXY_stream_logs),
+	    cmocka_unit_test(test_LOGS_MANAGER_PROXY_stream_logs_compressed),
+	    cmocka_unit_test(test_LOGS_MANAGER_PROXY_stream_logs_incompressible),
 };
 
 /**
@@ -58,16 +58,17 @@ int __wrap_POSTMAN_disconnect(void) {
     return (int) mock();
 }
 /**
- * \fn uint8_t* __wrap_POSTMAN_read_request(void)
+ * \fn int __wrap_POSTMAN_read_request(const uint8_t ** frame)
  * \brief Mock function of read_request.
  * \author Fatoumata TRAORE
  *
  * \see ../../src/com/postman.c
  */
-uint8_t* __wrap_POSTMAN_read_request(void) {
+int __wrap_POSTMAN_read_request(const uint8_t ** frame) {
     function_called();
 
-    return (uint8_t*)mock();
+    *frame = mock_ptr_type(const uint8_t *);
+    return (int) mock();
 }
 
 /**
@@ -84,3 +85,18 @@ int __wrap_POSTMAN_send_request(uint8_t * data) {
 
     return (int) mock();
 }
+
+/**
+ * \fn int __wrap_POSTMAN_stream(Postman_Page_Source next_page)
+ * \brief Mock function of stream.
+ * \author Prose A2
+ *
+ * \see ../../src/com/postman.c
+ */
+int __wrap_POSTMAN_stream(Postman_Page_Source next_page) {
+    function_called();
+
+    check_expected_ptr(next_page);
+
+    return (int) mock();
+}
@@ -3,7 +3,7 @@
  * \version  0.1
  * \author Joshua MONTREUIL
  * \date May 3, 2023
- * \brief This file is just used for compilation purpose.
+ * \brief Test module for the postman.
  *
  * \see ../../src/com/postman.c
  * \see ../../src/com/postman.h
@@ -37,4 +37,92 @@
  */
 
 /* ----------------------  INCLUDES  ---------------------------------------- */
-#include "../../src/com/postman.c"
\ No newline at end of file
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+
+#include "../../src/com/postman.c"
+
+/*
+ * \var static int peer_socket
+ * End of the operator connection kept by the test, in place of SB_IHM.
+ */
+static int peer_socket = -1;
+
+static int set_up(void **state) {
+    int sockets[2];
+    if(FRAME_POOL_create() == -1 || socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == -1) {
+        return -1;
+    }
+    epoll_fd = epoll_create1(0);
+    /* The operator slot as POSTMAN_accept() leaves it, the listening socket already watched. */
+    memset(&connections[OPERATOR_SLOT], 0, sizeof(Connection));
+    connections[OPERATOR_SLOT].socket = sockets[0];
+    peer_socket = sockets[1];
+    is_listening = TRUE;
+    return 0;
+}
+
+static int tear_down(void **state) {
+    POSTMAN_close_connection(OPERATOR_SLOT);
+    POSTMAN_hand_socket(-1);
+    close(peer_socket);
+    close(epoll_fd);
+    epoll_fd = -1;
+    is_listening = FALSE;
+    return FRAME_POOL_destroy();
+}
+
+/**
+ * \fn static void test_POSTMAN_action_disconnection_after_ack(void **state)
+ * \brief Unit test of action_disconnection with CMOCKA : the ACK_DISCONNECTION requested in the same round is written
+ * before the operator socket is closed.
+ * \author Prose A2
+ *
+ * \see ../../src/com/postman.c
+ */
+static void test_POSTMAN_action_disconnection_after_ack(void **state) {
+    uint8_t expected_data[4] = {0x00, 0x02, 0x11, 0x00};
+    uint8_t received_data[sizeof(expected_data) + 1];
+    Postman_Lane_Stats stats_before, stats_after;
+    POSTMAN_get_lane_stats(LANE_CONTROL, &stats_before);
+
+    Mq_Msg_Data ack = {.event = E_WRITE_REQUEST, .data = FRAME_POOL_new_frame(ACK_DISCONNECTION, 0)};
+    assert_non_null(ack.data);
+    ack.lane = POSTMAN_get_lane(ack.data);
+    assert_int_equal(POSTMAN_enter_lane(ack.lane, TRUE), 0);
+    ack.request_time = POSTMAN_now_us();
+    Mq_Msg_Data disconnection = {.event = E_DISCONNECTION};
+
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
+
+    /* Both requests taken from the mail box in one round : no flush of the round in between. */
+    assert_int_equal(POSTMAN_action_send_msg(&ack), 0);
+    assert_int_equal(POSTMAN_action_disconnection(&disconnection), 0);
+
+    assert_int_equal(connections[OPERATOR_SLOT].socket, -1);
+    assert_int_equal(recv(peer_socket, received_data, sizeof(received_data), MSG_WAITALL), sizeof(expected_data));
+    assert_memory_equal(received_data, expected_data, sizeof(expected_data));
+    POSTMAN_get_lane_stats(LANE_CONTROL, &stats_after);
+    assert_int_equal(stats_after.written - stats_before.written, 1);
+    assert_int_equal(stats_after.dropped - stats_before.dropped, 0);
+    assert_int_equal(stats_after.depth, stats_before.depth);
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_POSTMAN_action_disconnection_after_ack, set_up, tear_down),
+};
+
+/**
+ * \fn int POSTMAN_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int POSTMAN_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module postman", tests, NULL, NULL);
+}
\ No newline at end of file
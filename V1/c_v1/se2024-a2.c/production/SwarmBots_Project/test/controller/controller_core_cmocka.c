@@ -156,6 +156,21 @@ int __wrap_CONTROLLER_CORE_ask_set_state(Id_Robot id_robot, State state) {
 
     return (int) mock();
 }
+/**
+ * \fn int __wrap_CONTROLLER_CORE_ask_resume(Id_Robot id_robot, uint32_t session_token)
+ * \brief Mock function of ask_resume.
+ * \author Prose A2
+ *
+ * \see ../../src/controller/controller_core.c
+ */
+int __wrap_CONTROLLER_CORE_ask_resume(Id_Robot id_robot, uint32_t session_token) {
+    function_called();
+
+    check_expected(id_robot);
+    check_expected(session_token);
+
+    return (int) mock();
+}
 /**
  * \fn int __wrap_CONTROLLER_CORE_ask_mode(Id_Robot id_robot)
  * \brief Mock function of ask_mode.
@@ -354,6 +354,11 @@ static void test_CONTROLLER_CORE_action_connection(void **state) {
     expect_value(__wrap_STATE_INDICATOR_set_state, state, expected_robot_state);
     will_return(__wrap_STATE_INDICATOR_set_state, mock_ret);
 
+    expect_function_call(__wrap_GUI_SECRETARY_PROXY_set_session);
+    expect_not_value(__wrap_GUI_SECRETARY_PROXY_set_session, session_token, 0);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_session, is_resumed, FALSE);
+    will_return(__wrap_GUI_SECRETARY_PROXY_set_session, mock_ret);
+
     fct_return = CONTROLLER_CORE_action_connection(&dt_action_param);
 
     assert_int_equal(expected_ret,fct_return);
@@ -508,6 +513,9 @@ static void test_CONTROLLER_CORE_action_disconnect_ok(void **state) {
 
     Command expected_cmd = STOP;
     State expected_robot_state = WAITING_FOR_CONNECTION;
+
+    expect_function_call(__wrap_watchdog_cancel);
+    expect_value(__wrap_watchdog_cancel, watchdog, controller_core_grace_watchdog);
     
     expect_function_call(__wrap_GUI_SECRETARY_PROXY_disconnected_ok);
     expect_value(__wrap_GUI_SECRETARY_PROXY_disconnected_ok, id_robot, dt_id_robot);
@@ -562,10 +570,9 @@ static void test_CONTROLLER_CORE_action_disconnect(void **state) {
     expect_value(__wrap_PILOT_ask_cmd, cmd, expected_cmd);
     will_return(__wrap_PILOT_ask_cmd, mock_ret);
 
-    expect_function_call(__wrap_CAMERA_disconnect_camera);
-    will_return(__wrap_CAMERA_disconnect_camera, mock_ret);
-
-    /* Those two following functions are in the code but not in the design document */
+    /* The camera is kept for the grace period */
+    expect_function_call(__wrap_watchdog_start);
+    expect_value(__wrap_watchdog_start, watchdog, controller_core_grace_watchdog);
 
     expect_function_call(__wrap_CONTROLLER_LOGGER_log);
     will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
@@ -574,8 +581,131 @@ static void test_CONTROLLER_CORE_action_disconnect(void **state) {
     expect_value(__wrap_STATE_INDICATOR_set_state, state, expected_robot_state);
     will_return(__wrap_STATE_INDICATOR_set_state, mock_ret);
 
+    session_token = 0x1234;
+    robot_state = SELECTED;
+
     fct_return = CONTROLLER_CORE_action_disconnect(&dt_action_param);
 
+    assert_int_equal(expected_return,fct_return);
+    assert_int_equal(0x1234,lost_session_token);
+    assert_int_equal(SELECTED,lost_robot_state);
+}
+/**
+ * \fn static void test_CONTROLLER_CORE_action_resume(void **state)
+ * \brief Unit test of action_resume with CMOCKA : the right token restores the state and gives the mode.
+ * \author Prose A2
+ *
+ * \see ../../src/controller/controller_core.c
+ */
+static void test_CONTROLLER_CORE_action_resume(void **state) {
+    int mock_ret = 0;
+    int expected_return = 0, fct_return;
+    Action_Param_Data dt_action_param = {ID_ROBOT, 0, {0, 0, 0, 0}, 0x1234};
+
+    lost_session_token = 0x1234;
+    lost_robot_state = SELECTED;
+    session_token = 0x5678;
+    robot_state = NOT_SELECTED;
+
+    expect_function_call(__wrap_watchdog_cancel);
+    expect_value(__wrap_watchdog_cancel, watchdog, controller_core_grace_watchdog);
+
+    expect_function_call(__wrap_STATE_INDICATOR_set_state);
+    expect_value(__wrap_STATE_INDICATOR_set_state, state, SELECTED);
+    will_return(__wrap_STATE_INDICATOR_set_state, mock_ret);
+
+    expect_function_call(__wrap_GUI_SECRETARY_PROXY_set_session);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_session, session_token, 0x5678);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_session, is_resumed, TRUE);
+    will_return(__wrap_GUI_SECRETARY_PROXY_set_session, mock_ret);
+
+    expect_function_call(__wrap_GUI_SECRETARY_PROXY_set_mode);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_mode, id_robot, ID_ROBOT);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_mode, operating_mode.camera_mode, robot_operating_mode.camera_mode);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_mode, operating_mode.radar_mode, robot_operating_mode.radar_mode);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_mode, operating_mode.buzzer_mode, robot_operating_mode.buzzer_mode);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_mode, operating_mode.leds_mode, robot_operating_mode.leds_mode);
+    will_return(__wrap_GUI_SECRETARY_PROXY_set_mode, mock_ret);
+
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
+
+    fct_return = CONTROLLER_CORE_action_resume(&dt_action_param);
+
+    assert_int_equal(expected_return,fct_return);
+    assert_int_equal(SELECTED,robot_state);
+    assert_int_equal(0,lost_session_token);
+}
+/**
+ * \fn static void test_CONTROLLER_CORE_action_resume_refused(void **state)
+ * \brief Unit test of action_resume with CMOCKA : a wrong token keeps the new session.
+ * \author Prose A2
+ *
+ * \see ../../src/controller/controller_core.c
+ */
+static void test_CONTROLLER_CORE_action_resume_refused(void **state) {
+    int mock_ret = 0;
+    int expected_return = 0, fct_return;
+    Action_Param_Data dt_action_param = {ID_ROBOT, 0, {0, 0, 0, 0}, 0x4321};
+
+    lost_session_token = 0x1234;
+    session_token = 0x5678;
+    robot_state = NOT_SELECTED;
+
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
+
+    expect_function_call(__wrap_GUI_SECRETARY_PROXY_set_session);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_session, session_token, 0x5678);
+    expect_value(__wrap_GUI_SECRETARY_PROXY_set_session, is_resumed, FALSE);
+    will_return(__wrap_GUI_SECRETARY_PROXY_set_session, mock_ret);
+
+    fct_return = CONTROLLER_CORE_action_resume(&dt_action_param);
+
+    assert_int_equal(expected_return,fct_return);
+    assert_int_equal(NOT_SELECTED,robot_state);
+    assert_int_equal(0x1234,lost_session_token);
+}
+/**
+ * \fn static void test_CONTROLLER_CORE_action_end_session(void **state)
+ * \brief Unit test of action_end_session with CMOCKA.
+ * \author Prose A2
+ *
+ * \see ../../src/controller/controller_core.c
+ */
+static void test_CONTROLLER_CORE_action_end_session(void **state) {
+    int mock_ret = 0;
+    int expected_return = 0, fct_return;
+    Action_Param_Data dt_action_param = {0, 0, {0, 0, 0, 0}};
+
+    lost_session_token = 0x1234;
+
+    expect_function_call(__wrap_CAMERA_disconnect_camera);
+    will_return(__wrap_CAMERA_disconnect_camera, mock_ret);
+
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
+
+    fct_return = CONTROLLER_CORE_action_end_session(&dt_action_param);
+
+    assert_int_equal(expected_return,fct_return);
+    assert_int_equal(0,lost_session_token);
+}
+/**
+ * \fn static void test_CONTROLLER_CORE_action_sleep_servo_motor(void **state)
+ * \brief Unit test of action_sleep_servo_motor with CMOCKA.
+ * \author Prose A2
+ *
+ * \see ../../src/controller/controller_core.c
+ */
+static void test_CONTROLLER_CORE_action_sleep_servo_motor(void **state) {
+    int expected_return = 0, fct_return;
+    Action_Param_Data dt_action_param = {0, 0, {0, 0, 0, 0}};
+
+    expect_function_call(__wrap_SERVO_MOTOR_disable_servo_motor);
+
+    fct_return = CONTROLLER_CORE_action_sleep_servo_motor(&dt_action_param);
+
     assert_int_equal(expected_return,fct_return);
 }
 /**
@@ -774,6 +904,10 @@ static const struct CMUnitTest tests[] =
     cmocka_unit_test(test_CONTROLLER_CORE_action_disconnect_ok),
     cmocka_unit_test(test_CONTROLLER_CORE_action_disconnect),
     cmocka_unit_test(test_CONTROLLER_CORE_action_init),
+    cmocka_unit_test(test_CONTROLLER_CORE_action_resume),
+    cmocka_unit_test(test_CONTROLLER_CORE_action_resume_refused),
+    cmocka_unit_test(test_CONTROLLER_CORE_action_end_session),
+    cmocka_unit_test(test_CONTROLLER_CORE_action_sleep_servo_motor),
 
 #endif
 };
@@ -376,20 +376,17 @@ static void test_CONTROLLER_RINGER_can_still_fail_pings(void **state) {
  * \see ../../src/controller/controller_ringer.c
  */
 static void test_CONTROLLER_RINGER_ping_time_out(void **state) {
-    int mock_ret = 0;
+    mq_msg received_msg;
     event_e expected_event = E_TIME_OUT_PING;
 
-    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
-    will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
+    assert_int_equal(0, CONTROLLER_RINGER_create());
 
-#ifdef _WRAP_MQ_CONTROLLER_RINGER_MOCKERY_CMOCKA
-    expect_function_call(__wrap_CONTROLLER_RINGER_add_msg_to_queue);
-    will_return(__wrap_CONTROLLER_RINGER_add_msg_to_queue, mock_ret);
-#endif
+    watchdog_expire(controller_ringer_ping_watchdog);
 
-    CONTROLLER_RINGER_ping_time_out(controller_ringer_ping_watchdog);
+    assert_int_equal(1, MAILBOX_try_receive(ACTOR_get_mailbox(controller_ringer_actor), &received_msg));
+    assert_int_equal(expected_event, received_msg.data.event);
 
-    assert_int_equal(expected_event,mq_msg_test->data.event);
+    assert_int_equal(0, CONTROLLER_RINGER_destroy());
 }
 
 /**
@@ -77,6 +77,12 @@ int __wrap_PILOT_action_check_radar(mq_msg * msg) {
     return (int) mock();
 }
 
+/**
+ * \def FLOOD_CMD_NB
+ * Amount of commands asked while the pilot is busy.
+ */
+#define FLOOD_CMD_NB 1000
+
 static int set_up(void **state) {
 	return 0;
 }
@@ -254,9 +260,6 @@ static void test_PILOT_action_check_radar(void **state) {
     expect_function_call(__wrap_CONTROLLER_LOGGER_log);
     will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
 
-    expect_function_call(__wrap_watchdog_start);
-    expect_value(__wrap_watchdog_start, watchdog, pilot_radar_check_watchdog);
-
     fct_return = PILOT_action_check_radar(&expected_msg);
 
     assert_int_equal(expected_obstacle_state,obstacle_state);
@@ -276,8 +279,26 @@ static void test_PILOT_action_check_radar(void **state) {
     will_return(__wrap_RADAR_get_radar, expected_radar);
     will_return(__wrap_RADAR_get_radar,mock_ret);
 
-    expect_function_call(__wrap_watchdog_start);
-    expect_value(__wrap_watchdog_start, watchdog, pilot_radar_check_watchdog);
+    fct_return = PILOT_action_check_radar(&expected_msg);
+
+    assert_int_equal(expected_obstacle_state,obstacle_state);
+    assert_int_equal(expected_return,fct_return);
+
+    mock_ret = -1; /* < radar failure : logged, the state is kept and the sampling goes on */
+    expected_radar = TRUE;
+
+    expect_function_call(__wrap_CONTROLLER_CORE_get_mode);
+    will_return(__wrap_CONTROLLER_CORE_get_mode, ENABLED);
+    will_return(__wrap_CONTROLLER_CORE_get_mode, ENABLED);
+    will_return(__wrap_CONTROLLER_CORE_get_mode, ENABLED);
+    will_return(__wrap_CONTROLLER_CORE_get_mode, ENABLED);
+
+    expect_function_call(__wrap_RADAR_get_radar);
+    will_return(__wrap_RADAR_get_radar, expected_radar);
+    will_return(__wrap_RADAR_get_radar,mock_ret);
+
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, 0);
 
     fct_return = PILOT_action_check_radar(&expected_msg);
 
@@ -372,18 +393,95 @@ static void test_PILOT_action_stop(void **state) {
  * \see ../../src/controller/pilot.c
  */
 static void test_PILOT_check_radar_time_out(void **state) {
-    int mock_ret = 0;
-    mq_msg expected_msg = {.data.event = 0, .data.cmd = 0};
+    mq_msg radar_msg = {.data.event = E_TIME_OUT_RADAR};
+    mq_msg received_msg;
     event_e expected_event = E_TIME_OUT_RADAR;
 
+    pilot_actor = ACTOR_create(&pilot_descriptor);
+    assert_non_null(pilot_actor);
+    pilot_radar_check_watchdog = watchdog_create_event(OBSTACLE_REFRESH_PERIOD_CHECK, pilot_actor, &radar_msg);
+    assert_non_null(pilot_radar_check_watchdog);
+
+    /* The time out is a message in the mailbox of the pilot, handled by its own thread. */
+    watchdog_expire(pilot_radar_check_watchdog);
+
+    assert_int_equal(1, MAILBOX_try_receive(ACTOR_get_mailbox(pilot_actor), &received_msg));
+    assert_int_equal(expected_event, received_msg.data.event);
+
+    watchdog_destroy(pilot_radar_check_watchdog);
+    ACTOR_destroy(pilot_actor);
+}
+/**
+ * \fn static void test_PILOT_ask_cmd_flood(void **state)
+ * \brief Unit test of ask_cmd with CMOCKA : commands flooded while the pilot is busy replace each other, only
+ * the most recent one reaches the motors.
+ * \author Prose A2
+ *
+ * \see ../../src/controller/pilot.c
+ */
+static void test_PILOT_ask_cmd_flood(void **state) {
+    int mock_ret = 0;
+    mq_msg msg = {.data.event = E_ASK_CMD, .data.cmd = STOP};
+    cmd_register = (cmd_register_t) {.cmd = STOP, .sequence = 0, .taken_sequence = 0, .is_notified = FALSE};
+
+    /* Only the first command notifies the pilot. */
 #ifdef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
     expect_function_call(__wrap_PILOT_add_msg_to_queue);
     will_return(__wrap_PILOT_add_msg_to_queue, mock_ret);
 #endif
+    for(int i = 0; i < FLOOD_CMD_NB / 2; i++) {
+        assert_int_equal(0, PILOT_ask_cmd((Command) (i % STOP)));
+    }
 
-    PILOT_check_radar_time_out(pilot_radar_check_watchdog);
+    /* The pilot takes the last one : E_ASK_CMD in S_IDLE. */
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
+#ifdef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
+    expect_function_call(__wrap_PILOT_add_msg_to_queue);
+    will_return(__wrap_PILOT_add_msg_to_queue, mock_ret);
+#endif
+    assert_int_equal(0, PILOT_action_evaluate_cmd(&msg));
+    assert_int_equal((FLOOD_CMD_NB / 2 - 1) % STOP, msg.data.cmd);
+    assert_int_equal(E_GO_IDLE, msg.data.event);
 
-    assert_int_equal(expected_event,mq_msg_test->data.event);
+    /* Commands still come while the pilot is in S_CHOICE : none of them is queued. */
+    for(int i = FLOOD_CMD_NB / 2; i < FLOOD_CMD_NB; i++) {
+        assert_int_equal(0, PILOT_ask_cmd((Command) (i % STOP)));
+    }
+
+    /* E_GO_IDLE in S_CHOICE : the pilot is notified again once the motors are set. */
+    expect_function_call(__wrap_MOTOR_set_velocity);
+    expect_value(__wrap_MOTOR_set_velocity, cmd, (FLOOD_CMD_NB / 2 - 1) % STOP);
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
+#ifdef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
+    expect_function_call(__wrap_PILOT_add_msg_to_queue);
+    will_return(__wrap_PILOT_add_msg_to_queue, mock_ret);
+#endif
+    assert_int_equal(0, PILOT_action_move_robot(&msg));
+
+    /* E_ASK_CMD in S_IDLE then E_GO_IDLE in S_CHOICE : the last command flooded is applied. */
+    msg.data.event = E_ASK_CMD;
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
+#ifdef _WRAP_STATIC_FUNCTIONS_MOCKERY_CMOCKA
+    expect_function_call(__wrap_PILOT_add_msg_to_queue);
+    will_return(__wrap_PILOT_add_msg_to_queue, mock_ret);
+#endif
+    assert_int_equal(0, PILOT_action_evaluate_cmd(&msg));
+    assert_int_equal((FLOOD_CMD_NB - 1) % STOP, msg.data.cmd);
+
+    expect_function_call(__wrap_MOTOR_set_velocity);
+    expect_value(__wrap_MOTOR_set_velocity, cmd, (FLOOD_CMD_NB - 1) % STOP);
+    expect_function_call(__wrap_CONTROLLER_LOGGER_log);
+    will_return(__wrap_CONTROLLER_LOGGER_log, mock_ret);
+    assert_int_equal(0, PILOT_action_move_robot(&msg));
+
+    /* Two applications for the whole flood, and nothing left to apply. */
+    assert_int_equal(FLOOD_CMD_NB, cmd_register.sequence);
+    assert_int_equal(FLOOD_CMD_NB, cmd_register.taken_sequence);
+    assert_false(cmd_register.is_notified);
+    assert_false(PILOT_take_cmd(&msg.data.cmd));
 }
 
 /**
@@ -404,6 +502,7 @@ static const struct CMUnitTest tests[] = {
     cmocka_unit_test(test_PILOT_action_evaluate_cmd),
     cmocka_unit_test(test_PILOT_action_nop),
     cmocka_unit_test(test_PILOT_ask_cmd),
+    cmocka_unit_test(test_PILOT_ask_cmd_flood),
 #endif
 };
 
@@ -647,15 +647,22 @@ static void test_STATE_INDICATOR_action_stop(void **state) {
  * \see ../../src/controller/state_indicator.c
  */
 static void test_STATE_INDICATOR_emergency_time_out(void **state) {
-    int mock_ret = 0;
+    mq_msg emergency_msg = {.data.event = E_TIME_OUT_EMERGENCY, 0};
+    mq_msg received_msg;
     event_e expected_event = E_TIME_OUT_EMERGENCY;
 
-    expect_function_call(__wrap_STATE_INDICATOR_add_msg_to_queue);
-    will_return(__wrap_STATE_INDICATOR_add_msg_to_queue, mock_ret);
+    state_indicator_actor = ACTOR_create(&state_indicator_descriptor);
+    assert_non_null(state_indicator_actor);
+    state_indicator_emergency_watchdog = watchdog_create_event(EMERGENCY_TIME_OUT, state_indicator_actor, &emergency_msg);
+    assert_non_null(state_indicator_emergency_watchdog);
+
+    watchdog_expire(state_indicator_emergency_watchdog);
 
-    STATE_INDICATOR_emergency_time_out(state_indicator_emergency_watchdog);
+    assert_int_equal(1, MAILBOX_try_receive(ACTOR_get_mailbox(state_indicator_actor), &received_msg));
+    assert_int_equal(expected_event, received_msg.data.event);
 
-    assert_int_equal(expected_event,mq_msg_test->data.event);
+    watchdog_destroy(state_indicator_emergency_watchdog);
+    ACTOR_destroy(state_indicator_actor);
 }
 /**
  * \fn static void test_STATE_INDICATOR_action_nop(void **state)
@@ -0,0 +1,371 @@
+/**
+ * \file  actor_test.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Test module for the runtime of the actors.
+ *
+ * \see ../../src/lib/actor.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+
+/* A single worker, as on a single core : a worker waiting for room must hire another one. */
+#define CONFIG_ACTOR_POOL_WORKERS 1
+#include "../../src/lib/actor.c"
+
+/**
+ * \def TICKS_NB
+ * Ticks sent to the actor run by the workers in test_ACTOR_pool.
+ */
+#define TICKS_NB 5000
+/**
+ * \def FLOOD_NB
+ * Ticks sent by an action to the small mailbox of the sink in test_ACTOR_pool_full.
+ */
+#define FLOOD_NB 32
+
+/**
+ * \enum Test_State
+ * \brief States of the actor of the tests.
+ */
+typedef enum {
+    S_TEST_FORGET = ACTOR_FORGET,
+    S_TEST_IDLE,
+    S_TEST_RUNNING,
+    S_TEST_DEATH,
+    S_TEST_NB,
+} Test_State;
+
+/**
+ * \enum Test_Event
+ * \brief Events of the actor of the tests.
+ */
+typedef enum {
+    E_TEST_GO = 0,
+    E_TEST_TICK,
+    E_TEST_STOP,
+    E_TEST_FLOOD,
+    E_TEST_NB,
+} Test_Event;
+
+/**
+ * \enum Test_Action
+ * \brief Actions of the actor of the tests.
+ */
+typedef enum {
+    A_TEST_NOP = 0,
+    A_TEST_INIT,
+    A_TEST_COUNT,
+    A_TEST_RAISE,
+    A_TEST_FAIL,
+    A_TEST_FLOOD,
+} Test_Action;
+
+/**
+ * \struct Test_Msg
+ * \brief Message of the tests : the event is not the first field, as in the messages of the postman.
+ */
+typedef struct {
+    int value;
+    Test_Event event;
+} Test_Msg;
+
+/**
+ * \var static const Actor_Transition test_state_machine[S_TEST_NB - 1][E_TEST_NB]
+ * \brief State machine of the actor of the tests.
+ */
+static const Actor_Transition test_state_machine[S_TEST_NB - 1][E_TEST_NB] = {
+    [S_TEST_IDLE][E_TEST_GO] = {S_TEST_RUNNING, A_TEST_RAISE},
+    [S_TEST_IDLE][E_TEST_STOP] = {S_TEST_DEATH, A_TEST_NOP},
+    [S_TEST_RUNNING][E_TEST_TICK] = {S_TEST_RUNNING, A_TEST_COUNT},
+    [S_TEST_RUNNING][E_TEST_GO] = {S_TEST_RUNNING, A_TEST_FAIL},
+    [S_TEST_RUNNING][E_TEST_STOP] = {S_TEST_DEATH, A_TEST_NOP},
+    [S_TEST_RUNNING][E_TEST_FLOOD] = {S_TEST_RUNNING, A_TEST_FLOOD},
+};
+
+/**
+ * \var static int test_sum
+ * \brief Sum of the values of the ticks counted.
+ */
+static int test_sum;
+
+/**
+ * \var static int test_init_nb
+ * \brief Times the initial action was performed.
+ */
+static int test_init_nb;
+
+/**
+ * \var static int test_last
+ * \brief Value of the last tick counted.
+ */
+static int test_last;
+
+/**
+ * \var static int test_disorders
+ * \brief Ticks counted after a tick of a greater value.
+ */
+static int test_disorders;
+
+/**
+ * \var static Actor * test_actor
+ * \brief Actor of the tests.
+ */
+static Actor * test_actor;
+
+/**
+ * \var static Actor * test_sink
+ * \brief Actor with a small mailbox, flooded by test_actor.
+ */
+static Actor * test_sink;
+
+static int ACTOR_TEST_perform(int action, void * msg) {
+    Test_Msg * test_msg = (Test_Msg *) msg;
+    switch(action) {
+        case A_TEST_INIT :
+            test_init_nb++;
+            return 0;
+        case A_TEST_COUNT :
+            test_disorders += test_msg->value < test_last;
+            test_last = test_msg->value;
+            test_sum += test_msg->value;
+            return 0;
+        case A_TEST_RAISE :
+            /* The tick raised is counted before any message of the mailbox. */
+            return ACTOR_raise(test_actor, &(Test_Msg) {.value = 0, .event = E_TEST_TICK});
+        case A_TEST_FAIL :
+            return -1;
+        case A_TEST_FLOOD :
+            for(int value = 1; value <= FLOOD_NB; value++) {
+                if(ACTOR_send(test_sink, &(Test_Msg) {.value = value, .event = E_TEST_TICK}, 0) == -1) {
+                    return -1;
+                }
+            }
+            return 0;
+        default :
+            return 0;
+    }
+}
+
+/**
+ * \var static const Actor_Descriptor test_descriptor
+ * \brief Descriptor of the actor of the tests.
+ */
+static const Actor_Descriptor test_descriptor = {
+    .name = "actor_test",
+    .mailbox_name = "/actor_test",
+    .msg_size = sizeof(Test_Msg),
+    .msg_count = 8,
+    .priorities_nb = 1,
+    .mailbox_kind = MAILBOX_RING,
+    .state_machine = &test_state_machine[0][0],
+    .states_nb = S_TEST_NB,
+    .events_nb = E_TEST_NB,
+    .event_offset = offsetof(Test_Msg, event),
+    .initial_state = S_TEST_IDLE,
+    .initial_action = A_TEST_INIT,
+    .perform = ACTOR_TEST_perform,
+    .run = NULL,
+    .is_logged = FALSE,
+};
+
+/**
+ * \var static const Actor_Descriptor test_sink_descriptor
+ * \brief Descriptor of the sink of the tests.
+ */
+static const Actor_Descriptor test_sink_descriptor = {
+    .name = "actor_test_sink",
+    .mailbox_name = "/actor_test_sink",
+    .msg_size = sizeof(Test_Msg),
+    .msg_count = 2,
+    .priorities_nb = 1,
+    .mailbox_kind = MAILBOX_RING,
+    .state_machine = &test_state_machine[0][0],
+    .states_nb = S_TEST_NB,
+    .events_nb = E_TEST_NB,
+    .event_offset = offsetof(Test_Msg, event),
+    .initial_state = S_TEST_RUNNING,
+    .initial_action = A_TEST_NOP,
+    .perform = ACTOR_TEST_perform,
+    .run = NULL,
+    .is_logged = FALSE,
+};
+
+static int set_up(void **state) {
+    test_sum = 0;
+    test_init_nb = 0;
+    test_last = -1;
+    test_disorders = 0;
+    test_actor = ACTOR_create(&test_descriptor);
+    return test_actor == NULL ? -1 : 0;
+}
+
+static int tear_down(void **state) {
+    return ACTOR_destroy(test_actor);
+}
+
+/**
+ * \fn static void test_ACTOR_handle(void **state)
+ * \brief Unit test of ACTOR_handle() with CMOCKA : the raised event is handled with the message raising it, the events
+ * without transition are forgotten, and both are measured.
+ *
+ * \see ../../src/lib/actor.c
+ */
+static void test_ACTOR_handle(void **state) {
+    Test_Msg msg = {.value = 1, .event = E_TEST_TICK};
+    assert_int_equal(ACTOR_handle(test_actor, &msg), 0);
+    assert_int_equal(ACTOR_get_state(test_actor), S_TEST_IDLE);
+    assert_int_equal(test_sum, 0);
+
+    msg.event = E_TEST_GO;
+    assert_int_equal(ACTOR_handle(test_actor, &msg), 0);
+    assert_int_equal(ACTOR_get_state(test_actor), S_TEST_RUNNING);
+    assert_int_equal(test_last, 0);
+
+    msg = (Test_Msg) {.value = 2, .event = E_TEST_TICK};
+    assert_int_equal(ACTOR_handle(test_actor, &msg), 0);
+    assert_int_equal(test_sum, 2);
+
+    msg.event = E_TEST_NB;
+    assert_int_equal(ACTOR_handle(test_actor, &msg), 0);
+    msg.event = E_TEST_GO;
+    assert_int_equal(ACTOR_handle(test_actor, &msg), -1);
+    assert_int_equal(ACTOR_get_state(test_actor), S_TEST_RUNNING);
+    assert_false(ACTOR_is_dead(test_actor));
+
+    Actor_Metrics metrics;
+    assert_int_equal(ACTOR_get_metrics("actor_test", &metrics), 0);
+    assert_int_equal(metrics.state, S_TEST_RUNNING);
+    assert_int_equal(metrics.events, 6);
+    assert_int_equal(metrics.forgotten, 2);
+    assert_true(metrics.action_time >= metrics.action_time_max);
+    assert_int_equal(ACTOR_get_metrics("unknown", &metrics), -1);
+}
+
+/**
+ * \fn static void test_ACTOR_start(void **state)
+ * \brief Unit test of the actors on their thread with CMOCKA : the initial action is performed once, the events sent are
+ * handled in order, and the actor is joined once dead.
+ *
+ * \see ../../src/lib/actor.c
+ */
+static void test_ACTOR_start(void **state) {
+    assert_int_equal(ACTOR_start(test_actor), 0);
+    Test_Msg msgs[] = {{0, E_TEST_GO}, {1, E_TEST_TICK}, {2, E_TEST_TICK}, {0, E_TEST_STOP}, {4, E_TEST_TICK}};
+    for(size_t i = 0; i < sizeof(msgs) / sizeof(msgs[0]); i++) {
+        assert_int_equal(ACTOR_send(test_actor, &msgs[i], 0), 0);
+    }
+    assert_int_equal(ACTOR_join(test_actor), 0);
+    assert_true(ACTOR_is_dead(test_actor));
+    assert_int_equal(test_init_nb, 1);
+    assert_int_equal(test_sum, 3);
+
+    Test_Msg left;
+    assert_int_equal(MAILBOX_try_receive(ACTOR_get_mailbox(test_actor), &left), 1);
+    assert_int_equal(left.value, 4);
+}
+
+/**
+ * \fn static void test_ACTOR_pool(void **state)
+ * \brief Unit test of ACTOR_POOL_SCHEDULER with CMOCKA : the messages sent before the start wait for the initial action,
+ * the ticks are handled once and in order whatever the worker, and the actor is joined once dead.
+ *
+ * \see ../../src/lib/actor.c
+ */
+static void test_ACTOR_pool(void **state) {
+    ACTOR_set_scheduler(&ACTOR_POOL_SCHEDULER);
+    assert_int_equal(ACTOR_send(test_actor, &(Test_Msg) {.value = 0, .event = E_TEST_GO}, 0), 0);
+    assert_int_equal(ACTOR_start(test_actor), 0);
+    for(int value = 1; value <= TICKS_NB; value++) {
+        assert_int_equal(ACTOR_send(test_actor, &(Test_Msg) {.value = value, .event = E_TEST_TICK}, 0), 0);
+    }
+    assert_int_equal(ACTOR_send(test_actor, &(Test_Msg) {.value = 0, .event = E_TEST_STOP}, 0), 0);
+    assert_int_equal(ACTOR_join(test_actor), 0);
+    ACTOR_set_scheduler(&ACTOR_THREAD_SCHEDULER);
+
+    assert_true(ACTOR_is_dead(test_actor));
+    assert_int_equal(test_init_nb, 1);
+    assert_int_equal(test_disorders, 0);
+    assert_int_equal(test_last, TICKS_NB);
+    assert_int_equal(test_sum, TICKS_NB * (TICKS_NB + 1) / 2);
+    assert_int_equal(pool.workers_nb, 0);
+}
+
+/**
+ * \fn static void test_ACTOR_pool_full(void **state)
+ * \brief Unit test of ACTOR_POOL_SCHEDULER with CMOCKA : the only worker, waiting for room in the mailbox of the sink,
+ * hires another one to run the sink, which leaves once the sink is done.
+ *
+ * \see ../../src/lib/actor.c
+ */
+static void test_ACTOR_pool_full(void **state) {
+    test_sink = ACTOR_create(&test_sink_descriptor);
+    assert_non_null(test_sink);
+    ACTOR_set_scheduler(&ACTOR_POOL_SCHEDULER);
+    assert_int_equal(ACTOR_start(test_actor), 0);
+    assert_int_equal(ACTOR_start(test_sink), 0);
+    assert_int_equal(pool.staff_nb, 1);
+    assert_int_equal(ACTOR_send(test_actor, &(Test_Msg) {.value = 0, .event = E_TEST_GO}, 0), 0);
+    assert_int_equal(ACTOR_send(test_actor, &(Test_Msg) {.value = 0, .event = E_TEST_FLOOD}, 0), 0);
+    assert_int_equal(ACTOR_send(test_actor, &(Test_Msg) {.value = 0, .event = E_TEST_STOP}, 0), 0);
+    assert_int_equal(ACTOR_join(test_actor), 0);
+    assert_int_equal(ACTOR_send(test_sink, &(Test_Msg) {.value = 0, .event = E_TEST_STOP}, 0), 0);
+    assert_int_equal(ACTOR_join(test_sink), 0);
+    ACTOR_set_scheduler(&ACTOR_THREAD_SCHEDULER);
+
+    assert_true(ACTOR_is_dead(test_sink));
+    assert_int_equal(test_disorders, 0);
+    assert_int_equal(test_last, FLOOD_NB);
+    assert_int_equal(test_sum, FLOOD_NB * (FLOOD_NB + 1) / 2);
+    assert_int_equal(pool.workers_nb, 0);
+    assert_int_equal(ACTOR_destroy(test_sink), 0);
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_ACTOR_handle, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_ACTOR_start, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_ACTOR_pool, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_ACTOR_pool_full, set_up, tear_down),
+};
+
+/**
+ * \fn int ACTOR_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int ACTOR_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module actor", tests, NULL, NULL);
+}
@@ -0,0 +1,160 @@
+/**
+ * \file  lz4_block_test.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Test module for the LZ4 block codec.
+ *
+ * \see ../../src/lib/lz4_block.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/lib/lz4_block.c"
+
+/**
+ * \def LOGS_SIZE
+ * Size of the logs compressed by the tests : a page of the logs upload.
+ */
+#define LOGS_SIZE 0xFFFA
+
+/**
+ * \fn static size_t LZ4_BLOCK_TEST_write_logs(uint8_t * logs, size_t logs_size)
+ * \brief Writes lines as the logger does, the time and the counter changing from one line to the next.
+ */
+static size_t LZ4_BLOCK_TEST_write_logs(uint8_t * logs, size_t logs_size) {
+    size_t written = 0;
+    for(unsigned int line = 0; written < logs_size; line++) {
+        char text[128];
+        int text_size = snprintf(text, sizeof(text), "INFO : Mon Jan  8 10:%02u:%02u 2024 - Postman has established a connection %u\n",
+                                 (line / 60) % 60, line % 60, line);
+        size_t copied = (size_t) text_size < logs_size - written ? (size_t) text_size : logs_size - written;
+        memcpy(logs + written, text, copied);
+        written += copied;
+    }
+    return written;
+}
+
+/**
+ * \fn static void test_LZ4_BLOCK_round_trip(void **state)
+ * \brief Unit test of the codec with CMOCKA : a page of logs is compressed several times and decompressed as it was.
+ *
+ * \see ../../src/lib/lz4_block.c
+ */
+static void test_LZ4_BLOCK_round_trip(void **state) {
+    static uint8_t logs[LOGS_SIZE];
+    static uint8_t block[LZ4_BLOCK_BOUND(LOGS_SIZE)];
+    static uint8_t decompressed[LOGS_SIZE];
+    LZ4_BLOCK_TEST_write_logs(logs, sizeof(logs));
+
+    int block_size = LZ4_BLOCK_compress(logs, sizeof(logs), block, sizeof(block));
+    assert_in_range(block_size, 1, sizeof(logs) / 4);
+    assert_int_equal(LZ4_BLOCK_decompress(block, (size_t) block_size, decompressed, sizeof(decompressed)), sizeof(logs));
+    assert_memory_equal(decompressed, logs, sizeof(logs));
+
+    /* Short inputs have no match, they are kept as literals. */
+    for(size_t size = 0; size < RUN_MASK; size++) {
+        block_size = LZ4_BLOCK_compress(logs, size, block, sizeof(block));
+        assert_int_equal(block_size, 1 + size);
+        assert_int_equal(LZ4_BLOCK_decompress(block, (size_t) block_size, decompressed, sizeof(decompressed)), size);
+        assert_memory_equal(decompressed, logs, size);
+    }
+}
+
+/**
+ * \fn static void test_LZ4_BLOCK_incompressible(void **state)
+ * \brief Unit test of the codec with CMOCKA : random bytes fit in LZ4_BLOCK_BOUND(), not in their own size.
+ *
+ * \see ../../src/lib/lz4_block.c
+ */
+static void test_LZ4_BLOCK_incompressible(void **state) {
+    static uint8_t input[LOGS_SIZE];
+    static uint8_t block[LZ4_BLOCK_BOUND(LOGS_SIZE)];
+    static uint8_t decompressed[LOGS_SIZE];
+    unsigned int random_state = 42;
+    for(size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (uint8_t) rand_r(&random_state);
+    }
+
+    assert_int_equal(LZ4_BLOCK_compress(input, sizeof(input), block, sizeof(input)), -1);
+    int block_size = LZ4_BLOCK_compress(input, sizeof(input), block, sizeof(block));
+    assert_in_range(block_size, sizeof(input), sizeof(block));
+    assert_int_equal(LZ4_BLOCK_decompress(block, (size_t) block_size, decompressed, sizeof(decompressed)), sizeof(input));
+    assert_memory_equal(decompressed, input, sizeof(input));
+    assert_int_equal(LZ4_BLOCK_compress(input, LZ4_BLOCK_MAX_INPUT_SIZE + 1, block, sizeof(block)), -1);
+}
+
+/**
+ * \fn static void test_LZ4_BLOCK_malformed(void **state)
+ * \brief Unit test of the decompressor with CMOCKA : blocks pointing out of their output or cut are refused.
+ *
+ * \see ../../src/lib/lz4_block.c
+ */
+static void test_LZ4_BLOCK_malformed(void **state) {
+    uint8_t output[32];
+    /* "abcd" then a match of 8 bytes at offset 4 : "abcdabcdabcd". */
+    uint8_t block[] = {0x44, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x00};
+    assert_int_equal(LZ4_BLOCK_decompress(block, sizeof(block), output, sizeof(output)), 12);
+    assert_memory_equal(output, "abcdabcdabcd", 12);
+
+    assert_int_equal(LZ4_BLOCK_decompress(block, sizeof(block), output, 11), -1);
+    uint8_t far_offset[] = {0x44, 'a', 'b', 'c', 'd', 0x05, 0x00, 0x00};
+    assert_int_equal(LZ4_BLOCK_decompress(far_offset, sizeof(far_offset), output, sizeof(output)), -1);
+    uint8_t null_offset[] = {0x44, 'a', 'b', 'c', 'd', 0x00, 0x00, 0x00};
+    assert_int_equal(LZ4_BLOCK_decompress(null_offset, sizeof(null_offset), output, sizeof(output)), -1);
+    uint8_t cut_literals[] = {0x50, 'a', 'b'};
+    assert_int_equal(LZ4_BLOCK_decompress(cut_literals, sizeof(cut_literals), output, sizeof(output)), -1);
+    uint8_t cut_length[] = {0xF0, 0xFF};
+    assert_int_equal(LZ4_BLOCK_decompress(cut_length, sizeof(cut_length), output, sizeof(output)), -1);
+    uint8_t cut_offset[] = {0x14, 'a', 0x01};
+    assert_int_equal(LZ4_BLOCK_decompress(cut_offset, sizeof(cut_offset), output, sizeof(output)), -1);
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_LZ4_BLOCK_round_trip),
+    cmocka_unit_test(test_LZ4_BLOCK_incompressible),
+    cmocka_unit_test(test_LZ4_BLOCK_malformed),
+};
+
+/**
+ * \fn int LZ4_BLOCK_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int LZ4_BLOCK_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module lz4_block", tests, NULL, NULL);
+}
@@ -0,0 +1,250 @@
+/**
+ * \file  mailbox_test.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Test module for the mailboxes.
+ *
+ * \see ../../src/lib/mailbox.c
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include <pthread.h>
+#include <poll.h>
+
+#include "../../src/lib/mailbox.c"
+
+/**
+ * \def PRODUCERS_NB
+ * Threads sending at the same time in test_MAILBOX_senders.
+ */
+#define PRODUCERS_NB 4
+/**
+ * \def MESSAGES_NB
+ * Messages sent by each of them.
+ */
+#define MESSAGES_NB 20000
+
+/**
+ * \struct Test_Msg
+ * \brief Message of the tests : its sender and its rank among the messages of the sender.
+ */
+typedef struct {
+    uint32_t sender;
+    uint32_t rank;
+} Test_Msg;
+
+/**
+ * \struct Test_Sender
+ * \brief Thread sending messages in a mailbox.
+ */
+typedef struct {
+    Mailbox * mailbox;
+    uint32_t id;
+    uint32_t msg_nb;
+    uint32_t sent_nb;
+} Test_Sender;
+
+static void * MAILBOX_TEST_send(void * arg) {
+    Test_Sender * sender = (Test_Sender *) arg;
+    for(uint32_t rank = 0; rank < sender->msg_nb; rank++) {
+        Test_Msg msg = {.sender = sender->id, .rank = rank};
+        if(MAILBOX_send(sender->mailbox, &msg, 0) == -1) {
+            break;
+        }
+        __atomic_store_n(&sender->sent_nb, rank + 1, __ATOMIC_SEQ_CST);
+    }
+    return NULL;
+}
+
+/**
+ * \fn static void test_MAILBOX_order(void **state)
+ * \brief Unit test of the mailboxes with CMOCKA : both kinds give the highest priority first, then the order of sending.
+ *
+ * \see ../../src/lib/mailbox.c
+ */
+static void test_MAILBOX_order(void **state) {
+    Mailbox_Kind kinds[] = {MAILBOX_POSIX_QUEUE, MAILBOX_RING};
+    for(size_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); i++) {
+        Mailbox * mailbox = MAILBOX_open("/mailbox_test", sizeof(Test_Msg), 4, 2, kinds[i]);
+        assert_non_null(mailbox);
+        Test_Msg sent[] = {{0, 0}, {1, 0}, {0, 1}};
+        assert_int_equal(MAILBOX_send(mailbox, &sent[0], 0), 0);
+        assert_int_equal(MAILBOX_send(mailbox, &sent[1], 1), 0);
+        assert_int_equal(MAILBOX_send(mailbox, &sent[2], 0), 0);
+
+        Test_Msg received;
+        assert_int_equal(MAILBOX_receive(mailbox, &received), 0);
+        assert_memory_equal(&received, &sent[1], sizeof(Test_Msg));
+        assert_int_equal(MAILBOX_try_receive(mailbox, &received), 1);
+        assert_memory_equal(&received, &sent[0], sizeof(Test_Msg));
+        assert_int_equal(MAILBOX_receive(mailbox, &received), 0);
+        assert_memory_equal(&received, &sent[2], sizeof(Test_Msg));
+        assert_int_equal(MAILBOX_try_receive(mailbox, &received), 0);
+        assert_int_equal(MAILBOX_close(mailbox), 0);
+    }
+}
+
+/**
+ * \fn static void test_MAILBOX_full(void **state)
+ * \brief Unit test of the ring with CMOCKA : a sender waits for room as with mq_send(), and goes on once a message is
+ * received.
+ *
+ * \see ../../src/lib/mailbox.c
+ */
+static void test_MAILBOX_full(void **state) {
+    Mailbox * mailbox = MAILBOX_open("/mailbox_test", sizeof(Test_Msg), 2, 1, MAILBOX_RING);
+    assert_non_null(mailbox);
+    Test_Sender sender = {.mailbox = mailbox, .id = 0, .msg_nb = 3, .sent_nb = 0};
+    pthread_t thread;
+    assert_int_equal(pthread_create(&thread, NULL, MAILBOX_TEST_send, &sender), 0);
+    usleep(50000);
+    assert_int_equal(__atomic_load_n(&sender.sent_nb, __ATOMIC_SEQ_CST), 2);
+
+    Test_Msg received;
+    for(uint32_t rank = 0; rank < 3; rank++) {
+        assert_int_equal(MAILBOX_receive(mailbox, &received), 0);
+        assert_int_equal(received.rank, rank);
+    }
+    pthread_join(thread, NULL);
+    assert_int_equal(sender.sent_nb, 3);
+    assert_int_equal(MAILBOX_close(mailbox), 0);
+}
+
+/**
+ * \fn static void test_MAILBOX_try_send(void **state)
+ * \brief Unit test of the mailboxes with CMOCKA : both kinds refuse a message without waiting once full, and take it
+ * again once a message is received.
+ *
+ * \see ../../src/lib/mailbox.c
+ */
+static void test_MAILBOX_try_send(void **state) {
+    Mailbox_Kind kinds[] = {MAILBOX_POSIX_QUEUE, MAILBOX_RING};
+    for(size_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); i++) {
+        Mailbox * mailbox = MAILBOX_open("/mailbox_test", sizeof(Test_Msg), 2, 1, kinds[i]);
+        assert_non_null(mailbox);
+        Test_Msg msg = {0, 0};
+        assert_int_equal(MAILBOX_try_send(mailbox, &msg, 0), 1);
+        msg.rank = 1;
+        assert_int_equal(MAILBOX_try_send(mailbox, &msg, 0), 1);
+        msg.rank = 2;
+        assert_int_equal(MAILBOX_try_send(mailbox, &msg, 0), 0);
+
+        Test_Msg received;
+        assert_int_equal(MAILBOX_receive(mailbox, &received), 0);
+        assert_int_equal(received.rank, 0);
+        assert_int_equal(MAILBOX_try_send(mailbox, &msg, 0), 1);
+        assert_int_equal(MAILBOX_receive(mailbox, &received), 0);
+        assert_int_equal(received.rank, 1);
+        assert_int_equal(MAILBOX_receive(mailbox, &received), 0);
+        assert_int_equal(received.rank, 2);
+        assert_int_equal(MAILBOX_close(mailbox), 0);
+    }
+}
+
+/**
+ * \fn static void test_MAILBOX_senders(void **state)
+ * \brief Unit test of the ring with CMOCKA : with several senders on a small ring, no message is lost or reordered.
+ *
+ * \see ../../src/lib/mailbox.c
+ */
+static void test_MAILBOX_senders(void **state) {
+    Mailbox * mailbox = MAILBOX_open("/mailbox_test", sizeof(Test_Msg), 8, 1, MAILBOX_RING);
+    assert_non_null(mailbox);
+    Test_Sender senders[PRODUCERS_NB];
+    pthread_t threads[PRODUCERS_NB];
+    uint32_t next_ranks[PRODUCERS_NB] = {0};
+    for(uint32_t id = 0; id < PRODUCERS_NB; id++) {
+        senders[id] = (Test_Sender) {.mailbox = mailbox, .id = id, .msg_nb = MESSAGES_NB, .sent_nb = 0};
+        assert_int_equal(pthread_create(&threads[id], NULL, MAILBOX_TEST_send, &senders[id]), 0);
+    }
+
+    for(uint32_t i = 0; i < PRODUCERS_NB * MESSAGES_NB; i++) {
+        Test_Msg received;
+        assert_int_equal(MAILBOX_receive(mailbox, &received), 0);
+        assert_in_range(received.sender, 0, PRODUCERS_NB - 1);
+        assert_int_equal(received.rank, next_ranks[received.sender]);
+        next_ranks[received.sender]++;
+    }
+    for(uint32_t id = 0; id < PRODUCERS_NB; id++) {
+        pthread_join(threads[id], NULL);
+    }
+    Test_Msg received;
+    assert_int_equal(MAILBOX_try_receive(mailbox, &received), 0);
+    assert_int_equal(MAILBOX_close(mailbox), 0);
+}
+
+/**
+ * \fn static void test_MAILBOX_fd(void **state)
+ * \brief Unit test of the ring with CMOCKA : its file descriptor is readable once a message is sent, and no more once
+ * the messages are taken.
+ *
+ * \see ../../src/lib/mailbox.c
+ */
+static void test_MAILBOX_fd(void **state) {
+    Mailbox * mailbox = MAILBOX_open("/mailbox_test", sizeof(Test_Msg), 4, 1, MAILBOX_RING);
+    assert_non_null(mailbox);
+    struct pollfd watched = {.fd = MAILBOX_get_fd(mailbox), .events = POLLIN};
+    assert_true(watched.fd >= 0);
+    Test_Msg msg = {0, 0};
+
+    assert_int_equal(MAILBOX_try_receive(mailbox, &msg), 0);
+    assert_int_equal(poll(&watched, 1, 0), 0);
+    assert_int_equal(MAILBOX_send(mailbox, &msg, 0), 0);
+    assert_int_equal(MAILBOX_send(mailbox, &msg, 0), 0);
+    assert_int_equal(poll(&watched, 1, 0), 1);
+    assert_int_equal(MAILBOX_try_receive(mailbox, &msg), 1);
+    assert_int_equal(MAILBOX_try_receive(mailbox, &msg), 1);
+    assert_int_equal(MAILBOX_try_receive(mailbox, &msg), 0);
+    assert_int_equal(poll(&watched, 1, 0), 0);
+    assert_int_equal(MAILBOX_close(mailbox), 0);
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_MAILBOX_order),
+    cmocka_unit_test(test_MAILBOX_full),
+    cmocka_unit_test(test_MAILBOX_try_send),
+    cmocka_unit_test(test_MAILBOX_senders),
+    cmocka_unit_test(test_MAILBOX_fd),
+};
+
+/**
+ * \fn int MAILBOX_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int MAILBOX_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module mailbox", tests, NULL, NULL);
+}
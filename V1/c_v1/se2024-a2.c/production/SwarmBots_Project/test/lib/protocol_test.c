@@ -0,0 +1,169 @@
+/**
+ * \file  protocol_test.c
+ * \version  0.1
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Test module for the protocol schema.
+ *
+ * \see ../../src/lib/protocol.h
+ *
+ * \section License
+ *
+ * The MIT License
+ *
+ * Copyright (c) 2023, Prose A2 2023
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \copyright Prose A2 2023
+ */
+
+/* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+
+#include "../../src/lib/protocol.h"
+
+/**
+ * \struct Documented_Size
+ * \brief Size field of a message as documented in the protocol, the fixed fields only for SET_LOGS and ASK_BATCH.
+ *
+ * SB_IHM of PROTOCOL_VERSION_LEGACY send and receive the availability messages without their fields.
+ */
+typedef struct {
+    Message_Type type;
+    uint16_t msg_size;
+} Documented_Size;
+/**
+ * \var static const Documented_Size documented_sizes[]
+ * Size fields of every message type of the protocol.
+ */
+static const Documented_Size documented_sizes[] = {
+    {ASK_AVAILABILITY, 7},
+    {SET_AVAILABILITY, 7},
+    {ASK_CMD, 3},
+    {SET_STATE, 3},
+    {ASK_MODE, 2},
+    {SET_MODE, 6},
+    {ASK_LOGS, 2},
+    {SET_LOGS, 4},
+    {ALERT, 3},
+    {ASK_TO_DISCONNECT, 2},
+    {ACK_DISCONNECTION, 2},
+    {SET_RADAR, 3},
+    {SET_CURRENT_TIME, 9},
+    {SET_IP_PORT, 8},
+    {LOGS_RECEIVED, 2},
+    {SET_SESSION, 7},
+    {ASK_RESUME, 6},
+    {ASK_BATCH, 2},
+};
+
+static int PROTOCOL_TEST_documented_size(Message_Type type) {
+    for(size_t i = 0; i < sizeof(documented_sizes) / sizeof(documented_sizes[0]); i++) {
+        if(documented_sizes[i].type == type) {
+            return documented_sizes[i].msg_size;
+        }
+    }
+    return -1;
+}
+
+/**
+ * \fn static void test_PROTOCOL_documented_sizes(void **state)
+ * \brief Unit test of the schema with CMOCKA : every message type encodes to its documented size.
+ *
+ * \see ../../src/lib/protocol.h
+ */
+static void test_PROTOCOL_documented_sizes(void **state) {
+    int messages_nb = 0;
+#define M(m) { \
+        uint8_t frame[PROTOCOL_HEAD_SIZE + PROTOCOL_##m##_SIZE]; \
+        uint8_t * payload = PROTOCOL_encode_##m(frame); \
+        assert_ptr_equal(payload, frame + PROTOCOL_HEAD_SIZE); \
+        assert_int_equal(PROTOCOL_get_U16(frame), PROTOCOL_TEST_documented_size(m)); \
+        assert_int_equal(PROTOCOL_get_fields_size(m) + 2, PROTOCOL_TEST_documented_size(m)); \
+        assert_int_equal(PROTOCOL_get_type(frame), m); \
+        assert_ptr_equal(PROTOCOL_decode_##m(frame, sizeof(frame)), payload); \
+        messages_nb++; \
+    }
+    PROTOCOL_GENERATION
+#undef M
+    assert_int_equal(messages_nb, sizeof(documented_sizes) / sizeof(documented_sizes[0]));
+}
+
+/**
+ * \fn static void test_PROTOCOL_round_trip(void **state)
+ * \brief Unit test of the accessors with CMOCKA : the fields are written in network byte order and read back.
+ *
+ * \see ../../src/lib/protocol.h
+ */
+static void test_PROTOCOL_round_trip(void **state) {
+    uint8_t frame[PROTOCOL_HEAD_SIZE + PROTOCOL_SET_IP_PORT_SIZE];
+    uint8_t expected_frame[] = {0x00, 0x08, 0x14, 0x00, 192, 168, 1, 42, 0x1F, 0x90};
+
+    uint8_t * payload = PROTOCOL_encode_SET_IP_PORT(frame);
+    PROTOCOL_put_SET_IP_PORT_ip(payload, 0xC0A8012A);
+    PROTOCOL_put_SET_IP_PORT_port(payload, 8080);
+
+    assert_memory_equal(frame, expected_frame, sizeof(expected_frame));
+    const uint8_t * decoded = PROTOCOL_decode_SET_IP_PORT(frame, sizeof(frame));
+    assert_non_null(decoded);
+    assert_int_equal(PROTOCOL_get_SET_IP_PORT_ip(decoded), 0xC0A8012A);
+    assert_int_equal(PROTOCOL_get_SET_IP_PORT_port(decoded), 8080);
+}
+
+/**
+ * \fn static void test_PROTOCOL_decode(void **state)
+ * \brief Unit test of the decoders with CMOCKA : frames of SB_IHM are accepted, wrong or short frames are not.
+ *
+ * \see ../../src/lib/protocol.h
+ */
+static void test_PROTOCOL_decode(void **state) {
+    /* SB_IHM writes the identifier of the type in the second byte of the field. */
+    uint8_t frame[] = {0x00, 0x06, 0x00, 0x17, 0x12, 0x34, 0x56, 0x78};
+
+    const uint8_t * payload = PROTOCOL_decode_ASK_RESUME(frame, sizeof(frame));
+    assert_ptr_equal(payload, frame + PROTOCOL_HEAD_SIZE);
+    assert_int_equal(PROTOCOL_get_ASK_RESUME_session_token(payload), 0x12345678);
+
+    assert_null(PROTOCOL_decode_SET_SESSION(frame, sizeof(frame)));
+    assert_null(PROTOCOL_decode_ASK_RESUME(frame, sizeof(frame) - 1));
+    frame[1] = 0x05;
+    assert_null(PROTOCOL_decode_ASK_RESUME(frame, sizeof(frame)));
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_PROTOCOL_documented_sizes),
+    cmocka_unit_test(test_PROTOCOL_round_trip),
+    cmocka_unit_test(test_PROTOCOL_decode),
+};
+
+/**
+ * \fn int PROTOCOL_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int PROTOCOL_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module protocol", tests, NULL, NULL);
+}
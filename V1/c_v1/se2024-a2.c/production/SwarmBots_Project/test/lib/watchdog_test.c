@@ -1,9 +1,11 @@
 /**
  * \file  watchdog_test.c
- * \version  1.1
+ * \version  1.2
  * \author Joshua MONTREUIL
- * \date Mar 14, 2023
- * \brief This file is just used for compilation purpose.
+ * \author Prose A2
+ * \date Oct 17, 2026
+ * \brief Unit tests of the watchdogs : delays, cancel, periodic watchdogs, their drift under load and events sent to an
+ * actor.
  *
  * \see ../../src/lib/watchdog.c
  * \see ../../src/lib/watchdog.h
@@ -36,4 +38,413 @@
  *
  */
 /* ----------------------  INCLUDES  ---------------------------------------- */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include "cmocka.h"
+
+/* Ticks of a millisecond : the periods of test_watchdog_drift are a tick long. */
+#define CONFIG_WATCHDOG_TICK_MS 1
 #include "../../src/lib/watchdog.c"
+
+/**
+ * \def TEST_DELAY
+ * Delay of the watchdogs of the tests, in milliseconds.
+ */
+#define TEST_DELAY 50
+/**
+ * \def TEST_LATE
+ * Time after its delay a watchdog is late, in milliseconds : a tick, and the time to schedule the thread of the wheel.
+ */
+#define TEST_LATE (CONFIG_WATCHDOG_TICK_MS + 40)
+/**
+ * \def TEST_PERIODS
+ * Expiries awaited in test_watchdog_start_periodic.
+ */
+#define TEST_PERIODS 5
+
+/**
+ * \def TEST_DRIFT_PERIODS
+ * Periods of the periodic watchdog of test_watchdog_drift.
+ */
+#define TEST_DRIFT_PERIODS 10000
+/**
+ * \def TEST_DRIFT_PERIOD
+ * Delay of the periodic watchdog of test_watchdog_drift, in milliseconds.
+ */
+#define TEST_DRIFT_PERIOD 1
+/**
+ * \def TEST_DRIFT_MAX
+ * Most time the last period of test_watchdog_drift may end after its deadline, in milliseconds. Started again at each
+ * expiry, the watchdog would be a tick late at each period, TEST_DRIFT_PERIODS ticks at the end.
+ */
+#define TEST_DRIFT_MAX 50
+
+/**
+ * \enum Test_State
+ * \brief States of the actor of the tests.
+ */
+typedef enum {
+    S_TEST_FORGET = ACTOR_FORGET,
+    S_TEST_IDLE,
+    S_TEST_DEATH,
+    S_TEST_NB,
+} Test_State;
+
+/**
+ * \enum Test_Event
+ * \brief Events of the actor of the tests.
+ */
+typedef enum {
+    E_TEST_TIME_OUT = 0,
+    E_TEST_NB,
+} Test_Event;
+
+/**
+ * \struct Test_Msg
+ * \brief Message of the actor of the tests.
+ */
+typedef struct {
+    Test_Event event;
+    int value;
+} Test_Msg;
+
+/**
+ * \var static const Actor_Transition test_state_machine[S_TEST_NB - 1][E_TEST_NB]
+ * \brief State machine of the actor of the tests, never started : the tests read its mailbox.
+ */
+static const Actor_Transition test_state_machine[S_TEST_NB - 1][E_TEST_NB] = {
+    [S_TEST_IDLE][E_TEST_TIME_OUT] = {S_TEST_IDLE, 0},
+};
+
+/**
+ * \var static int test_expiries
+ * \brief Calls of the callback of the tests.
+ */
+static int test_expiries;
+
+/**
+ * \var static uint64_t test_expiry_times[TEST_DRIFT_PERIODS]
+ * \brief Times of the expiries of test_watchdog_drift, in nanoseconds.
+ */
+static uint64_t test_expiry_times[TEST_DRIFT_PERIODS];
+
+/**
+ * \var static bool_e test_is_loaded
+ * \brief TRUE while the load threads of test_watchdog_drift spin.
+ */
+static bool_e test_is_loaded;
+
+/**
+ * \var static watchdog_t * test_pair[2]
+ * \brief Watchdogs of test_watchdog_destroy_in_callback, due at the same tick.
+ */
+static watchdog_t * test_pair[2];
+
+/**
+ * \var static sem_t test_expired
+ * \brief Posted by the callback of the tests.
+ */
+static sem_t test_expired;
+
+static int WATCHDOG_TEST_perform(int action, void * msg) {
+    return 0;
+}
+
+/**
+ * \var static const Actor_Descriptor test_descriptor
+ * \brief Descriptor of the actor of the tests : its mailbox holds two messages.
+ */
+static const Actor_Descriptor test_descriptor = {
+    .name = "watchdog_test",
+    .mailbox_name = "/watchdog_test",
+    .msg_size = sizeof(Test_Msg),
+    .msg_count = 2,
+    .priorities_nb = 1,
+    .mailbox_kind = MAILBOX_RING,
+    .state_machine = &test_state_machine[0][0],
+    .states_nb = S_TEST_NB,
+    .events_nb = E_TEST_NB,
+    .event_offset = offsetof(Test_Msg, event),
+    .initial_state = S_TEST_IDLE,
+    .initial_action = 0,
+    .perform = WATCHDOG_TEST_perform,
+    .run = NULL,
+    .is_logged = FALSE,
+};
+
+static void WATCHDOG_TEST_callback(watchdog_t * watchdog) {
+    test_expiries++;
+    sem_post(&test_expired);
+}
+
+static void WATCHDOG_TEST_record(watchdog_t * watchdog) {
+    test_expiry_times[test_expiries++] = watchdog_now();
+    if(test_expiries == TEST_DRIFT_PERIODS) {
+        watchdog_cancel(watchdog);
+        sem_post(&test_expired);
+    }
+}
+
+static void WATCHDOG_TEST_destroy_other(watchdog_t * watchdog) {
+    int other = test_pair[0] == watchdog ? 1 : 0;
+    watchdog_destroy(test_pair[other]);
+    test_pair[other] = NULL;
+    test_expiries++;
+    sem_post(&test_expired);
+}
+
+/**
+ * \fn static void * WATCHDOG_TEST_load(void * arg)
+ * \brief Thread spinning while test_is_loaded, the synthetic load of test_watchdog_drift.
+ */
+static void * WATCHDOG_TEST_load(void * arg) {
+    volatile unsigned long spins = 0;
+    while(__atomic_load_n(&test_is_loaded, __ATOMIC_RELAXED)) {
+        spins++;
+    }
+    return NULL;
+}
+
+/**
+ * \fn static uint64_t WATCHDOG_TEST_now_ms(void)
+ * \brief Reads the monotonic clock, in milliseconds.
+ */
+static uint64_t WATCHDOG_TEST_now_ms(void) {
+    return watchdog_now() / 1000000;
+}
+
+/**
+ * \fn static int WATCHDOG_TEST_wait(unsigned int timeout)
+ * \brief Waits for the callback of the tests.
+ *
+ * \return 0 when the callback was called within timeout milliseconds, -1 otherwise.
+ */
+static int WATCHDOG_TEST_wait(unsigned int timeout) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += (long) (timeout % 1000) * 1000000;
+    deadline.tv_sec += timeout / 1000 + deadline.tv_nsec / 1000000000;
+    deadline.tv_nsec %= 1000000000;
+    return sem_timedwait(&test_expired, &deadline);
+}
+
+static int set_up(void **state) {
+    test_expiries = 0;
+    return sem_init(&test_expired, 0, 0);
+}
+
+static int tear_down(void **state) {
+    return sem_destroy(&test_expired);
+}
+
+/**
+ * \fn static void test_watchdog_start(void **state)
+ * \brief Unit test of watchdog_start() with CMOCKA : the callback is called once, neither before the delay nor much later.
+ *
+ * \see ../../src/lib/watchdog.c
+ */
+static void test_watchdog_start(void **state) {
+    watchdog_t * watchdog = watchdog_create(TEST_DELAY, WATCHDOG_TEST_callback);
+    assert_non_null(watchdog);
+
+    uint64_t start = WATCHDOG_TEST_now_ms();
+    watchdog_start(watchdog);
+    assert_int_equal(WATCHDOG_TEST_wait(TEST_DELAY + TEST_LATE), 0);
+    uint64_t elapsed = WATCHDOG_TEST_now_ms() - start;
+    assert_in_range(elapsed, TEST_DELAY, TEST_DELAY + TEST_LATE);
+
+    assert_int_equal(WATCHDOG_TEST_wait(2 * TEST_DELAY), -1);
+    assert_int_equal(test_expiries, 1);
+    watchdog_destroy(watchdog);
+}
+
+/**
+ * \fn static void test_watchdog_cancel(void **state)
+ * \brief Unit test of watchdog_cancel() with CMOCKA : a watchdog cancelled, or started again, does not expire at its
+ * first deadline.
+ *
+ * \see ../../src/lib/watchdog.c
+ */
+static void test_watchdog_cancel(void **state) {
+    watchdog_t * watchdog = watchdog_create(TEST_DELAY, WATCHDOG_TEST_callback);
+    watchdog_t * restarted = watchdog_create(2 * TEST_DELAY, WATCHDOG_TEST_callback);
+
+    watchdog_start(watchdog);
+    watchdog_start(restarted);
+    watchdog_cancel(watchdog);
+    assert_int_equal(WATCHDOG_TEST_wait(TEST_DELAY + TEST_LATE), -1);
+    uint64_t start = WATCHDOG_TEST_now_ms();
+    watchdog_start(restarted);
+    assert_int_equal(WATCHDOG_TEST_wait(2 * TEST_DELAY + TEST_LATE), 0);
+    assert_in_range(WATCHDOG_TEST_now_ms() - start, 2 * TEST_DELAY, 2 * TEST_DELAY + TEST_LATE);
+    assert_int_equal(test_expiries, 1);
+
+    /* Cancelled twice, or destroyed while started. */
+    watchdog_cancel(watchdog);
+    watchdog_start(restarted);
+    watchdog_destroy(restarted);
+    watchdog_destroy(watchdog);
+}
+
+/**
+ * \fn static void test_watchdog_start_periodic(void **state)
+ * \brief Unit test of watchdog_start_periodic() with CMOCKA : the watchdog expires at each delay until it is cancelled.
+ *
+ * \see ../../src/lib/watchdog.c
+ */
+static void test_watchdog_start_periodic(void **state) {
+    watchdog_t * watchdog = watchdog_create(TEST_DELAY, WATCHDOG_TEST_callback);
+
+    uint64_t start = WATCHDOG_TEST_now_ms();
+    watchdog_start_periodic(watchdog);
+    for(int period = 0; period < TEST_PERIODS; period++) {
+        assert_int_equal(WATCHDOG_TEST_wait(TEST_DELAY + TEST_LATE), 0);
+    }
+    watchdog_cancel(watchdog);
+    assert_in_range(WATCHDOG_TEST_now_ms() - start, TEST_PERIODS * TEST_DELAY, TEST_PERIODS * TEST_DELAY + TEST_LATE);
+    assert_int_equal(WATCHDOG_TEST_wait(2 * TEST_DELAY), -1);
+    assert_int_equal(test_expiries, TEST_PERIODS);
+    watchdog_destroy(watchdog);
+}
+
+/**
+ * \fn static void test_watchdog_drift(void **state)
+ * \brief Unit test of watchdog_start_periodic() with CMOCKA : every core busy with a spinning thread, no period of the
+ * TEST_DRIFT_PERIODS ones is lost or early, and the last one is late by at most TEST_DRIFT_MAX.
+ *
+ * \see ../../src/lib/watchdog.c
+ */
+static void test_watchdog_drift(void **state) {
+    long loads_nb = sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_t loads[loads_nb];
+    __atomic_store_n(&test_is_loaded, TRUE, __ATOMIC_RELAXED);
+    for(long load = 0; load < loads_nb; load++) {
+        assert_int_equal(pthread_create(&loads[load], NULL, WATCHDOG_TEST_load, NULL), 0);
+    }
+
+    watchdog_t * watchdog = watchdog_create(TEST_DRIFT_PERIOD, WATCHDOG_TEST_record);
+    uint64_t start = watchdog_now();
+    watchdog_start_periodic(watchdog);
+    int ret = WATCHDOG_TEST_wait(TEST_DRIFT_PERIODS * TEST_DRIFT_PERIOD + 10000);
+
+    __atomic_store_n(&test_is_loaded, FALSE, __ATOMIC_RELAXED);
+    for(long load = 0; load < loads_nb; load++) {
+        pthread_join(loads[load], NULL);
+    }
+    watchdog_destroy(watchdog);
+
+    assert_int_equal(ret, 0);
+    assert_int_equal(test_expiries, TEST_DRIFT_PERIODS);
+    uint64_t period_ns = (uint64_t) TEST_DRIFT_PERIOD * 1000000;
+    for(int period = 0; period < TEST_DRIFT_PERIODS; period++) {
+        assert_true(test_expiry_times[period] >= start + (period + 1) * period_ns);
+    }
+    uint64_t drift = test_expiry_times[TEST_DRIFT_PERIODS - 1] - (start + TEST_DRIFT_PERIODS * period_ns);
+    assert_in_range(drift / 1000000, 0, TEST_DRIFT_MAX);
+}
+
+/**
+ * \fn static void test_watchdog_create_event(void **state)
+ * \brief Unit test of watchdog_create_event() with CMOCKA : the message is sent to the mailbox of the actor at the
+ * expiry, and sent again at the next tick while the mailbox is full.
+ *
+ * \see ../../src/lib/watchdog.c
+ */
+static void test_watchdog_create_event(void **state) {
+    Actor * actor = ACTOR_create(&test_descriptor);
+    assert_non_null(actor);
+    Test_Msg msg = {.event = E_TEST_TIME_OUT, .value = 42};
+    watchdog_t * watchdog = watchdog_create_event(TEST_DELAY, actor, &msg);
+    assert_non_null(watchdog);
+    msg.value = 0;
+
+    Test_Msg received;
+    watchdog_expire(watchdog);
+    assert_int_equal(MAILBOX_try_receive(ACTOR_get_mailbox(actor), &received), 1);
+    assert_int_equal(received.value, 42);
+
+    /* Mailbox full : the expiry waits for room, the other messages are kept. */
+    assert_int_equal(ACTOR_try_send(actor, &msg, 0), 1);
+    assert_int_equal(ACTOR_try_send(actor, &msg, 0), 1);
+    watchdog_start(watchdog);
+    usleep((TEST_DELAY + TEST_LATE) * 1000);
+    assert_int_equal(MAILBOX_try_receive(ACTOR_get_mailbox(actor), &received), 1);
+    assert_int_equal(received.value, 0);
+    usleep(TEST_LATE * 1000);
+    assert_int_equal(MAILBOX_try_receive(ACTOR_get_mailbox(actor), &received), 1);
+    assert_int_equal(received.value, 0);
+    assert_int_equal(MAILBOX_try_receive(ACTOR_get_mailbox(actor), &received), 1);
+    assert_int_equal(received.value, 42);
+    assert_int_equal(MAILBOX_try_receive(ACTOR_get_mailbox(actor), &received), 0);
+
+    watchdog_destroy(watchdog);
+    assert_int_equal(ACTOR_destroy(actor), 0);
+}
+
+/**
+ * \fn static void test_watchdog_destroy_in_callback(void **state)
+ * \brief Unit test of the expiry of a slot with CMOCKA : the first of two watchdogs due at the same tick destroys the
+ * other one from its callback, which is never called.
+ *
+ * \see ../../src/lib/watchdog.c
+ */
+static void test_watchdog_destroy_in_callback(void **state) {
+    test_pair[0] = watchdog_create(TEST_DELAY, WATCHDOG_TEST_destroy_other);
+    test_pair[1] = watchdog_create(TEST_DELAY, WATCHDOG_TEST_destroy_other);
+
+    /* Started under the lock of the wheel : both in the same slot. */
+    pthread_mutex_lock(&wheel.mutex);
+    watchdog_start(test_pair[0]);
+    watchdog_start(test_pair[1]);
+    pthread_mutex_unlock(&wheel.mutex);
+    assert_int_equal(WATCHDOG_TEST_wait(TEST_DELAY + TEST_LATE), 0);
+    assert_int_equal(WATCHDOG_TEST_wait(2 * TEST_DELAY), -1);
+    assert_int_equal(test_expiries, 1);
+
+    /* Only the watchdog which has expired is left. */
+    watchdog_destroy(test_pair[0] != NULL ? test_pair[0] : test_pair[1]);
+}
+
+/**
+ * \fn static void test_watchdog_restart(void **state)
+ * \brief Unit test of watchdog_destroy() with CMOCKA : the thread of the wheel stopped and started again at once, the
+ * watchdogs still expire once.
+ *
+ * \see ../../src/lib/watchdog.c
+ */
+static void test_watchdog_restart(void **state) {
+    for(int i = 0; i < 100; i++) {
+        watchdog_destroy(watchdog_create(TEST_DELAY, WATCHDOG_TEST_callback));
+    }
+    watchdog_t * watchdog = watchdog_create(TEST_DELAY, WATCHDOG_TEST_callback);
+    watchdog_start(watchdog);
+    assert_int_equal(WATCHDOG_TEST_wait(TEST_DELAY + TEST_LATE), 0);
+    assert_int_equal(WATCHDOG_TEST_wait(2 * TEST_DELAY), -1);
+    assert_int_equal(test_expiries, 1);
+    watchdog_destroy(watchdog);
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_watchdog_start, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_watchdog_cancel, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_watchdog_start_periodic, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_watchdog_drift, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_watchdog_create_event, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_watchdog_destroy_in_callback, set_up, tear_down),
+    cmocka_unit_test_setup_teardown(test_watchdog_restart, set_up, tear_down),
+};
+
+/**
+ * \fn int WATCHDOG_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int WATCHDOG_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module watchdog", tests, NULL, NULL);
+}
@@ -42,3 +42,63 @@
 #include "cmocka.h"
 /* ----------------------  INCLUDES  ---------------------------------------- */
 #include "../../src/logs/controller_logger.c"
+
+static int tear_down(void **state) {
+    /* The other modules expect every level to be logged. */
+    CONTROLLER_LOGGER_set_level(CONFIG_LOGGER_LOG_LEVEL);
+    return 0;
+}
+
+/**
+ * \fn static void test_CONTROLLER_LOGGER_is_enabled(void **state)
+ * \brief Unit test of is_enabled with CMOCKA : only the levels from the one set are logged.
+ * \author Prose A2
+ *
+ * \see ../../src/logs/controller_logger.c
+ */
+static void test_CONTROLLER_LOGGER_is_enabled(void **state) {
+    CONTROLLER_LOGGER_set_level(WARNING);
+
+    assert_false(CONTROLLER_LOGGER_is_enabled(DEBUG));
+    assert_false(CONTROLLER_LOGGER_is_enabled(INFO));
+    assert_true(CONTROLLER_LOGGER_is_enabled(WARNING));
+    assert_true(CONTROLLER_LOGGER_is_enabled(ERROR));
+
+    CONTROLLER_LOGGER_set_level(DEBUG);
+
+    assert_true(CONTROLLER_LOGGER_is_enabled(DEBUG));
+}
+/**
+ * \fn static void test_CONTROLLER_LOGGER_log_not_enabled(void **state)
+ * \brief Unit test of log with CMOCKA : a log below the level set is not sent to the logger.
+ * \author Prose A2
+ *
+ * \see ../../src/logs/controller_logger.c
+ */
+static void test_CONTROLLER_LOGGER_log_not_enabled(void **state) {
+    int formatted = 0;
+    CONTROLLER_LOGGER_set_level(ERROR);
+
+    /* The logger is not created : sending to its queue would fail. */
+    assert_int_equal(0, CONTROLLER_LOGGER_log(INFO, "Not logged"));
+    /* Neither are the arguments evaluated. */
+    CONTROLLER_LOGGER_LOG(WARNING, "Not logged : %d", ++formatted);
+    assert_int_equal(0, formatted);
+}
+
+/**
+ * \struct CMUnitTest
+ * \brief Lists the test suite for the module
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_teardown(test_CONTROLLER_LOGGER_is_enabled, tear_down),
+    cmocka_unit_test_teardown(test_CONTROLLER_LOGGER_log_not_enabled, tear_down),
+};
+
+/**
+ * \fn int CONTROLLER_LOGGER_TEST_run_tests()
+ * \brief Module tests suite launch.
+ */
+int CONTROLLER_LOGGER_TEST_run_tests() {
+    return cmocka_run_group_tests_name("Test du module controller_logger", tests, NULL, NULL);
+}
@@ -46,7 +46,7 @@
  * \def TESTS_SUITE_NB
  * Number of tests suite to be executed.
  * */
-#define TESTS_SUITE_NB 4
+#define TESTS_SUITE_NB 17
 /**
  * \see /controller/controller_core_test.c
  */
@@ -63,6 +63,46 @@ extern int PILOT_TEST_run_tests(void);
  * \see /controller/state_indicator_test.c
  */
 extern int STATE_INDICATOR_TEST_run_tests(void);
+/**
+ * \see /com/frame_pool_test.c
+ */
+extern int FRAME_POOL_TEST_run_tests(void);
+/**
+ * \see /com/frame_reader_test.c
+ */
+extern int FRAME_READER_TEST_run_tests(void);
+/**
+ * \see /lib/protocol_test.c
+ */
+extern int PROTOCOL_TEST_run_tests(void);
+/**
+ * \see /lib/lz4_block_test.c
+ */
+extern int LZ4_BLOCK_TEST_run_tests(void);
+/**
+ * \see /lib/mailbox_test.c
+ */
+extern int MAILBOX_TEST_run_tests(void);
+/**
+ * \see /lib/actor_test.c
+ */
+extern int ACTOR_TEST_run_tests(void);
+/**
+ * \see /lib/watchdog_test.c
+ */
+extern int WATCHDOG_TEST_run_tests(void);
+/**
+ * \see /com/capabilities_test.c
+ */
+extern int CAPABILITIES_TEST_run_tests(void);
+/**
+ * \see /logs/controller_logger_test.c
+ */
+extern int CONTROLLER_LOGGER_TEST_run_tests(void);
+/**
+ * \see /com/postman_test.c
+ */
+extern int POSTMAN_TEST_run_tests(void);
 /**
  * \see /com/dispatcher_test.c
  */
@@ -90,9 +130,19 @@ int (* suite_tests[])(void) = {
 	CONTROLLER_RINGER_TEST_run_tests,
 	PILOT_TEST_run_tests,
 	STATE_INDICATOR_TEST_run_tests,
-    //DISPATCHER_run_tests,   /* Not working */
-    //LOGS_MANAGER_PROXY_TEST_run_tests,    /* Not working */
-    //GUI_SECRETARY_PROXY_TEST_run_tests,   /* Not working */
+	FRAME_POOL_TEST_run_tests,
+	FRAME_READER_TEST_run_tests,
+	PROTOCOL_TEST_run_tests,
+	LZ4_BLOCK_TEST_run_tests,
+	MAILBOX_TEST_run_tests,
+	ACTOR_TEST_run_tests,
+	WATCHDOG_TEST_run_tests,
+	CAPABILITIES_TEST_run_tests,
+	CONTROLLER_LOGGER_TEST_run_tests,
+	DISPATCHER_run_tests,
+	POSTMAN_TEST_run_tests,
+	LOGS_MANAGER_PROXY_TEST_run_tests,
+	GUI_SECRETARY_PROXY_TEST_run_tests,
 	//GUI_RINGER_PROXY_TEST_run_tests,  /* Not working */
     //GUI_PROXY_TEST_run_tests, /* Not working */
 };